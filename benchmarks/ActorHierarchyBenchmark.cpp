@@ -0,0 +1,143 @@
+/**
+ * @file ActorHierarchyBenchmark.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include <string>
+
+#include "BenchmarkHelpers.h"
+#include "Scene.h"
+#include "TestHelpers.h"
+
+namespace
+{
+    constexpr int chainDepth = 1000;
+    constexpr int treeWidth = 100;  // Children per actor, two levels down from the root.
+    constexpr int frameCount = 50;
+
+    // The renderer, physics and audio each ask for an actor's transform in a frame.
+    constexpr int lookupsPerFrame = 3;
+
+    struct Hierarchy
+    {
+        std::vector<engine::Actor*> actors;
+        std::vector<int> parents;  // The index of each actor's parent, or -1 for the root.
+    };
+
+    Hierarchy buildChain(engine::Scene &scene)
+    {
+        Hierarchy hierarchy;
+        for (int i = 0; i < chainDepth; ++i)
+        {
+            Ref<engine::Actor> actor = scene.spawnActor<engine::Actor>("Link");
+            actor->position = glm::vec3(1.f, 0.f, 0.f);
+            if (i > 0)
+                hierarchy.actors.back()->addChildActor(actor, false);
+
+            hierarchy.parents.push_back(i - 1);
+            hierarchy.actors.push_back(actor.get());
+        }
+
+        return hierarchy;
+    }
+
+    Hierarchy buildTree(engine::Scene &scene)
+    {
+        Hierarchy hierarchy;
+        const auto addActor = [&](const int parentIndex) {
+            Ref<engine::Actor> actor = scene.spawnActor<engine::Actor>("Branch");
+            actor->position = glm::vec3(1.f, 0.f, 0.f);
+            if (parentIndex >= 0)
+                hierarchy.actors[parentIndex]->addChildActor(actor, false);
+
+            hierarchy.parents.push_back(parentIndex);
+            hierarchy.actors.push_back(actor.get());
+            return static_cast<int>(hierarchy.actors.size()) - 1;
+        };
+
+        const int root = addActor(-1);
+        for (int i = 0; i < treeWidth; ++i)
+        {
+            const int branch = addActor(root);
+            for (int j = 0; j < treeWidth; ++j)
+                addActor(branch);
+        }
+
+        return hierarchy;
+    }
+
+    glm::mat4 buildLocalTransform(const engine::Actor &actor)
+    {
+        return glm::translate(glm::mat4(1.f), actor.position) * glm::mat4_cast(actor.rotation) * glm::scale(glm::mat4(1.f), actor.scale);
+    }
+
+    /**
+     * @brief How getTransform() worked before world transforms were cached: every call multiplies its way up to the root.
+     */
+    glm::mat4 findTransformRecursive(const std::vector<glm::mat4> &locals, const std::vector<int> &parents, const int index)
+    {
+        if (parents[index] >= 0)
+            return findTransformRecursive(locals, parents, parents[index]) * locals[index];
+        return locals[index];
+    }
+
+    void benchmarkHierarchy(const std::string &name, engine::Scene &scene, const Hierarchy &hierarchy)
+    {
+        engine::Actor *root = hierarchy.actors.front();
+        scene.update();
+
+        // update() also walks the components, so this is a little more work than just the transforms.
+        const double cachedTime = bench::measure([&] {
+            for (int frame = 0; frame < frameCount; ++frame)
+            {
+                root->position.x += 0.01f;
+                scene.update();
+                scene.resolveTransforms();
+
+                float sum = 0.f;
+                for (int i = 0; i < lookupsPerFrame; ++i)
+                {
+                    for (const engine::Actor *actor : hierarchy.actors)
+                        sum += actor->getTransform()[3][0];
+                }
+                bench::keep(sum);
+            }
+        });
+        bench::report(name + ": cached", cachedTime / frameCount, "ms/frame");
+
+        // Every local transform used to be rebuilt on update whether the actor moved or not.
+        std::vector<glm::mat4> locals(hierarchy.actors.size());
+        const double recursiveTime = bench::measure([&] {
+            for (int frame = 0; frame < frameCount; ++frame)
+            {
+                root->position.x += 0.01f;
+                for (size_t i = 0; i < hierarchy.actors.size(); ++i)
+                    locals[i] = buildLocalTransform(*hierarchy.actors[i]);
+
+                float sum = 0.f;
+                for (int i = 0; i < lookupsPerFrame; ++i)
+                {
+                    for (size_t j = 0; j < hierarchy.actors.size(); ++j)
+                        sum += findTransformRecursive(locals, hierarchy.parents, static_cast<int>(j))[3][0];
+                }
+                bench::keep(sum);
+            }
+        });
+        bench::report(name + ": recursive", recursiveTime / frameCount, "ms/frame");
+    }
+}
+
+int main()
+{
+    test::Environment environment;
+
+    engine::Scene chainScene;
+    benchmarkHierarchy("Chain of 1000 actors", chainScene, buildChain(chainScene));
+
+    engine::Scene treeScene;
+    benchmarkHierarchy("Tree of 100 x 100 actors", treeScene, buildTree(treeScene));
+
+    return 0;
+}
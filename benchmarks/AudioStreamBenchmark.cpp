@@ -0,0 +1,178 @@
+/**
+ * @file AudioStreamBenchmark.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include <alc.h>
+#include <alext.h>
+
+#include "AudioSource.h"
+#include "BenchmarkHelpers.h"
+#include "EngineState.h"
+#include "FileLoader.h"
+#include "TestHelpers.h"
+#include "ThreadPool.h"
+
+#define STB_VORBIS_HEADER_ONLY
+#include <stb_vorbis.c>
+
+namespace
+{
+    constexpr ALCint sampleRate = 44100;
+    constexpr int framesPerSecond = 60;
+    constexpr ALCsizei samplesPerFrame = sampleRate / framesPerSecond;
+
+    /**
+     * @brief Mixes into memory instead of a sound card, so sources play the same with or without one.
+     */
+    class LoopbackDevice
+    {
+    public:
+        LoopbackDevice()
+        {
+            mDevice = alcLoopbackOpenDeviceSOFT(nullptr);
+            if (mDevice == nullptr)
+                return;
+
+            if (alcIsRenderFormatSupportedSOFT(mDevice, sampleRate, ALC_STEREO_SOFT, ALC_SHORT_SOFT) == ALC_FALSE)
+                return;
+
+            const std::vector<ALCint> attributes = {
+                ALC_FORMAT_CHANNELS_SOFT, ALC_STEREO_SOFT,
+                ALC_FORMAT_TYPE_SOFT, ALC_SHORT_SOFT,
+                ALC_FREQUENCY, sampleRate,
+                0
+            };
+            mContext = alcCreateContext(mDevice, attributes.data());
+            if (mContext != nullptr && alcMakeContextCurrent(mContext) == ALC_FALSE)
+            {
+                alcDestroyContext(mContext);
+                mContext = nullptr;
+            }
+        }
+
+        ~LoopbackDevice()
+        {
+            alcMakeContextCurrent(nullptr);
+            if (mContext != nullptr)
+                alcDestroyContext(mContext);
+            if (mDevice != nullptr)
+                alcCloseDevice(mDevice);
+        }
+
+        [[nodiscard]] bool isValid() const { return mContext != nullptr; }
+
+        /**
+         * @brief Mixes one frame's worth of audio from every playing source.
+         */
+        void render()
+        {
+            alcRenderSamplesSOFT(mDevice, mSamples.data(), samplesPerFrame);
+        }
+
+    protected:
+        ALCdevice *mDevice { nullptr };
+        ALCcontext *mContext { nullptr };
+        std::vector<short> mSamples = std::vector<short>(samplesPerFrame * 2);
+    };
+
+    /**
+     * @brief Calls the decode callbacks as they finish. A real frame is long enough for a chunk to be decoded, but
+     * the loopback device mixes far faster than real time, so the stream is given the time it would have had.
+     */
+    void waitForDecodes(load::ThreadPool &pool)
+    {
+        pool.resolveFinishedJobs();
+        while (pool.getJobCount() > 0)
+        {
+            std::this_thread::yield();
+            pool.resolveFinishedJobs();
+        }
+    }
+}
+
+int main()
+{
+    test::Environment environment;
+    if (!file::findResourceFolder())
+        return 1;
+
+    load::ThreadPool pool;
+    engine::threadPool = &pool;
+
+    LoopbackDevice device;
+    if (!device.isValid())
+        return 1;
+
+    for (const auto &entry : std::filesystem::directory_iterator(file::resourcePath() / "audio"))
+    {
+        const std::filesystem::path &path = entry.path();
+        if (!entry.is_regular_file() || path.extension() != ".ogg")
+            continue;
+
+        const std::string name = path.filename().string();
+
+        int error = 0;
+        stb_vorbis *decoder = stb_vorbis_open_filename(path.string().c_str(), &error, nullptr);
+        if (decoder == nullptr)
+            continue;
+
+        const stb_vorbis_info info = stb_vorbis_get_info(decoder);
+        const int frameCount = static_cast<int>(stb_vorbis_stream_length_in_seconds(decoder) * framesPerSecond);
+        stb_vorbis_close(decoder);
+
+        // The whole file is decoded and uploaded before anything can play.
+        std::shared_ptr<engine::AudioBuffer> buffer;
+        bench::report(name + ": buffer load", bench::measure([&] {
+            buffer = std::make_shared<engine::AudioBuffer>(path);
+        }), "ms");
+
+        ALint bufferBytes = 0;
+        alGetBufferi(buffer->id(), AL_SIZE, &bufferBytes);
+        bench::report(name + ": buffer memory", static_cast<double>(bufferBytes) / 1024.0, "KB");
+
+        {
+            const engine::AudioSource source(buffer);
+            source.play();
+            const double bufferTime = bench::measure([&] {
+                for (int i = 0; i < frameCount; ++i)
+                    device.render();
+            }, 1);
+            bench::report(name + ": buffer playback", bufferTime * 1000.0 / frameCount, "us/frame");
+        }
+        buffer.reset();
+
+        // Only the first chunk has to be decoded before the stream can start.
+        std::unique_ptr<engine::AudioSource> source;
+        bench::report(name + ": stream start", bench::measure([&] {
+            source = std::make_unique<engine::AudioSource>(std::make_unique<engine::AudioStream>(path));
+            source->play();
+            waitForDecodes(pool);
+            engine::AudioStream::updateAll();
+        }), "ms");
+
+        // Queuing and unqueuing buffers on the main thread, then the same frame with its chunk decodes waited on.
+        double updateTime = 0.0;
+        const double streamTime = bench::measure([&] {
+            for (int i = 0; i < frameCount; ++i)
+            {
+                updateTime += bench::measure([] { engine::AudioStream::updateAll(); }, 1);
+                device.render();
+                waitForDecodes(pool);
+            }
+        }, 1);
+        source.reset();
+        bench::report(name + ": stream updateAll()", updateTime * 1000.0 / frameCount, "us/frame");
+        bench::report(name + ": stream frame, decode included", streamTime * 1000.0 / frameCount, "us/frame");
+
+        // The same sum that AudioStream reports to the profiler.
+        const uint64_t chunkBytes = engine::AudioStream::chunkFrameCount * info.channels * sizeof(short);
+        const uint64_t streamBytes = info.setup_memory_required + info.temp_memory_required + chunkBytes * engine::AudioStream::bufferCount;
+        bench::report(name + ": stream memory", static_cast<double>(streamBytes) / 1024.0, "KB");
+    }
+
+    engine::threadPool = nullptr;
+    return 0;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file BenchmarkHelpers.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+// Each benchmark is a plain executable that prints its timings. Build in release for numbers that mean anything.
+namespace bench
+{
+    /**
+     * @returns The median time in milliseconds that function took over repeatCount runs.
+     */
+    template<typename TFunction>
+    double measure(TFunction &&function, const int repeatCount=5)
+    {
+        std::vector<double> times;
+        for (int i = 0; i < repeatCount; ++i)
+        {
+            const auto startTime = std::chrono::steady_clock::now();
+            function();
+            const std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - startTime;
+            times.push_back(duration.count());
+        }
+
+        std::sort(times.begin(), times.end());
+        return times[times.size() / 2];
+    }
+
+    /**
+     * @brief The same as measure() but setup is called before each run and is not part of the time.
+     */
+    template<typename TSetup, typename TFunction>
+    double measure(TSetup &&setup, TFunction &&function, const int repeatCount=5)
+    {
+        std::vector<double> times;
+        for (int i = 0; i < repeatCount; ++i)
+        {
+            setup();
+            const auto startTime = std::chrono::steady_clock::now();
+            function();
+            const std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - startTime;
+            times.push_back(duration.count());
+        }
+
+        std::sort(times.begin(), times.end());
+        return times[times.size() / 2];
+    }
+
+    inline void report(const std::string_view name, const double value, const std::string_view unit)
+    {
+        std::cout << std::left << std::setw(48) << name << std::right << std::setw(12) << std::fixed
+                  << std::setprecision(3) << value << " " << unit << "\n";
+    }
+
+    /**
+     * @brief Stops the optimiser from removing work whose result is never used.
+     */
+    template<typename T>
+    void keep(const T value)
+    {
+        static volatile T sink;
+        sink = value;
+    }
+}
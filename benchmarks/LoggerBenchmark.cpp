@@ -0,0 +1,77 @@
+/**
+ * @file LoggerBenchmark.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include <chrono>
+#include <thread>
+
+#include "BenchmarkHelpers.h"
+#include "Logger.h"
+#include "LoggerMacros.h"
+
+namespace
+{
+    /**
+     * @returns The median time in nanoseconds per message, as seen by the threads logging them. The logger is flushed
+     * between runs, outside of the timing, so that every run starts with an empty buffer.
+     */
+    double logMessages(debug::Logger &logger, const int threadCount, const int messageCount, const bool includeWrite)
+    {
+        std::vector<double> times;
+        for (int run = 0; run < 5; ++run)
+        {
+            const auto startTime = std::chrono::steady_clock::now();
+            std::vector<std::thread> threads;
+            for (int i = 0; i < threadCount; ++i)
+            {
+                threads.emplace_back([messageCount] {
+                    for (int j = 0; j < messageCount; ++j)
+                        MESSAGE_VERBOSE("Loaded mesh % in %ms", j, 1.5);
+                });
+            }
+            for (std::thread &thread : threads)
+                thread.join();
+
+            if (includeWrite)
+                logger.flush();
+
+            const std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - startTime;
+            times.push_back(duration.count() / (static_cast<double>(messageCount) * threadCount));
+            logger.flush();
+        }
+
+        std::sort(times.begin(), times.end());
+        return times[times.size() / 2];
+    }
+}
+
+int main()
+{
+    debug::Logger logger;
+    debug::logger = &logger;
+    logger.setOutputFlag(debug::OutputSourceFlag_File);
+
+    // A burst fits in the ring buffer, so it only measures the cost to the caller. A sustained stream doesn't, so
+    // under Block the caller ends up waiting on the writer.
+    constexpr int burstCount = 1000;
+    constexpr int streamCount = 200000;
+    for (const int threadCount : { 1, 4 })
+    {
+        const std::string threads = std::to_string(threadCount) + " thread(s)";
+
+        logger.setOverflowPolicy(debug::OverflowPolicy_Block);
+        bench::report("Block: " + threads + ", burst", logMessages(logger, threadCount, burstCount, false), "ns/msg");
+        bench::report("Block: " + threads + ", stream", logMessages(logger, threadCount, streamCount, false), "ns/msg");
+        bench::report("Block: " + threads + ", stream until written", logMessages(logger, threadCount, streamCount, true), "ns/msg");
+
+        logger.setOverflowPolicy(debug::OverflowPolicy_Drop);
+        bench::report("Drop: " + threads + ", stream", logMessages(logger, threadCount, streamCount, false), "ns/msg");
+    }
+
+    logger.flush();
+    debug::logger = nullptr;
+    return 0;
+}
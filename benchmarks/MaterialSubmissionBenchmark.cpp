@@ -0,0 +1,131 @@
+/**
+ * @file MaterialSubmissionBenchmark.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include <cstring>
+#include <random>
+
+#include "BenchmarkHelpers.h"
+#include "FrameArena.h"
+#include "InstanceBatching.h"
+#include "MaterialData.h"
+#include "TestHelpers.h"
+
+namespace
+{
+    using namespace graphics;
+
+    constexpr uint32_t materialCount = 1000;
+    constexpr uint32_t subMeshCount = 20000;
+    constexpr uint32_t meshCount = 200;
+    constexpr uint32_t dirtyMaterialCount = 10;
+
+    MaterialData makeMaterial(const uint32_t materialIndex)
+    {
+        MaterialData material;
+        material.textureArrayId = materialIndex + 1;
+        material.layers.resize(2);
+        material.masks.resize(1);
+        material.textureArrayData.resize(4);
+        return material;
+    }
+
+    /**
+     * @brief Stands in for the buffer writes since a benchmark doesn't have a gpu. Only the bytes moved matter here.
+     */
+    void stage(std::vector<std::byte> &staging, const MaterialData &material)
+    {
+        const size_t layerBytes = material.layers.size() * sizeof(LayerData);
+        const size_t maskBytes = material.masks.size() * sizeof(MaskData);
+        const size_t textureBytes = material.textureArrayData.size() * sizeof(TextureData);
+        const size_t offset = staging.size();
+        staging.resize(offset + layerBytes + maskBytes + textureBytes);
+        std::memcpy(staging.data() + offset, material.layers.data(), layerBytes);
+        std::memcpy(staging.data() + offset + layerBytes, material.masks.data(), maskBytes);
+        std::memcpy(staging.data() + offset + layerBytes + maskBytes, material.textureArrayData.data(), textureBytes);
+    }
+}
+
+int main()
+{
+    test::Environment environment;
+
+    std::vector<MaterialData> materials;
+    for (uint32_t i = 0; i < materialCount; ++i)
+        materials.push_back(makeMaterial(i));
+
+    // Every sub-mesh picks a mesh and a material at random so that batching has something to sort.
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<uint32_t> materialDistribution(0, materialCount - 1);
+    std::uniform_int_distribution<uint32_t> meshDistribution(0, meshCount - 1);
+    std::vector<GeometryObject> geometry;
+    std::vector<uint32_t> materialIndices;
+    for (uint32_t i = 0; i < subMeshCount; ++i)
+    {
+        const uint32_t mesh = meshDistribution(generator);
+        const glm::mat4 matrix = glm::translate(glm::mat4(1.f), glm::vec3(static_cast<float>(i), 0.f, 0.f));
+        geometry.emplace_back(mesh + 1, mesh, 36, mesh * 36, 0, matrix, BoundingSphere { glm::vec3(0.f), 1.f }, Mobility::Movable);
+        materialIndices.push_back(materialDistribution(generator));
+    }
+
+    std::vector<uint32_t> visible(subMeshCount);
+    for (uint32_t i = 0; i < subMeshCount; ++i)
+        visible[i] = i;
+
+    FrameArena arena;
+    std::vector<std::byte> staging;
+    InstanceBatcher batcher;
+    std::vector<InstanceBatch> batches;
+    std::vector<glm::mat4> matrices;
+
+    // How the renderer used to queue geometry: a full copy of the material with every sub-mesh, written out again
+    // for every draw.
+    bench::report("1k materials: queue MaterialData copies", bench::measure([&] {
+        std::vector<GeometryObject> geometryQueue;
+        std::vector<MaterialData> materialQueue;
+        for (uint32_t i = 0; i < subMeshCount; ++i)
+        {
+            geometryQueue.push_back(geometry[i]);
+            materialQueue.push_back(materials[materialIndices[i]]);
+        }
+
+        staging.clear();
+        for (const MaterialData &material : materialQueue)
+            stage(staging, material);
+        bench::keep(staging.size());
+    }), "ms");
+
+    // The queues only carry an index into the material table, and only the materials that changed are written.
+    bench::report("1k materials: queue material index", bench::measure([&] {
+        arena.reset();
+        FrameVector<GeometryObject> geometryQueue { FrameAllocator<GeometryObject>(arena) };
+        FrameVector<uint32_t> materialQueue { FrameAllocator<uint32_t>(arena) };
+        for (uint32_t i = 0; i < subMeshCount; ++i)
+        {
+            geometryQueue.push_back(geometry[i]);
+            materialQueue.push_back(materialIndices[i]);
+        }
+
+        staging.clear();
+        for (uint32_t i = 0; i < dirtyMaterialCount; ++i)
+            stage(staging, materials[i]);
+        bench::keep(staging.size());
+    }), "ms");
+
+    // Sorting and grouping the queued geometry by material index, which replaced hashing the material bytes.
+    FrameVector<GeometryObject> geometryQueue { FrameAllocator<GeometryObject>() };
+    FrameVector<uint32_t> materialQueue { FrameAllocator<uint32_t>() };
+    geometryQueue.assign(geometry.begin(), geometry.end());
+    materialQueue.assign(materialIndices.begin(), materialIndices.end());
+    bench::report("1k materials: batch by material index", bench::measure([&] {
+        batches.clear();
+        matrices.clear();
+        batcher.batchByMaterial(geometryQueue, materialQueue, visible, glm::mat4(1.f), batches, matrices);
+        bench::keep(batches.size());
+    }), "ms");
+
+    return 0;
+}
@@ -0,0 +1,105 @@
+/**
+ * @file MeshLoadBenchmark.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+
+#include "BenchmarkHelpers.h"
+#include "CommonLoader.h"
+#include "CookedMesh.h"
+#include "FileLoader.h"
+#include "TestHelpers.h"
+#include "Vertices.h"
+
+namespace
+{
+    using ReadyMesh = engine::disk::MeshData<StandardVertex>;
+
+    /**
+     * @brief The same import that ResourcePool::loadMesh() falls back to when there isn't a cooked mesh.
+     */
+    std::vector<ReadyMesh> importWithAssimp(const std::filesystem::path &path)
+    {
+        Assimp::Importer importer;
+        const aiScene *scene = importer.ReadFile(path.string(), load::meshImportFlags);
+        if (scene == nullptr)
+            return { };
+
+        std::vector<ReadyMesh> meshes;
+        for (int i = 0; i < scene->mNumMeshes; ++i)
+        {
+            const aiMesh *mesh = scene->mMeshes[i];
+
+            std::vector<uint32_t> indices;
+            indices.reserve(mesh->mNumFaces * 3);
+            for (int j = 0; j < mesh->mNumFaces; ++j)
+            {
+                for (int k = 0; k < mesh->mFaces[j].mNumIndices; ++k)
+                    indices.emplace_back(mesh->mFaces[j].mIndices[k]);
+            }
+
+            std::vector<StandardVertex> vertices;
+            vertices.reserve(mesh->mNumVertices);
+            for (int j = 0; j < mesh->mNumVertices; ++j)
+            {
+                const glm::vec3 position = load::toVec3(mesh->mVertices[j]);
+                const glm::vec2 uv = mesh->HasTextureCoords(0) ? load::toVec2(mesh->mTextureCoords[0][j]) : glm::vec2(0.f);
+                const glm::vec3 normal = load::toVec3(mesh->mNormals[j]);
+                const glm::vec3 tangent = mesh->HasTangentsAndBitangents() ? load::toVec3(mesh->mTangents[j]) : glm::vec3(0.f);
+                vertices.emplace_back(AssimpVertex { position, uv, normal, tangent });
+            }
+
+            meshes.emplace_back(ReadyMesh { indices, vertices, graphics::computeBoundingVolume(vertices) });
+        }
+
+        return meshes;
+    }
+}
+
+int main()
+{
+    test::Environment environment;
+    if (!file::findResourceFolder())
+        return 1;
+
+    for (const auto &entry : std::filesystem::directory_iterator(file::modelPath()))
+    {
+        const std::filesystem::path &path = entry.path();
+        if (!entry.is_regular_file() || !file::hasModelExtension(path))
+            continue;
+
+        const std::filesystem::path cookedPath = engine::disk::cookedMeshPath(path, engine::disk::layoutId<StandardVertex>());
+        std::vector<ReadyMesh> meshes = importWithAssimp(path);
+        engine::disk::CookedSource source = engine::disk::findCookedSource(path, load::meshImportFlags);
+        if (meshes.empty() || !engine::disk::writeCookedMesh(cookedPath, path, source, meshes))
+            continue;
+
+        const std::string name = path.filename().string();
+        bench::report(name + ": assimp", bench::measure([&] {
+            bench::keep(importWithAssimp(path).size());
+        }), "ms");
+
+        // What a load costs when the source hasn't changed since it was cooked.
+        bench::report(name + ": cooked", bench::measure([&] {
+            engine::disk::CookedSource cookedSource = engine::disk::findCookedSource(path, load::meshImportFlags);
+            std::vector<ReadyMesh> cooked;
+            engine::disk::readCookedMesh(cookedPath, path, cookedSource, cooked);
+            bench::keep(cooked.size());
+        }), "ms");
+
+        // The source was touched, so it has to be hashed before the cooked mesh can be trusted.
+        bench::report(name + ": cooked + hash", bench::measure([&] {
+            bench::keep(engine::disk::hashFile(path));
+            engine::disk::CookedSource cookedSource = engine::disk::findCookedSource(path, load::meshImportFlags);
+            std::vector<ReadyMesh> cooked;
+            engine::disk::readCookedMesh(cookedPath, path, cookedSource, cooked);
+            bench::keep(cooked.size());
+        }), "ms");
+    }
+
+    return 0;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file PhysicsMeshBenchmark.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+
+#include "BenchmarkHelpers.h"
+#include "CommonLoader.h"
+#include "CookedPhysicsMesh.h"
+#include "FileLoader.h"
+#include "PhysicsMeshBuffer.h"
+#include "TestHelpers.h"
+
+namespace
+{
+    using engine::physics::MeshColliderBuffer;
+    using engine::physics::MeshDataBuffer;
+
+    /**
+     * @brief The same import that ResourcePool::loadPhysicsMesh() falls back to when there isn't a cooked mesh.
+     */
+    std::vector<MeshDataBuffer> importWithAssimp(const std::filesystem::path &path)
+    {
+        Assimp::Importer importer;
+        const aiScene *scene = importer.ReadFile(path.string(), load::meshImportFlags);
+        if (scene == nullptr)
+            return { };
+
+        std::vector<MeshDataBuffer> meshes;
+        for (int i = 0; i < scene->mNumMeshes; ++i)
+        {
+            const aiMesh *mesh = scene->mMeshes[i];
+            MeshDataBuffer &meshData = meshes.emplace_back();
+
+            meshData.indices.reserve(mesh->mNumFaces * 3);
+            for (int j = 0; j < mesh->mNumFaces; ++j)
+            {
+                for (int k = 0; k < mesh->mFaces[j].mNumIndices; ++k)
+                    meshData.indices.emplace_back(mesh->mFaces[j].mIndices[k]);
+            }
+
+            meshData.vertices.reserve(mesh->mNumVertices);
+            for (int j = 0; j < mesh->mNumVertices; ++j)
+                meshData.vertices.emplace_back(load::toVec3(mesh->mVertices[j]));
+        }
+
+        return meshes;
+    }
+
+    /**
+     * @brief Bullet keeps pointers into the buffer, so every run builds into a new one.
+     */
+    std::unique_ptr<MeshColliderBuffer> buildCold(std::vector<MeshDataBuffer> meshes)
+    {
+        auto buffer = std::make_unique<MeshColliderBuffer>();
+        buffer->meshDataBuffers = std::move(meshes);
+        buffer->buildVertexArray();
+        buffer->buildShape();
+        return buffer;
+    }
+}
+
+int main()
+{
+    test::Environment environment;
+    if (!file::findResourceFolder())
+        return 1;
+
+    for (const auto &entry : std::filesystem::directory_iterator(file::modelPath()))
+    {
+        const std::filesystem::path &path = entry.path();
+        if (!entry.is_regular_file() || !file::hasModelExtension(path))
+            continue;
+
+        const std::vector<MeshDataBuffer> meshes = importWithAssimp(path);
+        if (meshes.empty())
+            continue;
+
+        // Cooks the mesh the same way as a cold load so that the warm runs have something to read.
+        const std::filesystem::path cookedPath = engine::disk::cookedPhysicsMeshPath(path);
+        {
+            const std::unique_ptr<MeshColliderBuffer> buffer = buildCold(meshes);
+            buffer->serializeBvh();
+            engine::disk::CookedSource source = engine::disk::findCookedSource(path, load::meshImportFlags);
+            if (!engine::disk::writeCookedPhysicsMesh(cookedPath, path, source, *buffer))
+                continue;
+        }
+
+        const std::string name = path.filename().string();
+        bench::report(name + ": cold (assimp + bvh build)", bench::measure([&] {
+            bench::keep(buildCold(importWithAssimp(path))->shape.get());
+        }), "ms");
+
+        bench::report(name + ": bvh build only", bench::measure([&] {
+            bench::keep(buildCold(meshes)->shape.get());
+        }), "ms");
+
+        // What a load costs when the source hasn't changed since it was cooked.
+        bench::report(name + ": warm (cooked bvh)", bench::measure([&] {
+            auto buffer = std::make_unique<MeshColliderBuffer>();
+            engine::disk::CookedSource source = engine::disk::findCookedSource(path, load::meshImportFlags);
+            if (engine::disk::readCookedPhysicsMesh(cookedPath, path, source, *buffer))
+                buffer->buildShapeFromSerializedBvh();
+            bench::keep(buffer->shape.get());
+        }), "ms");
+    }
+
+    return 0;
+}
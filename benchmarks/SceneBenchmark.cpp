@@ -0,0 +1,257 @@
+/**
+ * @file SceneBenchmark.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <set>
+#include <typeinfo>
+
+#include "BenchmarkHelpers.h"
+#include "Component.h"
+#include "Scene.h"
+#include "TestHelpers.h"
+
+namespace
+{
+    constexpr int actorCount = 100000;
+    constexpr int lookupCount = 1000000;
+    constexpr int componentActorCount = 10000;
+    constexpr int destroyCount = actorCount / 10;
+
+    // Every actor has a few components so that a lookup has something to skip over.
+    class Health : public engine::Component { };
+    class Stamina : public engine::Component { };
+    class Inventory : public engine::Component { };
+    class Target : public engine::Component { };
+
+    /**
+     * @brief How getActor() found an actor before the scene kept an index: a walk over every actor.
+     */
+    engine::Actor *findLinear(const std::vector<engine::Actor*> &actors, const engine::UUID actorId)
+    {
+        for (engine::Actor *actor : actors)
+        {
+            if (actor->getId() == actorId)
+                return actor;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief How a batch of actors was destroyed before the scene kept an index: destroy() searched for each actor and
+     * update() searched for it again before erasing it, which shifts every actor after it down.
+     */
+    void destroyByErase(std::vector<Resource<engine::Actor>> &actors, const std::vector<const engine::Actor*> &doomed)
+    {
+        std::set<const engine::Actor*> toDestroy;
+        for (const engine::Actor *actor : doomed)
+        {
+            const auto it = std::find_if(actors.begin(), actors.end(), [&actor](const Ref<engine::Actor> &left) {
+                return left.get() == actor;
+            });
+            if (it != actors.end())
+                toDestroy.emplace(actor);
+        }
+
+        for (auto &actor : actors)
+            actor->update();
+
+        for (const engine::Actor *actor : toDestroy)
+        {
+            const auto it = std::find_if(actors.begin(), actors.end(), [&actor](const Ref<engine::Actor> &left) {
+                return left.get() == actor;
+            });
+            actors.erase(it);
+        }
+    }
+
+    /**
+     * @brief How getComponent() and hasComponent() worked before actors kept an index: a dynamic_cast on every
+     * component until one is the exact type.
+     */
+    template<typename T>
+    Ref<T> findComponentByCast(engine::Actor &actor)
+    {
+        for (Resource<engine::Component> &component : actor.getComponents())
+        {
+            const T* t = dynamic_cast<const T*>(component.get());
+            if (t != nullptr && typeid(const T*).hash_code() == typeid(t).hash_code())
+                return dynamic_ref_cast<T>(component);
+        }
+        return Ref<T>();
+    }
+}
+
+int main()
+{
+    test::Environment environment;
+
+    engine::Scene scene;
+    std::vector<engine::Actor*> actors;
+    std::vector<engine::UUID> ids;
+    for (int i = 0; i < actorCount; ++i)
+    {
+        Ref<engine::Actor> actor = scene.spawnActor<engine::Actor>("Actor");
+        actors.push_back(actor.get());
+        ids.push_back(actor->getId());
+    }
+
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<size_t> distribution(0, ids.size() - 1);
+    std::vector<engine::UUID> lookups(lookupCount);
+    for (engine::UUID &id : lookups)
+        id = ids[distribution(generator)];
+
+    const double indexTime = bench::measure([&] {
+        uint64_t found = 0;
+        for (const engine::UUID id : lookups)
+            found += scene.getActor(id, false).isValid();
+        bench::keep(found);
+    });
+    bench::report("Indexed getActor()", indexTime * 1000000.0 / lookupCount, "ns/lookup");
+
+    // The linear walk is far too slow to do every lookup, so it only does a thousandth of them.
+    constexpr int linearCount = lookupCount / 1000;
+    const double linearTime = bench::measure([&] {
+        uint64_t found = 0;
+        for (int i = 0; i < linearCount; ++i)
+            found += findLinear(actors, lookups[i]) != nullptr;
+        bench::keep(found);
+    });
+    bench::report("Linear search", linearTime * 1000000.0 / linearCount, "ns/lookup");
+
+    const double missTime = bench::measure([&] {
+        uint64_t found = 0;
+        for (int i = 0; i < lookupCount; ++i)
+            found += scene.getActor(static_cast<engine::UUID>(i), false).isValid();
+        bench::keep(found);
+    });
+    bench::report("Indexed getActor(), missing actor", missTime * 1000000.0 / lookupCount, "ns/lookup");
+
+    // Each run gets a new scene. Making and tearing down the previous one isn't part of the time.
+    std::unique_ptr<engine::Scene> spawnScene;
+    const double spawnTime = bench::measure([&] {
+        spawnScene.reset();
+        spawnScene = std::make_unique<engine::Scene>();
+    }, [&] {
+        for (int i = 0; i < actorCount; ++i)
+            spawnScene->spawnActor<engine::Actor>("Actor");
+        spawnScene->update();
+    });
+    bench::report("spawnActor() + update(), 100k actors", spawnTime, "ms");
+
+    // The same random tenth of the actors is destroyed each run.
+    std::vector<size_t> doomedIndices(actorCount);
+    std::iota(doomedIndices.begin(), doomedIndices.end(), 0);
+    std::shuffle(doomedIndices.begin(), doomedIndices.end(), generator);
+    doomedIndices.resize(destroyCount);
+
+    std::unique_ptr<engine::Scene> destroyScene;
+    std::vector<const engine::Actor*> doomed;
+    const double destroyTime = bench::measure([&] {
+        destroyScene.reset();
+        destroyScene = std::make_unique<engine::Scene>();
+        std::vector<const engine::Actor*> spawned;
+        for (int i = 0; i < actorCount; ++i)
+            spawned.push_back(destroyScene->spawnActor<engine::Actor>("Actor").get());
+        destroyScene->update();
+
+        doomed.clear();
+        for (const size_t index : doomedIndices)
+            doomed.push_back(spawned[index]);
+    }, [&] {
+        for (const engine::Actor *actor : doomed)
+            destroyScene->destroy(actor);
+        destroyScene->update();
+    });
+    bench::report("destroy() 10k of 100k + update()", destroyTime, "ms");
+
+    std::vector<Resource<engine::Actor>> eraseActors;
+    const double eraseTime = bench::measure([&] {
+        eraseActors.clear();
+        for (int i = 0; i < actorCount; ++i)
+            eraseActors.push_back(makeResource<engine::Actor>("Actor"));
+
+        doomed.clear();
+        for (const size_t index : doomedIndices)
+            doomed.push_back(eraseActors[index].get());
+    }, [&] {
+        destroyByErase(eraseActors, doomed);
+    });
+    bench::report("Erase one at a time, 10k of 100k", eraseTime, "ms");
+
+    // Component lookups are timed on their own scene so that there are as many actors as a large level.
+    engine::Scene componentScene;
+    std::vector<engine::Actor*> componentActors;
+    for (int i = 0; i < componentActorCount; ++i)
+    {
+        Ref<engine::Actor> actor = componentScene.spawnActor<engine::Actor>("Actor");
+        actor->addComponent(makeResource<Health>());
+        actor->addComponent(makeResource<Stamina>());
+        actor->addComponent(makeResource<Inventory>());
+        if (i % 10 == 0)
+            actor->addComponent(makeResource<Target>());
+        componentActors.push_back(actor.get());
+    }
+
+    // The components are only moved out of the actors' pending lists on update.
+    componentScene.update();
+
+    const double registryTime = bench::measure([&] {
+        bench::keep(componentScene.findComponents<Target>().size());
+    });
+    bench::report("findComponents() on 10k actors", registryTime, "ms");
+
+    // How findComponents() used to work: ask every actor, which then casts every component.
+    const double registryCastTime = bench::measure([&] {
+        std::vector<Ref<Target>> results;
+        for (engine::Actor *actor : componentActors)
+        {
+            if (Ref<Target> component = findComponentByCast<Target>(*actor); component.isValid())
+                results.push_back(component);
+        }
+        bench::keep(results.size());
+    });
+    bench::report("findComponents(), dynamic_cast scan", registryCastTime, "ms");
+
+    const double getTime = bench::measure([&] {
+        uint64_t found = 0;
+        for (engine::Actor *actor : componentActors)
+            found += actor->getComponent<Inventory>(false).isValid();
+        bench::keep(found);
+    });
+    bench::report("getComponent() on each of 10k actors", getTime, "ms");
+
+    const double getCastTime = bench::measure([&] {
+        uint64_t found = 0;
+        for (engine::Actor *actor : componentActors)
+            found += findComponentByCast<Inventory>(*actor).isValid();
+        bench::keep(found);
+    });
+    bench::report("getComponent(), dynamic_cast scan", getCastTime, "ms");
+
+    const double hasTime = bench::measure([&] {
+        uint64_t found = 0;
+        for (engine::Actor *actor : componentActors)
+            found += actor->hasComponent<Target>();
+        bench::keep(found);
+    });
+    bench::report("hasComponent() on each of 10k actors", hasTime, "ms");
+
+    // hasComponent() was the same scan, so it had to walk every component when the actor didn't have one.
+    const double hasCastTime = bench::measure([&] {
+        uint64_t found = 0;
+        for (engine::Actor *actor : componentActors)
+            found += findComponentByCast<Target>(*actor).isValid();
+        bench::keep(found);
+    });
+    bench::report("hasComponent(), dynamic_cast scan", hasCastTime, "ms");
+
+    return 0;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file SceneFormatBenchmark.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include <fstream>
+#include <sstream>
+
+#include "BenchmarkHelpers.h"
+#include "BinaryScene.h"
+#include "FileLoader.h"
+#include "Serializer.h"
+#include "TestHelpers.h"
+
+namespace
+{
+    using namespace engine::serialize;
+
+    /**
+     * @brief Reads everything load::scene() reads from a .pcy file. Spawning the actors needs a window, so that is left out.
+     */
+    uint64_t loadYaml(const std::filesystem::path &path)
+    {
+        std::ifstream stream(path);
+        std::stringstream stringStream;
+        stringStream << stream.rdbuf();
+
+        const YAML::Node data = YAML::Load(stringStream.str());
+        uint64_t count = data["Scene"].as<std::string>().size();
+        for (const YAML::Node &actorNode : data["Actors"])
+        {
+            count += actorNode["Name"].as<std::string>().size();
+            count += actorNode["UUID"].as<engine::UUID>();
+            const auto position = actorNode["position"].as<glm::vec3>();
+            const auto rotation = actorNode["rotation"].as<glm::quat>();
+            const auto scale = actorNode["scale"].as<glm::vec3>();
+            bench::keep(position.x + rotation.w + scale.x);
+            if (const YAML::Node mobilityNode = actorNode["Mobility"]; mobilityNode.IsDefined())
+                count += mobilityNode.as<unsigned int>();
+            count += actorNode["Children"].as<std::vector<engine::UUID>>().size();
+
+            for (const YAML::Node &componentNode : actorNode["Components"])
+            {
+                if (componentNode["Component"].IsDefined())
+                    count += componentNode["Component"].as<std::string>().size() + componentNode.size();
+            }
+        }
+
+        return count;
+    }
+
+    /**
+     * @brief The same as loadYaml() but from a .pcyb file, including the nodes that are handed to the load delegates.
+     */
+    uint64_t loadBinary(const std::filesystem::path &path)
+    {
+        const BinarySceneReader reader(path);
+        if (!reader.isValid())
+            return 0;
+
+        uint64_t count = reader.getSceneName().size() + reader.getSceneNode().size();
+        for (uint32_t i = 0; i < reader.getActorCount(); ++i)
+        {
+            const BinaryActor actor = reader.getActor(i);
+            count += reader.getActorNode(actor).size();
+            count += reader.getString(actor.name).size();
+            count += actor.id;
+            bench::keep(actor.position[0] + actor.rotation[0] + actor.scale[0]);
+            count += reader.getChildren(actor).size();
+
+            for (uint32_t j = 0; j < actor.componentCount; ++j)
+            {
+                const BinaryComponent component = reader.getComponent(actor.firstComponent + j);
+                count += reader.getString(component.type).size() + reader.getComponentNode(component).size();
+            }
+        }
+
+        return count;
+    }
+}
+
+int main()
+{
+    test::Environment environment;
+    if (!file::findResourceFolder())
+        return 1;
+
+    for (const auto &entry : std::filesystem::directory_iterator(file::resourcePath() / "scenes"))
+    {
+        const std::filesystem::path &path = entry.path();
+        if (!entry.is_regular_file() || path.extension() != ".pcy")
+            continue;
+
+        const std::filesystem::path binaryPath = std::filesystem::temp_directory_path() / path.filename().replace_extension(".pcyb");
+        if (!convertToBinaryScene(path, binaryPath))
+            continue;
+
+        const std::string name = path.filename().string();
+        bench::report(name + ": yaml size", static_cast<double>(std::filesystem::file_size(path)) / 1024.0, "KB");
+        bench::report(name + ": binary size", static_cast<double>(std::filesystem::file_size(binaryPath)) / 1024.0, "KB");
+
+        bench::report(name + ": yaml load", bench::measure([&] {
+            bench::keep(loadYaml(path));
+        }), "ms");
+
+        bench::report(name + ": binary load", bench::measure([&] {
+            bench::keep(loadBinary(binaryPath));
+        }), "ms");
+
+        std::filesystem::remove(binaryPath);
+    }
+
+    return 0;
+}
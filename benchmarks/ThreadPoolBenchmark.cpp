@@ -0,0 +1,170 @@
+/**
+ * @file ThreadPoolBenchmark.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include <condition_variable>
+#include <queue>
+
+#include "BenchmarkHelpers.h"
+#include "TestHelpers.h"
+#include "ThreadPool.h"
+
+namespace
+{
+    /**
+     * @brief The pool from before the job system: one shared queue behind a single mutex.
+     */
+    class LegacyThreadPool
+    {
+    public:
+        LegacyThreadPool()
+        {
+            const uint32_t threadCount = glm::max(std::thread::hardware_concurrency(), 2u) - 1;
+            for (uint32_t i = 0; i < threadCount; ++i)
+                mThreads.emplace_back(&LegacyThreadPool::threadLoop, this);
+        }
+
+        ~LegacyThreadPool()
+        {
+            {
+                const std::unique_lock lock(mJobsMutex);
+                mShouldTerminate = true;
+            }
+            mMutexCondition.notify_all();
+            for (std::thread &thread : mThreads)
+                thread.join();
+        }
+
+        void queueJob(std::unique_ptr<load::IThreadTask> task)
+        {
+            ++mJobCount;
+            {
+                const std::unique_lock lock(mJobsMutex);
+                mJobs.push(std::move(task));
+            }
+            mMutexCondition.notify_one();
+        }
+
+        void resolveFinishedJobs()
+        {
+            const std::unique_lock lock(mFinishedJobsMutex);
+            while (!mFinishedJobs.empty())
+            {
+                mFinishedJobs.front()->callback();
+                mFinishedJobs.pop();
+                --mJobCount;
+            }
+        }
+
+        [[nodiscard]] uint32_t getJobCount() const { return mJobCount; }
+
+    protected:
+        void threadLoop()
+        {
+            while (true)
+            {
+                std::unique_ptr<load::IThreadTask> job;
+                {
+                    std::unique_lock lock(mJobsMutex);
+                    mMutexCondition.wait(lock, [this] { return !mJobs.empty() || mShouldTerminate; });
+                    if (mShouldTerminate)
+                        return;
+
+                    job = std::move(mJobs.front());
+                    mJobs.pop();
+                }
+                job->run();
+
+                const std::unique_lock lock(mFinishedJobsMutex);
+                mFinishedJobs.push(std::move(job));
+            }
+        }
+
+        bool mShouldTerminate = false;
+        std::vector<std::thread> mThreads;
+        std::queue<std::unique_ptr<load::IThreadTask>> mJobs;
+        std::condition_variable mMutexCondition;
+        std::mutex mJobsMutex;
+        std::queue<std::unique_ptr<load::IThreadTask>> mFinishedJobs;
+        std::mutex mFinishedJobsMutex;
+        uint32_t mJobCount = 0;
+    };
+
+    constexpr uint32_t jobCount = 20000;
+    constexpr uint32_t elementCount = 1 << 22;
+    constexpr uint32_t batchSize = 4096;
+
+    // Roughly the cost of a small job, such as decoding a chunk or transforming a batch.
+    uint64_t work(const uint32_t begin, const uint32_t end)
+    {
+        uint64_t sum = 0;
+        for (uint32_t i = begin; i < end; ++i)
+            sum += (i * 2654435761u) >> 7;
+        return sum;
+    }
+
+    template<typename TPool>
+    void runLoadingJobs(TPool &pool)
+    {
+        std::atomic<uint64_t> total { 0 };
+        for (uint32_t i = 0; i < jobCount; ++i)
+        {
+            pool.queueJob(load::makeJob<uint64_t>(
+                [i] { return work(i * 256, (i + 1) * 256); },
+                [&total](const uint64_t &result) { total += result; }));
+        }
+
+        while (pool.getJobCount() > 0)
+            pool.resolveFinishedJobs();
+        bench::keep(total.load());
+    }
+
+    // The old pool had no way to wait on work other than going through the main thread's callbacks.
+    void runBatches(LegacyThreadPool &pool)
+    {
+        std::atomic<uint64_t> total { 0 };
+        for (uint32_t begin = 0; begin < elementCount; begin += batchSize)
+        {
+            pool.queueJob(load::makeJob<uint64_t>(
+                [begin] { return work(begin, begin + batchSize); },
+                [&total](const uint64_t &result) { total += result; }));
+        }
+
+        while (pool.getJobCount() > 0)
+            pool.resolveFinishedJobs();
+        bench::keep(total.load());
+    }
+
+    void runBatches(load::ThreadPool &pool)
+    {
+        std::atomic<uint64_t> total { 0 };
+        pool.parallelFor(elementCount, batchSize, [&total](const uint32_t begin, const uint32_t end) {
+            total += work(begin, end);
+        });
+        bench::keep(total.load());
+    }
+}
+
+int main()
+{
+    test::Environment environment;
+
+    {
+        LegacyThreadPool pool;
+        bench::report("Legacy pool: 20k loading jobs", bench::measure([&] { runLoadingJobs(pool); }), "ms");
+        bench::report("Legacy pool: 4M elements in batches", bench::measure([&] { runBatches(pool); }), "ms");
+    }
+
+    {
+        load::ThreadPool pool;
+        pool.setCompletionBudget(1000.f);
+        bench::report("Job system: 20k loading jobs", bench::measure([&] { runLoadingJobs(pool); }), "ms");
+        bench::report("Job system: 4M elements with parallelFor", bench::measure([&] { runBatches(pool); }), "ms");
+    }
+
+    bench::report("Single thread: 4M elements", bench::measure([] { bench::keep(work(0, elementCount)); }), "ms");
+    return 0;
+}
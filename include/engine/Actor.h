@@ -17,12 +17,19 @@
 #include <yaml-cpp/emitter.h>
 
 #include "EngineRandom.h"
+#include "GraphicsDefinitions.h"
 #include "HitInfo.h"
 #include "Scene.h"
 
+namespace engine::serialize
+{
+    class BinarySceneReader;
+}
+
 namespace load
 {
     void actor(const YAML::Node&, engine::Scene*);
+    void actor(const engine::serialize::BinarySceneReader&, uint32_t, engine::Scene*);
     std::unique_ptr<class engine::Scene> scene(const std::filesystem::path &path);
 }
 
@@ -37,13 +44,15 @@ namespace engine
         : public ui::Drawable
     {
         friend void serialize::actor(YAML::Emitter &out, Actor *actor);
+        friend YAML::Node serialize::actorNode(Actor *actor);
         friend void load::actor(const YAML::Node&, engine::Scene*);
+        friend void load::actor(const engine::serialize::BinarySceneReader&, uint32_t, engine::Scene*);
         friend std::unique_ptr<Scene> load::scene(const std::filesystem::path &);
     public:
         friend class Scene;
         Actor() = default;
         explicit Actor(std::string name);
-        ~Actor() override = default;
+        ~Actor() override;
 
         void awake();
         void begin();
@@ -75,9 +84,10 @@ namespace engine
         Ref<T> addComponent(Resource<T> &&component);
         
         /**
-         * @returns The transform of this Actor in world space.
+         * @returns The transform of this Actor in world space. This is cached and only recomputed when this actor
+         * or one of its parents has moved.
          */
-        [[nodiscard]] glm::mat4 getTransform() const;
+        [[nodiscard]] const glm::mat4 &getTransform() const;
 
         /**
          * @returns The transform of this actor in object space.
@@ -149,12 +159,33 @@ namespace engine
         [[nodiscard]] std::vector<UUID> &getChildren();
         [[nodiscard]] Actor *getParent() const;
 
+        /**
+         * @brief Sets the local position and updates the transform straight away.
+         * Writing to position directly is picked up at the start of the next update.
+         */
+        void setPosition(const glm::vec3 &newPosition);
+        void setRotation(const glm::quat &newRotation);
+        void setScale(const glm::vec3 &newScale);
+
         void setWorldTransform(const glm::mat4 &worldTransform);
         [[nodiscard]] glm::vec3 getWorldPosition() const;
         void setWorldRotation(const glm::quat &worldRotation);
         [[nodiscard]] glm::quat getWorldRotation() const;
         [[nodiscard]] Scene *getScene() const;
 
+        /**
+         * @brief Static actors promise not to move so that the renderer can cache them. Lights on the actor
+         * share its mobility.
+         */
+        void setMobility(graphics::Mobility mobility);
+        [[nodiscard]] graphics::Mobility getMobility() const;
+
+        /**
+         * @brief Tells the scene that geometry drawn by this actor has changed so that cached shadows are redrawn.
+         * Does nothing for movable actors. Moving the actor already does this.
+         */
+        void markStaticSetChanged() const;
+
     protected:
         void onDrawUi() override;
 
@@ -191,13 +222,40 @@ namespace engine
         virtual void onTriggerBegin(Actor *otherActor, Component *myComponent, Component *otherComponent);
 
     private:
+        /**
+         * @brief Rebuilds the local transform if position, rotation or scale have changed since it was last built.
+         */
         void updateTransform();
+
+        /**
+         * @brief Sets the local transform directly and splits it back into position, rotation and scale.
+         */
+        void setLocalTransform(const glm::mat4 &transform);
+
+        /**
+         * @brief Keeps the scene's component registry in sync. Does nothing if the actor isn't in a scene yet.
+         */
+        void registerComponent(const Ref<Component> &component);
+        void registerComponents();
+        void unregisterComponent(Component *component);
+
+        /**
+         * @returns The first component of exactly this type, including ones waiting to be added. Nullptr otherwise.
+         */
+        [[nodiscard]] const Resource<Component> *findComponent(ComponentTypeId typeId) const;
+        void rebuildComponentIndex() const;
+
+        /**
+         * @brief Marks the world transform of this actor and all of its children as out of date.
+         */
+        void markTransformDirty();
         void updateComponents();
 
     protected:
         std::string mName      { "Actor" };  // I've put the name here so that the debugger shows this as the first field.
         Scene *mScene    { nullptr };
         UUID mId               { random::generateId() };
+        graphics::Mobility mMobility { graphics::Mobility::Movable };
 
     public:
         glm::vec3 position     { glm::vec3(0.f) };
@@ -207,6 +265,15 @@ namespace engine
     protected:
         glm::mat4         mTransform    { glm::mat4(1.f) };
         Actor*            mParent       { nullptr };  // Nullptr means that its parent is the scene.
+
+        // What mTransform was last built from.
+        glm::vec3 mBuiltPosition { glm::vec3(0.f) };
+        glm::quat mBuiltRotation { glm::identity<glm::quat>() };
+        glm::vec3 mBuiltScale    { glm::vec3(1.f) };
+
+        // If an actor is dirty then so are all of its children.
+        mutable glm::mat4 mWorldTransform          { glm::mat4(1.f) };
+        mutable bool      mIsWorldTransformDirty   { true };
         std::vector<UUID> mChildren;
 
         std::vector<Resource<Component>> mComponents;
@@ -217,6 +284,20 @@ namespace engine
 
         std::vector<Resource<Component>> mComponentsToAdd;
         std::set<UUID>                   mChildrenToRemove;
+
+        /**
+         * @brief Where a component of a type is. Indices past the end of mComponents are in mComponentsToAdd.
+         */
+        struct ComponentSlot
+        {
+            ComponentTypeId typeId;
+            uint32_t index;
+        };
+
+        // Sorted by type, then by index so that the first of a type is found first. Rebuilt on the next lookup after
+        // components have been added, moved or removed.
+        mutable std::vector<ComponentSlot> mComponentIndex;
+        mutable bool mIsComponentIndexDirty { false };
     };
     
     template<typename T>
@@ -224,115 +305,62 @@ namespace engine
     {
         Ref<T> ref = component;
         component->attachToActor(this);
+        registerComponent(ref);
         mComponentsToAdd.push_back(std::move(component));
+        mIsComponentIndexDirty = true;
         return ref;
     }
     
     template<typename T>
     Ref<T> Actor::getComponent(const bool warn)
     {
-        const auto it = std::find_if(mComponents.begin(), mComponents.end(), [](const Resource<Component> &component) {
-            const T* t = dynamic_cast<const T*>(component.get());
-            if (t == nullptr)
-                return false;
-            else  // Make sure that it's the exact type rather than a child type.
-                return typeid(const T*).hash_code() == typeid(t).hash_code();
-        });
-        
-        if (it == mComponents.end())
+        const Resource<Component> *component = findComponent(componentTypeId<T>());
+        if (component == nullptr)
         {
-            const auto it2 = std::find_if(mComponentsToAdd.begin(), mComponentsToAdd.end(), [](const Resource<Component> &component) {
-                const T* t = dynamic_cast<const T*>(component.get());
-                if (t == nullptr)
-                    return false;
-                else  // Make sure that it's the exact type rather than a child type.
-                    return typeid(const T*).hash_code() == typeid(t).hash_code();
-            });
-            
-            if (it2 == mComponentsToAdd.end())
-            {
-                if (warn)
-                    WARN("Component % does not exist.", typeid(T).name());
-                return Ref<T>();
-            }
-            
-            return dynamic_ref_cast<T>(*it2);
+            if (warn)
+                WARN("Component % does not exist.", typeid(T).name());
+            return Ref<T>();
         }
         
-        return dynamic_ref_cast<T>(*it);
+        const Ref<Component> ref(*component);
+        return Ref<T>(ref, static_cast<T*>(ref.get()));
     }
     
     template<typename T>
     bool Actor::hasComponent() const
     {
-        const bool inComponentList = std::any_of(mComponents.begin(), mComponents.end(), [](const Resource<Component> &component) {
-            const T* t = dynamic_cast<const T*>(component.get());
-            if (t == nullptr)
-                return false;
-            else  // Make sure that it's the exact type rather than a child type.
-                return typeid(const T*).hash_code() == typeid(t).hash_code();
-        });
-        
-        const bool inAddList = std::any_of(mComponentsToAdd.begin(), mComponentsToAdd.end(), [](const Resource<Component> &component) {
-            const T* t = dynamic_cast<const T*>(component.get());
-            if (t == nullptr)
-                return false;
-            else  // Make sure that it's the exact type rather than a child type.
-                return typeid(const T*).hash_code() == typeid(t).hash_code();
-        });
-        
-        return inComponentList || inAddList;
+        return findComponent(componentTypeId<T>()) != nullptr;
     }
     
     template<typename T>
     void Actor::removeComponent()
     {
-        const auto it = std::find_if(mComponents.begin(), mComponents.end(), [](const Resource<Component> &component) {
-            const T* t = dynamic_cast<const T*>(component.get());
-            if (t == nullptr)
-                return false;
-            else  // Make sure that it's the exact type rather than a child type.
-                return typeid(const T*).hash_code() == typeid(t).hash_code();
-        });
-        
-        if (it == mComponents.end())
+        const Resource<Component> *component = findComponent(componentTypeId<T>());
+        if (component == nullptr)
         {
-            const auto it2 = std::find_if(mComponentsToAdd.begin(), mComponentsToAdd.end(), [](const Resource<Component> &component) {
-                const T* t = dynamic_cast<const T*>(component.get());
-                if (t == nullptr)
-                    return false;
-                else  // Make sure that it's the exact type rather than a child type.
-                    return typeid(const T*).hash_code() == typeid(t).hash_code();
-            });
-            
-            if (it2 == mComponentsToAdd.end())
-            {
-                WARN("Component % does not exist in this Actor and so it cannot be removed.", typeid(T).name());
-                return;
-            }
-            
-            mComponentsToAdd.erase(it2);
+            WARN("Component % does not exist in this Actor and so it cannot be removed.", typeid(T).name());
             return;
         }
-        else
-            mComponentsToDestroy->emplace((*it).get());
+        
+        removeComponent(component->get());
     }
-    
-    
+
     template<typename TActor, std::enable_if_t<std::is_convertible_v<TActor*, Actor*>, bool>>
     Ref<TActor> Actor::addChildActor(Ref<TActor> tActor, const bool keepWorldRelative)
     {
         Ref<Actor> actor(tActor);
 
         actor->mParent = this;
-        actor->mScene = mScene;  // In case this wasn't created using spawnActor<>();
-
-        if (keepWorldRelative)
+        if (actor->mScene != mScene)
         {
-            actor->mTransform = glm::inverse(getTransform()) * actor->mTransform;
-            math::decompose(actor->mTransform, actor->position, actor->rotation, actor->scale);
+            actor->mScene = mScene;  // In case this wasn't created using spawnActor<>();
+            actor->registerComponents();
         }
 
+        if (keepWorldRelative)
+            actor->setLocalTransform(glm::inverse(getTransform()) * actor->mTransform);
+        actor->markTransformDirty();
+
         mChildren.push_back(actor->getId());
 
         return actor;
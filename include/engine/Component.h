@@ -11,8 +11,28 @@
 #include "Drawable.h"
 #include "HitInfo.h"
 
+#include <limits>
+#include <typeinfo>
+
 namespace engine
 {
+    typedef uint32_t ComponentTypeId;
+
+    /**
+     * @returns A small, dense id for the exact type. Ids are handed out the first time a type is seen.
+     */
+    ComponentTypeId componentTypeId(const std::type_info &type);
+
+    /**
+     * @returns The id of T. The lookup only happens once per type, after that it's a static load.
+     */
+    template<typename T>
+    ComponentTypeId componentTypeId()
+    {
+        static const ComponentTypeId id = componentTypeId(typeid(T));
+        return id;
+    }
+
     /**
      * @author Ryan Purse
      * @date 07/08/2023
@@ -31,6 +51,11 @@ namespace engine
         void collisionBegin(Actor *otherActor, Component *myComponent, Component *otherComponent, const HitInfo &hitInfo);
         void triggerBegin(Actor *otherActor, Component *myComponent, Component *otherComponent);
         [[nodiscard]] Actor *getActor() const;
+
+        /**
+         * @returns The id of the most derived type of this component. Only valid once attached to an actor.
+         */
+        [[nodiscard]] ComponentTypeId getTypeId() const;
         
     protected:
         /**
@@ -83,6 +108,12 @@ namespace engine
         [[nodiscard]] glm::mat4 getWorldTransform() const;
         
         Actor *mActor { nullptr };
+
+    private:
+        friend class ComponentRegistry;
+
+        ComponentTypeId mTypeId { 0 };
+        uint32_t mRegistryIndex { std::numeric_limits<uint32_t>::max() };  // Where this lives in the scene's registry.
     };
     
 } // engine
@@ -0,0 +1,56 @@
+/**
+ * @file ComponentRegistry.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include "Pch.h"
+#include "Component.h"
+#include "EngineMemory.h"
+
+namespace engine
+{
+    /**
+     * @brief Every component in a scene bucketed by its exact type so that finding all components of a type
+     * doesn't need to visit every actor.
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class ComponentRegistry
+    {
+    public:
+        void add(const Ref<Component> &component);
+
+        /**
+         * @brief Swaps the component with the last one of its type and pops it. Does nothing if it isn't registered.
+         */
+        void remove(Component *component);
+
+        [[nodiscard]] const std::vector<Ref<Component>> &getComponents(ComponentTypeId typeId) const;
+
+        template<typename T>
+        [[nodiscard]] std::vector<Ref<T>> findComponents() const;
+
+    protected:
+        std::vector<std::vector<Ref<Component>>> mComponents;
+        const std::vector<Ref<Component>> mEmpty;
+    };
+
+    template<typename T>
+    std::vector<Ref<T>> ComponentRegistry::findComponents() const
+    {
+        const std::vector<Ref<Component>> &components = getComponents(componentTypeId<T>());
+
+        std::vector<Ref<T>> results;
+        results.reserve(components.size());
+
+        // The ids match the exact type so there is no need to dynamic_cast.
+        for (const Ref<Component> &component : components)
+            results.emplace_back(component, static_cast<T*>(component.get()));
+
+        return results;
+    }
+} // engine
@@ -35,7 +35,7 @@ namespace engine
      */
     class Core
     {
-        inline static std::string tempFilePath = "temp.pcy";
+        inline static std::string tempFilePath = "temp.pcyb";
     public:
         /**
          * \param resolution The resolution of the window to begin with (The window is resizable).
@@ -94,6 +94,7 @@ namespace engine
         std::filesystem::path mScenePath;
         std::string mSceneName;
         
+        std::unique_ptr<load::ThreadPool> mThreadPool;
         std::unique_ptr<ResourcePool>   mResourcePool;
         std::unique_ptr<Renderer>       mRenderer;
         std::unique_ptr<debug::Logger>  mLogger;
@@ -76,6 +76,8 @@ protected:
     float       mRotationSpeed          { 0.1f };
     glm::dvec2  mPanAngles              { 0.f };
     bool        mUseUberVariant         { false };
+    bool        mUseClusteredLighting   { true };
+    bool        mUseDepthPrepass        { false };
 
     // Input linkage.
     bool        mDoMoveAction           { false };
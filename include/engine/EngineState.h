@@ -10,6 +10,11 @@
 #include "Pch.h"
 #include "glew.h"
 
+namespace load
+{
+    class ThreadPool;
+}
+
 namespace engine
 {
     extern class Core               *core;
@@ -18,6 +23,12 @@ namespace engine
     extern class Serializer         *serializer;
     extern class ResourcePool       *resourcePool;
     extern class PhysicsCore        *physicsSystem;
+    extern load::ThreadPool         *threadPool;
+    
+    /**
+     * @returns False when there is no core to be in play mode, such as in the tests and benchmarks.
+     */
+    [[nodiscard]] bool isInPlayMode();
     
     void GLAPIENTRY forwardOpenGlCallback(
         GLenum source, GLenum type, GLuint id,
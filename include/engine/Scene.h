@@ -9,11 +9,24 @@
 
 #include "Pch.h"
 #include "Actor.h"
+#include "ComponentRegistry.h"
 #include "EngineMemory.h"
 #include "Callback.h"
 
+namespace YAML
+{
+    class Node;
+}
+
+namespace engine::serialize
+{
+    class BinarySceneReader;
+}
+
 namespace load
 {
+    void actor(const YAML::Node &, engine::Scene *);
+    void actor(const engine::serialize::BinarySceneReader &, uint32_t, engine::Scene *);
     std::unique_ptr<engine::Scene> scene(const std::filesystem::path &path);
 }
 
@@ -27,6 +40,9 @@ namespace engine
     class Scene
         : public ui::Drawable
     {
+        friend class Actor;
+        friend void load::actor(const YAML::Node &, Scene *);
+        friend void load::actor(const engine::serialize::BinarySceneReader &, uint32_t, Scene *);
         friend std::unique_ptr<Scene> load::scene(const std::filesystem::path &);
     public:
         ~Scene() override = default;
@@ -34,6 +50,11 @@ namespace engine
         void update();
         void fixedUpdate();
         void preRender();
+        
+        /**
+         * @brief Computes the world transform of every actor that moved. Called by preRender().
+         */
+        void resolveTransforms();
 
         /**
          * \returns A list of actors that can be iterated over.
@@ -65,7 +86,7 @@ namespace engine
         Ref<TActor> addActor(Resource<TActor> &&actor);
 
         /**
-         * \brief Finds the actor via the given id.
+         * \brief Finds the actor via the given id. This is a hash lookup so it is safe to call often.
          * \param actorId The ID of the actor that you want to find.
          * \param warn Should a warning message be printed to the console if it can't find the specified actor
          * \returns A reference to the actor. A nullreference if it could not find anything.
@@ -73,26 +94,71 @@ namespace engine
         Ref<Actor> getActor(UUID actorId, bool warn=true) const;
 
         /**
-         * @brief Finds all components of type T that exist within the scene. This is a slow linear search. Do not use every frame!
+         * @brief Finds all components of exactly type T (not subclasses) that exist within the scene.
+         * Components are kept in a registry by type so this only copies the ones that match.
          */
         template<typename T>
         std::vector<Ref<T>> findComponents();
 
+        /**
+         * @brief Called when a static actor is added, removed or moved so that the renderer knows to redraw cached
+         * shadows. Generations are unique across scenes so that loading a new scene is always seen as a change.
+         */
+        void markStaticSetChanged();
+        [[nodiscard]] uint64_t getStaticGeneration() const;
+
     protected:
         virtual void onUpdate();
         virtual void onFixedUpdate();
         virtual void onPreRender();
         void onDrawUi() override;
 
+        /**
+         * \brief Where an actor lives. Pending actors are in mToAdd until the next update.
+         */
+        struct ActorSlot
+        {
+            uint32_t index;
+            bool isPending;
+        };
+
+        /**
+         * \brief Changes the id of an actor that is already in the scene (loaders assign ids after spawning).
+         */
+        void changeActorId(Actor *actor, UUID newId);
+
+        /**
+         * \brief Adds the actor to the index. An actor whose id is already taken is warned about and given a new one.
+         */
+        void indexActor(Actor *actor, ActorSlot slot);
+
+        /**
+         * \brief Swaps the actor with the last one in its list and pops it. The index is kept up to date.
+         * \returns The removed actor so that the caller can choose when it is destroyed.
+         */
+        Resource<Actor> removeActorAt(ActorSlot slot);
+
+        /**
+         * @brief Registers the components an actor had before it was added to this scene.
+         */
+        void registerComponents(Actor *actor);
+
+        // Declared before the actor lists so that it outlives the actors unregistering from it.
+        ComponentRegistry mComponentRegistry;
+
     public:
         std::vector<Resource<Actor>> mActors;
 
     private:
+        std::unordered_map<UUID, ActorSlot> mActorIndex;
+
         std::set<const Actor*> mDestroyBuffer0;
         std::set<const Actor*> mDestroyBuffer1;
         std::set<const Actor*> *mToDestroy { &mDestroyBuffer0 };
         
         std::vector<Resource<Actor>> mToAdd;
+
+        uint64_t mStaticGeneration { 0 };
     };
     
     template<typename TActor, typename... TArgs>
@@ -108,7 +174,9 @@ namespace engine
         
         actor->mScene = this;
         actor->mParent = nullptr;
+        registerComponents(actor.get());
         actor->awake();
+        indexActor(actor.get(), ActorSlot { static_cast<uint32_t>(mToAdd.size()), true });
         mToAdd.push_back(std::move(actor));
         
         return actorRef;
@@ -117,20 +185,6 @@ namespace engine
     template<typename T>
     [[nodiscard]] std::vector<Ref<T>> Scene::findComponents()
     {
-        std::vector<Ref<T>> results;
-
-        for (Ref<Actor> actor : mActors)
-        {
-            if (Ref<T> component = actor->getComponent<T>(false); component.isValid())
-                results.push_back(component);
-        }
-
-        for (Ref<Actor> actor : mToAdd)
-        {
-            if (Ref<T> component = actor->getComponent<T>(false); component.isValid())
-                results.push_back(component);
-        }
-
-        return results;
+        return mComponentRegistry.findComponents<T>();
     }
 } // engine
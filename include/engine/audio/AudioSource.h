@@ -10,6 +10,7 @@
 #include <al.h>
 
 #include "AudioBuffer.h"
+#include "AudioStream.h"
 #include "Pch.h"
 
 namespace engine
@@ -25,6 +26,7 @@ namespace engine
         AudioSource(AudioSource&) = delete;
         AudioSource operator=(AudioSource) = delete;
         explicit AudioSource(std::shared_ptr<engine::AudioBuffer> audioBuffer);
+        explicit AudioSource(std::unique_ptr<engine::AudioStream> audioStream);
 
         ~AudioSource();
 
@@ -36,6 +38,7 @@ namespace engine
     protected:
         ALuint mId { 0 };
         std::shared_ptr<AudioBuffer> mBuffer;
+        std::unique_ptr<AudioStream> mStream;  // Used instead of the buffer for long tracks.
         glm::vec3 mPosition { 0 };
     };
 
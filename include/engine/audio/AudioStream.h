@@ -0,0 +1,107 @@
+/**
+ * @file AudioStream.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include <al.h>
+#include <deque>
+#include <filesystem>
+
+#include "Pch.h"
+
+struct stb_vorbis;
+
+namespace engine
+{
+    /**
+     * @brief Plays an ogg file through a source a chunk at a time instead of decoding it all up front. Chunks are
+     * decoded on the thread pool into a small ring of buffers that are queued on the source as they free up.
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class AudioStream
+    {
+    public:
+        // Four chunks of this many frames keeps about a second and a half queued at 44.1kHz.
+        static constexpr size_t chunkFrameCount = 16384;
+        static constexpr size_t bufferCount = 4;
+
+        explicit AudioStream(const std::filesystem::path &path);
+        ~AudioStream();
+
+        AudioStream(const AudioStream&) = delete;
+        AudioStream& operator=(const AudioStream&) = delete;
+
+        /**
+         * @returns True if the file is long enough that it's worth streaming instead of decoding it in one go.
+         */
+        static bool shouldStream(const std::filesystem::path &path);
+
+        /**
+         * @brief Decodes up to chunkFrameCount frames from where the decoder is. Doesn't touch OpenAL, so it can run
+         * on any thread.
+         * @param samples Resized to the interleaved samples that were decoded.
+         * @returns True if the end of the file was reached.
+         */
+        static bool decodeChunk(stb_vorbis *decoder, int channels, std::vector<short> &samples);
+
+        /**
+         * @brief Keeps every stream fed and updates the profiler. Call once a frame.
+         */
+        static void updateAll();
+
+        /**
+         * @brief Sets the source that this stream queues its buffers on. Must be called before play().
+         */
+        void bind(ALuint sourceId);
+
+        /**
+         * @brief Starts playing from the beginning.
+         */
+        void play();
+
+        [[nodiscard]] bool isValid() const;
+        [[nodiscard]] std::filesystem::path getPath() const;
+
+    protected:
+        struct Chunk
+        {
+            std::vector<short> samples;
+            uint32_t generation { 0 };
+            long long decodeMicroseconds { 0 };
+            bool isLast { false };
+        };
+
+        // Shared with the decode jobs so that a stream can be destroyed while one is in flight.
+        struct State
+        {
+            ~State();
+
+            stb_vorbis *decoder { nullptr };  // Only touched by the job that's in flight.
+            std::deque<Chunk> readyChunks;
+            uint32_t generation { 0 };
+            bool isDecoding { false };
+        };
+
+        void update();
+        void requestChunk();
+
+        std::filesystem::path mPath;
+        std::shared_ptr<State> mState;
+        int mChannels { 0 };
+        int mSampleRate { 0 };
+        uint64_t mMemoryUsage { 0 };
+
+        ALuint mSourceId { 0 };
+        std::vector<ALuint> mBuffers;
+        std::vector<ALuint> mFreeBuffers;
+        bool mIsPlaying { false };
+        bool mNeedsRewind { false };
+        bool mIsDecoderFinished { false };
+        long long mDecodeMicroseconds { 0 };
+    };
+} // engine
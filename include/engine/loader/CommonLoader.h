@@ -8,9 +8,18 @@
 #pragma once
 
 #include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
 
 namespace load
 {
+    // Changing these changes what gets imported, so they're stored in every cooked mesh.
+    constexpr unsigned int meshImportFlags =
+        aiProcess_GlobalScale           |
+        aiProcess_CalcTangentSpace      |
+        aiProcess_Triangulate           |
+        aiProcess_JoinIdenticalVertices |
+        aiProcess_SortByPType;
+
     glm::vec3 toVec3(const aiVector3D &v);
     glm::vec2 toVec2(const aiVector2D &v);
     glm::vec2 toVec2(const aiVector3D &v);
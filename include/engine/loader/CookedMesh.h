@@ -0,0 +1,260 @@
+/**
+ * @file CookedMesh.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <type_traits>
+
+#include "BoundingVolumes.h"
+#include "Pch.h"
+#include "Vertices.h"
+
+// A binary copy of a mesh after it has gone through assimp so that we only pay for importing once.
+namespace engine::disk
+{
+    // Bump this whenever the layout below changes. The import flags are stored in each file.
+    constexpr uint32_t cookedMeshVersion = 2;
+    constexpr char cookedMeshMagic[4] { 'P', 'C', 'M', 'S' };
+    constexpr uint64_t cookedMeshAlignment = 16;
+
+    /**
+     * @brief What a cooked file was built from. Hashing the source means reading all of it, so it's only done when
+     * the size or write time no longer match.
+     */
+    struct CookedSource
+    {
+        uint64_t hash;
+        uint64_t size;
+        int64_t writeTime;
+        uint32_t importFlags;  // Anything else that changes the result, such as assimp's post process flags.
+        uint32_t padding;
+    };
+
+    struct CookedMeshHeader
+    {
+        char magic[4];
+        uint32_t version;
+        CookedSource source;
+        uint64_t layoutId;
+        uint32_t vertexStride;
+        uint32_t subMeshCount;
+    };
+
+    struct CookedSubMeshEntry
+    {
+        uint64_t vertexOffset;
+        uint64_t indexOffset;
+        uint32_t vertexCount;
+        uint32_t indexCount;
+        graphics::BoundingVolume bounds;
+    };
+
+    /**
+     * @brief A sub-mesh that is ready to be sent to the gpu.
+     */
+    template<typename TVertex>
+    struct MeshData
+    {
+        std::vector<uint32_t> indices;
+        std::vector<TVertex> vertices;
+        graphics::BoundingVolume bounds;
+    };
+
+    /**
+     * @brief A read-only view of a file that has been mapped into memory.
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class MappedFile
+    {
+    public:
+        explicit MappedFile(const std::filesystem::path &path);
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+        ~MappedFile();
+
+        [[nodiscard]] bool isOpen() const { return mData != nullptr; }
+        [[nodiscard]] const std::byte *data() const { return mData; }
+        [[nodiscard]] uint64_t size() const { return mSize; }
+
+    protected:
+        const std::byte *mData { nullptr };
+        uint64_t mSize { 0 };
+#ifdef _WIN32
+        void *mFile { nullptr };
+        void *mMapping { nullptr };
+#else
+        int mFile { -1 };
+#endif  // _WIN32
+    };
+
+    uint64_t hashBytes(const std::byte *data, uint64_t size, uint64_t seed=14695981039346656037ull);
+
+    /**
+     * @returns The hash of the file's contents or zero if it could not be read.
+     */
+    uint64_t hashFile(const std::filesystem::path &path);
+
+    /**
+     * @brief Fills in everything but the hash. The size is zero if the source doesn't exist.
+     */
+    CookedSource findCookedSource(const std::filesystem::path &sourcePath, uint32_t importFlags);
+
+    /**
+     * @brief Hashes the source if it hasn't been already.
+     * @returns false if the source couldn't be read.
+     */
+    bool hashSource(const std::filesystem::path &sourcePath, CookedSource &source);
+
+    /**
+     * @brief Compares the source that a file was cooked from with the current one. The source is only hashed when
+     * its size or write time have changed.
+     * @param isStampStale Set when the contents match but the size or write time don't, so the file should be updated.
+     */
+    bool isSameSource(const CookedSource &cooked, const std::filesystem::path &sourcePath, CookedSource &source, bool &isStampStale);
+
+    /**
+     * @brief Overwrites the source stored at offset in a cooked file so that the next load doesn't need to hash.
+     */
+    void refreshCookedSource(const std::filesystem::path &path, uint64_t offset, const CookedSource &source);
+
+    /**
+     * @brief Where the cooked version of a mesh lives. Each vertex layout gets its own file.
+     */
+    std::filesystem::path cookedMeshPath(const std::filesystem::path &sourcePath, uint64_t layoutId);
+
+    /**
+     * @brief Rounds up to the next cookedMeshAlignment boundary.
+     */
+    uint64_t alignUp(uint64_t value);
+
+    bool isValidCookedHeader(const CookedMeshHeader &header, uint64_t layoutId, uint32_t vertexStride, uint32_t importFlags);
+
+    /**
+     * @brief Writes the blobs to a temporary file first and then swaps it in so a half written file is never read.
+     */
+    bool writeCookedMesh(
+        const std::filesystem::path &path, const CookedMeshHeader &header,
+        const std::vector<CookedSubMeshEntry> &entries,
+        const std::vector<const void*> &vertexData, const std::vector<const void*> &indexData);
+
+    template<typename TVertex>
+    uint64_t layoutId()
+    {
+        const Instructions instructions = TVertex::layout();
+        uint64_t hash = hashBytes(reinterpret_cast<const std::byte*>(instructions.data()), instructions.size() * sizeof(Instruction));
+        const uint64_t stride = sizeof(TVertex);
+        return hashBytes(reinterpret_cast<const std::byte*>(&stride), sizeof(uint64_t), hash);
+    }
+
+    /**
+     * @brief Copies the sub-meshes out of a cooked mesh whose header has already been checked.
+     */
+    template<typename TVertex>
+    bool readCookedMeshData(const MappedFile &file, const CookedMeshHeader &header, std::vector<MeshData<TVertex>> &meshes)
+    {
+        const uint64_t tableSize = static_cast<uint64_t>(header.subMeshCount) * sizeof(CookedSubMeshEntry);
+        if (file.size() < sizeof(CookedMeshHeader) + tableSize)
+            return false;
+
+        std::vector<CookedSubMeshEntry> entries(header.subMeshCount);
+        std::memcpy(entries.data(), file.data() + sizeof(CookedMeshHeader), tableSize);
+
+        std::vector<MeshData<TVertex>> result;
+        result.reserve(entries.size());
+        for (const CookedSubMeshEntry &entry : entries)
+        {
+            const uint64_t vertexBytes = static_cast<uint64_t>(entry.vertexCount) * sizeof(TVertex);
+            const uint64_t indexBytes = static_cast<uint64_t>(entry.indexCount) * sizeof(uint32_t);
+            if (entry.vertexOffset + vertexBytes > file.size() || entry.indexOffset + indexBytes > file.size())
+                return false;
+            if (entry.vertexOffset % alignof(TVertex) != 0 || entry.indexOffset % alignof(uint32_t) != 0)
+                return false;
+
+            const auto *vertices = reinterpret_cast<const TVertex*>(file.data() + entry.vertexOffset);
+            const auto *indices = reinterpret_cast<const uint32_t*>(file.data() + entry.indexOffset);
+
+            MeshData<TVertex> &mesh = result.emplace_back();
+            mesh.vertices.assign(vertices, vertices + entry.vertexCount);
+            mesh.indices.assign(indices, indices + entry.indexCount);
+            mesh.bounds = entry.bounds;
+        }
+
+        meshes = std::move(result);
+        return true;
+    }
+
+    /**
+     * @brief Reads a cooked mesh if it exists and was built from the same source, import flags and vertex layout.
+     * @param source From findCookedSource(). Its hash is filled in if it had to be computed.
+     * @returns false if the cooked mesh is missing, stale or corrupt.
+     */
+    template<typename TVertex>
+    bool readCookedMesh(
+        const std::filesystem::path &path, const std::filesystem::path &sourcePath, CookedSource &source,
+        std::vector<MeshData<TVertex>> &meshes)
+    {
+        static_assert(std::is_trivially_copyable_v<TVertex>, "Cooked vertices are copied straight from disk.");
+
+        bool isStampStale = false;
+        {
+            const MappedFile file(path);
+            if (!file.isOpen() || file.size() < sizeof(CookedMeshHeader))
+                return false;
+
+            CookedMeshHeader header { };
+            std::memcpy(&header, file.data(), sizeof(CookedMeshHeader));
+            if (!isValidCookedHeader(header, layoutId<TVertex>(), sizeof(TVertex), source.importFlags)
+                || !isSameSource(header.source, sourcePath, source, isStampStale))
+                return false;
+
+            if (!readCookedMeshData(file, header, meshes))
+                return false;
+        }
+
+        if (isStampStale)
+            refreshCookedSource(path, offsetof(CookedMeshHeader, source), source);
+        return true;
+    }
+
+    /**
+     * @param source From findCookedSource(). Its hash is filled in if it hasn't been computed yet.
+     */
+    template<typename TVertex>
+    bool writeCookedMesh(
+        const std::filesystem::path &path, const std::filesystem::path &sourcePath, CookedSource &source,
+        const std::vector<MeshData<TVertex>> &meshes)
+    {
+        static_assert(std::is_trivially_copyable_v<TVertex>, "Cooked vertices are copied straight to disk.");
+
+        if (!hashSource(sourcePath, source))
+            return false;
+
+        CookedMeshHeader header { };
+        std::memcpy(header.magic, cookedMeshMagic, sizeof(cookedMeshMagic));
+        header.version = cookedMeshVersion;
+        header.source = source;
+        header.layoutId = layoutId<TVertex>();
+        header.vertexStride = sizeof(TVertex);
+        header.subMeshCount = static_cast<uint32_t>(meshes.size());
+
+        std::vector<CookedSubMeshEntry> entries;
+        std::vector<const void*> vertexData;
+        std::vector<const void*> indexData;
+        for (const MeshData<TVertex> &mesh : meshes)
+        {
+            entries.push_back({ 0, 0, static_cast<uint32_t>(mesh.vertices.size()), static_cast<uint32_t>(mesh.indices.size()), mesh.bounds });
+            vertexData.push_back(mesh.vertices.data());
+            indexData.push_back(mesh.indices.data());
+        }
+
+        return writeCookedMesh(path, header, entries, vertexData, indexData);
+    }
+}
@@ -0,0 +1,64 @@
+/**
+ * @file CookedPhysicsMesh.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include <filesystem>
+
+#include "CookedMesh.h"
+#include "Pch.h"
+#include "PhysicsMeshBuffer.h"
+
+// A binary copy of a physics mesh and its bvh so that neither assimp nor the bvh build is paid for twice.
+namespace engine::disk
+{
+    // Bump this whenever the layout below or the Bullet version change. The import flags are stored in each file.
+    constexpr uint32_t cookedPhysicsMeshVersion = 2;
+    constexpr char cookedPhysicsMeshMagic[4] { 'P', 'C', 'P', 'H' };
+
+    struct CookedPhysicsMeshHeader
+    {
+        char magic[4];
+        uint32_t version;
+        CookedSource source;
+        uint64_t bvhOffset;
+        uint64_t bvhSize;
+        uint32_t meshCount;
+        uint32_t padding;
+    };
+
+    struct CookedPhysicsMeshEntry
+    {
+        uint64_t vertexOffset;
+        uint64_t indexOffset;
+        uint32_t vertexCount;
+        uint32_t indexCount;
+    };
+
+    /**
+     * @brief Where the cooked version of a physics mesh lives.
+     */
+    std::filesystem::path cookedPhysicsMeshPath(const std::filesystem::path &sourcePath);
+
+    /**
+     * @brief Fills in the mesh data and serialised bvh of the buffer if the cooked mesh was built from the same source
+     * and import flags. The vertex array and shape are left for the caller to build.
+     * @param source From findCookedSource(). Its hash is filled in if it had to be computed.
+     * @returns false if the cooked mesh is missing, stale or corrupt.
+     */
+    bool readCookedPhysicsMesh(
+        const std::filesystem::path &path, const std::filesystem::path &sourcePath, CookedSource &source,
+        physics::MeshColliderBuffer &buffer);
+
+    /**
+     * @brief Writes the mesh data and serialised bvh of the buffer. Like cooked meshes, a half written file is never read.
+     * @param source From findCookedSource(). Its hash is filled in if it hasn't been computed yet.
+     */
+    bool writeCookedPhysicsMesh(
+        const std::filesystem::path &path, const std::filesystem::path &sourcePath, CookedSource &source,
+        const physics::MeshColliderBuffer &buffer);
+}
@@ -35,6 +35,11 @@ namespace engine
     class AudioSource;
     class Scene;
     class Actor;
+
+    namespace serialize
+    {
+        class BinarySceneReader;
+    }
 }
 
 namespace load
@@ -50,7 +55,7 @@ namespace load
     std::unique_ptr<engine::AudioSource> audio(const std::filesystem::path &path);
 
     /**
-     * \brief Creates a scene from a .pcy file.
+     * \brief Creates a scene from a .pcy file or the binary .pcyb version of one.
      */
     std::unique_ptr<engine::Scene> scene(const std::filesystem::path &path);
 
@@ -64,10 +69,11 @@ namespace load
     /**
      * @brief Creates a textures that can be used anywhere.
      * @param path - The path to the texture that you want to load.
+     * @param priority - How soon the texture is needed once it has been decoded.
      * @returns A texture object. ->id() is 0 if it failed to load the texture
      * (check the runtime logs for more info).
      */
-    std::shared_ptr<Texture> texture(const std::filesystem::path &path);
+    std::shared_ptr<Texture> texture(const std::filesystem::path &path, Priority priority=Priority::Visible);
 
     /**
      * \brief Creates a task bar icon that can shown by windows.
@@ -79,14 +85,20 @@ namespace load
      */
     void actor(const YAML::Node &actorNode, engine::Scene *scene);
 
+    /**
+     * \brief Loads an actor from a binary scene into a scene.
+     */
+    void actor(const engine::serialize::BinarySceneReader &reader, uint32_t index, engine::Scene *scene);
+
     /**
      * \brief Creates a model that can be used by the renerer.
      * \tparam TVertex The type of vertex that you want the mesh to use.
      * \param path The path to the model.
+     * \param priority How soon the model is needed once it has been loaded.
      * \returns A shared mesh that contains multiple SubMeshes.
      */
     template<typename TVertex>
-    SharedMesh model(const std::filesystem::path &path);
+    SharedMesh model(const std::filesystem::path &path, Priority priority=Priority::Visible);
 
     /**
      * @brief Creates a single submesh with the first mesh found within the model loaded.
@@ -107,9 +119,9 @@ namespace load
 namespace load
 {
     template<typename TVertex>
-    SharedMesh model(const std::filesystem::path &path)
+    SharedMesh model(const std::filesystem::path &path, const Priority priority)
     {
-        return engine::resourcePool->loadMesh<TVertex>(path);
+        return engine::resourcePool->loadMesh<TVertex>(path, priority);
     }
 
     template<typename TVertex>
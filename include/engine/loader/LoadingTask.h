@@ -14,6 +14,19 @@
 
 namespace load
 {
+    /**
+     * @brief The order that finished loading jobs are completed in on the main thread. A job is only completed once
+     * everything of a higher priority that has finished is.
+     */
+    enum class Priority : uint8_t
+    {
+        Visible,     // Needed for what's on screen right now.
+        Nearby,      // Likely to be needed soon.
+        Background,  // Editor previews and anything else that can wait.
+    };
+
+    constexpr size_t priorityCount = 3;
+
     class IThreadTask
     {
     public:
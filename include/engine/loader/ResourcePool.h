@@ -21,11 +21,17 @@
 
 #include "AudioSource.h"
 #include "Callback.h"
+#include "CookedMesh.h"
+#include "CookedPhysicsMesh.h"
 #include "Disk.h"
+#include "EngineState.h"
 #include "LoadingTask.h"
 #include "PhysicsMeshBuffer.h"
 #include "Texture.h"
+#include "TextureUploader.h"
 #include "ThreadPool.h"
+#include "Timers.h"
+#include "ProfileTimer.h"
 
 namespace engine
 {
@@ -41,6 +47,7 @@ namespace engine
     {
     public:
         Callback<std::shared_ptr<Texture>> onTextureReady;
+        Callback<std::shared_ptr<physics::MeshColliderBuffer>> onPhysicsMeshReady;
 
         void clean();
         void saveAllAssets();
@@ -48,10 +55,10 @@ namespace engine
         [[nodiscard]] std::shared_ptr<Shader> loadShader(const std::filesystem::path &vertexPath, const std::filesystem::path &fragmentPath);
         
         template<typename TVertex>
-        [[nodiscard]] SharedMesh loadMesh(const std::filesystem::path &path);
-        [[nodiscard]] std::shared_ptr<Texture> loadTexture(const std::filesystem::path &path);
+        [[nodiscard]] SharedMesh loadMesh(const std::filesystem::path &path, load::Priority priority=load::Priority::Visible);
+        [[nodiscard]] std::shared_ptr<Texture> loadTexture(const std::filesystem::path &path, load::Priority priority=load::Priority::Visible);
         [[nodiscard]] std::shared_ptr<AudioBuffer> loadAudioBuffer(const std::filesystem::path &path);
-        [[nodiscard]] std::shared_ptr<physics::MeshColliderBuffer> loadPhysicsMesh(const std::filesystem::path &path);
+        [[nodiscard]] std::shared_ptr<physics::MeshColliderBuffer> loadPhysicsMesh(const std::filesystem::path &path, load::Priority priority=load::Priority::Visible);
         [[nodiscard]] std::shared_ptr<UberLayer> loadMaterialLayer(const std::filesystem::path&path);
         [[nodiscard]] std::shared_ptr<UberMaterial> loadMaterial(const std::filesystem::path&path);
         uint32_t getLoadingCount() const;
@@ -65,12 +72,14 @@ namespace engine
         std::unordered_map<std::string, std::shared_ptr<physics::MeshColliderBuffer>> mMeshColliders;
         std::unordered_map<std::string, std::shared_ptr<UberLayer>> mMaterialLayers;
         std::unordered_map<std::string, std::shared_ptr<UberMaterial>> mMaterials;
-        load::ThreadPool mThreadPool;
+
+        // Made on first use since the pool exists before there is an OpenGL context.
+        std::unique_ptr<graphics::TextureUploader> mTextureUploader;
     };
 
 
     template<typename TVertex>
-    SharedMesh ResourcePool::loadMesh(const std::filesystem::path &path)
+    SharedMesh ResourcePool::loadMesh(const std::filesystem::path &path, const load::Priority priority)
     {
         const std::string hashName = path.string() + std::to_string(typeid(TVertex).hash_code());
         if (auto it = mModels.find(hashName); it != mModels.end())
@@ -83,22 +92,24 @@ namespace engine
         SharedMesh sharedMesh = std::make_shared<std::vector<std::unique_ptr<SubMesh>>>();
         mModels[hashName] = sharedMesh;
 
-        struct ReadyMesh
-        {
-            std::vector<uint32_t> indices;
-            std::vector<TVertex> vertices;
-        };
+        using ReadyMesh = disk::MeshData<TVertex>;
 
-        mThreadPool.queueJob(load::makeJob<std::vector<ReadyMesh>>(
+        threadPool->queueJob(load::makeJob<std::vector<ReadyMesh>>(
             [path] {
+                PROFILE_FUNC_NAMED("Load Mesh");
+                const double startTime = timers::getTicks<double>();
+                disk::CookedSource source = disk::findCookedSource(path, load::meshImportFlags);
+                const std::filesystem::path cookedPath = disk::cookedMeshPath(path, disk::layoutId<TVertex>());
+
+                std::vector<ReadyMesh> meshes;
+                if (disk::readCookedMesh(cookedPath, path, source, meshes))
+                {
+                    MESSAGE_VERBOSE("Loaded cooked mesh % in %ms", path.filename(), (timers::getTicks<double>() - startTime) * 1000.0);
+                    return meshes;
+                }
+
                 Assimp::Importer importer;
-                const aiScene *scene = importer.ReadFile(
-                    path.string(),
-                    aiProcess_GlobalScale           |
-                    aiProcess_CalcTangentSpace      |
-                    aiProcess_Triangulate           |
-                    aiProcess_JoinIdenticalVertices |
-                    aiProcess_SortByPType);
+                const aiScene *scene = importer.ReadFile(path.string(), source.importFlags);
 
                 if (scene == nullptr)
                 {
@@ -109,7 +120,6 @@ namespace engine
                 // We're using assimp's logger so that the last message when collapsed is this.
                 Assimp::DefaultLogger::get()->info("Load successful.");
 
-                std::vector<ReadyMesh> meshes;
                 for (int i = 0; i < scene->mNumMeshes; ++i)
                 {
                     const aiMesh *mesh = scene->mMeshes[i];
@@ -139,15 +149,21 @@ namespace engine
                     else if (!mesh->HasTangentsAndBitangents())  // No uvs = no tangents.
                         WARN("Submesh % does not have bi-/tangents. (%)", i, path);
 
-                    meshes.emplace_back(ReadyMesh { indices, vertices });
+                    const graphics::BoundingVolume bounds = graphics::computeBoundingVolume(vertices);
+                    meshes.emplace_back(ReadyMesh { indices, vertices, bounds });
                 }
+
+                if (source.size != 0)
+                    disk::writeCookedMesh(cookedPath, path, source, meshes);
+
+                MESSAGE_VERBOSE("Imported % with assimp in %ms", path.filename(), (timers::getTicks<double>() - startTime) * 1000.0);
                 return meshes;
             },
             [sharedMesh](const std::vector<ReadyMesh> &meshes) {
                 for (auto &mesh : meshes)
-                    sharedMesh->emplace_back(std::make_unique<SubMesh>(mesh.vertices, mesh.indices));
+                    sharedMesh->emplace_back(std::make_unique<SubMesh>(mesh.vertices, mesh.indices, mesh.bounds));
                 }
-            ));
+            ), priority);
 
         return sharedMesh;
     }
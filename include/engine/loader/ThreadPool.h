@@ -7,43 +7,162 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <mutex>
-#include <queue>
+#include <thread>
 
 #include "LoadingTask.h"
 #include "Pch.h"
 
 namespace load
 {
+    using JobFunction = std::function<void()>;
+
+    struct Job;
+
+    /**
+     * @brief Tracks how many jobs still need to finish before anything depending on them can start.
+     */
+    struct JobCounter
+    {
+        std::atomic<uint32_t> remaining { 0 };
+        std::atomic<bool> cancelled { false };
+
+        // Guards continuations and isComplete so that a dependency can't be added after the counter finishes.
+        std::mutex mutex;
+        std::vector<std::shared_ptr<Job>> continuations;
+        bool isComplete { false };
+    };
+
+    struct Job
+    {
+        JobFunction work;
+        std::shared_ptr<JobCounter> counter;
+        std::atomic<uint32_t> pendingDependencies { 1 };
+        bool isLoading { false };  // Loading jobs are only ever run by workers.
+    };
+
+    /**
+     * @brief A handle to one or more jobs. A default constructed handle is always done.
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class JobHandle
+    {
+        friend class ThreadPool;
+    public:
+        JobHandle() = default;
+
+        [[nodiscard]] bool isDone() const;
+
+        /**
+         * @brief Jobs that have not started yet are skipped. Anything depending on this handle still runs.
+         */
+        void cancel() const;
+
+    protected:
+        explicit JobHandle(std::shared_ptr<JobCounter> counter);
+
+        std::shared_ptr<JobCounter> mCounter;
+    };
+
     /**
+     * @brief A work-stealing job system. Each worker owns a deque that it pushes and pops from the back of,
+     * idle workers steal from the front of another worker's deque. Threads outside the pool hand out work round-robin.
+     * Loading jobs sit in their own queue that only workers take from, once there is nothing else to do, so that a
+     * thread waiting on the pool never picks up a slow load.
      * @author Ryan Purse
      * @date 27/03/2024
      */
-    class ThreadPool 
+    class ThreadPool
     {
     public:
         ThreadPool();
         ~ThreadPool();
         void start();
-        void queueJob(std::unique_ptr<IThreadTask> task);
+
+        /**
+         * @brief Runs the task on a worker and then calls its callback on the main thread
+         * during resolveFinishedJobs().
+         */
+        void queueJob(std::unique_ptr<IThreadTask> task, Priority priority=Priority::Visible);
+
+        /**
+         * @brief Schedules work to run on any thread in the pool once all dependencies are done.
+         */
+        JobHandle schedule(JobFunction work, const std::vector<JobHandle> &dependencies={ });
+        JobHandle schedule(JobFunction work, const JobHandle &dependency);
+
+        /**
+         * @brief Splits [0, count) into batches of batchSize and calls work(begin, end) for each batch in parallel.
+         * The calling thread helps out and only returns once every batch is done.
+         */
+        void parallelFor(uint32_t count, uint32_t batchSize, const std::function<void(uint32_t, uint32_t)> &work);
+
+        /**
+         * @brief Blocks until the handle is done. The calling thread runs other jobs while it waits, but never
+         * loading jobs.
+         */
+        void wait(const JobHandle &handle);
+
+        /**
+         * @brief Joins every worker. Scheduled jobs that haven't started are run on the calling thread, loading jobs
+         * that haven't started are thrown away. Anything scheduled afterwards runs on the calling thread.
+         */
         void stop();
         bool isBusy();
+
+        /**
+         * @brief Calls the callbacks of finished jobs, highest priority first, until the frame's budget is used up.
+         * At least one is called every frame. The rest carry over to the next frame.
+         */
         void resolveFinishedJobs();
+
+        /**
+         * @brief How long resolveFinishedJobs() can spend on callbacks each frame.
+         */
+        void setCompletionBudget(float milliseconds) { mCompletionBudget = milliseconds; }
         uint32_t getJobCount() const { return mJobCount; }
+        [[nodiscard]] uint32_t getWorkerCount() const { return static_cast<uint32_t>(mThreads.size()); }
 
     protected:
-        void threadLoop();
+        struct WorkerQueue
+        {
+            std::deque<std::shared_ptr<Job>> jobs;
+            std::mutex mutex;
+        };
+
+        void threadLoop(uint32_t workerIndex);
+        void submit(
+            JobFunction work, const std::shared_ptr<JobCounter> &counter, const std::vector<JobHandle> &dependencies,
+            bool isLoading=false);
+        void push(std::shared_ptr<Job> job);
+        std::shared_ptr<Job> popOrSteal(uint32_t startIndex, bool isOwner);
+        std::shared_ptr<Job> popLoadingJob();
+        bool tryRunJob();
+        void execute(const std::shared_ptr<Job> &job);
+        void complete(const std::shared_ptr<JobCounter> &counter);
 
         bool mShouldTerminate = false;
         std::vector<std::thread> mThreads;
+        std::vector<std::unique_ptr<WorkerQueue>> mQueues;
+        WorkerQueue mLoadingQueue;
+        std::atomic<uint32_t> mNextQueue { 0 };
+        std::atomic<uint32_t> mQueuedCount { 0 };  // Only changed while holding the lock of the queue the job is in.
 
-        std::queue<std::unique_ptr<IThreadTask>> mJobs;
         std::condition_variable mMutexCondition;
-        std::mutex mJobsMutex;
+        std::mutex mSleepMutex;
 
-        std::queue<std::unique_ptr<IThreadTask>> mFinishedJobs;
+        std::vector<std::shared_ptr<IThreadTask>> mFinishedJobs[priorityCount];
         std::mutex mFinishedJobsMutex;
 
+        // Finished jobs whose callbacks haven't been called yet. Only the main thread can touch these.
+        std::deque<std::shared_ptr<IThreadTask>> mCompletionQueues[priorityCount];
+        float mCompletionBudget { 4.f };
+
         uint32_t mJobCount = 0;  // Only the main thread can touch this.
     };
 } // load
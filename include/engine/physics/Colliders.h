@@ -10,6 +10,7 @@
 #include <BulletCollision/CollisionShapes/btBoxShape.h>
 #include <BulletCollision/CollisionShapes/btBvhTriangleMeshShape.h>
 #include <BulletCollision/CollisionShapes/btCollisionShape.h>
+#include <BulletCollision/CollisionShapes/btScaledBvhTriangleMeshShape.h>
 #include <BulletCollision/CollisionShapes/btSphereShape.h>
 #include <BulletCollision/CollisionShapes/btTriangleIndexVertexArray.h>
 
@@ -75,7 +76,7 @@ namespace engine
     public:
         MeshCollider();
         explicit MeshCollider(const std::filesystem::path&path);
-        ~MeshCollider() override = default;
+        ~MeshCollider() override;
 
         void onBegin() override;
         void onDrawUi() override;
@@ -84,8 +85,12 @@ namespace engine
 
     protected:
         void initialiseBasedOnPath(std::filesystem::path path);
+        void setupShape();
         std::shared_ptr<physics::MeshColliderBuffer> mMeshColliderBuffer;
-        std::unique_ptr<btBvhTriangleMeshShape> mMeshShape;
+
+        // Null until the buffer has finished loading. Wraps the buffer's shape so that each collider can have its own scale.
+        std::unique_ptr<btScaledBvhTriangleMeshShape> mMeshShape;
+        uint32_t mCallbackToken = 0;
         std::filesystem::path  mPath;
         SharedMesh mDebugShape;
 
@@ -20,10 +20,47 @@ namespace engine::physics
         std::vector<int>       indices;
     };
 
+    /**
+     * @brief A triangle mesh and its bvh, shared by every mesh collider that uses the same model. It is filled in on
+     * a worker, so nothing other than isReady may be touched on the main thread until isReady is set. It must not
+     * move once filled since Bullet keeps pointers into it.
+     */
     struct MeshColliderBuffer
     {
         std::vector<MeshDataBuffer> meshDataBuffers;
         std::vector<btIndexedMesh>  indexedMeshes;
         btTriangleIndexVertexArray  vertexArray;
+
+        // Colliders wrap this in a scaled shape so that the bvh is only ever built once.
+        std::unique_ptr<btBvhTriangleMeshShape> shape;
+
+        // Bullet's in-place serialisation needs 16 byte alignment. A bvh read from disk lives in here.
+        struct alignas(16) BvhBlock { std::byte bytes[16]; };
+        std::vector<BvhBlock> serializedBvh;
+
+        bool isReady { false };
+
+        /**
+         * @brief Points the vertex array at the mesh data. Call once meshDataBuffers is filled.
+         */
+        void buildVertexArray();
+
+        /**
+         * @brief Builds the bvh from scratch.
+         */
+        void buildShape();
+
+        /**
+         * @brief Builds the vertex array and uses the bvh in serializedBvh instead of building one.
+         * @returns false if the data doesn't describe a valid bvh. Nothing is built in this case.
+         */
+        bool buildShapeFromSerializedBvh();
+
+        /**
+         * @brief Writes the shape's bvh into serializedBvh.
+         */
+        void serializeBvh();
+
+        [[nodiscard]] uint64_t serializedBvhSize() const { return serializedBvh.size() * sizeof(BvhBlock); }
     };
 }
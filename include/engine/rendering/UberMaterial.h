@@ -26,6 +26,9 @@ namespace engine
     {
     public:
         explicit UberMaterial(const std::filesystem::path &path);
+        ~UberMaterial() override;
+        UberMaterial(const UberMaterial &) = delete;
+        UberMaterial &operator=(const UberMaterial &) = delete;
         std::string name() const { return mName; }
         std::filesystem::path path() const { return mPath; };
         bool empty() const { return mLayers.empty(); }
@@ -35,8 +38,15 @@ namespace engine
         void onDrawUi() override;
         void saveToDisk() const;
 
+        /**
+         * @brief Applies any pending layer and mask changes and, if anything changed, updates the renderer's copy.
+         */
         void onPreRender();
-        graphics::MaterialData getData() { return mData; }
+
+        /**
+         * @returns The index into the renderer's material table that geometry should be drawn with.
+         */
+        uint32_t materialIndex() const { return mMaterialIndex; }
 
     protected:
         void loadFromDisk();
@@ -59,6 +69,8 @@ namespace engine
         std::vector<std::unique_ptr<UberMask>> mMasks;
         graphics::TexturePool mTexturePool = graphics::TexturePool(mPath.string(), graphics::textureFormat::Rgba8, 8);
         graphics::MaterialData mData;
+        uint32_t mMaterialIndex = 0;
+        bool mIsDirty = true;  // Whether mData needs to be sent to the renderer.
 
         uint32_t mCallbackToken = 0;
     };
@@ -0,0 +1,132 @@
+/**
+ * @file BinaryScene.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include <filesystem>
+#include <string_view>
+
+#include "CookedMesh.h"
+#include "EngineRandom.h"
+#include "Pch.h"
+
+#include <yaml-cpp/yaml.h>
+
+// A binary copy of a .pcy scene. Actors are stored as plain structs and everything that goes through the serializer's
+// delegates is stored as a compact node tree, so loading never has to parse any text.
+namespace engine::serialize
+{
+    // Bump this whenever the layout below changes.
+    constexpr uint32_t binarySceneVersion = 1;
+    constexpr char binarySceneMagic[4] { 'P', 'C', 'Y', 'B' };
+    constexpr uint32_t binarySceneNone = ~0u;
+
+    // Offsets to sections are from the start of the file. Everything inside a section is relative to that section.
+    struct BinarySceneHeader
+    {
+        char magic[4];
+        uint32_t version;
+        uint32_t sceneName;  // String index.
+        uint32_t stringCount;
+        uint32_t actorCount;
+        uint32_t componentCount;
+        uint32_t childCount;
+        uint32_t padding;
+        uint64_t stringTableOffset;
+        uint64_t stringDataOffset;
+        uint64_t actorTableOffset;
+        uint64_t componentTableOffset;
+        uint64_t childTableOffset;
+        uint64_t blobDataOffset;
+        uint64_t sceneBlobOffset;  // Anything the scene's delegate saved, such as its type.
+        uint64_t sceneBlobSize;
+    };
+
+    struct BinaryString
+    {
+        uint32_t offset;
+        uint32_t size;
+    };
+
+    struct BinaryActor
+    {
+        UUID id;
+        uint32_t name;      // String index.
+        uint32_t mobility;  // binarySceneNone if it wasn't saved.
+        float position[3];
+        float rotation[4];  // w, x, y, z like the yaml version.
+        float scale[3];
+        uint32_t firstComponent;
+        uint32_t componentCount;
+        uint32_t firstChild;
+        uint32_t childCount;
+        uint64_t blobOffset;  // Anything the actor's delegate saved, such as its type.
+        uint64_t blobSize;
+    };
+
+    struct BinaryComponent
+    {
+        uint32_t type;  // String index of the name the component's load delegate is registered with.
+        uint32_t padding;
+        uint64_t blobOffset;
+        uint64_t blobSize;
+    };
+
+    [[nodiscard]] bool isBinaryScene(const std::filesystem::path &path);
+
+    /**
+     * @brief A read-only view of a binary scene that has been mapped into memory.
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class BinarySceneReader
+    {
+    public:
+        explicit BinarySceneReader(const std::filesystem::path &path);
+
+        /**
+         * @returns false if the file is missing, from another version or any of its sections are out of bounds.
+         */
+        [[nodiscard]] bool isValid() const { return mIsValid; }
+
+        [[nodiscard]] std::string_view getString(uint32_t index) const;
+        [[nodiscard]] std::string_view getSceneName() const;
+        [[nodiscard]] uint32_t getActorCount() const { return mHeader.actorCount; }
+        [[nodiscard]] BinaryActor getActor(uint32_t index) const;
+        [[nodiscard]] BinaryComponent getComponent(uint32_t index) const;
+        [[nodiscard]] std::vector<UUID> getChildren(const BinaryActor &actor) const;
+
+        /**
+         * @brief The nodes given to the scene, actor and component load delegates.
+         */
+        [[nodiscard]] YAML::Node getSceneNode() const;
+        [[nodiscard]] YAML::Node getActorNode(const BinaryActor &actor) const;
+        [[nodiscard]] YAML::Node getComponentNode(const BinaryComponent &component) const;
+
+        /**
+         * @brief Rebuilds the whole scene as it would have been written to a .pcy file.
+         */
+        [[nodiscard]] YAML::Node toYaml() const;
+
+    protected:
+        [[nodiscard]] YAML::Node decodeBlob(uint64_t offset, uint64_t size) const;
+        bool decodeNode(const std::byte *&cursor, const std::byte *end, YAML::Node &node, uint32_t depth) const;
+
+        disk::MappedFile mFile;
+        BinarySceneHeader mHeader { };
+        std::vector<std::string_view> mStrings;
+        bool mIsValid { false };
+    };
+
+    /**
+     * @brief Writes a scene that is laid out like a .pcy file. Like cooked meshes, a half written file is never read.
+     */
+    bool writeBinaryScene(const std::filesystem::path &path, const YAML::Node &scene);
+
+    bool convertToBinaryScene(const std::filesystem::path &yamlPath, const std::filesystem::path &binaryPath);
+    bool convertToYamlScene(const std::filesystem::path &binaryPath, const std::filesystem::path &yamlPath);
+}
@@ -41,6 +41,7 @@ namespace engine
         Serializer() = default;
         void saveComponent(YAML::Emitter &out, Component *component) const;
         void loadComponent(const YAML::Node &node, const Ref<Actor> &actor);
+        void loadComponent(const std::string &type, const YAML::Node &node, const Ref<Actor> &actor);
         void saveActor(YAML::Emitter &out, Actor *actor) const;
         Ref<Actor> loadActor(const YAML::Node &node, Scene *scene);
         void saveScene(YAML::Emitter &out, Scene *scene) const;
@@ -85,6 +86,12 @@ namespace engine::serialize
     void scene(const std::filesystem::path &path, Scene* scene);
     void actor(YAML::Emitter &out, Actor *actor);
     void component(YAML::Emitter &out, Component *component);
+
+    /**
+     * @brief Builds the same tree as actor() and component() without writing it out as text first.
+     */
+    YAML::Node actorNode(Actor *actor);
+    YAML::Node componentNode(Component *component);
 }
 
 // Used within the engine due to the namespace. We cannot forward declare and friend at the same time in a namespace.
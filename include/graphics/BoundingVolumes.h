@@ -0,0 +1,75 @@
+/**
+ * @file BoundingVolumes.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include "Pch.h"
+
+namespace graphics
+{
+    struct Aabb
+    {
+        glm::vec3 min { 0.f };
+        glm::vec3 max { 0.f };
+    };
+
+    struct BoundingSphere
+    {
+        glm::vec3 centre { 0.f };
+        float radius { 0.f };
+    };
+
+    /**
+     * @brief Local space bounds of a sub-mesh. Computed once at load time.
+     */
+    struct BoundingVolume
+    {
+        Aabb aabb;
+        BoundingSphere sphere;
+    };
+
+    /**
+     * @brief A sphere that will pass every frustum test. Used for geometry that was submitted without bounds.
+     */
+    BoundingSphere unboundedSphere();
+
+    /**
+     * @brief Transforms a local space sphere into world space. Non-uniform scale is handled by using the largest axis.
+     */
+    BoundingSphere transformSphere(const BoundingSphere &sphere, const glm::mat4 &matrix);
+
+    /**
+     * @brief Computes an aabb and a bounding sphere from the position of each vertex.
+     * The sphere is centred on the aabb and encloses the furthest vertex from that centre.
+     * @tparam TVertex Any vertex type with a glm::vec3 position member.
+     */
+    template<typename TVertex>
+    BoundingVolume computeBoundingVolume(const std::vector<TVertex> &vertices)
+    {
+        if (vertices.empty())
+            return { };
+
+        BoundingVolume volume { { vertices[0].position, vertices[0].position }, { } };
+        for (const TVertex &vertex : vertices)
+        {
+            volume.aabb.min = glm::min(volume.aabb.min, vertex.position);
+            volume.aabb.max = glm::max(volume.aabb.max, vertex.position);
+        }
+
+        volume.sphere.centre = 0.5f * (volume.aabb.min + volume.aabb.max);
+
+        float radiusSquared = 0.f;
+        for (const TVertex &vertex : vertices)
+        {
+            const glm::vec3 offset = vertex.position - volume.sphere.centre;
+            radiusSquared = glm::max(radiusSquared, glm::dot(offset, offset));
+        }
+        volume.sphere.radius = glm::sqrt(radiusSquared);
+
+        return volume;
+    }
+}
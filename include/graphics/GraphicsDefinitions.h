@@ -9,6 +9,7 @@
 
 #include "Pch.h"
 #include "Shader.h"
+#include "BoundingVolumes.h"
 #include <functional>
 #include <Statistics.h>
 
@@ -41,6 +42,25 @@ namespace graphics
         Red, Rg, Rgb, Rgba, Depth, Stencil
     };
 
+    /**
+     * @brief Whether something can change after it has been placed. Static shadow casters and lights are
+     * cached between frames.
+     */
+    enum class Mobility : uint8_t
+    {
+        Static, Movable
+    };
+
+    inline const char *to_string(const Mobility mobility)
+    {
+        switch (mobility)
+        {
+            case Mobility::Static: return "Static";
+            case Mobility::Movable: return "Movable";
+            default: return "unknown";
+        }
+    }
+
     enum class gbuffer : uint8_t
     {
         Normal, Roughness, Diffuse,
@@ -69,18 +89,28 @@ namespace graphics
 
     struct GeometryObject
     {
-        GeometryObject(const uint32_t vao, const int32_t indicesCount, const glm::mat4 &matrix)
-            : vao(vao), indicesCount(indicesCount), matrix(matrix) { }
+        GeometryObject(
+            const uint32_t vao, const uint32_t meshId, const int32_t indicesCount, const uint32_t firstIndex,
+            const int32_t baseVertex, const glm::mat4 &matrix, const BoundingSphere &worldBounds, const Mobility mobility)
+            : vao(vao), meshId(meshId), indicesCount(indicesCount), firstIndex(firstIndex), baseVertex(baseVertex),
+              matrix(matrix), worldBounds(worldBounds), mobility(mobility) { }
 
         uint32_t vao = 0;
+        uint32_t meshId = 0;      // Dense id used to group instances of the same mesh when sorting.
         int32_t indicesCount = 0;
+        uint32_t firstIndex = 0;  // Into the vao's index buffer.
+        int32_t baseVertex = 0;   // Added to each index.
         glm::mat4 matrix = glm::mat4(1.f);
+        BoundingSphere worldBounds;
+        Mobility mobility = Mobility::Movable;
     };
 
     struct DebugQueueObject
     {
         uint32_t    vao;
         int32_t     indiciesCount;
+        uint32_t    firstIndex;
+        int32_t     baseVertex;
         glm::mat4   matrix;
         glm::vec3   colour;
     };
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include "Mesh.h"
 #include "Pch.h"
 #include "Texture.h"
 
@@ -46,5 +47,13 @@ namespace graphics
      */
     void dispatchComputeIndirect(uint32_t buffer, int offset=0);
 
+    /**
+     * @brief Draws from the bound vao's element buffer. Meshes share their vao's buffers, so they start part way in.
+     * @param firstIndex The first index to read from the element buffer.
+     * @param baseVertex Added to every index read.
+     */
+    void drawElements(GLenum mode, int32_t indicesCount, uint32_t firstIndex, int32_t baseVertex);
+    void drawElements(GLenum mode, const SubMesh &subMesh);
+
     void validateGpuState();
 }
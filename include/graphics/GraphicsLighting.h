@@ -8,26 +8,35 @@
 #pragma once
 
 #include "Pch.h"
+#include "Cubemap.h"
+#include "GraphicsDefinitions.h"
 #include "TextureArrayObject.h"
+#include "TextureBufferObject.h"
+#include "FixedVector.h"
 
 namespace graphics
 {
+    // Must match DirectionalLightBlock.h.
+    constexpr size_t maxCascadeCount = 16;
+
     struct DirectionalLight
     {
         glm::vec3                               direction       { glm::normalize(glm::vec3(1.f, 1.f, 1.f)) };
         glm::vec3                               colourIntensity { 10'000.f };
+        Mobility                                mobility        { Mobility::Movable };
         
         // Shadow Settings
         
         std::shared_ptr<TextureArrayObject>     shadowMap       { nullptr };
         
         // VP matrices are updated in the render loop. They do not need to be set.
-        std::vector<glm::mat4>                  vpMatrices;
+        // Lights are copied into the render queues every frame, so these are kept in place to avoid the heap.
+        containers::FixedVector<glm::mat4, maxCascadeCount> vpMatrices;
         float                                   shadowZMultiplier { 5.f };
-        std::vector<float>                      shadowCascadeMultipliers { 0.04f, 0.16f, 0.36f, 0.64f };
+        containers::FixedVector<float, maxCascadeCount> shadowCascadeMultipliers { 0.04f, 0.16f, 0.36f, 0.64f };
         uint32_t                                shadowCascadeZones { 5 };
         glm::vec2                               shadowBias { 0.001f, 0.f };
-        std::vector<float>                      cascadeDepths;
+        containers::FixedVector<float, maxCascadeCount> cascadeDepths;
     };
     
     struct PointLight
@@ -38,6 +47,7 @@ namespace graphics
         glm::vec2   bias            { 0.005f, 0.15f };
         float       softnessRadius  { 0.02f };
         glm::mat4   vpMatrices[6];
+        Mobility    mobility        { Mobility::Movable };
         
         std::shared_ptr<Cubemap> shadowMap { nullptr };
     };
@@ -51,6 +61,7 @@ namespace graphics
         float       cosOuterAngle   { glm::cos(glm::radians(45.f)) };
         float       outerAngle      { glm::radians(45.f) };
         float       radius          { 50.f };
+        Mobility    mobility        { Mobility::Movable };
         
         std::shared_ptr<TextureBufferObject> shadowMap { nullptr };
         glm::mat4   vpMatrix;
@@ -9,6 +9,8 @@
 
 #include "Pch.h"
 #include "Vertices.h"
+#include "BoundingVolumes.h"
+#include "MeshArena.h"
 
 class SubMesh;
 
@@ -17,6 +19,7 @@ typedef std::shared_ptr<std::vector<std::unique_ptr<SubMesh>>> SharedMesh;
 void setVaoLayout(unsigned int vao, const Instructions &instructions);
 
 /**
+ * @brief A mesh's place in the shared arena of its vertex format. Indices are relative to the base vertex.
  * @author Ryan Purse
  * @date 15/06/2023
  */
@@ -25,37 +28,52 @@ class SubMesh
 public:
     template<typename TVertex>
     SubMesh(const std::vector<TVertex> &vertices, const std::vector<uint32_t> &indices);
+
+    /**
+     * @param bounds Pre-computed bounds so that the work can be done off of the main thread.
+     */
+    template<typename TVertex>
+    SubMesh(const std::vector<TVertex> &vertices, const std::vector<uint32_t> &indices, const graphics::BoundingVolume &bounds);
     SubMesh(SubMesh &) = delete;
     
     ~SubMesh();
     
-    [[nodiscard]] uint32_t vao() const { return mVao; }
+    [[nodiscard]] uint32_t vao() const { return mArena->vao(); }
+
+    /**
+     * @returns An id that no other live mesh has. Unlike the first index, it doesn't change when the arena is defragmented.
+     */
+    [[nodiscard]] uint32_t meshId() const { return mAllocation.meshId; }
     [[nodiscard]] int32_t  indicesCount() const { return mIndicesCount; };
+
+    /**
+     * @returns Where the indices start in the arena's index buffer. Changes when the arena is defragmented.
+     */
+    [[nodiscard]] uint32_t firstIndex() const { return mArena->firstIndex(mAllocation); }
+
+    /**
+     * @returns Where the vertices start in the arena's vertex buffer. Changes when the arena is defragmented.
+     */
+    [[nodiscard]] int32_t  baseVertex() const { return mArena->baseVertex(mAllocation); }
+    [[nodiscard]] const graphics::BoundingVolume &bounds() const { return mBounds; }
     
 protected:
-    uint32_t mVao { 0 };
-    uint32_t mVbo { 0 };
-    uint32_t mEbo { 0 };
+    graphics::MeshArena *mArena { nullptr };
+    graphics::MeshAllocation mAllocation;
     int32_t  mIndicesCount { 0 };
+    graphics::BoundingVolume mBounds;
 };
 
 template<typename TVertex>
 SubMesh::SubMesh(const std::vector<TVertex> &vertices, const std::vector<uint32_t> &indices)
+    : SubMesh(vertices, indices, graphics::computeBoundingVolume(vertices))
 {
-    glCreateBuffers(1, &mVbo);
-    glCreateBuffers(1, &mEbo);
-    glNamedBufferData(mVbo, static_cast<int64_t>(vertices.size() * sizeof(TVertex)), static_cast<const void *>(&vertices[0]), GL_STATIC_DRAW);
-    glNamedBufferData(mEbo, static_cast<int64_t>(indices.size() * sizeof(uint32_t)), static_cast<const void *>(&indices[0]), GL_STATIC_DRAW);
-    mIndicesCount = static_cast<int32_t>(indices.size());
-    
-    glCreateVertexArrays(1, &mVao);
-    
-    const unsigned int bindingIndex = 0;
-    const unsigned int offSet = 0;
-    const unsigned int stride = sizeof(TVertex);
-    
-    setVaoLayout(mVao, TVertex::layout());
-    
-    glVertexArrayVertexBuffer(mVao, bindingIndex, mVbo, offSet, stride);
-    glVertexArrayElementBuffer(mVao, mEbo);
+}
+
+template<typename TVertex>
+SubMesh::SubMesh(const std::vector<TVertex> &vertices, const std::vector<uint32_t> &indices, const graphics::BoundingVolume &bounds)
+    : mArena(&graphics::meshArena<TVertex>()), mIndicesCount(static_cast<int32_t>(indices.size())), mBounds(bounds)
+{
+    mAllocation = mArena->allocate(
+        vertices.data(), static_cast<uint32_t>(vertices.size()), indices.data(), static_cast<uint32_t>(indices.size()));
 }
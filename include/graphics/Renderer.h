@@ -8,6 +8,7 @@
 #pragma once
 
 #include "Buffers.h"
+#include "FrameArena.h"
 #include "CameraSettings.h"
 #include "GraphicsDefinitions.h"
 #include "GraphicsLighting.h"
@@ -42,24 +43,48 @@ public:
     Renderer operator=(Renderer&&) = delete;
     ~Renderer();
 
+    /**
+     * @brief Reserves a slot in the renderer's material table. Release it with destroyMaterial().
+     * @returns The index that geometry is drawn with.
+     */
+    uint32_t createMaterial();
+
+    /**
+     * @brief Replaces the data of a material. Only call this when the material has changed since it is
+     * re-uploaded to the gpu on the next render.
+     */
+    void updateMaterial(uint32_t materialIndex, const graphics::MaterialData &material);
+
+    void destroyMaterial(uint32_t materialIndex);
+
     /**
      * @brief Draws an element to the geometry buffer.
      * @param vao Vertex Array Object
+     * @param meshId Groups instances of the same geometry when sorting. @see SubMesh::meshId()
      * @param indiciesCount The number of indices that make up the geometry.
+     * @param firstIndex Where the geometry's indices start in the vao's element buffer.
+     * @param baseVertex Added to each of the geometry's indices.
      * @param matrix The model matrix for this object (used for shadow mapping).
-     * @param material The material the geometry will be drawn with.
+     * @param materialIndex The material the geometry will be drawn with. @see createMaterial()
+     * @param worldBounds The world space bounds of the geometry used for culling. Unbounded geometry is never culled.
+     * @param mobility Static geometry is cached in the shadow maps of static lights.
      */
-    void drawMesh(uint32_t vao, int32_t indiciesCount, const glm::mat4 &matrix, const graphics::MaterialData &material);
-    void drawMesh(const SubMesh &surface, const glm::mat4 &matrix, const graphics::MaterialData &material);
+    void drawMesh(
+        uint32_t vao, uint32_t meshId, int32_t indiciesCount, uint32_t firstIndex, int32_t baseVertex, const glm::mat4 &matrix, uint32_t materialIndex,
+        const graphics::BoundingSphere &worldBounds=graphics::unboundedSphere(),
+        graphics::Mobility mobility=graphics::Mobility::Movable);
+    void drawMesh(const SubMesh &surface, const glm::mat4 &matrix, uint32_t materialIndex, graphics::Mobility mobility=graphics::Mobility::Movable);
 
     /**
      * @brief Draws an element to the debug buffer.
      * @param vao - Vertex Array Object.
      * @param indicesCount - The number of indices that make up the geometry.
+     * @param firstIndex - Where the geometry's indices start in the vao's element buffer.
+     * @param baseVertex - Added to each of the geometry's indices.
      * @param matrix - The model matrix for this object.
      * @param colour - The colour the mesh should be.
      */
-    void drawDebugMesh(uint32_t vao, int32_t indicesCount, const glm::mat4 &matrix, const glm::vec3 &colour);
+    void drawDebugMesh(uint32_t vao, int32_t indicesCount, uint32_t firstIndex, int32_t baseVertex, const glm::mat4 &matrix, const glm::vec3 &colour);
 
     /**
      * @brief Draws an element to the debug buffer.
@@ -106,9 +131,16 @@ public:
     void submit(const graphics::Spotlight &spotLight);
 
     /**
-     * Starts rendering everything that was submitted to the renderer this frame.
+     * @brief Tells the renderer which version of the static geometry is being submitted. It must change whenever
+     * static geometry is added, removed or moved so that cached shadows are redrawn.
      */
-    void render() const;
+    void setStaticGeneration(uint64_t generation);
+
+    /**
+     * Starts rendering everything that was submitted to the renderer this frame. The queues are handed to the backend,
+     * so this must be called once before every clear().
+     */
+    void render();
 
     /**
      * @brief Resets the data fro the next round of rendering. This is split so that ImGui can display information
@@ -153,20 +185,30 @@ public:
     void setIblMultiplier(float multiplier) const;
 
     void setUseUberVariant(bool useUber) const;
+    void setUseClusteredLighting(bool useClustered) const;
+    void setUseDepthPrepass(bool useDepthPrepass) const;
 
 protected:
-    std::vector<CameraSettings>              mCameraQueue;
-    std::vector<graphics::DirectionalLight>  mDirectionalLightQueue;
-    std::vector<graphics::PointLight>        mPointLightQueue;
-    std::vector<graphics::Spotlight>         mSpotlightQueue;
-    std::vector<graphics::DebugQueueObject>  mDebugQueue;
-    std::vector<graphics::LineQueueObject>   mLineQueue;
-
-    std::vector<graphics::GeometryObject>    mMultiMaterialGeometryQueue;
-    std::vector<graphics::MaterialData>      mMultiMaterialQueue;
-
-    std::vector<graphics::GeometryObject>    mSingleMaterialGeometryQueue;
-    std::vector<graphics::MaterialData>      mSingleMaterialQueue;
+    void resetQueues(graphics::FrameArena &arena);
+
+    // Queues are filled from one arena while the backend reads last frame's from the other.
+    graphics::FrameArena mFrameArenas[2];
+    uint32_t mFrameArenaIndex { 0 };
+
+    graphics::FrameVector<CameraSettings>              mCameraQueue;
+    graphics::FrameVector<graphics::DirectionalLight>  mDirectionalLightQueue;
+    graphics::FrameVector<graphics::PointLight>        mPointLightQueue;
+    graphics::FrameVector<graphics::Spotlight>         mSpotlightQueue;
+    graphics::FrameVector<graphics::DebugQueueObject>  mDebugQueue;
+    graphics::FrameVector<graphics::LineQueueObject>   mLineQueue;
+
+    graphics::FrameVector<graphics::GeometryObject>    mMultiMaterialGeometryQueue;
+    graphics::FrameVector<uint32_t>                    mMultiMaterialQueue;
+
+    graphics::FrameVector<graphics::GeometryObject>    mSingleMaterialGeometryQueue;
+    graphics::FrameVector<uint32_t>                    mSingleMaterialQueue;
+
+    uint64_t mStaticGeneration { 0 };
 
     SubMesh mFullscreenTriangle;
 
@@ -9,6 +9,7 @@
 
 #include "Pch.h"
 #include <filesystem>
+#include <functional>
 
 namespace graphics
 {
@@ -17,6 +18,39 @@ namespace graphics
         std::string symbol;
         int constant = 1;
     };
+
+    /**
+     * @brief A uniform location resolved ahead of time so that hot loops don't have to look it up by name.
+     * Invalid handles are ignored by OpenGL, the same as setting a uniform that doesn't exist.
+     */
+    struct UniformHandle
+    {
+        int location = -1;
+
+        [[nodiscard]] bool isValid() const { return location != -1; }
+    };
+
+    /**
+     * @brief Immediate shaders are built in their constructor. Deferred shaders are built by a ShaderCompiler.
+     */
+    enum class BuildMode
+    {
+        Immediate, Deferred
+    };
+
+    /**
+     * @brief Runs a job on another thread and returns a function that blocks until the job is done.
+     */
+    typedef std::function<std::function<void()>(std::function<void()>)> JobScheduler;
+
+    /**
+     * @brief Where deferred shaders are preprocessed. The engine points this at its job system. Without a scheduler,
+     * shaders are preprocessed on the thread that submits them.
+     */
+    void setShaderJobScheduler(JobScheduler scheduler);
+
+    struct PendingBuild;
+    class ShaderCompiler;
 }
 
 /**
@@ -30,12 +64,37 @@ public:
     Shader(Shader&) = delete;
     Shader(const Shader&) = delete;
 
-    explicit Shader(const std::vector<std::filesystem::path> &paths, const std::vector<graphics::Definition> &definitions={ });
+    explicit Shader(
+        const std::vector<std::filesystem::path> &paths, const std::vector<graphics::Definition> &definitions={ },
+        graphics::BuildMode buildMode=graphics::BuildMode::Immediate);
     Shader(Shader&& other) noexcept;
     virtual ~Shader();
     
     void bind() const;
     static void unbind();
+
+    /**
+     * @returns False while a deferred shader is waiting on its ShaderCompiler. It must not be used until then.
+     */
+    [[nodiscard]] bool isBuilt() const { return mPendingBuild == nullptr; }
+
+    /**
+     * @brief Looks up a uniform in the table that was reflected when the program linked. Store the handle
+     * in the pass to avoid hashing the name every frame.
+     * @returns An invalid handle and warns once if the uniform is not active in this program.
+     */
+    [[nodiscard]] graphics::UniformHandle getUniform(const std::string &uniformName);
+
+    void set(graphics::UniformHandle uniform, int value) const;
+    void set(graphics::UniformHandle uniform, unsigned int value) const;
+    void set(graphics::UniformHandle uniform, float value) const;
+    void set(graphics::UniformHandle uniform, const glm::mat4 &value) const;
+    void set(graphics::UniformHandle uniform, const glm::vec4 &value) const;
+    void set(graphics::UniformHandle uniform, const glm::vec3 &value) const;
+    void set(graphics::UniformHandle uniform, const glm::vec2 &value) const;
+    void set(graphics::UniformHandle uniform, uint32_t textureId, int bindPoint) const;
+    void set(graphics::UniformHandle uniform, const float* values, int count) const;
+    void set(graphics::UniformHandle uniform, const glm::mat4 *values, int count) const;
     
     /**
      * @brief Sets a uniform within the shader.
@@ -113,13 +172,25 @@ public:
     void validateProgram() const;
 
 protected:
+    friend class graphics::ShaderCompiler;
 
     std::string mDebugName;
     unsigned int mId { 0 };
-    std::unordered_map<std::string , int> mCache;
-    
-    int getLocation(const std::string &name);
+
+    // Filled in from the program's interface once it has linked. Inactive names are added with an invalid
+    // location when they're first looked up so that they're only reported once.
+    std::unordered_map<std::string, int> mUniformLocations;
+    std::unordered_map<std::string, unsigned int> mBlockIndices;
+
+    std::unique_ptr<graphics::PendingBuild> mPendingBuild;
+
+    void reflectInterface();
+
+    // Building is split up so that the ShaderCompiler can overlap many programs.
+    void startPreprocessing(bool isAsync);
+    void submitBuild();
+    [[nodiscard]] bool isBuildComplete() const;
+    void finishBuild();
 
     void CreateShaderSource(std::initializer_list<std::filesystem::path> paths) const;
-    void CreateShaderSource(const std::vector<std::filesystem::path> &paths, const std::vector<graphics::Definition> &macros) const;
 };
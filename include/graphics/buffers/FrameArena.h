@@ -0,0 +1,110 @@
+/**
+ * @file FrameArena.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include "Pch.h"
+
+namespace graphics
+{
+    /**
+     * @brief A linear allocator for data that only lives for one frame. Allocating bumps a pointer and nothing is
+     * freed until reset(). Once the arena has seen the biggest frame it needs, it stops touching the heap.
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class FrameArena
+    {
+    public:
+        explicit FrameArena(uint64_t blockSize=1024 * 1024);
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        /**
+         * @param alignment Must be a power of two.
+         */
+        void *allocate(uint64_t size, uint64_t alignment);
+
+        /**
+         * @brief Forgets every allocation. If the last frame spilled over into more than one block, they're
+         * replaced by a single block that fits all of them. Nothing allocated from the arena may be used after this.
+         */
+        void reset();
+
+        [[nodiscard]] uint64_t usedBytes() const { return mCompletedBytes + mHead; }
+        [[nodiscard]] uint64_t capacity() const;
+
+        /**
+         * @returns How many times the arena has had to go to the heap for a block.
+         */
+        [[nodiscard]] uint64_t heapAllocationCount() const { return mHeapAllocationCount; }
+
+    protected:
+        struct Block
+        {
+            std::unique_ptr<std::byte[]> data;
+            uint64_t size;
+        };
+
+        void addBlock(uint64_t size);
+
+        uint64_t mBlockSize;
+        std::vector<Block> mBlocks;
+        size_t mCurrentBlock { 0 };
+        uint64_t mHead { 0 };
+        uint64_t mCompletedBytes { 0 };  // Used by the blocks before the current one.
+        uint64_t mHeapAllocationCount { 0 };
+    };
+
+    /**
+     * @brief Lets standard containers allocate from a FrameArena. Freeing does nothing since the arena is reset
+     * as a whole. A default constructed allocator has no arena and falls back to the heap.
+     */
+    template<typename T>
+    class FrameAllocator
+    {
+    public:
+        using value_type = T;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+        using is_always_equal = std::false_type;
+
+        FrameAllocator() = default;
+        explicit FrameAllocator(FrameArena &arena) : mArena(&arena) { }
+
+        template<typename U>
+        FrameAllocator(const FrameAllocator<U> &other) : mArena(other.arena()) { }
+
+        T *allocate(const size_t count)
+        {
+            if (mArena == nullptr)
+                return static_cast<T*>(::operator new(count * sizeof(T)));
+            return static_cast<T*>(mArena->allocate(count * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T *pointer, size_t)
+        {
+            if (mArena == nullptr)
+                ::operator delete(pointer);
+        }
+
+        [[nodiscard]] FrameArena *arena() const { return mArena; }
+
+    protected:
+        FrameArena *mArena { nullptr };
+    };
+
+    template<typename T, typename U>
+    bool operator==(const FrameAllocator<T> &lhs, const FrameAllocator<U> &rhs) { return lhs.arena() == rhs.arena(); }
+
+    template<typename T, typename U>
+    bool operator!=(const FrameAllocator<T> &lhs, const FrameAllocator<U> &rhs) { return lhs.arena() != rhs.arena(); }
+
+    template<typename T>
+    using FrameVector = std::vector<T, FrameAllocator<T>>;
+}
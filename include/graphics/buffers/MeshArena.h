@@ -0,0 +1,94 @@
+/**
+ * @file MeshArena.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include "Pch.h"
+#include "RangeAllocator.h"
+#include "Vertices.h"
+
+namespace graphics
+{
+    /**
+     * @brief Where a mesh's vertices and indices live in a MeshArena.
+     */
+    struct MeshAllocation
+    {
+        uint32_t vertices = RangeAllocator::invalidHandle;
+        uint32_t indices = RangeAllocator::invalidHandle;
+
+        // Unique across every arena and reused once freed, so that ids stay small enough to pack into sort keys.
+        uint32_t meshId = RangeAllocator::invalidHandle;
+    };
+
+    /**
+     * @brief One vertex buffer and one index buffer that every mesh with the same vertex format is sub-allocated
+     * from. They share one vao so that draws only differ by their first index and base vertex, which lets whole
+     * queues be drawn with one multi-draw. Must only be used on the main thread.
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class MeshArena
+    {
+    public:
+        MeshArena(uint32_t vertexStride, const Instructions &layout, std::string debugName);
+        ~MeshArena();
+
+        MeshArena(const MeshArena&) = delete;
+        MeshArena& operator=(const MeshArena&) = delete;
+
+        /**
+         * @brief Copies the mesh into the arena, growing the buffers if there isn't a gap big enough.
+         * @param indices Relative to the first vertex of this mesh.
+         */
+        MeshAllocation allocate(const void *vertices, uint32_t vertexCount, const uint32_t *indices, uint32_t indexCount);
+        void free(const MeshAllocation &allocation);
+
+        [[nodiscard]] int32_t baseVertex(const MeshAllocation &allocation) const;
+        [[nodiscard]] uint32_t firstIndex(const MeshAllocation &allocation) const;
+        [[nodiscard]] uint32_t vao() const { return mVao; }
+
+        /**
+         * @brief Packs the meshes together once too much of the buffers is lost to gaps. Offsets change, so this
+         * must only be called while nothing is queued for drawing.
+         */
+        void defragmentIfNeeded();
+
+        /**
+         * @brief Calls defragmentIfNeeded() on every arena.
+         */
+        static void defragmentAll();
+
+    protected:
+        struct Buffer
+        {
+            unsigned int id { 0 };
+            uint32_t elementSize { 0 };
+            RangeAllocator allocator;
+        };
+
+        uint32_t allocate(Buffer &buffer, const void *data, uint32_t count);
+        void resize(Buffer &buffer, uint64_t capacity);
+        void defragment(Buffer &buffer);
+        void attachBuffers() const;
+
+        std::string mDebugName;
+        unsigned int mVao { 0 };
+        Buffer mVertices;
+        Buffer mIndices;
+    };
+
+    /**
+     * @returns The arena that every mesh of this vertex format is allocated from.
+     */
+    template<typename TVertex>
+    MeshArena &meshArena()
+    {
+        static MeshArena arena(sizeof(TVertex), TVertex::layout(), "Mesh Arena (" + std::to_string(sizeof(TVertex)) + " byte vertices)");
+        return arena;
+    }
+}
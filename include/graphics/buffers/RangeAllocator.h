@@ -0,0 +1,84 @@
+/**
+ * @file RangeAllocator.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include <map>
+
+#include "Pch.h"
+
+namespace graphics
+{
+    /**
+     * @brief Hands out ranges of a buffer that can be freed in any order. Free ranges are merged with their
+     * neighbours and the live ranges can be packed together on request. Allocations are referred to by a handle
+     * so that their offset can change when packed. This only does the bookkeeping so that it can be used without a GPU.
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class RangeAllocator
+    {
+    public:
+        static constexpr uint32_t invalidHandle = ~0u;
+
+        /**
+         * @brief A copy that moves an allocation when the allocator is defragmented.
+         */
+        struct Move
+        {
+            uint64_t from;
+            uint64_t to;
+            uint64_t size;
+        };
+
+        explicit RangeAllocator(uint64_t capacity=0);
+
+        /**
+         * @brief Finds the first free range that fits. Zero sized allocations still take up one unit.
+         * @returns invalidHandle if there isn't a free range big enough.
+         */
+        uint32_t allocate(uint64_t size);
+        void free(uint32_t handle);
+
+        /**
+         * @brief Adds the new space to the end. Existing allocations keep their offsets.
+         */
+        void grow(uint64_t capacity);
+
+        /**
+         * @brief Packs every live allocation to the start, keeping their order.
+         * @returns The copies needed to do the same to the data. Destinations never come after their source.
+         */
+        std::vector<Move> defragment();
+
+        [[nodiscard]] uint64_t offset(uint32_t handle) const { return mAllocations[handle].offset; }
+        [[nodiscard]] uint64_t size(uint32_t handle) const { return mAllocations[handle].size; }
+        [[nodiscard]] uint64_t capacity() const { return mCapacity; }
+        [[nodiscard]] uint64_t usedSize() const { return mUsedSize; }
+        [[nodiscard]] uint64_t largestFreeRange() const;
+        [[nodiscard]] size_t freeRangeCount() const { return mFreeRanges.size(); }
+
+        /**
+         * @returns How much of the free space can't be used by one allocation, from 0 to 1.
+         */
+        [[nodiscard]] float fragmentation() const;
+
+    protected:
+        struct Allocation
+        {
+            uint64_t offset = 0;
+            uint64_t size = 0;
+            bool isLive = false;
+        };
+
+        uint64_t mCapacity { 0 };
+        uint64_t mUsedSize { 0 };
+        std::vector<Allocation> mAllocations;
+        std::vector<uint32_t> mFreeHandles;
+        std::map<uint64_t, uint64_t> mFreeRanges;  // Offset to size. Ordered so that neighbours can be merged.
+    };
+}
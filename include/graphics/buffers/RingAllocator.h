@@ -0,0 +1,110 @@
+/**
+ * @file RingAllocator.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include <deque>
+
+#include "Pch.h"
+
+namespace graphics
+{
+    /**
+     * @brief Hands out ranges of a fixed size buffer in a circle. Allocations are grouped into frames and a frame
+     * owns its space until it is retired. This only does the bookkeeping so that it can be used without a GPU.
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class RingAllocator
+    {
+    public:
+        static constexpr uint64_t invalidOffset = ~0ull;
+
+        explicit RingAllocator(uint64_t capacity=0);
+
+        /**
+         * @brief Forgets every allocation and frame.
+         */
+        void reset(uint64_t capacity);
+
+        /**
+         * @brief Finds space for size bytes at the given alignment (a power of two). If older frames still own
+         * the space, they're retired oldest first by calling retireFrame(frameId), which must not return until
+         * that frame is no longer in use.
+         * @returns invalidOffset if the allocation can't fit alongside the current frame.
+         */
+        template<typename TRetire>
+        uint64_t allocate(uint64_t size, uint64_t alignment, TRetire &&retireFrame);
+
+        /**
+         * @brief Retires frames, oldest first, for as long as isDone(frameId) returns true.
+         */
+        template<typename TIsDone>
+        void retireCompletedFrames(TIsDone &&isDone);
+
+        /**
+         * @brief Closes the current frame.
+         * @returns The id of the frame that was closed so that the caller can track when it is done.
+         */
+        uint64_t endFrame();
+
+        [[nodiscard]] uint64_t capacity() const { return mCapacity; }
+        [[nodiscard]] uint64_t usedBytes() const { return mHead - mTail; }
+        [[nodiscard]] size_t framesInFlight() const { return mFrames.size(); }
+
+    protected:
+        struct Frame
+        {
+            uint64_t id;
+            uint64_t end;
+        };
+
+        void retireOldestFrame();
+
+        // Heads and tails only ever increase. The physical offset is them modulo the capacity.
+        uint64_t mCapacity { 0 };
+        uint64_t mHead { 0 };
+        uint64_t mTail { 0 };
+        uint64_t mNextFrameId { 0 };
+        std::deque<Frame> mFrames;  // Closed frames that haven't been retired, oldest first.
+    };
+
+    template<typename TRetire>
+    uint64_t RingAllocator::allocate(const uint64_t size, const uint64_t alignment, TRetire &&retireFrame)
+    {
+        if (size > mCapacity)
+            return invalidOffset;
+
+        const uint64_t physicalHead = mHead % mCapacity;
+        uint64_t padding = ((physicalHead + alignment - 1) & ~(alignment - 1)) - physicalHead;
+
+        // Allocations never straddle the end of the buffer. Skip to the start instead, which is always aligned.
+        if (physicalHead + padding + size > mCapacity)
+            padding = mCapacity - physicalHead;
+
+        const uint64_t total = padding + size;
+        while (mHead + total - mTail > mCapacity)
+        {
+            if (mFrames.empty())
+                return invalidOffset;
+
+            retireFrame(mFrames.front().id);
+            retireOldestFrame();
+        }
+
+        const uint64_t offset = (physicalHead + padding) % mCapacity;
+        mHead += total;
+        return offset;
+    }
+
+    template<typename TIsDone>
+    void RingAllocator::retireCompletedFrames(TIsDone &&isDone)
+    {
+        while (!mFrames.empty() && isDone(mFrames.front().id))
+            retireOldestFrame();
+    }
+}
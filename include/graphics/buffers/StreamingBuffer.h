@@ -0,0 +1,82 @@
+/**
+ * @file StreamingBuffer.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include <cstring>
+
+#include "Pch.h"
+#include "RingAllocator.h"
+
+namespace graphics
+{
+    /**
+     * @brief A range of a StreamingBuffer that has been written to and can be bound to a shader.
+     */
+    struct StreamingRange
+    {
+        unsigned int bufferId { 0 };
+        uint64_t offset { 0 };
+        uint64_t size { 0 };
+    };
+
+    /**
+     * @brief A persistently mapped buffer for data that is written by the CPU every frame. Ranges are
+     * sub-allocated in a circle and each frame is fenced so that data is never overwritten while the
+     * GPU might still be reading it. Ranges stay valid until the end of the frame that they were written in,
+     * even if the buffer grows.
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class StreamingBuffer
+    {
+    public:
+        explicit StreamingBuffer(uint64_t capacity, const std::string &debugName="");
+        ~StreamingBuffer();
+
+        StreamingBuffer(const StreamingBuffer&) = delete;
+        StreamingBuffer& operator=(const StreamingBuffer&) = delete;
+
+        /**
+         * @brief Copies the data into the buffer, aligned so that it can be bound as a shader storage buffer.
+         * The buffer grows if the current frame doesn't fit. The old buffer is kept until the end of the frame
+         * so ranges that are already bound aren't affected.
+         */
+        template<typename TData>
+        StreamingRange write(const TData *data, uint64_t size);
+
+        /**
+         * @brief Fences everything written since the last call. Call once the draws using the ranges have been issued.
+         */
+        void endFrame();
+
+        static void bindToSlot(const StreamingRange &range, unsigned int bindPoint);
+
+    protected:
+        StreamingRange allocate(uint64_t size);
+        void grow(uint64_t size);
+        void deleteRetiredBuffers();
+        void create(uint64_t capacity);
+        void destroy();
+
+        std::string mDebugName;
+        unsigned int mBufferId { 0 };
+        std::byte *mMappedData { nullptr };
+        RingAllocator mAllocator;
+        std::deque<GLsync> mFences;  // One for every frame the allocator has in flight, oldest first.
+        std::vector<unsigned int> mRetiredBufferIds;  // Replaced by growing this frame but ranges may still be bound.
+    };
+
+    template<typename TData>
+    StreamingRange StreamingBuffer::write(const TData *data, const uint64_t size)
+    {
+        const StreamingRange range = allocate(size);
+        if (size > 0)
+            std::memcpy(mMappedData + range.offset, data, size);
+        return range;
+    }
+}
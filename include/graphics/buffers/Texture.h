@@ -9,6 +9,7 @@
 
 #include <filesystem>
 #include "Pch.h"
+#include "TextureUploader.h"
 
 
 
@@ -30,7 +31,15 @@ public:
     [[nodiscard]] std::filesystem::path path() const { return mPath; }
     void setData(const glm::ivec2 &size, const unsigned char *bytes);
 
+    /**
+     * @brief Copies the pixels from space that a worker has already filled. Nothing waits on the GPU.
+     */
+    void setData(const glm::ivec2 &size, graphics::TextureUploader &uploader, const graphics::PixelUpload &upload);
+
     std::filesystem::path mPath;
     uint32_t mId { 0 };
     glm::ivec2 mSize { 0 };
+
+protected:
+    void createStorage(const glm::ivec2 &size);
 };
@@ -0,0 +1,101 @@
+/**
+ * @file TextureUploader.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <mutex>
+
+#include "Pch.h"
+
+namespace graphics
+{
+    /**
+     * @brief Space in a TextureUploader's buffer that a worker can write pixels into.
+     */
+    struct PixelUpload
+    {
+        uint64_t id { 0 };
+        uint64_t offset { 0 };
+        uint64_t size { 0 };
+        std::byte *data { nullptr };
+
+        [[nodiscard]] bool isValid() const { return data != nullptr; }
+    };
+
+    /**
+     * @brief A persistently mapped pixel unpack buffer that textures are streamed through. Workers reserve space and
+     * write pixels into it directly, so the main thread only has to issue the copy into the texture. Space is handed
+     * out in a circle and is reused once the copy's fence has signalled.
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class TextureUploader
+    {
+    public:
+        /**
+         * @brief Must be created on the thread that owns the OpenGL context.
+         */
+        explicit TextureUploader(uint64_t capacity=128 * 1024 * 1024);
+        ~TextureUploader();
+
+        TextureUploader(const TextureUploader&) = delete;
+        TextureUploader& operator=(const TextureUploader&) = delete;
+
+        /**
+         * @brief Can be called from any thread and never waits. Space is only freed by update() on the owning thread,
+         * so a worker blocking here would hold up the pool without making room any sooner.
+         * @returns An invalid upload if there isn't room. Callers should fall back to uploading from client memory.
+         * A valid upload must be passed to copyToTexture(), since that is the only way its space comes back.
+         */
+        PixelUpload reserve(uint64_t size);
+
+        /**
+         * @brief Copies the upload into the first level of an RGBA8 texture and fences it.
+         */
+        void copyToTexture(const PixelUpload &upload, unsigned int textureId, const glm::ivec2 &size);
+
+        /**
+         * @brief Frees the space of every copy that the GPU has finished and updates the profiler. Call once a frame.
+         */
+        void update();
+
+    protected:
+        struct Region
+        {
+            uint64_t id;
+            uint64_t end;
+            bool isDone;
+        };
+
+        struct Copy
+        {
+            GLsync fence;
+            uint64_t id;
+            std::chrono::steady_clock::time_point issueTime;
+        };
+
+        PixelUpload tryAllocate(uint64_t size);
+        void release(uint64_t id);
+
+        std::mutex mMutex;
+
+        unsigned int mBufferId { 0 };
+        std::byte *mMappedData { nullptr };
+
+        // Heads and tails only ever increase. The physical offset is them modulo the capacity.
+        uint64_t mCapacity { 0 };
+        uint64_t mHead { 0 };
+        uint64_t mTail { 0 };
+        std::deque<Region> mRegions;  // Oldest first. Space is only reclaimed from the front.
+
+        std::deque<Copy> mCopies;  // Only touched by the owning thread.
+        uint64_t mFrameBytes { 0 };
+        long long mLatencyMicroseconds { 0 };
+    };
+}
@@ -0,0 +1,76 @@
+/**
+ * @file FixedVector.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include <array>
+#include <initializer_list>
+
+namespace containers
+{
+    /**
+     * @brief A vector that keeps its elements in place, so copying it never touches the heap. Anything pushed or
+     * resized past the capacity is dropped.
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    template<typename T, size_t Capacity>
+    class FixedVector
+    {
+    public:
+        FixedVector() = default;
+        FixedVector(std::initializer_list<T> values) { assign(values.begin(), values.end()); }
+
+        template<typename TIt>
+        void assign(TIt first, const TIt last)
+        {
+            mSize = 0;
+            for (; first != last && mSize < Capacity; ++first)
+                mData[mSize++] = *first;
+        }
+
+        template<typename... TArgs>
+        void emplace_back(TArgs&&... args)
+        {
+            if (mSize < Capacity)
+                mData[mSize++] = T(std::forward<TArgs>(args)...);
+        }
+
+        void push_back(const T &value) { emplace_back(value); }
+
+        void resize(const size_t size, const T &value=T())
+        {
+            const size_t newSize = std::min(size, Capacity);
+            for (size_t i = mSize; i < newSize; ++i)
+                mData[i] = value;
+            mSize = newSize;
+        }
+
+        // Kept so that code written against std::vector still reads the same.
+        void reserve(size_t) { }
+        void clear() { mSize = 0; }
+
+        [[nodiscard]] size_t size() const { return mSize; }
+        [[nodiscard]] bool empty() const { return mSize == 0; }
+        [[nodiscard]] static constexpr size_t capacity() { return Capacity; }
+
+        T &operator[](const size_t index) { return mData[index]; }
+        const T &operator[](const size_t index) const { return mData[index]; }
+
+        T *data() { return mData.data(); }
+        const T *data() const { return mData.data(); }
+
+        T *begin() { return mData.data(); }
+        T *end() { return mData.data() + mSize; }
+        const T *begin() const { return mData.data(); }
+        const T *end() const { return mData.data() + mSize; }
+
+    protected:
+        std::array<T, Capacity> mData { };
+        size_t mSize { 0 };
+    };
+}
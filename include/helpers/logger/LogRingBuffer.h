@@ -0,0 +1,86 @@
+/**
+ * @file LogRingBuffer.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace debug
+{
+    typedef int Severity;
+
+    /**
+     * @brief A log call as it is passed to the writer thread. Records are a fixed size so pushing one never allocates
+     * unless the message is too long to fit inline.
+     */
+    struct LogRecord
+    {
+        static constexpr uint32_t inlineCapacity = 224;
+
+        const char *file;  // Always __FILE__ so it is never copied.
+        int line;
+        Severity severity;
+        uint32_t length;
+        std::string *overflow;  // Owned by the record. Only set when the message doesn't fit inline.
+        char text[inlineCapacity];
+
+        void setMessage(std::string_view message);
+        [[nodiscard]] std::string_view message() const;
+
+        /**
+         * @brief Frees the overflow string. Must be called once the consumer is done with the record.
+         */
+        void release();
+    };
+
+    /**
+     * @brief A bounded, lock-free, multi producer single consumer queue of log records.
+     * Each slot holds a sequence number that tells producers and the consumer whose turn it is to use it.
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class LogRingBuffer
+    {
+    public:
+        static constexpr uint32_t capacity = 4096;  // Must be a power of two.
+
+        LogRingBuffer();
+
+        /**
+         * @brief Safe to call from any thread.
+         * @returns false if the buffer is full.
+         */
+        bool tryPush(const LogRecord &record);
+
+        /**
+         * @brief Must only be called from the consumer thread.
+         * @returns false if the buffer is empty.
+         */
+        bool tryPop(LogRecord &record);
+
+        [[nodiscard]] bool isEmpty() const;
+
+        /**
+         * @returns Roughly how many records are waiting. Only exact when no one is pushing or popping.
+         */
+        [[nodiscard]] uint64_t size() const;
+
+    protected:
+        struct Slot
+        {
+            std::atomic<uint64_t> sequence;
+            LogRecord record;
+        };
+
+        std::unique_ptr<Slot[]> mSlots;
+        alignas(64) std::atomic<uint64_t> mHead { 0 };  // Claimed by the producers.
+        alignas(64) std::atomic<uint64_t> mTail { 0 };  // Only written by the consumer.
+    };
+}
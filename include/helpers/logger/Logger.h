@@ -11,10 +11,16 @@
 #include <unordered_map>
 #include <set>
 #include <filesystem>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
 #include "glew.h"
 #include "gtc/matrix_access.hpp"
 #include "assimp/LogStream.hpp"
 #include "Format.h"
+#include "LogRingBuffer.h"
 
 namespace debug
 {
@@ -51,6 +57,17 @@ namespace debug
         return static_cast<OutputSourceFlag>(static_cast<int>(a) & static_cast<int>(b));
     }
     
+    /**
+     * @brief What a producer does when the writer thread can't keep up and the buffer is full.
+     * Warnings and errors always block so they are never lost.
+     */
+    enum OverflowPolicy_
+    {
+        OverflowPolicy_Drop,    // Discard the message if it's below a warning. The writer reports how many were lost.
+        OverflowPolicy_Block,   // Wait for the writer to free up a slot.
+    };
+    typedef OverflowPolicy_ OverflowPolicy;
+    
     struct Message
     {
         int         line;
@@ -72,6 +89,8 @@ namespace debug
     };
     
     /**
+     * @brief Log calls are pushed into a bounded ring buffer and written out to the console, file and queue by a
+     * background thread. Messages at or above the throw level are flushed before throwing so nothing is lost.
      * @author Ryan Purse
      * @date 06/08/2023
      */
@@ -131,7 +150,12 @@ namespace debug
         /** Call back to attach to opengl when in debug mode. */
         void openglCallBack(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar *message, const void *userParam);
         
-        [[nodiscard]] const std::vector<Message> &getLogs() const;
+        /**
+         * @brief Calls callback(const Message &) for each message in the history, newest first.
+         * The history is locked while iterating so keep the callback short.
+         */
+        template<typename TCallback>
+        void forEachLog(TCallback &&callback) const;
         
         [[nodiscard]] std::string_view toStringView(Severity severity) const;
         
@@ -139,15 +163,47 @@ namespace debug
         
         void setOutputFlag(OutputSourceFlag flag);
         
+        /**
+         * @brief Only applies to messages below a warning.
+         */
+        void setOverflowPolicy(OverflowPolicy policy);
+        
+        /**
+         * @brief Blocks until every message logged before this call has been written out.
+         */
+        void flush();
+        
     protected:
+        void push(const char file[], int line, Severity severity, std::string_view message, OverflowPolicy policy);
+        void writerLoop();
+        void write(const LogRecord &record);
         void logToConsole(std::string_view message) const;
-        void logToFile(std::string_view message) const;
+        void logToFile(std::string_view message);
         void logToQueue(std::string_view message, const char file[], int line, Severity severity);
     protected:
         Severity throwLevel { Severity_Major };
-        OutputSourceFlag sources { OutputSourceFlag_File | OutputSourceFlag_IoStream | OutputSourceFlag_Queue };
+        std::atomic<OutputSourceFlag> sources { OutputSourceFlag_File | OutputSourceFlag_IoStream | OutputSourceFlag_Queue };
+        std::atomic<OverflowPolicy> mOverflowPolicy { OverflowPolicy_Block };
         std::string_view fileName = "log.txt";
-        std::vector<Message> messages;
+        
+        // Only the writer thread touches the file.
+        std::ofstream mFile;
+        
+        LogRingBuffer mRingBuffer;
+        std::atomic<uint64_t> mPushedCount { 0 };
+        std::atomic<uint64_t> mWrittenCount { 0 };
+        std::atomic<uint64_t> mDroppedCount { 0 };
+        
+        static constexpr uint64_t wakeThreshold = LogRingBuffer::capacity / 8;
+        std::thread mWriterThread;
+        std::mutex mWriterMutex;
+        std::condition_variable mWriterCondition;
+        std::condition_variable mFlushCondition;
+        bool mShouldTerminate { false };
+        
+        static constexpr size_t historyCapacity = 2048;
+        std::deque<Message> messages;
+        mutable std::mutex mMessagesMutex;
         
         std::set<uint64_t> blackList { 131185, 131218 };
         
@@ -200,6 +256,14 @@ namespace debug
         }
     };
     
+    template<typename TCallback>
+    void Logger::forEachLog(TCallback &&callback) const
+    {
+        const std::lock_guard lock(mMessagesMutex);
+        for (auto it = messages.rbegin(); it != messages.rend(); ++it)
+            callback(*it);
+    }
+    
     template<glm::length_t L, typename T, glm::qualifier Q>
     void Logger::log(const char *file, int line, Severity severity, const glm::vec<L, T, Q> &message)
     {
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "Pch.h"
+#include "Profiler.h"
 
 
 namespace debug
@@ -43,9 +44,13 @@ namespace debug
     #define PROFILE_FUNC() const debug::ProfileTimer CONCAT(debugProfileTimer, __LINE__)(__FUNCTION__)
     #define PROFILE_SCOPE_BEGIN(id, name) debug::ProfileTimer id(name)
     #define PROFILE_SCOPE_END(name) name.stop();
+    #define PROFILE_COUNTER(name, value) profiler->setCounter(name, static_cast<long long>(value))
+    #define PROFILE_THREAD(name) profiler->setThreadName(name)
 #else
     #define PROFILE_FUNC_NAMED(name)
     #define PROFILE_FUNC()
     #define PROFILE_SCOPE_BEGIN(id, name)
     #define PROFILE_SCOPE_END(name)
+    #define PROFILE_COUNTER(name, value)
+    #define PROFILE_THREAD(name)
 #endif
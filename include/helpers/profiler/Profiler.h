@@ -7,7 +7,10 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <fstream>
+#include <mutex>
 #include "Pch.h"
 
 
@@ -23,7 +26,7 @@ namespace debug
         long long stopNanoSeconds;
         uint32_t threadId;
     };
-    
+
     struct ProfileNode
     {
         uint64_t id;
@@ -31,9 +34,77 @@ namespace debug
         long long startNanoSeconds;
         long long stopNanoSeconds;
         std::vector<ProfileNode> children;
-        
+
         bool tryInsert(ProfileResult result);
     };
+
+    /**
+     * @brief The profile tree of a single thread.
+     */
+    struct ProfileThread
+    {
+        uint32_t threadId;
+        std::string name;
+        std::vector<ProfileNode> nodes;
+    };
+
+    struct ProfileCounter
+    {
+        std::string_view name;
+        long long value;
+        long long timeNanoSeconds;
+    };
+
+    /**
+     * @brief A single producer, single consumer ring buffer. The owning thread pushes results and
+     * the main thread drains them once per frame. Results are dropped when the buffer is full.
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class ProfileBuffer
+    {
+    public:
+        static constexpr uint32_t capacity = 8192;  // Must be a power of two.
+
+        explicit ProfileBuffer(uint32_t threadId);
+
+        bool push(const ProfileResult &result);
+
+        template<typename TCallback>
+        void drain(TCallback &&callback);
+
+        [[nodiscard]] uint32_t threadId() const { return mThreadId; }
+        [[nodiscard]] uint64_t takeDroppedCount() { return mDroppedCount.exchange(0, std::memory_order_relaxed); }
+
+    protected:
+        std::array<ProfileResult, capacity> mResults { };
+        alignas(64) std::atomic<uint64_t> mHead { 0 };  // Written by the producer.
+        alignas(64) std::atomic<uint64_t> mTail { 0 };  // Written by the consumer.
+        std::atomic<uint64_t> mDroppedCount { 0 };
+        uint32_t mThreadId;
+    };
+
+    template<typename TCallback>
+    void ProfileBuffer::drain(TCallback &&callback)
+    {
+        const uint64_t head = mHead.load(std::memory_order_acquire);
+        uint64_t tail = mTail.load(std::memory_order_relaxed);
+        for (; tail != head; ++tail)
+            callback(mResults[tail & (capacity - 1)]);
+        mTail.store(tail, std::memory_order_release);
+    }
+
+    /**
+     * @brief Every thread's buffer. Threads share ownership of it so that they can hand their buffer back when they
+     * exit, even if the profiler has already gone. Returned buffers are given to the next thread that needs one.
+     */
+    struct ProfileBufferPool
+    {
+        std::vector<std::unique_ptr<ProfileBuffer>> buffers;
+        std::vector<ProfileBuffer*> freeBuffers;
+        std::unordered_map<uint32_t, std::string> threadNames;
+        std::mutex mutex;
+    };
 }
 
 /**
@@ -43,26 +114,56 @@ namespace debug
 class Profiler
 {
 public:
+    Profiler();
     ~Profiler();
+
+    /**
+     * @brief Records a result into the calling thread's buffer. Safe to call from any thread.
+     * The thread id of the result is filled in by the profiler.
+     */
     void addResult(const debug::ProfileResult &result);
+
+    /**
+     * @brief Sets the value of a named counter for this frame. Setting the same counter twice overrides the first value.
+     * @param name Must outlive the profiler (a string literal).
+     */
+    void setCounter(std::string_view name, long long value);
+
+    /**
+     * @brief Names the calling thread in the profiler viewer and in snapshots.
+     */
+    void setThreadName(const std::string &name);
     uint64_t getNewId();
+
+    /**
+     * @brief Merges every thread's buffer. Must be called from the main thread.
+     */
     void updateAndClear();
-    
+
     [[nodiscard]] bool isFrozen() const;
     void setFreeze(bool isFrozen);
     void setUpdateRate(float updateRate);
-    [[nodiscard]] const std::vector<debug::ProfileNode> &getTree() const;
+    [[nodiscard]] const std::vector<debug::ProfileThread> &getTree() const;
+    [[nodiscard]] const std::vector<debug::ProfileCounter> &getCounters() const;
 
     void beginSnapshot(const std::string &filePath);
     void endSnapshot();
 
 protected:
+    debug::ProfileBuffer &getThreadBuffer();
+    std::string getThreadName(uint32_t threadId);
+    void mergeThreadBuffers();
     void writeProfile(const debug::ProfileResult &result);
+    void writeCounter(const debug::ProfileCounter &counter);
+    void writeThreadName(uint32_t threadId, const std::string &name);
     void createTree();
 
     std::vector<debug::ProfileResult> mResults { };
     std::vector<debug::ProfileResult> mSnapshotResults { };
-    std::vector<debug::ProfileNode> mTree { };
+    std::vector<debug::ProfileThread> mTree { };
+    std::vector<debug::ProfileCounter> mCounters { };
+    std::vector<debug::ProfileCounter> mSnapshotCounters { };
+    std::vector<debug::ProfileCounter> mCounterView { };
     std::ofstream mOutputSteam;
     float mUpdateRate { 0.1f };
     float mTimer { 0.f };
@@ -70,7 +171,9 @@ protected:
     uint64_t mProfileCount { 0 };
     std::string mSnapshotFilePath;
     bool mIsRecordingSnapshot { false };
-    
-    uint64_t mId { 0 };
-};
 
+    std::shared_ptr<debug::ProfileBufferPool> mBufferPool { std::make_shared<debug::ProfileBufferPool>() };
+    std::mutex mCountersMutex;
+
+    std::atomic<uint64_t> mId { 0 };
+};
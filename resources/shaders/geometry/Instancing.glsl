@@ -0,0 +1,32 @@
+// Model matrices of every instance drawn this pass. Written by the InstanceBatcher.
+layout(binding = 4, std430)
+readonly buffer InstanceBlock
+{
+    mat4 models[];
+};
+
+// One for each command of the pass's multi-draws. Must match graphics::DrawData.
+struct DrawData
+{
+    uint instanceOffset;  // Where the draw starts in models.
+    uint materialIndex;
+};
+
+layout(binding = 10, std430)
+readonly buffer DrawBlock
+{
+    DrawData draws[];
+};
+
+// Where the current multi-draw starts in draws.
+uniform int u_draw_offset;
+
+DrawData currentDraw()
+{
+    return draws[u_draw_offset + gl_DrawID];
+}
+
+mat4 instanceModelMatrix()
+{
+    return models[currentDraw().instanceOffset + gl_InstanceID];
+}
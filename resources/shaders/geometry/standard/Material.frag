@@ -2,13 +2,7 @@
 
 #include "PoolSampling.glsl"
 #include "../GBuffer.glsl"
-#include "GeometryData.glsl"
-
-layout(binding = 1, std430)
-buffer MaterialBuffer
-{
-    LayerData material;
-};
+#include "MaterialTable.glsl"
 
 in vec2 v_uv;
 in vec3 v_position_ws;
@@ -21,6 +15,9 @@ void main()
 {
     GBuffer gBuffer = gBufferCreate();
 
+    // Only the first layer is read as that's the only one we can safely use.
+    const LayerData material = materialLayer(0);
+
     const vec2 coordinates = v_uv * material.uvScaling;
     if (material.metallicTextureIndex == -1)
     {
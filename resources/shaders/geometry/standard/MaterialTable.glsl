@@ -0,0 +1,62 @@
+#version 460 core
+
+#include "GeometryData.glsl"
+
+// Where a material lives in the packed arrays. Must match graphics::MaterialEntry.
+struct MaterialEntry
+{
+    uint layerOffset;
+    uint layerCount;
+    uint maskOffset;
+    uint maskCount;
+    uint textureOffset;
+    uint textureCount;
+};
+
+// Every live material in the scene. Only rewritten when a material changes.
+layout(binding = 1, std430)
+readonly buffer LayerTable
+{
+    LayerData layerTable[];
+};
+
+layout(binding = 2, std430)
+readonly buffer TextureTable
+{
+    TextureData textureTable[];
+};
+
+layout(binding = 3, std430)
+readonly buffer MaskTable
+{
+    MaskData maskTable[];
+};
+
+layout(binding = 5, std430)
+readonly buffer MaterialEntryTable
+{
+    MaterialEntry materialEntries[];
+};
+
+// The material of the current draw. Fetched by the vertex shader since gl_DrawID only exists there.
+in flat uint v_material_index;
+
+MaterialEntry currentMaterial()
+{
+    return materialEntries[v_material_index];
+}
+
+LayerData materialLayer(uint index)
+{
+    return layerTable[currentMaterial().layerOffset + index];
+}
+
+MaskData materialMask(uint index)
+{
+    return maskTable[currentMaterial().maskOffset + index];
+}
+
+TextureData materialTexture(int index)
+{
+    return textureTable[currentMaterial().textureOffset + uint(index)];
+}
@@ -2,21 +2,7 @@
 
 #include "PoolSampling.glsl"
 #include "../GBuffer.glsl"
-#include "GeometryData.glsl"
-
-layout(binding = 1, std430)
-buffer MaterialData
-{
-    LayerData[] layers;
-};
-
-// binding 2 is in PoolSampling.glsl as it is shared with Material.frag
-
-layout(binding = 3, std430)
-buffer MaskDataArray
-{
-    MaskData[] masks;
-};
+#include "MaterialTable.glsl"
 
 in vec2 v_uv;
 in vec3 v_position_ws;
@@ -51,7 +37,7 @@ void main()
 {
     GBuffer gBuffer = gBufferCreate();
 
-    LayerData material = layers[0];
+    LayerData material = materialLayer(0);
 
     const vec2 coordinates = v_uv * material.uvScaling;
     if (material.metallicTextureIndex == -1)
@@ -88,10 +74,11 @@ void main()
     gBuffer.refractiveIndex = sampleValue(material.refractiveIndex, coordinates, material.refractiveIndexTextureIndex);
 
     // There should be one less mask that there are layers. If not, we can just skip them.
-    for (int i = 0; i < min(layers.length() - 1, masks.length()); ++i)
+    const MaterialEntry entry = currentMaterial();
+    for (uint i = 0; i < min(entry.layerCount - 1, entry.maskCount); ++i)
     {
-        const LayerData material = layers[i + 1];
-        const MaskData mask = masks[i];
+        const LayerData material = materialLayer(i + 1);
+        const MaskData mask = materialMask(i);
         const float textureValue = sampleMask(v_uv, mask.textureIndex).r;
         const vec2 coordinates = v_uv * material.uvScaling;
 
@@ -1,22 +1,16 @@
 #version 460 core
 
-#include "GeometryData.glsl"
+#include "MaterialTable.glsl"
 #include "../../Colour.glsl"
 
 layout(binding = 0) uniform sampler2DArray textures;
 
-layout(binding = 2, std430)
-buffer TextureDataArray
-{
-    TextureData[] textureData;
-};
-
 float sampleMask(vec2 uv, int index)
 {
     if (index == -1)
         return 1.f;
 
-    TextureData data = textureData[index];
+    TextureData data = materialTexture(index);
     const vec2 maxDimensions = textureSize(textures, 0).xy;
 
     if (data.wrapOp == WRAP_REPEAT)
@@ -33,7 +27,7 @@ vec4 sampleTexture(vec2 uv, int index)
     if (index == -1)
         return vec4(vec3(0.f), 1.f);
 
-    TextureData data = textureData[index];
+    TextureData data = materialTexture(index);
 
     if (data.wrapOp == WRAP_REPEAT)
         uv = fract(uv);
@@ -1,14 +1,23 @@
 #version 460
 
+#if !defined(INSTANCED)
+    #define INSTANCED 0
+#endif
+
 #include "../../interfaces/CameraBlock.h"
+#include "../Instancing.glsl"
 
 layout(location=0) in vec3 a_position;
 layout(location=1) in vec2 a_uv;
 layout(location=2) in vec3 a_normal;
 layout(location=3) in vec3 a_tangent;
 
-uniform mat4 u_mvp_matrix;
-uniform mat4 u_model_matrix;
+#if INSTANCED > 0
+    uniform mat4 u_vp_matrix;
+#else
+    uniform mat4 u_mvp_matrix;
+    uniform mat4 u_model_matrix;
+#endif
 
 out vec2 v_uv;
 out vec3 v_position_ws;
@@ -16,10 +25,22 @@ out vec3 v_normal_ws;
 out flat mat3 v_tbn_matrix;
 out vec3 v_camera_position_ts;
 out vec3 v_position_ts;
+#if INSTANCED > 0
+    out flat uint v_material_index;
+#endif
+
+// The depth pre-pass relies on this shader writing exactly the same depth in every program it's linked into.
+invariant gl_Position;
 
 void main()
 {
+#if INSTANCED > 0
+    const mat4 u_model_matrix = instanceModelMatrix();
+    v_material_index = currentDraw().materialIndex;
+    gl_Position = u_vp_matrix * u_model_matrix * vec4(a_position, 1.f);
+#else
     gl_Position = u_mvp_matrix * vec4(a_position, 1.f);
+#endif
 
     v_uv = a_uv;
     v_normal_ws = normalize(vec3(u_model_matrix * vec4(a_normal, 0.f)));
@@ -0,0 +1,121 @@
+/**
+ * @file ClusteredLights.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+// The view frustum is split into X by Y tiles on screen and Z exponential slices in depth.
+#define CLUSTER_COUNT_X 16
+#define CLUSTER_COUNT_Y 9
+#define CLUSTER_COUNT_Z 24
+
+// Each tile gathers its clusters' lights into a bit mask, so this is the most of each type that can be shaded.
+#define CLUSTER_MAX_LIGHTS 1024
+
+#define CLUSTER_RANGE_BINDING 6
+#define CLUSTER_LIGHT_INDEX_BINDING 7
+#define CLUSTER_POINT_LIGHT_BINDING 8
+#define CLUSTER_SPOTLIGHT_BINDING 9
+
+#ifdef GRAPHICS_INTERFACE
+
+#include "Pch.h"
+#include <glm.hpp>
+
+/**
+ * @brief Where a cluster's lights are in the index list. Point light indices come first, then spotlight indices.
+ */
+struct ClusterRange
+{
+    uint32_t offset;
+    uint32_t pointLightCount;
+    uint32_t spotlightCount;
+    uint32_t padding;
+};
+
+struct ClusteredPointLight
+{
+    glm::vec4 positionInvSqrRadius;  // w: 1 / radius^2
+    glm::vec4 intensityZFar;         // w: the shadow map's far plane.
+    glm::vec2 bias;
+    float softnessRadius;
+    float padding;
+    uint64_t shadowMap;              // Bindless handle of the shadow cubemap.
+    uint64_t padding1;
+};
+
+struct ClusteredSpotlight
+{
+    glm::mat4 vpMatrix;
+    glm::vec4 positionInvSqrRadius;  // w: 1 / radius^2
+    glm::vec4 directionZFar;         // w: the shadow map's far plane.
+    glm::vec4 intensityAngleScale;   // w: angle scale.
+    glm::vec2 bias;
+    float angleOffset;
+    float padding;
+    uint64_t shadowMap;              // Bindless handle of the shadow map.
+    uint64_t padding1;
+};
+
+#else
+
+struct ClusterRange
+{
+    uint offset;
+    uint pointLightCount;
+    uint spotlightCount;
+    uint padding;
+};
+
+struct ClusteredPointLight
+{
+    vec4 positionInvSqrRadius;
+    vec4 intensityZFar;
+    vec2 bias;
+    float softnessRadius;
+    float padding;
+    uvec2 shadowMap;
+    uvec2 padding1;
+};
+
+struct ClusteredSpotlight
+{
+    mat4 vpMatrix;
+    vec4 positionInvSqrRadius;
+    vec4 directionZFar;
+    vec4 intensityAngleScale;
+    vec2 bias;
+    float angleOffset;
+    float padding;
+    uvec2 shadowMap;
+    uvec2 padding1;
+};
+
+layout(binding = CLUSTER_RANGE_BINDING, std430)
+readonly buffer ClusterRangeTable
+{
+    ClusterRange clusterRanges[];
+};
+
+layout(binding = CLUSTER_LIGHT_INDEX_BINDING, std430)
+readonly buffer ClusterLightIndexTable
+{
+    uint clusterLightIndices[];
+};
+
+layout(binding = CLUSTER_POINT_LIGHT_BINDING, std430)
+readonly buffer ClusteredPointLightTable
+{
+    ClusteredPointLight clusteredPointLights[];
+};
+
+layout(binding = CLUSTER_SPOTLIGHT_BINDING, std430)
+readonly buffer ClusteredSpotlightTable
+{
+    ClusteredSpotlight clusteredSpotlights[];
+};
+
+#endif
@@ -1,14 +1,16 @@
 #version 460
 
+#include "../geometry/Instancing.glsl"
+
 layout(location=0) in vec3 a_position;
 
-uniform mat4 u_model_matrix;
-uniform mat4 u_mvp_matrix;
+uniform mat4 u_vp_matrix;
 
 out vec3 v_position;
 
 void main()
 {
-    v_position = (u_model_matrix * vec4(a_position, 1.f)).xyz;
-    gl_Position = u_mvp_matrix * vec4(a_position, 1.f);
+    const vec4 position_ws = instanceModelMatrix() * vec4(a_position, 1.f);
+    v_position = position_ws.xyz;
+    gl_Position = u_vp_matrix * position_ws;
 }
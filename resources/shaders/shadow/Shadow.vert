@@ -1,10 +1,12 @@
 #version 460
 
+#include "../geometry/Instancing.glsl"
+
 layout(location=0) in vec3 a_position;
 
-uniform mat4 u_mvp_matrix;
+uniform mat4 u_vp_matrix;
 
 void main()
 {
-    gl_Position = u_mvp_matrix * vec4(a_position, 1.f);
+    gl_Position = u_vp_matrix * instanceModelMatrix() * vec4(a_position, 1.f);
 }
\ No newline at end of file
@@ -23,6 +23,32 @@ namespace engine
     
     }
 
+    Actor::~Actor()
+    {
+        for (Resource<Component> &component : mComponents)
+            unregisterComponent(component.get());
+        for (Resource<Component> &component : mComponentsToAdd)
+            unregisterComponent(component.get());
+    }
+
+    void Actor::registerComponent(const Ref<Component> &component)
+    {
+        if (mScene != nullptr)
+            mScene->mComponentRegistry.add(component);
+    }
+
+    void Actor::registerComponents()
+    {
+        if (mScene != nullptr)
+            mScene->registerComponents(this);
+    }
+
+    void Actor::unregisterComponent(Component *component)
+    {
+        if (mScene != nullptr)
+            mScene->mComponentRegistry.remove(component);
+    }
+
     void Actor::awake()
     {
         try
@@ -83,13 +109,60 @@ namespace engine
             
             if (changedFlag)
                 updateTransform();
+
+            if (ImGui::BeginCombo("Mobility", graphics::to_string(mMobility)))
+            {
+                for (const graphics::Mobility mobility : { graphics::Mobility::Static, graphics::Mobility::Movable })
+                {
+                    if (ImGui::Selectable(graphics::to_string(mobility), mobility == mMobility))
+                        setMobility(mobility);
+                }
+                ImGui::EndCombo();
+            }
+            ui::drawToolTip("Static actors are cached in the shadow maps of static lights.");
         }
         ImGui::PopID();
     }
     
     void Actor::updateTransform()
     {
+        if (position == mBuiltPosition && rotation == mBuiltRotation && scale == mBuiltScale)
+            return;
+
+        mBuiltPosition = position;
+        mBuiltRotation = rotation;
+        mBuiltScale = scale;
         mTransform = glm::translate(glm::mat4(1.f), position) *  glm::mat4_cast(rotation) * glm::scale(glm::mat4(1.f), scale);
+        markTransformDirty();
+    }
+
+    void Actor::setLocalTransform(const glm::mat4 &transform)
+    {
+        mTransform = transform;
+        math::decompose(mTransform, position, rotation, scale);
+
+        // The matrix is kept as is rather than being rebuilt from the decomposed parts.
+        mBuiltPosition = position;
+        mBuiltRotation = rotation;
+        mBuiltScale = scale;
+    }
+
+    void Actor::markTransformDirty()
+    {
+        if (mIsWorldTransformDirty)
+            return;  // Our children must already be dirty.
+
+        mIsWorldTransformDirty = true;
+        if (mScene == nullptr)
+            return;
+
+        markStaticSetChanged();
+
+        for (const UUID childId : mChildren)
+        {
+            if (Ref<Actor> child = mScene->getActor(childId, false); child.isValid())
+                child->markTransformDirty();
+        }
     }
 
     void Actor::onAwake()
@@ -102,11 +175,15 @@ namespace engine
         return mComponents;
     }
     
-    glm::mat4 Actor::getTransform() const
+    const glm::mat4 &Actor::getTransform() const
     {
-        if (mParent != nullptr)
-            return mParent->getTransform() * mTransform;
-        return mTransform;
+        if (mIsWorldTransformDirty)
+        {
+            mWorldTransform = mParent != nullptr ? mParent->getTransform() * mTransform : mTransform;
+            mIsWorldTransformDirty = false;
+        }
+
+        return mWorldTransform;
     }
     
     void Actor::markForDeath()
@@ -119,7 +196,7 @@ namespace engine
     void Actor::update()
     {
         updateTransform();
-        if (core->isInPlayMode())
+        if (isInPlayMode())
         {
             try
             {
@@ -195,12 +272,13 @@ namespace engine
         {
             mComponentsToAdd[i]->begin();
             mComponents.push_back(std::move(mComponentsToAdd[i]));
+            mIsComponentIndexDirty = true;
         }
 
         // Any components that are added from awake or begin will be processed next frame.
         mComponentsToAdd.erase(mComponentsToAdd.begin(), mComponentsToAdd.begin() + count);
 
-        if (core->isInPlayMode())
+        if (isInPlayMode())
         {
             for (auto &component : mComponents)
                 component->update();
@@ -222,12 +300,53 @@ namespace engine
             
             // We've already removed it in a previous pass.
             if (it != mComponents.end())
+            {
+                unregisterComponent(it->get());
                 mComponents.erase(it);
+                mIsComponentIndexDirty = true;
+            }
         }
         
         currentComponentDestroyBuffer->clear();
     }
     
+    const Resource<Component> *Actor::findComponent(const ComponentTypeId typeId) const
+    {
+        if (mIsComponentIndexDirty)
+            rebuildComponentIndex();
+
+        const auto it = std::lower_bound(
+            mComponentIndex.begin(), mComponentIndex.end(), typeId, [](const ComponentSlot &slot, const ComponentTypeId id) {
+                return slot.typeId < id;
+            });
+
+        if (it == mComponentIndex.end() || it->typeId != typeId)
+            return nullptr;
+
+        return it->index < mComponents.size() ? &mComponents[it->index] : &mComponentsToAdd[it->index - mComponents.size()];
+    }
+
+    void Actor::rebuildComponentIndex() const
+    {
+        mComponentIndex.clear();
+        auto addSlots = [this, index = 0u](const std::vector<Resource<Component>> &components) mutable {
+            // Components that have been moved out of mComponentsToAdd but not erased yet are skipped.
+            for (const Resource<Component> &component : components)
+            {
+                if (component.get() != nullptr)
+                    mComponentIndex.push_back({ component->getTypeId(), index });
+                ++index;
+            }
+        };
+        addSlots(mComponents);
+        addSlots(mComponentsToAdd);
+
+        std::stable_sort(mComponentIndex.begin(), mComponentIndex.end(), [](const ComponentSlot &lhs, const ComponentSlot &rhs) {
+            return lhs.typeId < rhs.typeId;
+        });
+        mIsComponentIndexDirty = false;
+    }
+
     void Actor::removeComponent(const Component *component)
     {
         if (component == nullptr)
@@ -257,7 +376,10 @@ namespace engine
             else
             {
                 // Pretend it never existed.
+                unregisterComponent(it2->get());
                 mComponentsToAdd.erase(it2);
+                mIsComponentIndexDirty = true;
+                return;
             }
         }
         
@@ -288,9 +410,9 @@ namespace engine
             }
 
             // We reset the transform to world space since we aren't connect to anything.
-            actor->mTransform = actor->getTransform();
-            math::decompose(actor->mTransform, actor->position, actor->rotation, actor->scale);
+            actor->setLocalTransform(actor->getTransform());
             actor->mParent = nullptr;
+            actor->markTransformDirty();
             mChildrenToRemove.insert(actor->getId());
         }
         else
@@ -318,11 +440,29 @@ namespace engine
     void Actor::setWorldTransform(const glm::mat4& worldTransform)
     {
         if (mParent)
-            mTransform = glm::inverse(mParent->getTransform()) * worldTransform;
+            setLocalTransform(glm::inverse(mParent->getTransform()) * worldTransform);
         else
-            mTransform = worldTransform;
+            setLocalTransform(worldTransform);
 
-        math::decompose(mTransform, position, rotation, scale);
+        markTransformDirty();
+    }
+
+    void Actor::setPosition(const glm::vec3 &newPosition)
+    {
+        position = newPosition;
+        updateTransform();
+    }
+
+    void Actor::setRotation(const glm::quat &newRotation)
+    {
+        rotation = newRotation;
+        updateTransform();
+    }
+
+    void Actor::setScale(const glm::vec3 &newScale)
+    {
+        scale = newScale;
+        updateTransform();
     }
 
     glm::vec3 Actor::getWorldPosition() const
@@ -351,6 +491,28 @@ namespace engine
     {
         return mScene;
     }
+
+    void Actor::setMobility(const graphics::Mobility mobility)
+    {
+        if (mobility == mMobility)
+            return;
+
+        // Either way the set of static actors changes.
+        mMobility = mobility;
+        if (mScene != nullptr)
+            mScene->markStaticSetChanged();
+    }
+
+    graphics::Mobility Actor::getMobility() const
+    {
+        return mMobility;
+    }
+
+    void Actor::markStaticSetChanged() const
+    {
+        if (mMobility == graphics::Mobility::Static && mScene != nullptr)
+            mScene->markStaticSetChanged();
+    }
     
     void Actor::removeComponent(const Ref<Component> &component)
     {
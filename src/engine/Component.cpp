@@ -9,8 +9,21 @@
 #include "Actor.h"
 #include <Statistics.h>
 
+#include <mutex>
+#include <typeindex>
+
 namespace engine
 {
+    ComponentTypeId componentTypeId(const std::type_info &type)
+    {
+        // Ids can be asked for from any thread.
+        static std::mutex mutex;
+        static std::unordered_map<std::type_index, ComponentTypeId> typeIds;
+        const std::lock_guard lock(mutex);
+        const auto [it, _] = typeIds.try_emplace(std::type_index(type), static_cast<ComponentTypeId>(typeIds.size()));
+        return it->second;
+    }
+
     void Component::awake()
     {
         try
@@ -69,6 +82,7 @@ namespace engine
     void Component::attachToActor(Actor *actor)
     {
         mActor = actor;
+        mTypeId = componentTypeId(typeid(*this));
     }
 
     void Component::collisionBegin(
@@ -128,6 +142,11 @@ namespace engine
         return mActor;
     }
 
+    ComponentTypeId Component::getTypeId() const
+    {
+        return mTypeId;
+    }
+
     void Component::onAwake()
     {
 
@@ -0,0 +1,49 @@
+/**
+ * @file ComponentRegistry.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "ComponentRegistry.h"
+
+namespace engine
+{
+    void ComponentRegistry::add(const Ref<Component> &component)
+    {
+        Component *const pointer = component.get();
+        if (pointer->mRegistryIndex != std::numeric_limits<uint32_t>::max())
+            return;  // Already registered.
+
+        const ComponentTypeId typeId = pointer->getTypeId();
+        if (typeId >= mComponents.size())
+            mComponents.resize(typeId + 1);
+
+        std::vector<Ref<Component>> &components = mComponents[typeId];
+        pointer->mRegistryIndex = static_cast<uint32_t>(components.size());
+        components.push_back(component);
+    }
+
+    void ComponentRegistry::remove(Component *component)
+    {
+        const uint32_t index = component->mRegistryIndex;
+        if (index == std::numeric_limits<uint32_t>::max())
+            return;
+
+        std::vector<Ref<Component>> &components = mComponents[component->getTypeId()];
+        if (index + 1 != components.size())
+        {
+            components[index] = components.back();
+            components[index].get()->mRegistryIndex = index;
+        }
+        components.pop_back();
+        component->mRegistryIndex = std::numeric_limits<uint32_t>::max();
+    }
+
+    const std::vector<Ref<Component>> &ComponentRegistry::getComponents(const ComponentTypeId typeId) const
+    {
+        if (typeId >= mComponents.size())
+            return mEmpty;
+        return mComponents[typeId];
+    }
+} // engine
@@ -10,6 +10,7 @@
 #include <alext.h>
 #include <AL/alext.h>
 
+#include "AudioStream.h"
 #include "Camera.h"
 #include "Scene.h"
 #include "WindowHelpers.h"
@@ -30,6 +31,7 @@
 #include "ComponentSerializer.h"
 #include "FileExplorer.h"
 #include "Loader.h"
+#include "Shader.h"
 
 namespace engine
 {
@@ -45,6 +47,13 @@ namespace engine
         eventHandler = &mEventHandler;
         core = this;
 
+        mThreadPool = std::make_unique<load::ThreadPool>();
+        threadPool = mThreadPool.get();
+        graphics::setShaderJobScheduler([pool = mThreadPool.get()](std::function<void()> job) -> std::function<void()> {
+            const load::JobHandle handle = pool->schedule(std::move(job));
+            return [pool, handle] { pool->wait(handle); };
+        });
+
         mResourcePool = std::make_unique<ResourcePool>();
         resourcePool = mResourcePool.get();
 
@@ -279,6 +288,10 @@ namespace engine
     
     Core::~Core()
     {
+        // Jobs can touch the resource pool and the logger, so no worker can be running by the time they're destroyed.
+        mThreadPool->stop();
+        graphics::setShaderJobScheduler(nullptr);
+
         // Should be calling scene cleanup.
         mScene.reset();
 
@@ -338,6 +351,7 @@ namespace engine
             mEditor->update();
 
             mResourcePool->update();  // Calls material onPreRender() function.
+            AudioStream::updateAll();
             mEditor->preRender();
             mScene->preRender();
             mPhysics->renderDebugShapes();
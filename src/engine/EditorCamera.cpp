@@ -128,6 +128,10 @@ void EditorCamera::onDrawUi()
     ImGui::Begin("Renderer Settings", &showCameraSettings);
     if (ImGui::Checkbox("Use Uber variant for tile classification?", &mUseUberVariant))
         graphics::renderer->setUseUberVariant(mUseUberVariant);
+    if (ImGui::Checkbox("Use clustered point lights and spotlights?", &mUseClusteredLighting))
+        graphics::renderer->setUseClusteredLighting(mUseClusteredLighting);
+    if (ImGui::Checkbox("Use a depth pre-pass?", &mUseDepthPrepass))
+        graphics::renderer->setUseDepthPrepass(mUseDepthPrepass);
 
     if (ImGui::CollapsingHeader("Camera Details"))
     {
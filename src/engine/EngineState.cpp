@@ -6,6 +6,7 @@
 
 
 #include "EngineState.h"
+#include "Core.h"
 #include "Logger.h"
 
 namespace engine
@@ -16,6 +17,12 @@ namespace engine
     Serializer *serializer;
     ResourcePool *resourcePool;
     PhysicsCore *physicsSystem;
+    load::ThreadPool *threadPool;
+    
+    bool isInPlayMode()
+    {
+        return core != nullptr && core->isInPlayMode();
+    }
     
     void GLAPIENTRY forwardOpenGlCallback(
         GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar *message,
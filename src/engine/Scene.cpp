@@ -7,24 +7,36 @@
 
 #include "Scene.h"
 
+#include <atomic>
+
 #include "Core.h"
 #include "EngineState.h"
+#include "GraphicsState.h"
 #include "imgui.h"
 #include "WindowHelpers.h"
 #include "ProfileTimer.h"
 
 namespace engine
 {
+    namespace
+    {
+        std::atomic<uint64_t> lastStaticGeneration { 0 };
+    }
+
     void Scene::update()
     {
         PROFILE_FUNC();
         onUpdate();
         
+        // The actor is moved over before begin() so that destroying it from there is deferred like any other actor.
         for (int i = 0; i <mToAdd.size(); ++i)
         {
-            if (core->isInPlayMode())
-                mToAdd[i]->begin();
+            Actor *actor = mToAdd[i].get();
+            mActorIndex[actor->getId()] = ActorSlot { static_cast<uint32_t>(mActors.size()), false };
             mActors.push_back(std::move(mToAdd[i]));
+            actor->markStaticSetChanged();
+            if (isInPlayMode())
+                actor->begin();
         }
         mToAdd.clear();
 
@@ -37,13 +49,14 @@ namespace engine
         else
             mToDestroy = &mDestroyBuffer0;
         
+        // Anything destroyed while the removed actors go out of scope ends up in the other buffer.
         for (const Actor *actor : *currentDestroyBuffer)
         {
-            const auto it = std::find_if(mActors.begin(), mActors.end(), [&actor](const Ref<Actor> &left) {
-                return left.get() == actor;
-            });
-
-            mActors.erase(it);
+            const auto it = mActorIndex.find(actor->getId());
+            if (it == mActorIndex.end() || it->second.isPending)
+                continue;
+            
+            removeActorAt(it->second);
         }
         
         currentDestroyBuffer->clear();
@@ -84,6 +97,10 @@ namespace engine
     void Scene::preRender()
     {
         PROFILE_FUNC();
+        resolveTransforms();
+
+        graphics::renderer->setStaticGeneration(mStaticGeneration);
+
         for (auto &actor : mActors)
         {
             for (auto &component : actor->getComponents())
@@ -93,25 +110,26 @@ namespace engine
         onPreRender();
     }
     
+    void Scene::resolveTransforms()
+    {
+        PROFILE_FUNC_NAMED("Resolve Transforms");
+        // Only dirty actors are recomputed. A child asks for its parent's transform first so each is done once.
+        for (auto &actor : mActors)
+            static_cast<void>(actor->getTransform());
+    }
+    
     void Scene::destroy(const Actor* actor)
     {
-        const auto it = std::find_if(mActors.begin(), mActors.end(), [&actor](const Ref<Actor> &left) {
-            return left.get() == actor;
-        });
+        const auto it = mActorIndex.find(actor->getId());
+        if (it == mActorIndex.end())
+        {
+            WARN("Actor % does not exist in this scene and so it cannot be removed.", actor->getName());
+            return;
+        }
         
-        if (it == mActors.end())
+        if (it->second.isPending)
         {
-            const auto it2 = std::find_if(mToAdd.begin(), mToAdd.end(), [&actor](const Ref<Actor> &left) {
-                return left.get() == actor;
-            });
-            
-            if (it2 == mToAdd.end())
-            {
-                WARN("Actor % does not exist in this scene and so it cannot be removed.", actor->getName());
-                return;
-            }
-
-            mToAdd.erase(it2);  // Pretend that it didn't exist to begin with.
+            removeActorAt(it->second);  // Pretend that it didn't exist to begin with.
             return;
         }
         
@@ -123,16 +141,10 @@ namespace engine
 
     Ref<Actor> Scene::getActor(const UUID actorId, const bool warn) const
     {
-        for (const auto & actor : mActors)
+        if (const auto it = mActorIndex.find(actorId); it != mActorIndex.end())
         {
-            if (actor->getId() == actorId)
-                return actor;
-        }
-
-        for (const auto & actor : mToAdd)
-        {
-            if (actor->getId() == actorId)
-                return actor;
+            const ActorSlot slot = it->second;
+            return slot.isPending ? mToAdd[slot.index] : mActors[slot.index];
         }
 
         if (warn)
@@ -140,4 +152,75 @@ namespace engine
 
         return Ref<Actor>();
     }
+
+    void Scene::changeActorId(Actor *actor, const UUID newId)
+    {
+        const auto it = mActorIndex.find(actor->getId());
+        if (it == mActorIndex.end())
+        {
+            actor->mId = newId;
+            return;
+        }
+
+        if (newId == actor->getId())
+            return;
+
+        if (mActorIndex.count(newId) > 0)
+        {
+            WARN("Actor % cannot take the ID % since another actor in the scene already has it. It keeps %.", actor->getName(), newId, actor->getId());
+            return;
+        }
+
+        const ActorSlot slot = it->second;
+        mActorIndex.erase(it);
+        actor->mId = newId;
+        mActorIndex.try_emplace(newId, slot);
+    }
+
+    void Scene::indexActor(Actor *actor, const ActorSlot slot)
+    {
+        while (!mActorIndex.try_emplace(actor->getId(), slot).second)
+        {
+            const UUID newId = random::generateId();
+            WARN("Actor % has the same ID as another actor in the scene (%). It has been given the ID %.", actor->getName(), actor->getId(), newId);
+            actor->mId = newId;
+        }
+    }
+
+    void Scene::registerComponents(Actor *actor)
+    {
+        for (const Resource<Component> &component : actor->mComponents)
+            mComponentRegistry.add(component);
+        for (const Resource<Component> &component : actor->mComponentsToAdd)
+            mComponentRegistry.add(component);
+    }
+
+    Resource<Actor> Scene::removeActorAt(const ActorSlot slot)
+    {
+        std::vector<Resource<Actor>> &actors = slot.isPending ? mToAdd : mActors;
+
+        Resource<Actor> removed = std::move(actors[slot.index]);
+        mActorIndex.erase(removed->getId());
+        if (!slot.isPending)
+            removed->markStaticSetChanged();
+
+        if (slot.index + 1 != actors.size())
+        {
+            actors[slot.index] = std::move(actors.back());
+            mActorIndex[actors[slot.index]->getId()] = slot;
+        }
+        actors.pop_back();
+
+        return removed;
+    }
+
+    void Scene::markStaticSetChanged()
+    {
+        mStaticGeneration = ++lastStaticGeneration;
+    }
+
+    uint64_t Scene::getStaticGeneration() const
+    {
+        return mStaticGeneration;
+    }
 }
@@ -25,15 +25,27 @@ namespace engine
         alSourcei(mId, AL_BUFFER, static_cast<ALint>(mBuffer->id()));
     }
 
+    AudioSource::AudioSource(std::unique_ptr<AudioStream> audioStream)
+        : mStream(std::move(audioStream))
+    {
+        alGenSources(1, &mId);
+        mStream->bind(mId);
+    }
+
     AudioSource::~AudioSource()
     {
+        // The stream has to give its buffers back before the source goes.
+        mStream.reset();
         if (mId != 0)
             alDeleteSources(1, &mId);
     }
 
     void AudioSource::play() const
     {
-        alSourcePlay(mId);
+        if (mStream)
+            mStream->play();
+        else
+            alSourcePlay(mId);
     }
 
     void AudioSource::setPosition(const glm::vec3 &position)
@@ -51,6 +63,8 @@ namespace engine
 
     std::filesystem::path AudioSource::getPath() const
     {
+        if (mStream)
+            return mStream->getPath();
         if (mBuffer)
             return mBuffer->getPath();
         return "";
@@ -0,0 +1,255 @@
+/**
+ * @file AudioStream.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "AudioStream.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "EngineState.h"
+#include "Logger.h"
+#include "LoggerMacros.h"
+#include "ProfileTimer.h"
+#include "ThreadPool.h"
+
+#define STB_VORBIS_HEADER_ONLY
+#include <stb_vorbis.c>
+
+namespace engine
+{
+    namespace
+    {
+        // Anything shorter than this is a sound effect and is decoded in one go so that it can be shared.
+        constexpr float streamingThreshold = 10.f;
+
+        std::vector<AudioStream*> &activeStreams()
+        {
+            static std::vector<AudioStream*> streams;
+            return streams;
+        }
+    }
+
+    AudioStream::State::~State()
+    {
+        if (decoder != nullptr)
+            stb_vorbis_close(decoder);
+    }
+
+    AudioStream::AudioStream(const std::filesystem::path &path)
+        : mPath(path), mState(std::make_shared<State>())
+    {
+        int error = 0;
+        mState->decoder = stb_vorbis_open_filename(path.string().c_str(), &error, nullptr);
+        if (mState->decoder == nullptr)
+        {
+            WARN("Failed to open % for streaming (%)", path, error);
+            return;
+        }
+
+        const stb_vorbis_info info = stb_vorbis_get_info(mState->decoder);
+        mChannels = info.channels;
+        mSampleRate = static_cast<int>(info.sample_rate);
+
+        mBuffers.resize(bufferCount);
+        alGenBuffers(static_cast<ALsizei>(mBuffers.size()), mBuffers.data());
+        mFreeBuffers = mBuffers;
+
+        const uint64_t chunkSize = chunkFrameCount * mChannels * sizeof(short);
+        mMemoryUsage = info.setup_memory_required + info.temp_memory_required + chunkSize * bufferCount;
+
+        activeStreams().push_back(this);
+    }
+
+    AudioStream::~AudioStream()
+    {
+        std::vector<AudioStream*> &streams = activeStreams();
+        streams.erase(std::remove(streams.begin(), streams.end(), this), streams.end());
+
+        // The source may still have buffers queued, and OpenAL won't delete those.
+        if (mSourceId != 0)
+        {
+            alSourceStop(mSourceId);
+            alSourcei(mSourceId, AL_BUFFER, 0);
+        }
+
+        if (!mBuffers.empty())
+            alDeleteBuffers(static_cast<ALsizei>(mBuffers.size()), mBuffers.data());
+    }
+
+    bool AudioStream::shouldStream(const std::filesystem::path &path)
+    {
+        if (path.extension() != ".ogg")
+            return false;
+
+        int error = 0;
+        stb_vorbis *decoder = stb_vorbis_open_filename(path.string().c_str(), &error, nullptr);
+        if (decoder == nullptr)
+            return false;
+
+        const float length = stb_vorbis_stream_length_in_seconds(decoder);
+        stb_vorbis_close(decoder);
+        return length > streamingThreshold;
+    }
+
+    bool AudioStream::decodeChunk(stb_vorbis *decoder, const int channels, std::vector<short> &samples)
+    {
+        samples.resize(chunkFrameCount * channels);
+
+        bool isLast = false;
+        size_t frameCount = 0;
+        while (frameCount < chunkFrameCount)
+        {
+            const int decoded = stb_vorbis_get_samples_short_interleaved(
+                decoder, channels,
+                samples.data() + frameCount * channels,
+                static_cast<int>((chunkFrameCount - frameCount) * channels));
+            if (decoded == 0)
+            {
+                isLast = true;
+                break;
+            }
+            frameCount += decoded;
+        }
+
+        samples.resize(frameCount * channels);
+        return isLast;
+    }
+
+    void AudioStream::updateAll()
+    {
+        PROFILE_FUNC();
+        uint64_t memoryUsage = 0;
+        long long decodeMicroseconds = 0;
+        for (AudioStream *stream : activeStreams())
+        {
+            stream->update();
+            memoryUsage += stream->mMemoryUsage;
+            decodeMicroseconds += stream->mDecodeMicroseconds;
+            stream->mDecodeMicroseconds = 0;
+        }
+
+        PROFILE_COUNTER("Audio Streams", activeStreams().size());
+        PROFILE_COUNTER("Audio Stream Memory (KB)", memoryUsage / 1024);
+        PROFILE_COUNTER("Audio Stream Decode Time (us)", decodeMicroseconds);
+    }
+
+    void AudioStream::bind(const ALuint sourceId)
+    {
+        mSourceId = sourceId;
+    }
+
+    void AudioStream::play()
+    {
+        if (!isValid() || mSourceId == 0)
+            return;
+
+        // Stopping the source lets go of every buffer, including ones that haven't been played yet.
+        alSourceStop(mSourceId);
+        alSourcei(mSourceId, AL_BUFFER, 0);
+        mFreeBuffers = mBuffers;
+
+        // Anything still being decoded is from the old position and is thrown away when it arrives.
+        mState->readyChunks.clear();
+        ++mState->generation;
+        mNeedsRewind = true;
+        mIsDecoderFinished = false;
+        mIsPlaying = true;
+
+        update();
+    }
+
+    bool AudioStream::isValid() const
+    {
+        return mState->decoder != nullptr;
+    }
+
+    std::filesystem::path AudioStream::getPath() const
+    {
+        return mPath;
+    }
+
+    void AudioStream::update()
+    {
+        if (!mIsPlaying)
+            return;
+
+        ALint processedCount = 0;
+        alGetSourcei(mSourceId, AL_BUFFERS_PROCESSED, &processedCount);
+        for (int i = 0; i < processedCount; ++i)
+        {
+            ALuint bufferId = 0;
+            alSourceUnqueueBuffers(mSourceId, 1, &bufferId);
+            mFreeBuffers.push_back(bufferId);
+        }
+
+        const ALenum format = mChannels < 2 ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
+        while (!mFreeBuffers.empty() && !mState->readyChunks.empty())
+        {
+            Chunk &chunk = mState->readyChunks.front();
+            if (!chunk.samples.empty())
+            {
+                const ALuint bufferId = mFreeBuffers.back();
+                mFreeBuffers.pop_back();
+                alBufferData(bufferId, format, chunk.samples.data(), static_cast<ALsizei>(chunk.samples.size() * sizeof(short)), mSampleRate);
+                alSourceQueueBuffers(mSourceId, 1, &bufferId);
+            }
+
+            mIsDecoderFinished = chunk.isLast;
+            mDecodeMicroseconds += chunk.decodeMicroseconds;
+            mState->readyChunks.pop_front();
+        }
+
+        if (!mIsDecoderFinished && !mState->isDecoding && mState->readyChunks.size() < mFreeBuffers.size())
+            requestChunk();
+
+        // The source stops by itself if it runs dry, so it's restarted once there is something to play again.
+        ALint queuedCount = 0;
+        ALint state = AL_STOPPED;
+        alGetSourcei(mSourceId, AL_BUFFERS_QUEUED, &queuedCount);
+        alGetSourcei(mSourceId, AL_SOURCE_STATE, &state);
+        if (state != AL_PLAYING)
+        {
+            if (queuedCount > 0)
+                alSourcePlay(mSourceId);
+            else if (mIsDecoderFinished)
+                mIsPlaying = false;
+        }
+    }
+
+    void AudioStream::requestChunk()
+    {
+        mState->isDecoding = true;
+        const uint32_t generation = mState->generation;
+        const bool needsRewind = mNeedsRewind;
+        mNeedsRewind = false;
+
+        const int channels = mChannels;
+        std::shared_ptr<State> state = mState;
+        threadPool->queueJob(load::makeJob<Chunk>(
+            [state, generation, needsRewind, channels]
+            {
+                PROFILE_FUNC_NAMED("Decode Audio Chunk");
+                const auto startTime = std::chrono::steady_clock::now();
+                if (needsRewind)
+                    stb_vorbis_seek_start(state->decoder);
+
+                Chunk chunk;
+                chunk.generation = generation;
+                chunk.isLast = decodeChunk(state->decoder, channels, chunk.samples);
+                const auto decodeTime = std::chrono::steady_clock::now() - startTime;
+                chunk.decodeMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(decodeTime).count();
+                return chunk;
+            },
+            [state](Chunk &chunk)
+            {
+                state->isDecoding = false;
+                if (chunk.generation == state->generation)
+                    state->readyChunks.push_back(std::move(chunk));
+            }),
+            load::Priority::Visible);
+    }
+} // engine
@@ -0,0 +1,252 @@
+/**
+ * @file CookedMesh.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "CookedMesh.h"
+
+#include <cstdio>
+#include <fstream>
+
+#include "Logger.h"
+#include "LoggerMacros.h"
+
+#ifdef _WIN32
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif  // _WIN32
+
+namespace engine::disk
+{
+    MappedFile::MappedFile(const std::filesystem::path &path)
+    {
+#ifdef _WIN32
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return;
+        mFile = file;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+            return;
+
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr)
+            return;
+        mMapping = mapping;
+
+        mData = static_cast<const std::byte*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        mSize = mData != nullptr ? static_cast<uint64_t>(size.QuadPart) : 0;
+#else
+        mFile = open(path.c_str(), O_RDONLY);
+        if (mFile < 0)
+            return;
+
+        struct stat status { };
+        if (fstat(mFile, &status) != 0 || status.st_size == 0)
+            return;
+
+        void *data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, mFile, 0);
+        if (data == MAP_FAILED)
+            return;
+
+        mData = static_cast<const std::byte*>(data);
+        mSize = static_cast<uint64_t>(status.st_size);
+#endif  // _WIN32
+    }
+
+    MappedFile::~MappedFile()
+    {
+#ifdef _WIN32
+        if (mData != nullptr)
+            UnmapViewOfFile(mData);
+        if (mMapping != nullptr)
+            CloseHandle(mMapping);
+        if (mFile != nullptr)
+            CloseHandle(mFile);
+#else
+        if (mData != nullptr)
+            munmap(const_cast<std::byte*>(mData), static_cast<size_t>(mSize));
+        if (mFile >= 0)
+            close(mFile);
+#endif  // _WIN32
+    }
+
+    uint64_t hashBytes(const std::byte *data, const uint64_t size, const uint64_t seed)
+    {
+        // FNV-1a, but eight bytes at a time since we hash entire models.
+        constexpr uint64_t prime = 1099511628211ull;
+        uint64_t hash = seed;
+
+        uint64_t i = 0;
+        for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+        {
+            uint64_t word;
+            std::memcpy(&word, data + i, sizeof(uint64_t));
+            hash = (hash ^ word) * prime;
+        }
+
+        for (; i < size; ++i)
+            hash = (hash ^ static_cast<uint64_t>(data[i])) * prime;
+
+        return hash;
+    }
+
+    uint64_t hashFile(const std::filesystem::path &path)
+    {
+        const MappedFile file(path);
+        if (!file.isOpen())
+            return 0;
+
+        return hashBytes(file.data(), file.size());
+    }
+
+    CookedSource findCookedSource(const std::filesystem::path &sourcePath, const uint32_t importFlags)
+    {
+        CookedSource source { };
+        source.importFlags = importFlags;
+
+        std::error_code error;
+        const uint64_t size = std::filesystem::file_size(sourcePath, error);
+        if (error)
+            return source;
+
+        const auto writeTime = std::filesystem::last_write_time(sourcePath, error);
+        if (error)
+            return source;
+
+        source.size = size;
+        source.writeTime = static_cast<int64_t>(writeTime.time_since_epoch().count());
+        return source;
+    }
+
+    bool hashSource(const std::filesystem::path &sourcePath, CookedSource &source)
+    {
+        if (source.hash == 0)
+            source.hash = hashFile(sourcePath);
+        return source.hash != 0;
+    }
+
+    bool isSameSource(const CookedSource &cooked, const std::filesystem::path &sourcePath, CookedSource &source, bool &isStampStale)
+    {
+        isStampStale = false;
+        if (source.size == 0 || cooked.importFlags != source.importFlags)
+            return false;
+
+        if (cooked.size == source.size && cooked.writeTime == source.writeTime)
+        {
+            source.hash = cooked.hash;
+            return true;
+        }
+
+        // The file was touched or copied, which doesn't always mean that it changed.
+        if (!hashSource(sourcePath, source) || cooked.hash != source.hash)
+            return false;
+
+        isStampStale = true;
+        return true;
+    }
+
+    void refreshCookedSource(const std::filesystem::path &path, const uint64_t offset, const CookedSource &source)
+    {
+        std::fstream stream(path, std::ios::binary | std::ios::in | std::ios::out);
+        if (!stream.is_open())
+            return;
+
+        stream.seekp(static_cast<std::streamoff>(offset));
+        stream.write(reinterpret_cast<const char*>(&source), sizeof(CookedSource));
+    }
+
+    std::filesystem::path cookedMeshPath(const std::filesystem::path &sourcePath, const uint64_t layoutId)
+    {
+        const std::string pathString = sourcePath.lexically_normal().string();
+        const uint64_t pathHash = hashBytes(reinterpret_cast<const std::byte*>(pathString.data()), pathString.size(), layoutId);
+
+        char name[17];
+        std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(pathHash));
+        return std::filesystem::path("meshCache") / (sourcePath.stem().string() + "_" + name + ".pcymesh");
+    }
+
+    bool isValidCookedHeader(const CookedMeshHeader &header, const uint64_t layoutId, const uint32_t vertexStride, const uint32_t importFlags)
+    {
+        return std::memcmp(header.magic, cookedMeshMagic, sizeof(cookedMeshMagic)) == 0
+            && header.version == cookedMeshVersion
+            && header.source.importFlags == importFlags
+            && header.layoutId == layoutId
+            && header.vertexStride == vertexStride;
+    }
+
+    uint64_t alignUp(const uint64_t value)
+    {
+        return (value + cookedMeshAlignment - 1) / cookedMeshAlignment * cookedMeshAlignment;
+    }
+
+    bool writeCookedMesh(
+        const std::filesystem::path &path, const CookedMeshHeader &header,
+        const std::vector<CookedSubMeshEntry> &entries,
+        const std::vector<const void*> &vertexData, const std::vector<const void*> &indexData)
+    {
+        // Lay the blobs out after the table, each starting on an aligned boundary so they can be read in place.
+        std::vector<CookedSubMeshEntry> table = entries;
+        uint64_t offset = sizeof(CookedMeshHeader) + table.size() * sizeof(CookedSubMeshEntry);
+        for (CookedSubMeshEntry &entry : table)
+        {
+            entry.vertexOffset = alignUp(offset);
+            offset = entry.vertexOffset + static_cast<uint64_t>(entry.vertexCount) * header.vertexStride;
+            entry.indexOffset = alignUp(offset);
+            offset = entry.indexOffset + static_cast<uint64_t>(entry.indexCount) * sizeof(uint32_t);
+        }
+
+        std::error_code error;
+        std::filesystem::create_directories(path.parent_path(), error);
+
+        std::filesystem::path temporaryPath = path;
+        temporaryPath += ".tmp";
+        {
+            std::ofstream stream(temporaryPath, std::ios::binary | std::ios::trunc);
+            if (!stream.is_open())
+            {
+                WARN("Could not open % to write a cooked mesh.", temporaryPath);
+                return false;
+            }
+
+            const char padding[cookedMeshAlignment] { };
+            auto writeAt = [&stream, &padding](const uint64_t position, const void *data, const uint64_t size) {
+                const auto current = static_cast<uint64_t>(stream.tellp());
+                stream.write(padding, static_cast<std::streamsize>(position - current));
+                stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            };
+
+            stream.write(reinterpret_cast<const char*>(&header), sizeof(CookedMeshHeader));
+            stream.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(table.size() * sizeof(CookedSubMeshEntry)));
+            for (int i = 0; i < table.size(); ++i)
+            {
+                const CookedSubMeshEntry &entry = table[i];
+                writeAt(entry.vertexOffset, vertexData[i], static_cast<uint64_t>(entry.vertexCount) * header.vertexStride);
+                writeAt(entry.indexOffset, indexData[i], static_cast<uint64_t>(entry.indexCount) * sizeof(uint32_t));
+            }
+
+            if (!stream.good())
+            {
+                WARN("Failed to write cooked mesh %.", temporaryPath);
+                return false;
+            }
+        }
+
+        std::filesystem::rename(temporaryPath, path, error);
+        if (error)
+        {
+            WARN("Could not move cooked mesh into place %\n%", path, error.message());
+            std::filesystem::remove(temporaryPath, error);
+            return false;
+        }
+
+        return true;
+    }
+}
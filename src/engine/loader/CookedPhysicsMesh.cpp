@@ -0,0 +1,170 @@
+/**
+ * @file CookedPhysicsMesh.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "CookedPhysicsMesh.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "Logger.h"
+#include "LoggerMacros.h"
+
+namespace engine::disk
+{
+    namespace
+    {
+        /**
+         * @brief Reads everything but the stamp refresh so that the file is unmapped before it is written to.
+         */
+        bool readCookedPhysicsMeshData(
+            const std::filesystem::path &path, const std::filesystem::path &sourcePath, CookedSource &source,
+            physics::MeshColliderBuffer &buffer, bool &isStampStale)
+        {
+            const MappedFile file(path);
+            if (!file.isOpen() || file.size() < sizeof(CookedPhysicsMeshHeader))
+                return false;
+
+            CookedPhysicsMeshHeader header { };
+            std::memcpy(&header, file.data(), sizeof(CookedPhysicsMeshHeader));
+            if (std::memcmp(header.magic, cookedPhysicsMeshMagic, sizeof(cookedPhysicsMeshMagic)) != 0
+                || header.version != cookedPhysicsMeshVersion
+                || !isSameSource(header.source, sourcePath, source, isStampStale))
+                return false;
+
+            const uint64_t tableSize = static_cast<uint64_t>(header.meshCount) * sizeof(CookedPhysicsMeshEntry);
+            if (file.size() < sizeof(CookedPhysicsMeshHeader) + tableSize || header.bvhOffset + header.bvhSize > file.size())
+                return false;
+
+            std::vector<CookedPhysicsMeshEntry> entries(header.meshCount);
+            std::memcpy(entries.data(), file.data() + sizeof(CookedPhysicsMeshHeader), tableSize);
+
+            std::vector<physics::MeshDataBuffer> meshes;
+            meshes.reserve(entries.size());
+            for (const CookedPhysicsMeshEntry &entry : entries)
+            {
+                const uint64_t vertexBytes = static_cast<uint64_t>(entry.vertexCount) * sizeof(glm::vec3);
+                const uint64_t indexBytes = static_cast<uint64_t>(entry.indexCount) * sizeof(int);
+                if (entry.vertexOffset + vertexBytes > file.size() || entry.indexOffset + indexBytes > file.size())
+                    return false;
+
+                physics::MeshDataBuffer &mesh = meshes.emplace_back();
+                mesh.vertices.resize(entry.vertexCount);
+                mesh.indices.resize(entry.indexCount);
+                std::memcpy(mesh.vertices.data(), file.data() + entry.vertexOffset, vertexBytes);
+                std::memcpy(mesh.indices.data(), file.data() + entry.indexOffset, indexBytes);
+            }
+
+            // Copied out of the mapping since Bullet fixes up the bvh's pointers in place.
+            buffer.serializedBvh.resize((header.bvhSize + sizeof(physics::MeshColliderBuffer::BvhBlock) - 1) / sizeof(physics::MeshColliderBuffer::BvhBlock));
+            std::memcpy(buffer.serializedBvh.data(), file.data() + header.bvhOffset, header.bvhSize);
+            buffer.meshDataBuffers = std::move(meshes);
+            return true;
+        }
+    }
+
+    std::filesystem::path cookedPhysicsMeshPath(const std::filesystem::path &sourcePath)
+    {
+        const std::string pathString = sourcePath.lexically_normal().string();
+        const uint64_t pathHash = hashBytes(reinterpret_cast<const std::byte*>(pathString.data()), pathString.size());
+
+        char name[17];
+        std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(pathHash));
+        return std::filesystem::path("meshCache") / (sourcePath.stem().string() + "_" + name + ".pcyphys");
+    }
+
+    bool readCookedPhysicsMesh(
+        const std::filesystem::path &path, const std::filesystem::path &sourcePath, CookedSource &source,
+        physics::MeshColliderBuffer &buffer)
+    {
+        bool isStampStale = false;
+        if (!readCookedPhysicsMeshData(path, sourcePath, source, buffer, isStampStale))
+            return false;
+
+        if (isStampStale)
+            refreshCookedSource(path, offsetof(CookedPhysicsMeshHeader, source), source);
+        return true;
+    }
+
+    bool writeCookedPhysicsMesh(
+        const std::filesystem::path &path, const std::filesystem::path &sourcePath, CookedSource &source,
+        const physics::MeshColliderBuffer &buffer)
+    {
+        if (!hashSource(sourcePath, source))
+            return false;
+
+        std::vector<CookedPhysicsMeshEntry> table;
+        uint64_t offset = sizeof(CookedPhysicsMeshHeader) + buffer.meshDataBuffers.size() * sizeof(CookedPhysicsMeshEntry);
+        for (const physics::MeshDataBuffer &mesh : buffer.meshDataBuffers)
+        {
+            CookedPhysicsMeshEntry &entry = table.emplace_back();
+            entry.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+            entry.indexCount = static_cast<uint32_t>(mesh.indices.size());
+            entry.vertexOffset = alignUp(offset);
+            offset = entry.vertexOffset + static_cast<uint64_t>(entry.vertexCount) * sizeof(glm::vec3);
+            entry.indexOffset = alignUp(offset);
+            offset = entry.indexOffset + static_cast<uint64_t>(entry.indexCount) * sizeof(int);
+        }
+
+        CookedPhysicsMeshHeader header { };
+        std::memcpy(header.magic, cookedPhysicsMeshMagic, sizeof(cookedPhysicsMeshMagic));
+        header.version = cookedPhysicsMeshVersion;
+        header.source = source;
+        header.bvhOffset = alignUp(offset);
+        header.bvhSize = buffer.serializedBvhSize();
+        header.meshCount = static_cast<uint32_t>(table.size());
+
+        std::error_code error;
+        std::filesystem::create_directories(path.parent_path(), error);
+
+        std::filesystem::path temporaryPath = path;
+        temporaryPath += ".tmp";
+        {
+            std::ofstream stream(temporaryPath, std::ios::binary | std::ios::trunc);
+            if (!stream.is_open())
+            {
+                WARN("Could not open % to write a cooked physics mesh.", temporaryPath);
+                return false;
+            }
+
+            const char padding[cookedMeshAlignment] { };
+            auto writeAt = [&stream, &padding](const uint64_t position, const void *data, const uint64_t size) {
+                const auto current = static_cast<uint64_t>(stream.tellp());
+                stream.write(padding, static_cast<std::streamsize>(position - current));
+                stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            };
+
+            stream.write(reinterpret_cast<const char*>(&header), sizeof(CookedPhysicsMeshHeader));
+            stream.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(table.size() * sizeof(CookedPhysicsMeshEntry)));
+            for (int i = 0; i < table.size(); ++i)
+            {
+                const CookedPhysicsMeshEntry &entry = table[i];
+                const physics::MeshDataBuffer &mesh = buffer.meshDataBuffers[i];
+                writeAt(entry.vertexOffset, mesh.vertices.data(), static_cast<uint64_t>(entry.vertexCount) * sizeof(glm::vec3));
+                writeAt(entry.indexOffset, mesh.indices.data(), static_cast<uint64_t>(entry.indexCount) * sizeof(int));
+            }
+            writeAt(header.bvhOffset, buffer.serializedBvh.data(), header.bvhSize);
+
+            if (!stream.good())
+            {
+                WARN("Failed to write cooked physics mesh %.", temporaryPath);
+                return false;
+            }
+        }
+
+        std::filesystem::rename(temporaryPath, path, error);
+        if (error)
+        {
+            WARN("Could not move cooked physics mesh into place %\n%", path, error.message());
+            std::filesystem::remove(temporaryPath, error);
+            return false;
+        }
+
+        return true;
+    }
+}
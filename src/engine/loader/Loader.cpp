@@ -10,6 +10,7 @@
 #include <fstream>
 #include <stb_image.h>
 
+#include "BinaryScene.h"
 #include "EngineState.h"
 #include "ResourcePool.h"
 #include "Scene.h"
@@ -23,6 +24,9 @@ namespace load
 
     std::unique_ptr<engine::AudioSource> audio(const std::filesystem::path& path)
     {
+        if (engine::AudioStream::shouldStream(path))
+            return std::make_unique<engine::AudioSource>(std::make_unique<engine::AudioStream>(path));
+
         return std::make_unique<engine::AudioSource>(engine::resourcePool->loadAudioBuffer(path));
     }
 
@@ -34,25 +38,46 @@ namespace load
             return std::make_unique<engine::Scene>();
         }
 
-        std::ifstream stream(path);
-        std::stringstream stringStream;
-        stringStream << stream.rdbuf();
-        stream.close();
-
-        YAML::Node data = YAML::Load(stringStream.str());
-        if (!data["Scene"])
+        const double startTime = timers::getTicks<double>();
+        std::unique_ptr<engine::Scene> scene;
+        if (engine::serialize::isBinaryScene(path))
         {
-            WARN("File does not contain a scene: %", path);
-            return std::make_unique<engine::Scene>();
+            const engine::serialize::BinarySceneReader reader(path);
+            if (!reader.isValid())
+            {
+                WARN("File does not contain a binary scene: %", path);
+                return std::make_unique<engine::Scene>();
+            }
+
+            MESSAGE_VERBOSE("loading scene: %", reader.getSceneName());
+
+            scene = engine::serializer->loadScene(reader.getSceneNode());
+
+            for (uint32_t i = 0; i < reader.getActorCount(); ++i)
+                load::actor(reader, i, scene.get());
         }
+        else
+        {
+            std::ifstream stream(path);
+            std::stringstream stringStream;
+            stringStream << stream.rdbuf();
+            stream.close();
 
-        const auto sceneName = data["Scene"].as<std::string>();
-        MESSAGE_VERBOSE("loading scene: %", sceneName);
+            YAML::Node data = YAML::Load(stringStream.str());
+            if (!data["Scene"])
+            {
+                WARN("File does not contain a scene: %", path);
+                return std::make_unique<engine::Scene>();
+            }
 
-        auto scene = engine::serializer->loadScene(data);
+            const auto sceneName = data["Scene"].as<std::string>();
+            MESSAGE_VERBOSE("loading scene: %", sceneName);
 
-        for (const YAML::Node &actorNode : data["Actors"])
-            load::actor(actorNode, scene.get());
+            scene = engine::serializer->loadScene(data);
+
+            for (const YAML::Node &actorNode : data["Actors"])
+                load::actor(actorNode, scene.get());
+        }
 
         // Linking all of the children to their parents.
         for (Ref<engine::Actor> actor : scene->mToAdd)
@@ -61,9 +86,11 @@ namespace load
             {
                 auto child = scene->getActor(childId);
                 child->mParent = actor.get();
+                child->markTransformDirty();
             }
         }
 
+        MESSAGE_VERBOSE("Loaded scene % in %ms", path.filename(), (timers::getTicks<double>() - startTime) * 1000.0);
         return scene;
     }
 
@@ -74,9 +101,9 @@ namespace load
         return engine::resourcePool->loadShader(vertexPath, fragmentPath);
     }
 
-    std::shared_ptr<Texture> texture(const std::filesystem::path &path)
+    std::shared_ptr<Texture> texture(const std::filesystem::path &path, const Priority priority)
     {
-        return engine::resourcePool->loadTexture(path);
+        return engine::resourcePool->loadTexture(path, priority);
     }
 
     GLFWimage windowIcon(std::string_view path)
@@ -107,16 +134,38 @@ namespace load
     {
         auto actor = engine::serializer->loadActor(actorNode, scene);
         actor->mName = actorNode["Name"].as<std::string>();
-        actor->mId = actorNode["UUID"].as<engine::UUID>();
+        scene->changeActorId(actor.get(), actorNode["UUID"].as<engine::UUID>());
         actor->position = actorNode["position"].as<glm::vec3>();
         actor->rotation = actorNode["rotation"].as<glm::quat>();
         actor->scale = actorNode["scale"].as<glm::vec3>();
+        if (const YAML::Node mobilityNode = actorNode["Mobility"]; mobilityNode.IsDefined())
+            actor->mMobility = static_cast<graphics::Mobility>(mobilityNode.as<unsigned int>());
         actor->mChildren = actorNode["Children"].as<std::vector<engine::UUID>>();
 
         for (auto &componentNode : actorNode["Components"])
             engine::serializer->loadComponent(componentNode, actor);
     }
 
+    void actor(const engine::serialize::BinarySceneReader &reader, const uint32_t index, engine::Scene *scene)
+    {
+        const engine::serialize::BinaryActor binaryActor = reader.getActor(index);
+        auto actor = engine::serializer->loadActor(reader.getActorNode(binaryActor), scene);
+        actor->mName = reader.getString(binaryActor.name);
+        scene->changeActorId(actor.get(), binaryActor.id);
+        actor->position = glm::vec3(binaryActor.position[0], binaryActor.position[1], binaryActor.position[2]);
+        actor->rotation = glm::quat(binaryActor.rotation[0], binaryActor.rotation[1], binaryActor.rotation[2], binaryActor.rotation[3]);
+        actor->scale = glm::vec3(binaryActor.scale[0], binaryActor.scale[1], binaryActor.scale[2]);
+        if (binaryActor.mobility != engine::serialize::binarySceneNone)
+            actor->mMobility = static_cast<graphics::Mobility>(binaryActor.mobility);
+        actor->mChildren = reader.getChildren(binaryActor);
+
+        for (uint32_t i = 0; i < binaryActor.componentCount; ++i)
+        {
+            const engine::serialize::BinaryComponent component = reader.getComponent(binaryActor.firstComponent + i);
+            engine::serializer->loadComponent(std::string(reader.getString(component.type)), reader.getComponentNode(component), actor);
+        }
+    }
+
     std::shared_ptr<engine::UberLayer> materialLayer(const std::filesystem::path& path)
     {
         return engine::resourcePool->loadMaterialLayer(path);
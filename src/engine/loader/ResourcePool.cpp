@@ -8,6 +8,7 @@
 #include "ResourcePool.h"
 #include <Statistics.h>
 #include <FileLoader.h>
+#include <cstring>
 #include <future>
 
 #include "Disk.h"
@@ -16,6 +17,15 @@
 
 namespace engine
 {
+    namespace
+    {
+        struct DecodedTexture
+        {
+            disk::StbiTextureData image;
+            graphics::PixelUpload upload;
+        };
+    }
+
     template<typename T>
     void internalClean(std::unordered_map<std::string, std::shared_ptr<T>> &map)
     {
@@ -91,7 +101,10 @@ namespace engine
     void ResourcePool::update()
     {
         PROFILE_FUNC();
-        mThreadPool.resolveFinishedJobs();
+        threadPool->resolveFinishedJobs();
+
+        if (mTextureUploader != nullptr)
+            mTextureUploader->update();
 
         // I have no idea where else to do this since I only want to update every material onece.
         // This is the only container that stores unique instances.
@@ -123,7 +136,7 @@ namespace engine
         return resource;
     }
     
-    std::shared_ptr<Texture> ResourcePool::loadTexture(const std::filesystem::path &path)
+    std::shared_ptr<Texture> ResourcePool::loadTexture(const std::filesystem::path &path, const load::Priority priority)
     {
         const std::string hashName = path.string();
         if (auto it = mTextures.find(hashName); it != mTextures.end())
@@ -148,19 +161,48 @@ namespace engine
             return resource;
         }
 
-        mThreadPool.queueJob(load::makeJob<disk::StbiTextureData>(
-            [path]
+        if (mTextureUploader == nullptr)
+            mTextureUploader = std::make_unique<graphics::TextureUploader>();
+
+        graphics::TextureUploader *uploader = mTextureUploader.get();
+        threadPool->queueJob(load::makeJob<DecodedTexture>(
+            [path, uploader]
             {
-                return disk::image(path);
+                PROFILE_FUNC_NAMED("Load Texture");
+                DecodedTexture texture { disk::image(path) };
+                if (texture.image.bytes == nullptr)
+                    return texture;
+
+                // The pixels are moved into the upload buffer here so that the main thread only has to start the copy.
+                const uint64_t size = static_cast<uint64_t>(texture.image.width) * texture.image.height * 4;
+                texture.upload = uploader->reserve(size);
+                if (texture.upload.isValid())
+                {
+                    std::memcpy(texture.upload.data, texture.image.bytes, size);
+                    disk::release(texture.image);
+                }
+
+                return texture;
             },
-            [this, resource, path](disk::StbiTextureData &image)
+            [this, resource, path, uploader](DecodedTexture &texture)
             {
-                resource->setData(glm::ivec2(image.width, image.height), image.bytes);
-                disk::release(image);
+                const glm::ivec2 size(texture.image.width, texture.image.height);
+                if (texture.upload.isValid())
+                {
+                    resource->setData(size, *uploader, texture.upload);
+                }
+                else
+                {
+                    if (texture.image.bytes != nullptr)
+                        MESSAGE_VERBOSE("No room to stream %, uploading it directly.", path.filename());
+                    resource->setData(size, texture.image.bytes);
+                    disk::release(texture.image);
+                }
+
                 MESSAGE_VERBOSE("Texture Ready, broadcasting result: %", path.filename());
                 onTextureReady.broadcast(resource);
-            })
-        );
+            }),
+            priority);
 
         return resource;
     }
@@ -176,7 +218,7 @@ namespace engine
         return resource;
     }
 
-    std::shared_ptr<physics::MeshColliderBuffer> ResourcePool::loadPhysicsMesh(const std::filesystem::path& path)
+    std::shared_ptr<physics::MeshColliderBuffer> ResourcePool::loadPhysicsMesh(const std::filesystem::path& path, const load::Priority priority)
     {
         const std::string hashName = path.string();
         if (const auto it = mMeshColliders.find(hashName); it != mMeshColliders.end())
@@ -185,69 +227,96 @@ namespace engine
         if (path.empty())
             return { };
 
-        Assimp::Importer importer;
-        const aiScene *scene = importer.ReadFile(
-            path.string(),
-            aiProcess_GlobalScale           |
-            aiProcess_CalcTangentSpace      |
-            aiProcess_Triangulate           |
-            aiProcess_JoinIdenticalVertices |
-            aiProcess_SortByPType);
+        auto meshColliderBuffer = std::make_shared<engine::physics::MeshColliderBuffer>();
+        mMeshColliders[hashName] = meshColliderBuffer;
 
-        if (scene == nullptr)
-        {
-            ERROR("Could not load model with path %\n%", path, importer.GetErrorString());
-            return { };
-        }
+        // The buffer is only touched by the worker until the callback marks it as ready.
+        threadPool->queueJob(load::makeJob<bool>(
+            [path, meshColliderBuffer]
+            {
+                PROFILE_FUNC_NAMED("Load Physics Mesh");
+                const double startTime = timers::getTicks<double>();
+                const std::filesystem::path cookedPath = disk::cookedPhysicsMeshPath(path);
 
-        auto meshColliderBuffer = std::make_shared<engine::physics::MeshColliderBuffer>();
+                // Like render meshes, the source is only hashed when its size or write time have changed.
+                disk::CookedSource source = disk::findCookedSource(path, load::meshImportFlags);
+                if (disk::readCookedPhysicsMesh(cookedPath, path, source, *meshColliderBuffer))
+                {
+                    if (meshColliderBuffer->buildShapeFromSerializedBvh())
+                    {
+                        MESSAGE_VERBOSE("Loaded cooked physics mesh % in %ms", path.filename(), (timers::getTicks<double>() - startTime) * 1000.0);
+                        return true;
+                    }
+
+                    WARN("Cooked physics mesh for % is corrupt. Rebuilding it.", path);
+                    meshColliderBuffer->meshDataBuffers.clear();
+                    meshColliderBuffer->serializedBvh.clear();
+                }
 
-        for (int i = 0; i < scene->mNumMeshes; ++i)
-        {
-            engine::physics::MeshDataBuffer meshDataBuffer;
+                Assimp::Importer importer;
+                const aiScene *scene = importer.ReadFile(path.string(), load::meshImportFlags);
 
-            const aiMesh *mesh = scene->mMeshes[i];
+                if (scene == nullptr)
+                {
+                    WARN("Could not load model with path %\n%", path, importer.GetErrorString());
+                    return false;
+                }
 
-            for (int j = 0; j < mesh->mNumFaces; ++j)
-            {
-                for (int k = 0; k < mesh->mFaces[j].mNumIndices; ++k)
+                for (int i = 0; i < scene->mNumMeshes; ++i)
                 {
-                    const int index = mesh->mFaces[j].mIndices[k];
-                    meshDataBuffer.indices.emplace_back(index);
+                    engine::physics::MeshDataBuffer meshDataBuffer;
+
+                    const aiMesh *mesh = scene->mMeshes[i];
+
+                    meshDataBuffer.indices.reserve(mesh->mNumFaces * 3);
+                    for (int j = 0; j < mesh->mNumFaces; ++j)
+                    {
+                        for (int k = 0; k < mesh->mFaces[j].mNumIndices; ++k)
+                        {
+                            const int index = mesh->mFaces[j].mIndices[k];
+                            meshDataBuffer.indices.emplace_back(index);
+                        }
+                    }
+
+                    meshDataBuffer.vertices.reserve(mesh->mNumVertices);
+                    for (int j = 0; j < mesh->mNumVertices; ++j)
+                    {
+                        const glm::vec3 position = load::toVec3(mesh->mVertices[j]);
+                        meshDataBuffer.vertices.emplace_back(position);
+                    }
+
+                    meshColliderBuffer->meshDataBuffers.push_back(std::move(meshDataBuffer));
                 }
-            }
 
-            meshDataBuffer.vertices.reserve(mesh->mNumVertices);
-            for (int j = 0; j < mesh->mNumVertices; ++j)
-            {
-                const glm::vec3 position = load::toVec3(mesh->mVertices[j]);
-                meshDataBuffer.vertices.emplace_back(position);
-            }
+                // We're using assimp's logger so that the last message when collapsed is this.
+                Assimp::DefaultLogger::get()->info("Load successful.");
 
-            meshColliderBuffer->meshDataBuffers.push_back(std::move(meshDataBuffer));
-        }
+                meshColliderBuffer->buildVertexArray();
+                meshColliderBuffer->buildShape();
 
-        // We're using assimp's logger so that the last message when collapsed is this.
-        Assimp::DefaultLogger::get()->info("Load successful.");
+                if (source.size > 0)
+                {
+                    meshColliderBuffer->serializeBvh();
+                    disk::writeCookedPhysicsMesh(cookedPath, path, source, *meshColliderBuffer);
 
-        for (const physics::MeshDataBuffer &dataBuffer : meshColliderBuffer->meshDataBuffers)
-        {
-            btIndexedMesh indexedMesh;
-            // The most annoying interface for a mesh.
-            indexedMesh.m_numTriangles = static_cast<int>(dataBuffer.indices.size()) / 3;
-            indexedMesh.m_triangleIndexBase = (const unsigned char*)dataBuffer.indices.data();
-            indexedMesh.m_triangleIndexStride = 3 * sizeof(int);
-            indexedMesh.m_numVertices = static_cast<int>(dataBuffer.vertices.size());
-            indexedMesh.m_vertexBase = (const unsigned char*)dataBuffer.vertices.data();
-            indexedMesh.m_vertexStride = sizeof(float) * 3;
-            indexedMesh.m_indexType = PHY_INTEGER;
-            meshColliderBuffer->indexedMeshes.push_back(indexedMesh);
-        }
+                    // The shape owns its own bvh, so the serialised copy is only needed for writing.
+                    meshColliderBuffer->serializedBvh = { };
+                }
 
-        for (btIndexedMesh indexedMesh : meshColliderBuffer->indexedMeshes)
-            meshColliderBuffer->vertexArray.addIndexedMesh(indexedMesh, PHY_INTEGER);
+                MESSAGE_VERBOSE("Imported and built physics mesh % in %ms", path.filename(), (timers::getTicks<double>() - startTime) * 1000.0);
+                return true;
+            },
+            [this, meshColliderBuffer, path](const bool &isLoaded)
+            {
+                if (!isLoaded)
+                    return;
+
+                meshColliderBuffer->isReady = true;
+                MESSAGE_VERBOSE("Physics Mesh Ready, broadcasting result: %", path.filename());
+                onPhysicsMeshReady.broadcast(meshColliderBuffer);
+            }),
+            priority);
 
-        mMeshColliders[hashName] = meshColliderBuffer;
         return meshColliderBuffer;
     }
 
@@ -281,6 +350,6 @@ namespace engine
 
     uint32_t ResourcePool::getLoadingCount() const
     {
-        return mThreadPool.getJobCount();
+        return threadPool->getJobCount();
     }
 }
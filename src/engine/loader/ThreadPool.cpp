@@ -7,12 +7,34 @@
 
 #include "ThreadPool.h"
 
+#include <chrono>
+
 #include "Logger.h"
 #include "LoggerMacros.h"
 #include "ProfileTimer.h"
 
 namespace load
 {
+    // Which pool and deque the current thread belongs to. Threads outside a pool have no deque.
+    thread_local const ThreadPool *currentPool = nullptr;
+    thread_local uint32_t currentWorkerIndex = 0;
+
+    JobHandle::JobHandle(std::shared_ptr<JobCounter> counter)
+        : mCounter(std::move(counter))
+    {
+    }
+
+    bool JobHandle::isDone() const
+    {
+        return mCounter == nullptr || mCounter->remaining.load(std::memory_order_acquire) == 0;
+    }
+
+    void JobHandle::cancel() const
+    {
+        if (mCounter != nullptr)
+            mCounter->cancelled.store(true, std::memory_order_relaxed);
+    }
+
     ThreadPool::ThreadPool()
     {
         start();
@@ -25,82 +47,313 @@ namespace load
 
     void ThreadPool::start()
     {
-        const uint32_t threadCount = std::thread::hardware_concurrency() - 1;
+        // hardware_concurrency() is allowed to return zero, so always have at least one worker.
+        const uint32_t threadCount = glm::max(std::thread::hardware_concurrency(), 2u) - 1;
+        mShouldTerminate = false;
+
+        for (uint32_t i = 0; i < threadCount; ++i)
+            mQueues.emplace_back(std::make_unique<WorkerQueue>());
+
         for (uint32_t i = 0; i < threadCount; ++i)
-            mThreads.emplace_back(std::thread(&ThreadPool::threadLoop, this));
+            mThreads.emplace_back(std::thread(&ThreadPool::threadLoop, this, i));
         MESSAGE_VERBOSE("Generating thread pool of size %", threadCount);
     }
 
-    void ThreadPool::queueJob(std::unique_ptr<IThreadTask> task)
+    void ThreadPool::queueJob(std::unique_ptr<IThreadTask> task, const Priority priority)
     {
         ++mJobCount;
+
+        // std::function must be copyable so the task is shared with the job.
+        std::shared_ptr<IThreadTask> sharedTask = std::move(task);
+        auto counter = std::make_shared<JobCounter>();
+        counter->remaining.store(1, std::memory_order_relaxed);
+        submit([this, sharedTask, priority] {
+            sharedTask->run();
+
+            const std::unique_lock lock(mFinishedJobsMutex);
+            mFinishedJobs[static_cast<size_t>(priority)].push_back(sharedTask);
+        }, counter, { }, true);
+    }
+
+    JobHandle ThreadPool::schedule(JobFunction work, const std::vector<JobHandle> &dependencies)
+    {
+        auto counter = std::make_shared<JobCounter>();
+        counter->remaining.store(1, std::memory_order_relaxed);
+        submit(std::move(work), counter, dependencies);
+        return JobHandle(counter);
+    }
+
+    JobHandle ThreadPool::schedule(JobFunction work, const JobHandle &dependency)
+    {
+        return schedule(std::move(work), std::vector { dependency });
+    }
+
+    void ThreadPool::parallelFor(const uint32_t count, const uint32_t batchSize, const std::function<void(uint32_t, uint32_t)> &work)
+    {
+        if (count == 0)
+            return;
+
+        const uint32_t size = glm::max(batchSize, 1u);
+        const uint32_t batchCount = (count + size - 1) / size;
+
+        auto counter = std::make_shared<JobCounter>();
+        counter->remaining.store(batchCount, std::memory_order_relaxed);
+
+        // The work is only referenced by the batches, which are all done before this function returns.
+        for (uint32_t begin = 0; begin < count; begin += size)
         {
-            const std::unique_lock lock(mJobsMutex);
-            mJobs.push(std::move(task));
+            const uint32_t end = glm::min(begin + size, count);
+            submit([&work, begin, end] { work(begin, end); }, counter, { });
+        }
+
+        wait(JobHandle(counter));
+    }
+
+    void ThreadPool::wait(const JobHandle &handle)
+    {
+        while (!handle.isDone())
+        {
+            if (!tryRunJob())
+                std::this_thread::yield();
         }
-        mMutexCondition.notify_one();
     }
 
     void ThreadPool::stop()
     {
         {
-            const std::unique_lock lock(mJobsMutex);
+            const std::unique_lock lock(mSleepMutex);
             mShouldTerminate = true;
         }
         mMutexCondition.notify_all();
         for (std::thread &thread : mThreads)
             thread.join();
-
         mThreads.clear();
+
+        // Scheduled jobs can be waited on, so they're run here rather than leaving their handles stuck forever.
+        std::vector<std::unique_ptr<WorkerQueue>> queues = std::move(mQueues);
+        mQueues.clear();
+        for (const std::unique_ptr<WorkerQueue> &queue : queues)
+        {
+            while (!queue->jobs.empty())
+            {
+                const std::shared_ptr<Job> job = std::move(queue->jobs.front());
+                queue->jobs.pop_front();
+                execute(job);
+            }
+        }
+
+        {
+            const std::unique_lock lock(mLoadingQueue.mutex);
+            mLoadingQueue.jobs.clear();
+        }
+        mQueuedCount.store(0);
     }
 
     bool ThreadPool::isBusy()
     {
-        bool isBusy = false;
-        {
-            const std::unique_lock lock(mJobsMutex);
-            isBusy = !mJobs.empty();
-        }
-        return isBusy;
+        return mQueuedCount.load(std::memory_order_relaxed) > 0;
     }
 
     void ThreadPool::resolveFinishedJobs()
     {
         PROFILE_FUNC();
         {
+            // Only hold the lock long enough to take what's finished so that workers aren't blocked by callbacks.
             const std::unique_lock lock(mFinishedJobsMutex);
-            while (!mFinishedJobs.empty())
+            for (size_t i = 0; i < priorityCount; ++i)
             {
-                const std::unique_ptr<IThreadTask> finishedJob = std::move(mFinishedJobs.front());
-                mFinishedJobs.pop();
+                for (std::shared_ptr<IThreadTask> &finishedJob : mFinishedJobs[i])
+                    mCompletionQueues[i].push_back(std::move(finishedJob));
+                mFinishedJobs[i].clear();
+            }
+        }
+
+        const auto startTime = std::chrono::steady_clock::now();
+        const std::chrono::duration<float, std::milli> budget(mCompletionBudget);
+        uint32_t completedCount = 0;
+        for (auto &queue : mCompletionQueues)
+        {
+            // Always complete something so that a single slow callback can't stall loading forever.
+            while (!queue.empty() && (completedCount == 0 || std::chrono::steady_clock::now() - startTime < budget))
+            {
+                const std::shared_ptr<IThreadTask> finishedJob = std::move(queue.front());
+                queue.pop_front();
 
                 finishedJob->callback();
                 --mJobCount;
+                ++completedCount;
             }
         }
+
+        const std::chrono::duration<float, std::milli> usedTime = std::chrono::steady_clock::now() - startTime;
+        PROFILE_COUNTER("Completion Budget Used (%)", usedTime / budget * 100.f);
+        PROFILE_COUNTER("Completions This Frame", completedCount);
+        PROFILE_COUNTER("Completion Queue (Visible)", mCompletionQueues[static_cast<size_t>(Priority::Visible)].size());
+        PROFILE_COUNTER("Completion Queue (Nearby)", mCompletionQueues[static_cast<size_t>(Priority::Nearby)].size());
+        PROFILE_COUNTER("Completion Queue (Background)", mCompletionQueues[static_cast<size_t>(Priority::Background)].size());
     }
 
-    void ThreadPool::threadLoop()
+    void ThreadPool::submit(
+        JobFunction work, const std::shared_ptr<JobCounter> &counter, const std::vector<JobHandle> &dependencies,
+        const bool isLoading)
     {
-        while (true)
+        auto job = std::make_shared<Job>();
+        job->work = std::move(work);
+        job->counter = counter;
+        job->isLoading = isLoading;
+
+        // pendingDependencies starts at one so that the job can't be pushed while we're still registering it.
+        for (const JobHandle &dependency : dependencies)
         {
-            std::unique_ptr<IThreadTask> job;
+            if (dependency.mCounter == nullptr)
+                continue;
+
+            const std::unique_lock lock(dependency.mCounter->mutex);
+            if (dependency.mCounter->isComplete)
+                continue;
+
+            job->pendingDependencies.fetch_add(1, std::memory_order_relaxed);
+            dependency.mCounter->continuations.push_back(job);
+        }
+
+        if (job->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            push(std::move(job));
+    }
+
+    void ThreadPool::push(std::shared_ptr<Job> job)
+    {
+        // The pool has been stopped, so there's no one else to run it.
+        if (mQueues.empty())
+        {
+            execute(job);
+            return;
+        }
+
+        WorkerQueue &queue = job->isLoading
+            ? mLoadingQueue
+            : *mQueues[currentPool == this
+                ? currentWorkerIndex
+                : mNextQueue.fetch_add(1, std::memory_order_relaxed) % static_cast<uint32_t>(mQueues.size())];
+
+        {
+            // Counted before the job is visible so that a thief can't take it and decrement first.
+            const std::unique_lock lock(queue.mutex);
+            mQueuedCount.fetch_add(1, std::memory_order_release);
+            queue.jobs.push_back(std::move(job));
+        }
+
+        // Taking the lock stops a worker from missing the notify between checking the count and going to sleep.
+        {
+            const std::unique_lock lock(mSleepMutex);
+        }
+        mMutexCondition.notify_one();
+    }
+
+    std::shared_ptr<Job> ThreadPool::popOrSteal(const uint32_t startIndex, const bool isOwner)
+    {
+        const auto queueCount = static_cast<uint32_t>(mQueues.size());
+        for (uint32_t i = 0; i < queueCount; ++i)
+        {
+            WorkerQueue &queue = *mQueues[(startIndex + i) % queueCount];
+            const std::unique_lock lock(queue.mutex);
+            if (queue.jobs.empty())
+                continue;
+
+            std::shared_ptr<Job> job;
+            // The owner works LIFO to keep its cache warm. Thieves take the oldest job.
+            if (isOwner && i == 0)
             {
-                std::unique_lock lock(mJobsMutex);
-                mMutexCondition.wait(lock, [this] {
-                    return !mJobs.empty() || mShouldTerminate;
-                });
-                if (mShouldTerminate)
-                    return;
-
-                job = std::move(mJobs.front());
-                mJobs.pop();
+                job = std::move(queue.jobs.back());
+                queue.jobs.pop_back();
             }
-            job->run();
+            else
             {
-                const std::unique_lock lock(mFinishedJobsMutex);
-                mFinishedJobs.push(std::move(job));
+                job = std::move(queue.jobs.front());
+                queue.jobs.pop_front();
             }
+
+            mQueuedCount.fetch_sub(1, std::memory_order_relaxed);
+            return job;
+        }
+
+        return nullptr;
+    }
+
+    std::shared_ptr<Job> ThreadPool::popLoadingJob()
+    {
+        const std::unique_lock lock(mLoadingQueue.mutex);
+        if (mLoadingQueue.jobs.empty())
+            return nullptr;
+
+        std::shared_ptr<Job> job = std::move(mLoadingQueue.jobs.front());
+        mLoadingQueue.jobs.pop_front();
+        mQueuedCount.fetch_sub(1, std::memory_order_relaxed);
+        return job;
+    }
+
+    bool ThreadPool::tryRunJob()
+    {
+        if (mQueues.empty())
+            return false;
+
+        const bool isWorker = currentPool == this;
+        const uint32_t startIndex = isWorker
+            ? currentWorkerIndex
+            : mNextQueue.load(std::memory_order_relaxed) % static_cast<uint32_t>(mQueues.size());
+
+        std::shared_ptr<Job> job = popOrSteal(startIndex, isWorker);
+        if (job == nullptr && isWorker)
+            job = popLoadingJob();
+        if (job == nullptr)
+            return false;
+
+        execute(job);
+        return true;
+    }
+
+    void ThreadPool::execute(const std::shared_ptr<Job> &job)
+    {
+        PROFILE_FUNC_NAMED("Job");
+        if (!job->counter->cancelled.load(std::memory_order_relaxed))
+            job->work();
+
+        if (job->counter->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            complete(job->counter);
+    }
+
+    void ThreadPool::complete(const std::shared_ptr<JobCounter> &counter)
+    {
+        std::vector<std::shared_ptr<Job>> continuations;
+        {
+            const std::unique_lock lock(counter->mutex);
+            counter->isComplete = true;
+            continuations = std::move(counter->continuations);
+        }
+
+        for (std::shared_ptr<Job> &job : continuations)
+        {
+            if (job->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                push(std::move(job));
+        }
+    }
+
+    void ThreadPool::threadLoop(const uint32_t workerIndex)
+    {
+        currentPool = this;
+        currentWorkerIndex = workerIndex;
+        PROFILE_THREAD(format::string("Worker %", workerIndex));
+
+        while (true)
+        {
+            if (tryRunJob())
+                continue;
+
+            std::unique_lock lock(mSleepMutex);
+            mMutexCondition.wait(lock, [this] {
+                return mQueuedCount.load(std::memory_order_acquire) > 0 || mShouldTerminate;
+            });
+            if (mShouldTerminate)
+                return;
         }
     }
 } // load
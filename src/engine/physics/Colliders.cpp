@@ -10,11 +10,13 @@
 #include <BulletCollision/CollisionShapes/btTriangleIndexVertexArray.h>
 
 #include "Actor.h"
+#include "EngineState.h"
 #include "FileExplorer.h"
 #include "FileLoader.h"
 #include "Loader.h"
 #include "PhysicsConversions.h"
 #include "ResourceFolder.h"
+#include "ResourcePool.h"
 #include "RigidBody.h"
 
 namespace engine
@@ -97,14 +99,23 @@ namespace engine
 
     MeshCollider::MeshCollider()
     {
-
+        mCallbackToken = resourcePool->onPhysicsMeshReady.subscribe([this](const std::shared_ptr<physics::MeshColliderBuffer> &buffer) {
+            if (mMeshColliderBuffer == buffer)
+                setupShape();
+        });
     }
 
     MeshCollider::MeshCollider(const std::filesystem::path &path)
+        : MeshCollider()
     {
         initialiseBasedOnPath(path);
     }
 
+    MeshCollider::~MeshCollider()
+    {
+        resourcePool->onPhysicsMeshReady.unSubscribe(mCallbackToken);
+    }
+
     void MeshCollider::onBegin()
     {
         if (mMeshShape)
@@ -155,7 +166,25 @@ namespace engine
 
         mPath = std::move(path);
         mMeshColliderBuffer = load::physicsMesh(mPath);
-        mMeshShape = std::make_unique<btBvhTriangleMeshShape>(&mMeshColliderBuffer->vertexArray, true);
+        mMeshShape.reset();
         mDebugShape = load::model<PositionVertex>(mPath);
+
+        // Another collider may have already loaded this mesh.
+        setupShape();
+    }
+
+    void MeshCollider::setupShape()
+    {
+        if (mMeshColliderBuffer == nullptr || !mMeshColliderBuffer->isReady)
+            return;
+
+        const glm::vec3 scale = mActor != nullptr ? mActor->scale : glm::vec3(1.f);
+        mMeshShape = std::make_unique<btScaledBvhTriangleMeshShape>(mMeshColliderBuffer->shape.get(), physics::cast(scale));
+
+        // The rigid body would have skipped setup if it was awake before the mesh finished loading.
+        if (mActor == nullptr)
+            return;
+        if (auto rb = mActor->getComponent<RigidBody>(false); rb.isValid())
+            rb->setupRigidBody(getCollider());
     }
 }
@@ -0,0 +1,67 @@
+/**
+ * @file PhysicsMeshBuffer.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "PhysicsMeshBuffer.h"
+
+namespace engine::physics
+{
+    void MeshColliderBuffer::buildVertexArray()
+    {
+        indexedMeshes.clear();
+        for (const MeshDataBuffer &dataBuffer : meshDataBuffers)
+        {
+            btIndexedMesh indexedMesh;
+            // The most annoying interface for a mesh.
+            indexedMesh.m_numTriangles = static_cast<int>(dataBuffer.indices.size()) / 3;
+            indexedMesh.m_triangleIndexBase = (const unsigned char*)dataBuffer.indices.data();
+            indexedMesh.m_triangleIndexStride = 3 * sizeof(int);
+            indexedMesh.m_numVertices = static_cast<int>(dataBuffer.vertices.size());
+            indexedMesh.m_vertexBase = (const unsigned char*)dataBuffer.vertices.data();
+            indexedMesh.m_vertexStride = sizeof(float) * 3;
+            indexedMesh.m_indexType = PHY_INTEGER;
+            indexedMeshes.push_back(indexedMesh);
+        }
+
+        for (btIndexedMesh indexedMesh : indexedMeshes)
+            vertexArray.addIndexedMesh(indexedMesh, PHY_INTEGER);
+    }
+
+    void MeshColliderBuffer::buildShape()
+    {
+        constexpr bool useQuantizedAabbCompression = true;
+        shape = std::make_unique<btBvhTriangleMeshShape>(&vertexArray, useQuantizedAabbCompression);
+    }
+
+    bool MeshColliderBuffer::buildShapeFromSerializedBvh()
+    {
+        if (serializedBvh.empty())
+            return false;
+
+        constexpr bool swapEndian = false;
+        btOptimizedBvh *bvh = btOptimizedBvh::deSerializeInPlace(
+            serializedBvh.data(), static_cast<unsigned int>(serializedBvhSize()), swapEndian);
+        if (bvh == nullptr)
+            return false;
+
+        buildVertexArray();
+        constexpr bool useQuantizedAabbCompression = true;
+        constexpr bool buildBvh = false;
+        shape = std::make_unique<btBvhTriangleMeshShape>(&vertexArray, useQuantizedAabbCompression, buildBvh);
+        shape->setOptimizedBvh(bvh);
+        return true;
+    }
+
+    void MeshColliderBuffer::serializeBvh()
+    {
+        const btOptimizedBvh *bvh = shape->getOptimizedBvh();
+        const unsigned int size = bvh->calculateSerializeBufferSize();
+        serializedBvh.resize((size + sizeof(BvhBlock) - 1) / sizeof(BvhBlock));
+
+        constexpr bool swapEndian = false;
+        bvh->serializeInPlace(serializedBvh.data(), size, swapEndian);
+    }
+}
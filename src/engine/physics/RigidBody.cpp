@@ -43,6 +43,9 @@ namespace engine
             collisionShape = colliderComponent->getCollider();
         }
 
+        if (collisionShape == nullptr)
+            return;  // The collider is still loading. It will finish setup once it's ready.
+
         btTransform transform;
         transform.setIdentity();
         transform.setOrigin(physics::cast(mActor->getWorldPosition()));
@@ -32,7 +32,7 @@ namespace engine
         mDirectionalLight.shadowMap->setBorderColour(glm::vec4(1.f));
         mDirectionalLight.vpMatrices.reserve(depths.size());
         mDirectionalLight.shadowBias = bias;
-        mDirectionalLight.shadowCascadeMultipliers = depths;
+        mDirectionalLight.shadowCascadeMultipliers.assign(depths.begin(), depths.end());
         mDirectionalLight.shadowZMultiplier = zMultiplier;
         calculateDirection();
     }
@@ -127,6 +127,7 @@ namespace engine
     {
         mDirectionalLight.direction = direction;
         mDirectionalLight.colourIntensity = colour * intensity;
+        mDirectionalLight.mobility = mActor->getMobility();
         updateShadowMap(mDirectionalLight.shadowCascadeZones);
         
         graphics::renderer->submit(mDirectionalLight);
@@ -143,6 +144,7 @@ namespace engine
         mPointLight.radius = mRadius;
         mPointLight.bias = mBias;
         mPointLight.softnessRadius = mSoftnessRadius;
+        mPointLight.mobility = mActor->getMobility();
         
         if (mPointLight.shadowMap->getSize().x != mResolution)
             mPointLight.shadowMap = std::make_shared<Cubemap>(glm::ivec2(mResolution), GL_DEPTH_COMPONENT32);
@@ -287,6 +289,7 @@ namespace engine
         mSpotlight.cosInnerAngle = glm::cos(glm::radians(mInnerAngleDegrees));
         mSpotlight.outerAngle = glm::radians(mOuterAngleDegrees);
         mSpotlight.cosOuterAngle = glm::cos(mSpotlight.outerAngle);
+        mSpotlight.mobility = mActor->getMobility();
         graphics::renderer->submit(mSpotlight);
     }
     
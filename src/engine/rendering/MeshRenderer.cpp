@@ -43,7 +43,8 @@ namespace engine
             }
             else
             {
-                ImGui::Checkbox("Show", &mIsShowing);
+                if (ImGui::Checkbox("Show", &mIsShowing))
+                    mActor->markStaticSetChanged();
                 drawMeshOptions();
             }
             
@@ -74,6 +75,7 @@ namespace engine
             const SharedMesh mesh = load::model<StandardVertex>(meshPath);
             mMeshes = mesh;
             mMeshPath = meshPath;
+            mActor->markStaticSetChanged();
         }
         if (ImGui::BeginDragDropTarget())
         {
@@ -83,6 +85,7 @@ namespace engine
                 const SharedMesh mesh = load::model<StandardVertex>(path);
                 mMeshes = mesh;
                 mMeshPath = path.string();
+                mActor->markStaticSetChanged();
             }
 
             ImGui::EndDragDropTarget();
@@ -199,14 +202,16 @@ namespace engine
                 graphics::renderer->drawMesh(
                     surface,
                     getWorldTransform(),
-                    material->getData());
+                    material->materialIndex(),
+                    mActor->getMobility());
             }
             else
             {
                 graphics::renderer->drawMesh(
                     surface,
                     getWorldTransform(),
-                    core->getDefaultLitMaterial()->getData());
+                    core->getDefaultLitMaterial()->materialIndex(),
+                    mActor->getMobility());
             }
         };
 
@@ -227,7 +232,8 @@ namespace engine
                 graphics::renderer->drawMesh(
                     *(*mMeshes)[i],
                     getWorldTransform(),
-                    core->getDefaultLitMaterial()->getData());
+                    core->getDefaultLitMaterial()->materialIndex(),
+                    mActor->getMobility());
             }
         }
     }
@@ -10,6 +10,7 @@
 #include <yaml-cpp/yaml.h>
 
 #include "ContainerAlgorithms.h"
+#include "GraphicsState.h"
 #include "Loader.h"
 #include "ResourceFolder.h"
 #include "Ui.h"
@@ -17,12 +18,22 @@
 namespace engine
 {
     UberMaterial::UberMaterial(const std::filesystem::path& path)
-        : mName(path.filename().string()), mPath(path)
+        : mName(path.filename().string()), mPath(path), mMaterialIndex(graphics::renderer->createMaterial())
     {
         if (std::filesystem::exists(mPath))
             loadFromDisk();
         else  // So that it creates an entry immediately.
             saveToDisk();
+
+        // Geometry can be drawn with this material before its first onPreRender().
+        graphics::renderer->updateMaterial(mMaterialIndex, mData);
+        mIsDirty = false;
+    }
+
+    UberMaterial::~UberMaterial()
+    {
+        if (graphics::renderer != nullptr)
+            graphics::renderer->destroyMaterial(mMaterialIndex);
     }
 
     void UberMaterial::drawMaskArray()
@@ -140,9 +151,12 @@ namespace engine
         }
 
         if (anyChanges)
+            updateGraphicsData();
+
+        if (mIsDirty)
         {
-            mData.textureArrayId = mTexturePool.id();
-            mData.textureArrayData = mTexturePool.data();
+            graphics::renderer->updateMaterial(mMaterialIndex, mData);
+            mIsDirty = false;
         }
     }
 
@@ -235,6 +249,7 @@ namespace engine
             {
                 containers::moveInPlace(mLayers, *static_cast<int*>(payload->Data), index);
                 containers::moveInPlace(mData.layers, *static_cast<int*>(payload->Data), index);
+                mIsDirty = true;
             }
 
             if (const ImGuiPayload *payload = ImGui::AcceptDragDropPayload(resourceMaterialLayerPayload))
@@ -319,11 +334,13 @@ namespace engine
     {
         mData.textureArrayId = mTexturePool.id();
         mData.textureArrayData = mTexturePool.data();
+        mIsDirty = true;
     }
 
     void UberMaterial::addMask(std::unique_ptr<UberMask> mask)
     {
         auto &maskData = mData.masks.emplace_back();
+        mIsDirty = true;
         if (mask == nullptr)
             return;
 
@@ -347,12 +364,14 @@ namespace engine
 
         mMasks.erase(mMasks.begin() + index);
         mData.masks.erase(mData.masks.begin() + index);
+        updateGraphicsData();
     }
 
 
     void UberMaterial::addNewMaterialLayer(std::shared_ptr<UberLayer> layer)
     {
         auto &layerData = mData.layers.emplace_back();
+        mIsDirty = true;
         if (layer == nullptr)
             return;
 
@@ -487,6 +506,7 @@ namespace engine
 
         mLayers.erase(mLayers.begin() + index);
         mData.layers.erase(mData.layers.begin() + index);
+        updateGraphicsData();
     }
 
 } // engine
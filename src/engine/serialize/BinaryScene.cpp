@@ -0,0 +1,518 @@
+/**
+ * @file BinaryScene.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "BinaryScene.h"
+
+#include <cstring>
+#include <fstream>
+#include <unordered_set>
+
+#include "Logger.h"
+#include "LoggerMacros.h"
+
+namespace engine::serialize
+{
+    namespace
+    {
+        enum class NodeTag : uint8_t
+        {
+            Null,
+            Scalar,
+            Sequence,
+            Map,
+        };
+
+        constexpr uint8_t flowStyleFlag = 0x80;
+
+        // Protects against a corrupt blob recursing forever. Real scenes are only a handful of levels deep.
+        constexpr uint32_t maxNodeDepth = 256;
+
+        const std::unordered_set<std::string> sceneKeys { "Scene", "Actors" };
+        const std::unordered_set<std::string> actorKeys { "Name", "UUID", "position", "rotation", "scale", "Mobility", "Components", "Children" };
+        const std::unordered_set<std::string> componentKeys { "Component" };
+
+        /**
+         * @brief Every key and scalar is stored once, so the same paths and numbers across actors cost nothing.
+         */
+        class StringTable
+        {
+        public:
+            uint32_t intern(const std::string &value)
+            {
+                const auto [it, isNew] = mIndices.try_emplace(value, static_cast<uint32_t>(strings.size()));
+                if (isNew)
+                    strings.push_back(value);
+                return it->second;
+            }
+
+            std::vector<std::string> strings;
+
+        protected:
+            std::unordered_map<std::string, uint32_t> mIndices;
+        };
+
+        template<typename T>
+        void write(std::vector<std::byte> &out, const T value)
+        {
+            const size_t offset = out.size();
+            out.resize(offset + sizeof(T));
+            std::memcpy(out.data() + offset, &value, sizeof(T));
+        }
+
+        bool read(const std::byte *&cursor, const std::byte *end, uint32_t &value)
+        {
+            if (end - cursor < static_cast<std::ptrdiff_t>(sizeof(uint32_t)))
+                return false;
+            std::memcpy(&value, cursor, sizeof(uint32_t));
+            cursor += sizeof(uint32_t);
+            return true;
+        }
+
+        void encodeNode(
+            const YAML::Node &node, std::vector<std::byte> &out, StringTable &strings,
+            const std::unordered_set<std::string> *skipKeys=nullptr)
+        {
+            const uint8_t style = node.Style() == YAML::EmitterStyle::Flow ? flowStyleFlag : 0;
+            switch (node.Type())
+            {
+                case YAML::NodeType::Scalar:
+                    write(out, static_cast<uint8_t>(static_cast<uint8_t>(NodeTag::Scalar) | style));
+                    write(out, strings.intern(node.Scalar()));
+                    break;
+                case YAML::NodeType::Sequence:
+                    write(out, static_cast<uint8_t>(static_cast<uint8_t>(NodeTag::Sequence) | style));
+                    write(out, static_cast<uint32_t>(node.size()));
+                    for (const YAML::Node &child : node)
+                        encodeNode(child, out, strings);
+                    break;
+                case YAML::NodeType::Map:
+                {
+                    write(out, static_cast<uint8_t>(static_cast<uint8_t>(NodeTag::Map) | style));
+                    const size_t countOffset = out.size();
+                    write(out, static_cast<uint32_t>(0));
+
+                    uint32_t count = 0;
+                    for (const auto &pair : node)
+                    {
+                        const std::string &key = pair.first.Scalar();
+                        if (skipKeys != nullptr && skipKeys->count(key) > 0)
+                            continue;
+
+                        write(out, strings.intern(key));
+                        encodeNode(pair.second, out, strings);
+                        ++count;
+                    }
+                    std::memcpy(out.data() + countOffset, &count, sizeof(uint32_t));
+                    break;
+                }
+                default:
+                    write(out, static_cast<uint8_t>(NodeTag::Null));
+                    break;
+            }
+        }
+
+        void readFloats(const YAML::Node &node, float *values, const size_t count)
+        {
+            if (!node.IsSequence() || node.size() != count)
+                return;
+
+            for (size_t i = 0; i < count; ++i)
+                values[i] = node[i].as<float>();
+        }
+
+        YAML::Node makeFlowSequence(const float *values, const size_t count)
+        {
+            YAML::Node node(YAML::NodeType::Sequence);
+            for (size_t i = 0; i < count; ++i)
+                node.push_back(values[i]);
+            node.SetStyle(YAML::EmitterStyle::Flow);
+            return node;
+        }
+
+        bool isInRange(const uint64_t fileSize, const uint64_t offset, const uint64_t count, const uint64_t stride)
+        {
+            return offset <= fileSize && (stride == 0 || count <= (fileSize - offset) / stride);
+        }
+    }
+
+    bool isBinaryScene(const std::filesystem::path &path)
+    {
+        return path.extension() == ".pcyb";
+    }
+
+    BinarySceneReader::BinarySceneReader(const std::filesystem::path &path)
+        : mFile(path)
+    {
+        if (!mFile.isOpen() || mFile.size() < sizeof(BinarySceneHeader))
+            return;
+
+        std::memcpy(&mHeader, mFile.data(), sizeof(BinarySceneHeader));
+        if (std::memcmp(mHeader.magic, binarySceneMagic, sizeof(binarySceneMagic)) != 0 || mHeader.version != binarySceneVersion)
+            return;
+
+        const uint64_t size = mFile.size();
+        if (!isInRange(size, mHeader.stringTableOffset, mHeader.stringCount, sizeof(BinaryString))
+            || !isInRange(size, mHeader.stringDataOffset, 0, 0)
+            || !isInRange(size, mHeader.actorTableOffset, mHeader.actorCount, sizeof(BinaryActor))
+            || !isInRange(size, mHeader.componentTableOffset, mHeader.componentCount, sizeof(BinaryComponent))
+            || !isInRange(size, mHeader.childTableOffset, mHeader.childCount, sizeof(UUID))
+            || !isInRange(size, mHeader.blobDataOffset, 0, 0))
+            return;
+
+        mStrings.reserve(mHeader.stringCount);
+        const auto *stringData = reinterpret_cast<const char*>(mFile.data() + mHeader.stringDataOffset);
+        for (uint32_t i = 0; i < mHeader.stringCount; ++i)
+        {
+            BinaryString entry { };
+            std::memcpy(&entry, mFile.data() + mHeader.stringTableOffset + i * sizeof(BinaryString), sizeof(BinaryString));
+            if (!isInRange(size, mHeader.stringDataOffset + entry.offset, entry.size, 1))
+                return;
+            mStrings.emplace_back(stringData + entry.offset, entry.size);
+        }
+
+        mIsValid = true;
+    }
+
+    std::string_view BinarySceneReader::getString(const uint32_t index) const
+    {
+        if (index >= mStrings.size())
+            return { };
+        return mStrings[index];
+    }
+
+    std::string_view BinarySceneReader::getSceneName() const
+    {
+        return getString(mHeader.sceneName);
+    }
+
+    BinaryActor BinarySceneReader::getActor(const uint32_t index) const
+    {
+        BinaryActor actor { };
+        if (index < mHeader.actorCount)
+            std::memcpy(&actor, mFile.data() + mHeader.actorTableOffset + index * sizeof(BinaryActor), sizeof(BinaryActor));
+        return actor;
+    }
+
+    BinaryComponent BinarySceneReader::getComponent(const uint32_t index) const
+    {
+        BinaryComponent component { binarySceneNone };
+        if (index < mHeader.componentCount)
+            std::memcpy(&component, mFile.data() + mHeader.componentTableOffset + index * sizeof(BinaryComponent), sizeof(BinaryComponent));
+        return component;
+    }
+
+    std::vector<UUID> BinarySceneReader::getChildren(const BinaryActor &actor) const
+    {
+        if (actor.childCount == 0 || actor.firstChild > mHeader.childCount || actor.childCount > mHeader.childCount - actor.firstChild)
+            return { };
+
+        std::vector<UUID> children(actor.childCount);
+        std::memcpy(children.data(), mFile.data() + mHeader.childTableOffset + actor.firstChild * sizeof(UUID), actor.childCount * sizeof(UUID));
+        return children;
+    }
+
+    YAML::Node BinarySceneReader::getSceneNode() const
+    {
+        return decodeBlob(mHeader.sceneBlobOffset, mHeader.sceneBlobSize);
+    }
+
+    YAML::Node BinarySceneReader::getActorNode(const BinaryActor &actor) const
+    {
+        return decodeBlob(actor.blobOffset, actor.blobSize);
+    }
+
+    YAML::Node BinarySceneReader::getComponentNode(const BinaryComponent &component) const
+    {
+        return decodeBlob(component.blobOffset, component.blobSize);
+    }
+
+    YAML::Node BinarySceneReader::toYaml() const
+    {
+        YAML::Node root(YAML::NodeType::Map);
+        root["Scene"] = std::string(getSceneName());
+        for (const auto &pair : getSceneNode())
+            root[pair.first.Scalar()] = pair.second;
+
+        YAML::Node actors(YAML::NodeType::Sequence);
+        for (uint32_t i = 0; i < mHeader.actorCount; ++i)
+        {
+            const BinaryActor actor = getActor(i);
+            YAML::Node actorNode(YAML::NodeType::Map);
+            for (const auto &pair : getActorNode(actor))
+                actorNode[pair.first.Scalar()] = pair.second;
+
+            actorNode["Name"] = std::string(getString(actor.name));
+            actorNode["UUID"] = actor.id;
+            actorNode["position"] = makeFlowSequence(actor.position, 3);
+            actorNode["rotation"] = makeFlowSequence(actor.rotation, 4);
+            actorNode["scale"] = makeFlowSequence(actor.scale, 3);
+            if (actor.mobility != binarySceneNone)
+                actorNode["Mobility"] = actor.mobility;
+
+            YAML::Node components(YAML::NodeType::Sequence);
+            for (uint32_t j = 0; j < actor.componentCount; ++j)
+            {
+                const BinaryComponent component = getComponent(actor.firstComponent + j);
+                YAML::Node componentNode(YAML::NodeType::Map);
+                componentNode["Component"] = std::string(getString(component.type));
+                for (const auto &pair : getComponentNode(component))
+                    componentNode[pair.first.Scalar()] = pair.second;
+                components.push_back(componentNode);
+            }
+            actorNode["Components"] = components;
+
+            YAML::Node children(YAML::NodeType::Sequence);
+            for (const UUID child : getChildren(actor))
+                children.push_back(child);
+            actorNode["Children"] = children;
+
+            actors.push_back(actorNode);
+        }
+        root["Actors"] = actors;
+
+        return root;
+    }
+
+    YAML::Node BinarySceneReader::decodeBlob(const uint64_t offset, const uint64_t size) const
+    {
+        YAML::Node node(YAML::NodeType::Map);
+        const uint64_t blobOffset = mHeader.blobDataOffset + offset;
+        if (size == 0 || !isInRange(mFile.size(), blobOffset, size, 1))
+            return node;
+
+        const std::byte *cursor = mFile.data() + blobOffset;
+        if (!decodeNode(cursor, cursor + size, node, 0))
+        {
+            WARN("A binary scene contains a corrupt node. It will be treated as empty.");
+            return YAML::Node(YAML::NodeType::Map);
+        }
+
+        return node;
+    }
+
+    bool BinarySceneReader::decodeNode(const std::byte *&cursor, const std::byte *end, YAML::Node &node, const uint32_t depth) const
+    {
+        if (depth > maxNodeDepth || cursor >= end)
+            return false;
+
+        const auto tagByte = static_cast<uint8_t>(*cursor++);
+        switch (static_cast<NodeTag>(tagByte & ~flowStyleFlag))
+        {
+            case NodeTag::Null:
+                node = YAML::Node(YAML::NodeType::Null);
+                break;
+            case NodeTag::Scalar:
+            {
+                uint32_t index = 0;
+                if (!read(cursor, end, index) || index >= mStrings.size())
+                    return false;
+                node = YAML::Node(std::string(mStrings[index]));
+                break;
+            }
+            case NodeTag::Sequence:
+            {
+                uint32_t count = 0;
+                if (!read(cursor, end, count))
+                    return false;
+
+                node = YAML::Node(YAML::NodeType::Sequence);
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    YAML::Node child;
+                    if (!decodeNode(cursor, end, child, depth + 1))
+                        return false;
+                    node.push_back(child);
+                }
+                break;
+            }
+            case NodeTag::Map:
+            {
+                uint32_t count = 0;
+                if (!read(cursor, end, count))
+                    return false;
+
+                node = YAML::Node(YAML::NodeType::Map);
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    uint32_t key = 0;
+                    YAML::Node child;
+                    if (!read(cursor, end, key) || key >= mStrings.size() || !decodeNode(cursor, end, child, depth + 1))
+                        return false;
+                    // Keys were unique when they were written, so there's no need to look for an existing one.
+                    node.force_insert(std::string(mStrings[key]), child);
+                }
+                break;
+            }
+            default:
+                return false;
+        }
+
+        if ((tagByte & flowStyleFlag) != 0)
+            node.SetStyle(YAML::EmitterStyle::Flow);
+
+        return true;
+    }
+
+    bool writeBinaryScene(const std::filesystem::path &path, const YAML::Node &scene)
+    {
+        if (!scene.IsMap())
+        {
+            WARN("Scene data for % is not a map. Nothing will be saved.", path);
+            return false;
+        }
+
+        StringTable strings;
+        std::vector<BinaryActor> actors;
+        std::vector<BinaryComponent> components;
+        std::vector<UUID> children;
+        std::vector<std::byte> blobs;
+
+        BinarySceneHeader header { };
+        std::memcpy(header.magic, binarySceneMagic, sizeof(binarySceneMagic));
+        header.version = binarySceneVersion;
+        header.sceneName = strings.intern(scene["Scene"].IsDefined() ? scene["Scene"].as<std::string>() : "");
+
+        header.sceneBlobOffset = blobs.size();
+        encodeNode(scene, blobs, strings, &sceneKeys);
+        header.sceneBlobSize = blobs.size() - header.sceneBlobOffset;
+
+        for (const YAML::Node &actorNode : scene["Actors"])
+        {
+            BinaryActor actor { };
+            actor.id = actorNode["UUID"].as<UUID>();
+            actor.name = strings.intern(actorNode["Name"].as<std::string>());
+            actor.rotation[0] = 1.f;
+            actor.scale[0] = actor.scale[1] = actor.scale[2] = 1.f;
+            readFloats(actorNode["position"], actor.position, 3);
+            readFloats(actorNode["rotation"], actor.rotation, 4);
+            readFloats(actorNode["scale"], actor.scale, 3);
+            const YAML::Node mobilityNode = actorNode["Mobility"];
+            actor.mobility = mobilityNode.IsDefined() ? mobilityNode.as<uint32_t>() : binarySceneNone;
+
+            actor.firstComponent = static_cast<uint32_t>(components.size());
+            for (const YAML::Node &componentNode : actorNode["Components"])
+            {
+                // The serializer skips these too, since there is nothing to load them with.
+                if (!componentNode["Component"].IsDefined())
+                    continue;
+
+                BinaryComponent component { };
+                component.type = strings.intern(componentNode["Component"].as<std::string>());
+                component.blobOffset = blobs.size();
+                encodeNode(componentNode, blobs, strings, &componentKeys);
+                component.blobSize = blobs.size() - component.blobOffset;
+                components.push_back(component);
+            }
+            actor.componentCount = static_cast<uint32_t>(components.size()) - actor.firstComponent;
+
+            actor.firstChild = static_cast<uint32_t>(children.size());
+            for (const YAML::Node &childNode : actorNode["Children"])
+                children.push_back(childNode.as<UUID>());
+            actor.childCount = static_cast<uint32_t>(children.size()) - actor.firstChild;
+
+            actor.blobOffset = blobs.size();
+            encodeNode(actorNode, blobs, strings, &actorKeys);
+            actor.blobSize = blobs.size() - actor.blobOffset;
+            actors.push_back(actor);
+        }
+
+        std::vector<BinaryString> stringTable;
+        uint64_t stringDataSize = 0;
+        for (const std::string &value : strings.strings)
+        {
+            stringTable.push_back({ static_cast<uint32_t>(stringDataSize), static_cast<uint32_t>(value.size()) });
+            stringDataSize += value.size();
+        }
+
+        header.stringCount = static_cast<uint32_t>(stringTable.size());
+        header.actorCount = static_cast<uint32_t>(actors.size());
+        header.componentCount = static_cast<uint32_t>(components.size());
+        header.childCount = static_cast<uint32_t>(children.size());
+        header.stringTableOffset = disk::alignUp(sizeof(BinarySceneHeader));
+        header.stringDataOffset = disk::alignUp(header.stringTableOffset + stringTable.size() * sizeof(BinaryString));
+        header.actorTableOffset = disk::alignUp(header.stringDataOffset + stringDataSize);
+        header.componentTableOffset = disk::alignUp(header.actorTableOffset + actors.size() * sizeof(BinaryActor));
+        header.childTableOffset = disk::alignUp(header.componentTableOffset + components.size() * sizeof(BinaryComponent));
+        header.blobDataOffset = disk::alignUp(header.childTableOffset + children.size() * sizeof(UUID));
+
+        std::error_code error;
+        if (!path.parent_path().empty())
+            std::filesystem::create_directories(path.parent_path(), error);
+
+        std::filesystem::path temporaryPath = path;
+        temporaryPath += ".tmp";
+        {
+            std::ofstream stream(temporaryPath, std::ios::binary | std::ios::trunc);
+            if (!stream.is_open())
+            {
+                WARN("Could not open % to write a binary scene.", temporaryPath);
+                return false;
+            }
+
+            const char padding[disk::cookedMeshAlignment] { };
+            auto writeAt = [&stream, &padding](const uint64_t position, const void *data, const uint64_t size) {
+                const auto current = static_cast<uint64_t>(stream.tellp());
+                stream.write(padding, static_cast<std::streamsize>(position - current));
+                stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            };
+
+            stream.write(reinterpret_cast<const char*>(&header), sizeof(BinarySceneHeader));
+            writeAt(header.stringTableOffset, stringTable.data(), stringTable.size() * sizeof(BinaryString));
+            writeAt(header.stringDataOffset, nullptr, 0);
+            for (const std::string &value : strings.strings)
+                stream.write(value.data(), static_cast<std::streamsize>(value.size()));
+            writeAt(header.actorTableOffset, actors.data(), actors.size() * sizeof(BinaryActor));
+            writeAt(header.componentTableOffset, components.data(), components.size() * sizeof(BinaryComponent));
+            writeAt(header.childTableOffset, children.data(), children.size() * sizeof(UUID));
+            writeAt(header.blobDataOffset, blobs.data(), blobs.size());
+
+            if (!stream.good())
+            {
+                WARN("Failed to write binary scene %.", temporaryPath);
+                return false;
+            }
+        }
+
+        std::filesystem::rename(temporaryPath, path, error);
+        if (error)
+        {
+            WARN("Could not move binary scene into place %\n%", path, error.message());
+            std::filesystem::remove(temporaryPath, error);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool convertToBinaryScene(const std::filesystem::path &yamlPath, const std::filesystem::path &binaryPath)
+    {
+        if (!exists(yamlPath))
+        {
+            WARN("Path to scene does not exist. Nothing will be converted. (%)", yamlPath);
+            return false;
+        }
+
+        return writeBinaryScene(binaryPath, YAML::LoadFile(yamlPath.string()));
+    }
+
+    bool convertToYamlScene(const std::filesystem::path &binaryPath, const std::filesystem::path &yamlPath)
+    {
+        const BinarySceneReader reader(binaryPath);
+        if (!reader.isValid())
+        {
+            WARN("File does not contain a binary scene: %", binaryPath);
+            return false;
+        }
+
+        YAML::Emitter out;
+        out << reader.toYaml();
+
+        std::ofstream stream(yamlPath);
+        stream << out.c_str();
+        return stream.good();
+    }
+}
@@ -14,6 +14,7 @@
 #include <yaml-cpp/yaml.h>
 #include <fstream>
 
+#include "BinaryScene.h"
 #include "FileLoader.h"
 
 YAML::Emitter &operator<<(YAML::Emitter &out, const glm::vec2 &v)
@@ -76,14 +77,18 @@ namespace engine
         if (!node["Component"].IsDefined())
             return;
         
-        const auto componentType = node["Component"].as<std::string>();
-        if (auto it = mLoadComponentFunctions.find(componentType); it != mLoadComponentFunctions.end())
+        loadComponent(node["Component"].as<std::string>(), node, actor);
+    }
+
+    void Serializer::loadComponent(const std::string &type, const YAML::Node &node, const Ref<Actor> &actor)
+    {
+        if (auto it = mLoadComponentFunctions.find(type); it != mLoadComponentFunctions.end())
         {
             it->second(node, actor);
             return;
         }
-        
-        WARN("Could not find a function to load component type: %", componentType);
+
+        WARN("Could not find a function to load component type: %", type);
     }
 
     void Serializer::saveActor(YAML::Emitter& out, Actor* actor) const
@@ -146,6 +151,19 @@ namespace engine
     }
 }
 
+namespace
+{
+    /**
+     * @brief Delegates can only write to an emitter, so whatever they saved is read back into a node to be merged.
+     * Their fragments are small, so the rest of the scene never has to go through text.
+     */
+    void mergeFragment(YAML::Node &node, const YAML::Emitter &fragment)
+    {
+        for (const auto &pair : YAML::Load(fragment.c_str()))
+            node[pair.first.Scalar()] = pair.second;
+    }
+}
+
 namespace engine::serialize
 {
     void scene(const std::filesystem::path &path, Scene *scene)
@@ -163,6 +181,27 @@ namespace engine::serialize
             }
         }
         
+        if (isBinaryScene(path))
+        {
+            YAML::Node node;
+            node["Scene"] = file::makeRelativeToResourcePath(path).string();
+
+            YAML::Emitter fragment;
+            fragment << YAML::BeginMap;
+            serializer->saveScene(fragment, scene);
+            fragment << YAML::EndMap;
+            mergeFragment(node, fragment);
+
+            YAML::Node actors(YAML::NodeType::Sequence);
+            for (auto &actor : scene->getActors())
+                actors.push_back(serialize::actorNode(actor.get()));
+            node["Actors"] = actors;
+
+            if (writeBinaryScene(path, node))
+                MESSAGE("Scene saved to: %", path);
+            return;
+        }
+
         YAML::Emitter out;
         out << YAML::BeginMap;
         out << YAML::Key << "Scene" << YAML::Value << file::makeRelativeToResourcePath(path).string();
@@ -189,6 +228,7 @@ namespace engine::serialize
         out << YAML::Key << "position" << YAML::Value << actor->position;
         out << YAML::Key << "rotation" << YAML::Value << actor->rotation;
         out << YAML::Key << "scale" << YAML::Value << actor->scale;
+        out << YAML::Key << "Mobility" << YAML::Value << static_cast<unsigned int>(actor->mMobility);
 
         out << YAML::Key << "Components" << YAML::Value << YAML::BeginSeq;
         for (auto &component : actor->mComponents)
@@ -204,6 +244,41 @@ namespace engine::serialize
         serializer->saveComponent(out, component);
         out << YAML::EndMap;
     }
+
+    YAML::Node actorNode(Actor *actor)
+    {
+        YAML::Node node;
+        YAML::Emitter fragment;
+        fragment << YAML::BeginMap;
+        serializer->saveActor(fragment, actor);
+        fragment << YAML::EndMap;
+        mergeFragment(node, fragment);
+
+        node["Name"] = actor->mName;
+        node["UUID"] = actor->mId;
+        node["position"] = actor->position;
+        node["rotation"] = actor->rotation;
+        node["scale"] = actor->scale;
+        node["Mobility"] = static_cast<unsigned int>(actor->mMobility);
+
+        YAML::Node components(YAML::NodeType::Sequence);
+        for (auto &component : actor->mComponents)
+            components.push_back(serialize::componentNode(component.get()));
+        node["Components"] = components;
+        node["Children"] = actor->mChildren;
+        return node;
+    }
+
+    YAML::Node componentNode(Component *component)
+    {
+        YAML::Node node(YAML::NodeType::Map);
+        YAML::Emitter fragment;
+        fragment << YAML::BeginMap;
+        serializer->saveComponent(fragment, component);
+        fragment << YAML::EndMap;
+        mergeFragment(node, fragment);
+        return node;
+    }
 }
 
 
@@ -23,7 +23,7 @@ namespace engine
         {
             if (ImGui::Button("Clear"))
                 debug::logger->clearQueue();
-            ui::drawToolTip("Clears the log queue but does not clear the IO log.");
+            ui::drawToolTip("Clears the log queue but does not clear the IO log. Only the most recent messages are kept.");
             ImGui::SameLine();
             ImGui::Checkbox("Wrap Text", &mWrapText);
             ImGui::SameLine();
@@ -49,9 +49,7 @@ namespace engine
                 ImGui::TableHeadersRow();
                 ImGui::PushTextWrapPos(mWrapText ? 0.f : -1.f);
 
-                const std::vector<debug::Message> &logs = debug::logger->getLogs();
-                for (auto it = logs.rbegin(); it != logs.rend(); ++it)
-                    drawMessageUi(*it);
+                debug::logger->forEachLog([this](const debug::Message &message) { drawMessageUi(message); });
 
                 ImGui::PopTextWrapPos();
                 ImGui::EndTable();
@@ -46,8 +46,23 @@ namespace engine
             ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x - ImGui::CalcTextSize("Update Rate").x);
             ImGui::SliderFloat("Update Rate", &mUpdateRate, 0.f, 1.f);
             profiler->setUpdateRate(mUpdateRate);
-            for (const auto &node : profiler->getTree())
-                drawNode(node);
+            for (const debug::ProfileThread &thread : profiler->getTree())
+            {
+                const ImGuiTreeNodeFlags threadFlags = thread.threadId == 0 ? ImGuiTreeNodeFlags_DefaultOpen : 0;
+                ImGui::PushID(static_cast<int>(thread.threadId));
+                if (ImGui::CollapsingHeader(thread.name.c_str(), threadFlags))
+                {
+                    for (const auto &node : thread.nodes)
+                        drawNode(node);
+                }
+                ImGui::PopID();
+            }
+
+            if (!profiler->getCounters().empty() && ImGui::CollapsingHeader("Counters", ImGuiTreeNodeFlags_DefaultOpen))
+            {
+                for (const debug::ProfileCounter &counter : profiler->getCounters())
+                    ImGui::Text("%8lld | %.*s", counter.value, static_cast<int>(counter.name.size()), counter.name.data());
+            }
 #endif
         }
         ImGui::End();
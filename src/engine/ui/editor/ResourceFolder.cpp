@@ -338,7 +338,7 @@ namespace engine
         for (const auto &item : std::filesystem::directory_iterator(mSelectedFolder))
         {
             if (file::hasImageExtension(item))
-                mTextureIcons[item.path().filename().string()] = load::texture(item.path());
+                mTextureIcons[item.path().filename().string()] = load::texture(item.path(), load::Priority::Background);
         }
     }
 }
@@ -0,0 +1,33 @@
+/**
+ * @file BoundingVolumes.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "BoundingVolumes.h"
+
+#include <limits>
+
+namespace graphics
+{
+    BoundingSphere unboundedSphere()
+    {
+        // Not infinity so that the plane tests never have to deal with inf - inf.
+        return { glm::vec3(0.f), std::numeric_limits<float>::max() };
+    }
+
+    BoundingSphere transformSphere(const BoundingSphere &sphere, const glm::mat4 &matrix)
+    {
+        if (sphere.radius >= std::numeric_limits<float>::max())
+            return sphere;
+
+        const glm::vec3 centre = glm::vec3(matrix * glm::vec4(sphere.centre, 1.f));
+        const float scaleSquared = glm::max(
+            glm::dot(glm::vec3(matrix[0]), glm::vec3(matrix[0])), glm::max(
+            glm::dot(glm::vec3(matrix[1]), glm::vec3(matrix[1])),
+            glm::dot(glm::vec3(matrix[2]), glm::vec3(matrix[2]))));
+
+        return { centre, sphere.radius * glm::sqrt(scaleSquared) };
+    }
+}
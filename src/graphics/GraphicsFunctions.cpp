@@ -84,6 +84,17 @@ namespace graphics
         glDispatchComputeIndirect(static_cast<GLintptr>(offset));
     }
 
+    void drawElements(const GLenum mode, const int32_t indicesCount, const uint32_t firstIndex, const int32_t baseVertex)
+    {
+        const auto offset = static_cast<uintptr_t>(firstIndex) * sizeof(uint32_t);
+        glDrawElementsBaseVertex(mode, indicesCount, GL_UNSIGNED_INT, reinterpret_cast<const void*>(offset), baseVertex);
+    }
+
+    void drawElements(const GLenum mode, const SubMesh &subMesh)
+    {
+        drawElements(mode, subMesh.indicesCount(), subMesh.firstIndex(), subMesh.baseVertex());
+    }
+
     enum class GpuError : uint16_t
     {
         NoError = 0x00,
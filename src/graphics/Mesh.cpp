@@ -10,10 +10,7 @@
 
 SubMesh::~SubMesh()
 {
-    glDeleteBuffers(1, &mVbo);
-    glDeleteBuffers(1, &mEbo);
-    
-    glDeleteVertexArrays(1, &mVao);
+    mArena->free(mAllocation);
 }
 
 void setVaoLayout(unsigned int vao, const Instructions &instructions)
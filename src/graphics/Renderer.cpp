@@ -7,24 +7,34 @@
 
 #include "Renderer.h"
 #include "WindowHelpers.h"
+#include "GraphicsState.h"
 #include "Primitives.h"
 #include "GraphicsFunctions.h"
 #include "Shader.h"
 #include "ProfileTimer.h"
 #include "LtcSheenTable.h"
 #include "backend/RendererBackend.h"
+#include "shader/ProgramCache.h"
 #include "shader/ShaderCompilation.h"
 
 Renderer::Renderer() :
     mFullscreenTriangle(primitives::fullscreenTriangle()),
     mRendererBackend(new graphics::RendererBackend())
 {
+    resetQueues(mFrameArenas[mFrameArenaIndex]);
+
     // Blending texture data / enabling lerping.
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_CULL_FACE);
     glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+
+    const graphics::ProgramCacheStatistics &programStatistics = graphics::programCacheStatistics();
+    MESSAGE(
+        "Built renderer shader programs: % compiled from source in %ms, % loaded from the program cache in %ms.",
+        programStatistics.coldCount, programStatistics.coldMilliseconds,
+        programStatistics.warmCount, programStatistics.warmMilliseconds);
 }
 
 bool Renderer::debugMessageCallback(GLDEBUGPROC callback)
@@ -50,39 +60,65 @@ std::string Renderer::getVersion()
 Renderer::~Renderer()
 {
     delete mRendererBackend;
+
+    // Materials can outlive the renderer, so they need to know not to release their slot.
+    if (graphics::renderer == this)
+        graphics::renderer = nullptr;
+}
+
+uint32_t Renderer::createMaterial()
+{
+    return mRendererBackend->getMaterialTable().create();
+}
+
+void Renderer::updateMaterial(const uint32_t materialIndex, const graphics::MaterialData &material)
+{
+    mRendererBackend->getMaterialTable().update(materialIndex, material);
+}
+
+void Renderer::destroyMaterial(const uint32_t materialIndex)
+{
+    mRendererBackend->getMaterialTable().destroy(materialIndex);
 }
 
 void Renderer::drawMesh(
-    const uint32_t vao, int32_t indiciesCount, const glm::mat4& matrix, const graphics::MaterialData& material)
+    const uint32_t vao, const uint32_t meshId, int32_t indiciesCount, const uint32_t firstIndex, const int32_t baseVertex,
+    const glm::mat4& matrix, const uint32_t materialIndex, const graphics::BoundingSphere &worldBounds,
+    const graphics::Mobility mobility)
 {
-    if (material.layers.empty())
+    const graphics::MaterialTable &materials = mRendererBackend->getMaterialTable();
+    if (materials.layerCount(materialIndex) == 0)
         CRASH("No material layers results in undefined behaviour");
 
-    if (!material.masks.empty() && material.layers.size() > 1)
+    if (materials.isMultiMaterial(materialIndex))
     {
-        mMultiMaterialGeometryQueue.emplace_back(vao, indiciesCount, matrix);
-        mMultiMaterialQueue.push_back(material);
+        mMultiMaterialGeometryQueue.emplace_back(vao, meshId, indiciesCount, firstIndex, baseVertex, matrix, worldBounds, mobility);
+        mMultiMaterialQueue.push_back(materialIndex);
     }
     else
     {
-        mSingleMaterialGeometryQueue.emplace_back(vao, indiciesCount, matrix);
-        mSingleMaterialQueue.push_back(material);
+        mSingleMaterialGeometryQueue.emplace_back(vao, meshId, indiciesCount, firstIndex, baseVertex, matrix, worldBounds, mobility);
+        mSingleMaterialQueue.push_back(materialIndex);
     }
 }
 
-void Renderer::drawMesh(const SubMesh& surface, const glm::mat4& matrix, const graphics::MaterialData& material)
+void Renderer::drawMesh(const SubMesh& surface, const glm::mat4& matrix, const uint32_t materialIndex, const graphics::Mobility mobility)
 {
-    drawMesh(surface.vao(), surface.indicesCount(), matrix, material);
+    drawMesh(
+        surface.vao(), surface.meshId(), surface.indicesCount(), surface.firstIndex(), surface.baseVertex(), matrix, materialIndex,
+        graphics::transformSphere(surface.bounds().sphere, matrix), mobility);
 }
 
-void Renderer::drawDebugMesh(const uint32_t vao, const int32_t indicesCount, const glm::mat4& matrix, const glm::vec3& colour)
+void Renderer::drawDebugMesh(
+    const uint32_t vao, const int32_t indicesCount, const uint32_t firstIndex, const int32_t baseVertex,
+    const glm::mat4& matrix, const glm::vec3& colour)
 {
-    mDebugQueue.emplace_back(graphics::DebugQueueObject { vao, indicesCount, matrix, colour });
+    mDebugQueue.emplace_back(graphics::DebugQueueObject { vao, indicesCount, firstIndex, baseVertex, matrix, colour });
 }
 
 void Renderer::drawDebugMesh(const SubMesh& subMesh, const glm::mat4& matrix, const glm::vec3& colour)
 {
-    drawDebugMesh(subMesh.vao(), subMesh.indicesCount(), matrix, colour);
+    drawDebugMesh(subMesh.vao(), subMesh.indicesCount(), subMesh.firstIndex(), subMesh.baseVertex(), matrix, colour);
 }
 
 void Renderer::drawDebugMesh(const SharedMesh& mesh, const glm::mat4& matrix, const glm::vec3& colour)
@@ -119,41 +155,72 @@ void Renderer::submit(const graphics::Spotlight &spotLight)
     mSpotlightQueue.emplace_back(spotLight);
 }
 
-void Renderer::render() const
+void Renderer::setStaticGeneration(const uint64_t generation)
+{
+    mStaticGeneration = generation;
+}
+
+void Renderer::render()
 {
     PROFILE_FUNC();
-    if (window::bufferSize().x <= 0 || window::bufferSize().y <= 0)
-        return;
 
+    // Moving only swaps pointers since the arena goes with the queues. They're handed over even when nothing is drawn
+    // so that the backend never holds onto the arena that is reset next.
     mRendererBackend->copyQueues({
-        mCameraQueue,
-        mDirectionalLightQueue,
-        mPointLightQueue,
-        mSpotlightQueue,
-        mDebugQueue,
-        mLineQueue,
-        mMultiMaterialGeometryQueue,
-        mMultiMaterialQueue,
-        mSingleMaterialGeometryQueue,
-        mSingleMaterialQueue,
+        std::move(mCameraQueue),
+        std::move(mDirectionalLightQueue),
+        std::move(mPointLightQueue),
+        std::move(mSpotlightQueue),
+        std::move(mDebugQueue),
+        std::move(mLineQueue),
+        std::move(mMultiMaterialGeometryQueue),
+        std::move(mMultiMaterialQueue),
+        std::move(mSingleMaterialGeometryQueue),
+        std::move(mSingleMaterialQueue),
+        mStaticGeneration,
     });
+
+    if (window::bufferSize().x <= 0 || window::bufferSize().y <= 0)
+        return;
+
     mRendererBackend->execute();
 }
 
 void Renderer::clear()
 {
-    mCameraQueue.clear();
-    mDirectionalLightQueue.clear();
-    mPointLightQueue.clear();
-    mSpotlightQueue.clear();
-    mDebugQueue.clear();
-    mLineQueue.clear();
-
-    mMultiMaterialGeometryQueue.clear();
-    mMultiMaterialQueue.clear();
+    PROFILE_COUNTER("Frame Arena Bytes", mFrameArenas[mFrameArenaIndex].usedBytes());
+    PROFILE_COUNTER("Frame Arena Heap Allocations", mFrameArenas[0].heapAllocationCount() + mFrameArenas[1].heapAllocationCount());
+
+    // The backend reads this frame's queues until the next ones are handed over, so the next frame is built in the
+    // other arena. Whatever was in it was released when this frame's queues replaced it.
+    mFrameArenaIndex = 1 - mFrameArenaIndex;
+    graphics::FrameArena &arena = mFrameArenas[mFrameArenaIndex];
+    arena.reset();
+    resetQueues(arena);
+
+    // Nothing refers to a mesh's offsets until the next frame is queued, so it's safe to move them.
+    graphics::MeshArena::defragmentAll();
+}
 
-    mSingleMaterialGeometryQueue.clear();
-    mSingleMaterialQueue.clear();
+void Renderer::resetQueues(graphics::FrameArena &arena)
+{
+    const auto reset = [&arena](auto &queue) {
+        using Queue = std::decay_t<decltype(queue)>;
+        queue = Queue(typename Queue::allocator_type(arena));
+    };
+
+    reset(mCameraQueue);
+    reset(mDirectionalLightQueue);
+    reset(mPointLightQueue);
+    reset(mSpotlightQueue);
+    reset(mDebugQueue);
+    reset(mLineQueue);
+
+    reset(mMultiMaterialGeometryQueue);
+    reset(mMultiMaterialQueue);
+
+    reset(mSingleMaterialGeometryQueue);
+    reset(mSingleMaterialQueue);
 }
 
 void Renderer::generateSkybox(const std::string_view path, const glm::ivec2 desiredSize) const
@@ -164,7 +231,7 @@ void Renderer::generateSkybox(const std::string_view path, const glm::ivec2 desi
 void Renderer::drawFullscreenTriangleNow() const
 {
     glBindVertexArray(mFullscreenTriangle.vao());
-    glDrawElements(GL_TRIANGLES, mFullscreenTriangle.indicesCount(), GL_UNSIGNED_INT, nullptr);
+    graphics::drawElements(GL_TRIANGLES, mFullscreenTriangle);
 }
 
 const TextureBufferObject &Renderer::getPrimaryBuffer() const
@@ -212,6 +279,16 @@ void Renderer::setUseUberVariant(const bool useUber) const
     mRendererBackend->setUseUberVariant(useUber);
 }
 
+void Renderer::setUseClusteredLighting(const bool useClustered) const
+{
+    mRendererBackend->setUseClusteredLighting(useClustered);
+}
+
+void Renderer::setUseDepthPrepass(const bool useDepthPrepass) const
+{
+    mRendererBackend->setUseDepthPrepass(useDepthPrepass);
+}
+
 void Renderer::rendererGuiNewFrame()
 {
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
@@ -8,13 +8,20 @@
 #include "Shader.h"
 #include "gtc/type_ptr.hpp"
 #include <Statistics.h>
+#include <chrono>
 #include <fstream>
 #include <sstream>
+#include <utility>
 
+#include "ProfileTimer.h"
+#include "shader/ProgramCache.h"
 #include "shader/ShaderCompilation.h"
+#include "shader/ShaderCompiler.h"
 
 
-Shader::Shader(const std::vector<std::filesystem::path>& paths, const std::vector<graphics::Definition>& definitions)
+Shader::Shader(
+    const std::vector<std::filesystem::path>& paths, const std::vector<graphics::Definition>& definitions,
+    const graphics::BuildMode buildMode)
     : mId(glCreateProgram())
 {
     if (!paths.empty())
@@ -23,17 +30,39 @@ Shader::Shader(const std::vector<std::filesystem::path>& paths, const std::vecto
         setDebugName(mDebugName);
     }
 
-    CreateShaderSource(paths, definitions);
+    mPendingBuild = std::make_unique<graphics::PendingBuild>();
+    mPendingBuild->paths = paths;
+    mPendingBuild->definitions = definitions;
+    mPendingBuild->traceName = graphics::ShaderCompiler::traceName(mDebugName, definitions);
+
+    if (buildMode == graphics::BuildMode::Deferred)
+        return;
+
+    startPreprocessing(false);
+    submitBuild();
+    finishBuild();
 }
 
 Shader::Shader(Shader&& other) noexcept
-    : mDebugName(other.mDebugName), mId(other.mId), mCache(other.mCache)
+    : mDebugName(std::move(other.mDebugName)), mId(other.mId),
+      mUniformLocations(std::move(other.mUniformLocations)), mBlockIndices(std::move(other.mBlockIndices)),
+      mPendingBuild(std::move(other.mPendingBuild))
 {
     other.mId = 0;
 }
 
 Shader::~Shader()
 {
+    if (mPendingBuild != nullptr)
+    {
+        // The job still writes to the build.
+        if (mPendingBuild->waitForPreprocessing != nullptr)
+            mPendingBuild->waitForPreprocessing();
+
+        for (const unsigned int shaderId : mPendingBuild->shaderIds)
+            glDeleteShader(shaderId);
+    }
+
     if (mId != 0)
         glDeleteProgram(mId);
 }
@@ -48,69 +77,116 @@ void Shader::unbind()
     glUseProgram(0);
 }
 
-int Shader::getLocation(const std::string &name)
+graphics::UniformHandle Shader::getUniform(const std::string &uniformName)
 {
-    if (mCache.count(name) > 0)
-        return mCache.at(name);
-    
-    const int location = glGetUniformLocation(mId, name.data());
-    if (location == -1)
-        WARN("Uniform '%' does not exist! (%)", name, mDebugName);
-    
-    mCache[name] = location;
-    return location;
+    if (const auto it = mUniformLocations.find(uniformName); it != mUniformLocations.end())
+        return { it->second };
+
+    WARN("Uniform '%' is not active! (%)", uniformName, mDebugName);
+    mUniformLocations.emplace(uniformName, -1);
+    return { -1 };
 }
 
 void Shader::set(const std::string &uniformName, const int value)
 {
-    glProgramUniform1i(mId, getLocation(uniformName), value);
+    set(getUniform(uniformName), value);
 }
 
 void Shader::set(const std::string& uniformName, const unsigned int value)
 {
-    glProgramUniform1i(mId, getLocation(uniformName), static_cast<int>(value));
+    set(getUniform(uniformName), value);
 }
 
 void Shader::set(const std::string &uniformName, const float value)
 {
-    glProgramUniform1f(mId, getLocation(uniformName), value);
+    set(getUniform(uniformName), value);
 }
 
 void Shader::set(const std::string &uniformName, const glm::mat4 &value)
 {
-    glProgramUniformMatrix4fv(mId, getLocation(uniformName), 1, GL_FALSE, glm::value_ptr(value));
+    set(getUniform(uniformName), value);
 }
 
 void Shader::set(const std::string &uniformName, const glm::vec4 &value)
 {
-    glProgramUniform4fv(mId, getLocation(uniformName), 1, glm::value_ptr(value));
+    set(getUniform(uniformName), value);
 }
 
 void Shader::set(const std::string &uniformName, const glm::vec3 &value)
 {
-    glProgramUniform3fv(mId, getLocation(uniformName), 1, glm::value_ptr(value));
+    set(getUniform(uniformName), value);
 }
 
 void Shader::set(const std::string &uniformName, const glm::vec2 &value)
 {
-    glProgramUniform2fv(mId, getLocation(uniformName), 1, glm::value_ptr(value));
+    set(getUniform(uniformName), value);
 }
 
 void Shader::set(const std::string &uniformName, const uint32_t textureId, const int bindPoint)
 {
-    glActiveTexture(GL_TEXTURE0 + bindPoint);
-    glBindTextureUnit(bindPoint, textureId);
-    set(uniformName, bindPoint);
+    set(getUniform(uniformName), textureId, bindPoint);
 }
 
 void Shader::set(const std::string &uniformName, const float *values, const int count)
 {
-    glProgramUniform1fv(mId, getLocation(uniformName), count, values);
+    set(getUniform(uniformName), values, count);
 }
 
 void Shader::set(const std::string &uniformName, const glm::mat4 *values, const int count)
 {
-    glProgramUniformMatrix4fv(mId, getLocation(uniformName), count, GL_FALSE, glm::value_ptr(values[0]));
+    set(getUniform(uniformName), values, count);
+}
+
+void Shader::set(const graphics::UniformHandle uniform, const int value) const
+{
+    glProgramUniform1i(mId, uniform.location, value);
+}
+
+void Shader::set(const graphics::UniformHandle uniform, const unsigned int value) const
+{
+    glProgramUniform1i(mId, uniform.location, static_cast<int>(value));
+}
+
+void Shader::set(const graphics::UniformHandle uniform, const float value) const
+{
+    glProgramUniform1f(mId, uniform.location, value);
+}
+
+void Shader::set(const graphics::UniformHandle uniform, const glm::mat4 &value) const
+{
+    glProgramUniformMatrix4fv(mId, uniform.location, 1, GL_FALSE, glm::value_ptr(value));
+}
+
+void Shader::set(const graphics::UniformHandle uniform, const glm::vec4 &value) const
+{
+    glProgramUniform4fv(mId, uniform.location, 1, glm::value_ptr(value));
+}
+
+void Shader::set(const graphics::UniformHandle uniform, const glm::vec3 &value) const
+{
+    glProgramUniform3fv(mId, uniform.location, 1, glm::value_ptr(value));
+}
+
+void Shader::set(const graphics::UniformHandle uniform, const glm::vec2 &value) const
+{
+    glProgramUniform2fv(mId, uniform.location, 1, glm::value_ptr(value));
+}
+
+void Shader::set(const graphics::UniformHandle uniform, const uint32_t textureId, const int bindPoint) const
+{
+    glActiveTexture(GL_TEXTURE0 + bindPoint);
+    glBindTextureUnit(bindPoint, textureId);
+    set(uniform, bindPoint);
+}
+
+void Shader::set(const graphics::UniformHandle uniform, const float *values, const int count) const
+{
+    glProgramUniform1fv(mId, uniform.location, count, values);
+}
+
+void Shader::set(const graphics::UniformHandle uniform, const glm::mat4 *values, const int count) const
+{
+    glProgramUniformMatrix4fv(mId, uniform.location, count, GL_FALSE, glm::value_ptr(values[0]));
 }
 
 void Shader::image(const std::string &uniformName, const uint32_t textureId, const GLenum textureFormat, const int bindPoint, const bool isArrayOr3D, const uint32_t permissions, const int level)
@@ -124,14 +200,14 @@ void Shader::image(const std::string &uniformName, const uint32_t textureId, con
 
 void Shader::block(const std::string& blockName, const unsigned int blockBindPoint)
 {
-    const auto blockIndex = glGetUniformBlockIndex(mId, blockName.c_str());
-    if (blockIndex == GL_INVALID_INDEX)
+    const auto it = mBlockIndices.find(blockName);
+    if (it == mBlockIndices.end())
     {
         WARN("Block with name % does not exists in shader %", blockName, mDebugName);
         return;
     }
 
-    glUniformBlockBinding(mId, blockIndex, blockBindPoint);
+    glUniformBlockBinding(mId, it->second, blockBindPoint);
 }
 
 void Shader::setDebugName(const std::string_view name) const
@@ -172,19 +248,157 @@ void Shader::CreateShaderSource(const std::initializer_list<std::filesystem::pat
         glDeleteShader(shaderId);
 }
 
-void Shader::CreateShaderSource(
-    const std::vector<std::filesystem::path>& paths, const std::vector<graphics::Definition>& macros) const
+void Shader::startPreprocessing(const bool isAsync)
 {
-    std::vector<unsigned int> shaderIds;
-    for (const std::filesystem::path &path : paths)
-        shaderIds.push_back(compileShader(path, macros));
+    graphics::PendingBuild *build = mPendingBuild.get();
+    build->startTime = std::chrono::steady_clock::now();
+
+    // Only touches the build so the shader is free to move while this runs.
+    auto preprocess = [build] {
+        PROFILE_FUNC_NAMED(build->traceName);
+        build->shaders.reserve(build->paths.size());
+        for (const std::filesystem::path &path : build->paths)
+            build->shaders.push_back(graphics::preprocessShader(path, build->definitions));
+    };
+
+    if (!isAsync)
+    {
+        preprocess();
+        return;
+    }
 
-    for (const unsigned int shaderId : shaderIds)
+    // Errors are thrown again on the main thread once the build is submitted.
+    build->waitForPreprocessing = graphics::scheduleShaderJob([build, preprocess] {
+        try
+        {
+            preprocess();
+        }
+        catch (...)
+        {
+            build->preprocessingError = std::current_exception();
+        }
+    });
+}
+
+void Shader::submitBuild()
+{
+    graphics::PendingBuild &build = *mPendingBuild;
+    if (build.isSubmitted)
+        return;
+    build.isSubmitted = true;
+
+    // The sources still have to be preprocessed to know if the binary on disk is out of date.
+    if (build.waitForPreprocessing != nullptr)
+    {
+        build.waitForPreprocessing();
+        build.waitForPreprocessing = nullptr;
+    }
+
+    if (build.preprocessingError != nullptr)
+        std::rethrow_exception(std::exchange(build.preprocessingError, nullptr));
+
+    build.cacheKey = graphics::programCacheKey(build.shaders);
+    if (graphics::loadProgramBinary(mId, build.cacheKey))
+    {
+        build.isFromCache = true;
+        return;
+    }
+
+    for (const graphics::PreprocessedShader &shader : build.shaders)
+        build.shaderIds.push_back(graphics::submitShaderSource(shader));
+
+    for (const unsigned int shaderId : build.shaderIds)
         glAttachShader(mId, shaderId);
 
+    glProgramParameteri(mId, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     glLinkProgram(mId);
-    validateProgram();
+}
 
-    for (const unsigned int shaderId : shaderIds)
-        glDeleteShader(shaderId);
+bool Shader::isBuildComplete() const
+{
+    if (mPendingBuild == nullptr || mPendingBuild->isFromCache)
+        return true;
+
+    int result { 0 };
+    glGetProgramiv(mId, GL_COMPLETION_STATUS_KHR, &result);
+    return result == GL_TRUE;
+}
+
+void Shader::finishBuild()
+{
+    graphics::PendingBuild &build = *mPendingBuild;
+    PROFILE_FUNC_NAMED(build.traceName);
+
+    if (!build.isFromCache)
+    {
+        // Compile errors are more useful than the link error they cause, so only look at them if something went wrong.
+        int result { 0 };
+        glGetProgramiv(mId, GL_LINK_STATUS, &result);
+        if (result != GL_TRUE)
+        {
+            for (int i = 0; i < build.shaderIds.size(); ++i)
+                graphics::checkShaderCompile(build.shaderIds[i], build.shaders[i]);
+        }
+
+        validateProgram();
+
+        for (const unsigned int shaderId : build.shaderIds)
+        {
+            glDetachShader(mId, shaderId);
+            glDeleteShader(shaderId);
+        }
+        build.shaderIds.clear();
+
+        graphics::saveProgramBinary(mId, build.cacheKey);
+    }
+
+    const std::chrono::duration<double, std::milli> buildTime = std::chrono::steady_clock::now() - build.startTime;
+    graphics::recordProgramBuild(build.isFromCache, buildTime.count());
+
+    mPendingBuild.reset();
+    reflectInterface();
+}
+
+void Shader::reflectInterface()
+{
+    int nameLength { 0 };
+    glGetProgramInterfaceiv(mId, GL_UNIFORM, GL_MAX_NAME_LENGTH, &nameLength);
+    int blockNameLength { 0 };
+    glGetProgramInterfaceiv(mId, GL_UNIFORM_BLOCK, GL_MAX_NAME_LENGTH, &blockNameLength);
+    std::string name(glm::max(nameLength, blockNameLength), '\0');
+
+    int uniformCount { 0 };
+    glGetProgramInterfaceiv(mId, GL_UNIFORM, GL_ACTIVE_RESOURCES, &uniformCount);
+    mUniformLocations.reserve(uniformCount);
+    for (int i = 0; i < uniformCount; ++i)
+    {
+        // Members of a uniform block don't have a location so there's nothing to cache.
+        constexpr GLenum properties[] { GL_LOCATION, GL_ARRAY_SIZE };
+        int values[2] { -1, 0 };
+        glGetProgramResourceiv(mId, GL_UNIFORM, i, 2, properties, 2, nullptr, values);
+        const int location = values[0];
+        if (location == -1)
+            continue;
+
+        int length { 0 };
+        glGetProgramResourceName(mId, GL_UNIFORM, i, static_cast<int>(name.size()), &length, name.data());
+        std::string uniformName(name.data(), length);
+
+        // Arrays are reported as "name[0]" but are set by their plain name as well.
+        if (values[1] > 1 || uniformName.back() == ']')
+        {
+            if (const size_t bracket = uniformName.rfind('['); bracket != std::string::npos)
+                mUniformLocations.emplace(uniformName.substr(0, bracket), location);
+        }
+        mUniformLocations.emplace(std::move(uniformName), location);
+    }
+
+    int blockCount { 0 };
+    glGetProgramInterfaceiv(mId, GL_UNIFORM_BLOCK, GL_ACTIVE_RESOURCES, &blockCount);
+    for (int i = 0; i < blockCount; ++i)
+    {
+        int length { 0 };
+        glGetProgramResourceName(mId, GL_UNIFORM_BLOCK, i, static_cast<int>(name.size()), &length, name.data());
+        mBlockIndices.emplace(std::string(name.data(), length), static_cast<unsigned int>(i));
+    }
 }
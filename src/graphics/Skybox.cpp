@@ -8,6 +8,7 @@
 #include "Skybox.h"
 
 #include "FramebufferObject.h"
+#include "GraphicsFunctions.h"
 #include "Mesh.h"
 #include "Primitives.h"
 
@@ -54,7 +55,7 @@ namespace graphics
             auxiliaryFrameBuffer.attach(&hdrSkybox, 0, i);
             auxiliaryFrameBuffer.clear(glm::vec4(glm::vec3(0.f), 1.f));
 
-            glDrawElements(GL_TRIANGLES, fullscreenTriangle.indicesCount(), GL_UNSIGNED_INT, nullptr);
+            drawElements(GL_TRIANGLES, fullscreenTriangle);
 
             auxiliaryFrameBuffer.detach(0);
         }
@@ -91,7 +92,7 @@ namespace graphics
             auxiliaryFrameBuffer.attach(&irradianceMap, 0, i);
             auxiliaryFrameBuffer.clear(glm::vec4(glm::vec3(0.f), 1.f));
 
-            glDrawElements(GL_TRIANGLES, fullscreenTriangle.indicesCount(), GL_UNSIGNED_INT, nullptr);
+            drawElements(GL_TRIANGLES, fullscreenTriangle);
 
             auxiliaryFrameBuffer.detach(0);
         }
@@ -134,7 +135,7 @@ namespace graphics
                 auxiliaryFrameBuffer.attach(&prefilterMap, 0, i, mip);
                 auxiliaryFrameBuffer.clear(glm::vec4(glm::vec3(0.f), 1.f));
 
-                glDrawElements(GL_TRIANGLES, fullscreenTriangle.indicesCount(), GL_UNSIGNED_INT, nullptr);
+                drawElements(GL_TRIANGLES, fullscreenTriangle);
 
                 auxiliaryFrameBuffer.detach(0);
             }
@@ -38,5 +38,6 @@ namespace graphics
         UniformBufferObject<CameraBlock> camera;
 
         glm::mat4 cameraViewProjectionMatrix;
+        glm::mat4 cameraProjectionMatrix;
     };
 } // graphics
@@ -22,8 +22,8 @@ namespace graphics
     void DebugPass::execute(
         const glm::ivec2& size,
         const Context& context,
-        const std::vector<DebugQueueObject>& debugQueue,
-        const std::vector<LineQueueObject>& lineQueue)
+        const FrameVector<DebugQueueObject>& debugQueue,
+        const FrameVector<LineQueueObject>& lineQueue)
     {
         PROFILE_FUNC();
 
@@ -36,12 +36,12 @@ namespace graphics
         mDebugFramebuffer.clear(glm::vec4(0.f));
         mDebugShader.bind();
 
-        for (const auto & [vao, count, modelMatrix, colour] : debugQueue)
+        for (const auto & [vao, count, firstIndex, baseVertex, modelMatrix, colour] : debugQueue)
         {
             mDebugShader.set("u_mvp_matrix", context.cameraViewProjectionMatrix * modelMatrix);
             mDebugShader.set("u_colour", colour);
             glBindVertexArray(vao);
-            glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr);
+            drawElements(GL_TRIANGLES, count, firstIndex, baseVertex);
         }
 
         glEnable(GL_CULL_FACE);
@@ -55,7 +55,7 @@ namespace graphics
             mLineShader.set("u_locationA", startPosition);
             mLineShader.set("u_locationB", endPosition);
             mLineShader.set("u_colour",    colour);
-            glDrawElements(GL_LINES, mLine.indicesCount(), GL_UNSIGNED_INT, nullptr);
+            drawElements(GL_LINES, mLine);
         }
 
         mDebugFramebuffer.detach(0);
@@ -10,6 +10,7 @@
 #include "Context.h"
 #include "DebugGBufferBlock.h"
 #include "FileLoader.h"
+#include "FrameArena.h"
 #include "LookUpTables.h"
 #include "Mesh.h"
 #include "Pch.h"
@@ -27,7 +28,7 @@ namespace graphics
     {
     public:
         DebugPass();
-        void execute(const glm::ivec2 &size, const Context &context, const std::vector<DebugQueueObject> &debugQueue, const std::vector<LineQueueObject> &lineQueue);
+        void execute(const glm::ivec2 &size, const Context &context, const FrameVector<DebugQueueObject> &debugQueue, const FrameVector<LineQueueObject> &lineQueue);
         TextureBufferObject &tileOverlay(const glm::ivec2 &size, const Context &context);
         TextureBufferObject &whiteFurnaceTest(const glm::ivec2& size, const Context& context, const Lut &lut);
         TextureBufferObject &queryGBuffer(
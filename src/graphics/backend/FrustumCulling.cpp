@@ -0,0 +1,139 @@
+/**
+ * @file FrustumCulling.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "FrustumCulling.h"
+
+#include <limits>
+
+#include "ProfileTimer.h"
+
+namespace graphics
+{
+    Frustum extractFrustum(const glm::mat4 &viewProjectionMatrix)
+    {
+        const glm::mat4 transposed = glm::transpose(viewProjectionMatrix);
+        const glm::vec4 planes[6] {
+            transposed[3] + transposed[0],  // Left
+            transposed[3] - transposed[0],  // Right
+            transposed[3] + transposed[1],  // Bottom
+            transposed[3] - transposed[1],  // Top
+            transposed[3] + transposed[2],  // Near
+            transposed[3] - transposed[2],  // Far
+        };
+
+        Frustum frustum { };
+        for (int i = 0; i < 6; ++i)
+        {
+            const glm::vec4 plane = planes[i] / glm::length(glm::vec3(planes[i]));
+            frustum.x[i] = plane.x;
+            frustum.y[i] = plane.y;
+            frustum.z[i] = plane.z;
+            frustum.w[i] = plane.w;
+        }
+
+        return frustum;
+    }
+
+    Frustum extendTowardsEye(const Frustum &frustum)
+    {
+        // A plane with no normal and an infinite distance that every sphere is in front of.
+        constexpr int nearPlane = 4;
+        Frustum result = frustum;
+        result.x[nearPlane] = 0.f;
+        result.y[nearPlane] = 0.f;
+        result.z[nearPlane] = 0.f;
+        result.w[nearPlane] = std::numeric_limits<float>::infinity();
+        return result;
+    }
+
+    void cullSpheres(
+        const Frustum &frustum,
+        const float *x, const float *y, const float *z, const float *radius,
+        const size_t count, uint8_t *outVisible)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint8_t inside = 1;
+            for (int p = 0; p < 6; ++p)
+            {
+                const float distance = frustum.x[p] * x[i] + frustum.y[p] * y[i] + frustum.z[p] * z[i] + frustum.w[p];
+                inside &= static_cast<uint8_t>(distance > -radius[i]);
+            }
+            outVisible[i] = inside;
+        }
+    }
+
+    void cullSpheres(
+        const BoundingSphere &volume,
+        const float *x, const float *y, const float *z, const float *radius,
+        const size_t count, uint8_t *outVisible)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float dx = x[i] - volume.centre.x;
+            const float dy = y[i] - volume.centre.y;
+            const float dz = z[i] - volume.centre.z;
+            const float reach = radius[i] + volume.radius;
+            outVisible[i] = static_cast<uint8_t>(dx * dx + dy * dy + dz * dz <= reach * reach);
+        }
+    }
+
+    void cullSpheres(
+        const Cone &cone,
+        const float *x, const float *y, const float *z, const float *radius,
+        const size_t count, uint8_t *outVisible)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float dx = x[i] - cone.apex.x;
+            const float dy = y[i] - cone.apex.y;
+            const float dz = z[i] - cone.apex.z;
+            const float distanceSquared = dx * dx + dy * dy + dz * dz;
+            const float alongAxis = dx * cone.direction.x + dy * cone.direction.y + dz * cone.direction.z;
+            const float fromAxis = glm::sqrt(glm::max(distanceSquared - alongAxis * alongAxis, 0.f));
+
+            // Signed distance from the centre to the cone's side, measured perpendicular to it.
+            const float fromSide = cone.cosAngle * fromAxis - cone.sinAngle * alongAxis;
+
+            uint8_t inside = static_cast<uint8_t>(fromSide <= radius[i]);
+            inside &= static_cast<uint8_t>(alongAxis >= -radius[i]);
+            inside &= static_cast<uint8_t>(alongAxis <= cone.range + radius[i]);
+            outVisible[i] = inside;
+        }
+    }
+
+    void FrustumCuller::cull(
+        const Frustum &frustum, const FrameVector<GeometryObject> &geometryQueue, std::vector<uint32_t> &visibleIndices)
+    {
+        PROFILE_FUNC();
+        const size_t count = geometryQueue.size();
+
+        mX.resize(count);
+        mY.resize(count);
+        mZ.resize(count);
+        mRadius.resize(count);
+        mVisible.resize(count);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const BoundingSphere &sphere = geometryQueue[i].worldBounds;
+            mX[i] = sphere.centre.x;
+            mY[i] = sphere.centre.y;
+            mZ[i] = sphere.centre.z;
+            mRadius[i] = sphere.radius;
+        }
+
+        cullSpheres(frustum, mX.data(), mY.data(), mZ.data(), mRadius.data(), count, mVisible.data());
+
+        visibleIndices.clear();
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (mVisible[i] != 0)
+                visibleIndices.push_back(static_cast<uint32_t>(i));
+        }
+    }
+} // graphics
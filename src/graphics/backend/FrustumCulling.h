@@ -0,0 +1,98 @@
+/**
+ * @file FrustumCulling.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include "FrameArena.h"
+#include "GraphicsDefinitions.h"
+#include "Pch.h"
+
+namespace graphics
+{
+    /**
+     * @brief The six planes of a view frustum stored as a structure of arrays. The normals point inwards.
+     */
+    struct Frustum
+    {
+        float x[6];
+        float y[6];
+        float z[6];
+        float w[6];
+    };
+
+    /**
+     * @brief A cone with its apex at a light. Spheres are tested against the cone capped at range.
+     */
+    struct Cone
+    {
+        glm::vec3 apex { 0.f };
+        glm::vec3 direction { 0.f, 0.f, -1.f };  // Must be normalised.
+        float cosAngle { 1.f };
+        float sinAngle { 0.f };
+        float range { 0.f };
+    };
+
+    /**
+     * @brief Extracts the normalised frustum planes from an OpenGL style view projection matrix (Gribb-Hartmann).
+     */
+    Frustum extractFrustum(const glm::mat4 &viewProjectionMatrix);
+
+    /**
+     * @brief Removes the near plane so that anything between the eye and the frustum also passes. Used by
+     * directional lights since casters behind a cascade can still shadow it.
+     */
+    Frustum extendTowardsEye(const Frustum &frustum);
+
+    /**
+     * @brief Tests count spheres against the frustum. Kept over flat arrays with no early out so that the compiler
+     * can vectorise the loop over the spheres.
+     * @param outVisible Set to 1 when the sphere intersects the frustum, otherwise 0. Must hold count elements.
+     */
+    void cullSpheres(
+        const Frustum &frustum,
+        const float *x, const float *y, const float *z, const float *radius,
+        size_t count, uint8_t *outVisible);
+
+    /**
+     * @brief Tests count spheres against another sphere, such as a light's influence.
+     * @param outVisible Set to 1 when the spheres overlap, otherwise 0. Must hold count elements.
+     */
+    void cullSpheres(
+        const BoundingSphere &volume,
+        const float *x, const float *y, const float *z, const float *radius,
+        size_t count, uint8_t *outVisible);
+
+    /**
+     * @brief Tests count spheres against a cone. Conservative near the cap, where spheres just outside the range can pass.
+     * @param outVisible Set to 1 when the sphere intersects the cone, otherwise 0. Must hold count elements.
+     */
+    void cullSpheres(
+        const Cone &cone,
+        const float *x, const float *y, const float *z, const float *radius,
+        size_t count, uint8_t *outVisible);
+
+    /**
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class FrustumCuller
+    {
+    public:
+        /**
+         * @brief Fills visibleIndices with the index of every geometry object whose bounds intersect the frustum.
+         * The order of the queue is preserved.
+         */
+        void cull(const Frustum &frustum, const FrameVector<GeometryObject> &geometryQueue, std::vector<uint32_t> &visibleIndices);
+
+    protected:
+        std::vector<float> mX;
+        std::vector<float> mY;
+        std::vector<float> mZ;
+        std::vector<float> mRadius;
+        std::vector<uint8_t> mVisible;
+    };
+} // graphics
@@ -0,0 +1,202 @@
+/**
+ * @file InstanceBatching.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "InstanceBatching.h"
+
+#include "ProfileTimer.h"
+
+#include <cstring>
+
+namespace graphics
+{
+    namespace
+    {
+        // Sort key layout, most significant first: 20 bits of state, 20 bits of state, 24 bits of view depth.
+        // The material pass uses the material then the mesh id. Shadow and depth passes use the vao then the mesh id.
+        // Mesh ids are dense, so they only get masked past a million live meshes. That only weakens the grouping since
+        // batches compare the full values.
+        constexpr uint64_t stateMask = (1ull << 20) - 1;
+        constexpr int highStateShift = 44;
+        constexpr int lowStateShift = 24;
+
+        uint64_t makeKey(const uint32_t highState, const uint32_t lowState, const uint64_t depth)
+        {
+            return (static_cast<uint64_t>(highState) & stateMask) << highStateShift
+                 | (static_cast<uint64_t>(lowState) & stateMask) << lowStateShift
+                 | depth;
+        }
+
+        /**
+         * @returns The distance to the nearest point of the bounds along the view direction, in 24 bits.
+         * Positive floats sort the same as their bit patterns, so dropping the low mantissa bits keeps the order.
+         */
+        uint64_t quantiseDepth(const glm::mat4 &viewMatrix, const BoundingSphere &bounds)
+        {
+            const float viewDepth = glm::max(0.f, -(viewMatrix * glm::vec4(bounds.centre, 1.f)).z - bounds.radius);
+            uint32_t bits;
+            std::memcpy(&bits, &viewDepth, sizeof(float));
+            return bits >> 8;
+        }
+    }
+
+    uint32_t countStateChanges(
+        const FrameVector<GeometryObject> &geometryQueue, const FrameVector<uint32_t> &materials,
+        const std::vector<uint32_t> &visible)
+    {
+        uint32_t changes = 0;
+        const uint32_t *previous = nullptr;
+        for (const uint32_t &i : visible)
+        {
+            if (previous == nullptr
+                || geometryQueue[i].vao != geometryQueue[*previous].vao
+                || materials[i] != materials[*previous])
+                ++changes;
+            previous = &i;
+        }
+
+        return changes;
+    }
+
+    uint32_t countStateChanges(const InstanceBatch *batches, const size_t batchCount)
+    {
+        uint32_t changes = 0;
+        for (size_t i = 0; i < batchCount; ++i)
+        {
+            if (i == 0
+                || batches[i].vao != batches[i - 1].vao
+                || batches[i].materialIndex != batches[i - 1].materialIndex)
+                ++changes;
+        }
+
+        return changes;
+    }
+
+    void InstanceBatcher::batchByMaterial(
+        const FrameVector<GeometryObject> &geometryQueue, const FrameVector<uint32_t> &materials,
+        const std::vector<uint32_t> &visible, const glm::mat4 &viewMatrix,
+        std::vector<InstanceBatch> &batches, std::vector<glm::mat4> &matrices)
+    {
+        PROFILE_FUNC();
+        mKeys.clear();
+        mKeys.reserve(visible.size());
+        for (const uint32_t i : visible)
+        {
+            const GeometryObject &geometry = geometryQueue[i];
+            const uint64_t key = makeKey(materials[i], geometry.meshId, quantiseDepth(viewMatrix, geometry.worldBounds));
+            mKeys.push_back({ key, geometry.vao, geometry.indicesCount, geometry.firstIndex, geometry.baseVertex, materials[i], i });
+        }
+
+        emitBatches(geometryQueue, batches, matrices, nullptr);
+    }
+
+    void InstanceBatcher::batchByMesh(
+        const FrameVector<GeometryObject> &geometryQueue, const std::vector<uint32_t> &indices,
+        std::vector<InstanceBatch> &batches, std::vector<glm::mat4> &matrices, std::vector<BoundingSphere> &bounds)
+    {
+        PROFILE_FUNC();
+        mKeys.clear();
+        mKeys.reserve(indices.size());
+        for (const uint32_t i : indices)
+        {
+            const GeometryObject &geometry = geometryQueue[i];
+            const uint64_t key = makeKey(geometry.vao, geometry.meshId, 0);
+            mKeys.push_back({ key, geometry.vao, geometry.indicesCount, geometry.firstIndex, geometry.baseVertex, 0, i });
+        }
+
+        emitBatches(geometryQueue, batches, matrices, &bounds);
+    }
+
+    void InstanceBatcher::batchByMesh(
+        const FrameVector<GeometryObject> &geometryQueue, const std::vector<uint32_t> &indices,
+        const glm::mat4 &viewMatrix, std::vector<InstanceBatch> &batches, std::vector<glm::mat4> &matrices)
+    {
+        PROFILE_FUNC();
+        mKeys.clear();
+        mKeys.reserve(indices.size());
+        for (const uint32_t i : indices)
+        {
+            const GeometryObject &geometry = geometryQueue[i];
+            const uint64_t key = makeKey(geometry.vao, geometry.meshId, quantiseDepth(viewMatrix, geometry.worldBounds));
+            mKeys.push_back({ key, geometry.vao, geometry.indicesCount, geometry.firstIndex, geometry.baseVertex, 0, i });
+        }
+
+        emitBatches(geometryQueue, batches, matrices, nullptr);
+    }
+
+    void InstanceBatcher::sortKeys()
+    {
+        constexpr int digitCount = sizeof(uint64_t);
+        constexpr int radix = 256;
+
+        // Every digit's histogram is built in one go.
+        uint32_t counts[digitCount][radix] = { };
+        for (const SortKey &key : mKeys)
+        {
+            for (int digit = 0; digit < digitCount; ++digit)
+                ++counts[digit][(key.key >> (digit * 8)) & 0xFF];
+        }
+
+        mScratch.resize(mKeys.size());
+        for (int digit = 0; digit < digitCount; ++digit)
+        {
+            uint32_t *count = counts[digit];
+
+            // Every key has the same value for this digit. This is common for the high bits of small ids.
+            if (count[(mKeys.front().key >> (digit * 8)) & 0xFF] == mKeys.size())
+                continue;
+
+            uint32_t offset = 0;
+            for (int bucket = 0; bucket < radix; ++bucket)
+            {
+                const uint32_t bucketSize = count[bucket];
+                count[bucket] = offset;
+                offset += bucketSize;
+            }
+
+            for (const SortKey &key : mKeys)
+                mScratch[count[(key.key >> (digit * 8)) & 0xFF]++] = key;
+
+            mKeys.swap(mScratch);
+        }
+    }
+
+    void InstanceBatcher::emitBatches(
+        const FrameVector<GeometryObject> &geometryQueue, std::vector<InstanceBatch> &batches,
+        std::vector<glm::mat4> &matrices, std::vector<BoundingSphere> *bounds)
+    {
+        if (mKeys.empty())
+            return;
+
+        // The sort is stable, so keys that tie keep their submission order.
+        sortKeys();
+
+        const SortKey *previous = nullptr;
+        for (const SortKey &key : mKeys)
+        {
+            const bool canJoin = previous != nullptr
+                && key.vao == previous->vao
+                && key.indicesCount == previous->indicesCount
+                && key.firstIndex == previous->firstIndex
+                && key.baseVertex == previous->baseVertex
+                && key.materialIndex == previous->materialIndex;
+
+            if (canJoin)
+                ++batches.back().instanceCount;
+            else
+            {
+                batches.push_back({
+                    key.vao, key.indicesCount, key.firstIndex, key.baseVertex,
+                    static_cast<uint32_t>(matrices.size()), 1, key.materialIndex });
+            }
+
+            matrices.push_back(geometryQueue[key.index].matrix);
+            if (bounds != nullptr)
+                bounds->push_back(geometryQueue[key.index].worldBounds);
+            previous = &key;
+        }
+    }
+} // graphics
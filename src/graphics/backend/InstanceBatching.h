@@ -0,0 +1,100 @@
+/**
+ * @file InstanceBatching.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include "FrameArena.h"
+#include "GraphicsDefinitions.h"
+#include "Pch.h"
+
+namespace graphics
+{
+    /**
+     * @brief A group of geometry objects that can be drawn with one instanced draw call.
+     */
+    struct InstanceBatch
+    {
+        uint32_t vao;
+        int32_t indicesCount;
+        uint32_t firstIndex;
+        int32_t baseVertex;
+        uint32_t firstInstance;  // Offset into the instance matrices.
+        uint32_t instanceCount;
+        uint32_t materialIndex;  // Into the material table. Unused when batched by mesh.
+    };
+
+    /**
+     * @returns How many times the vao or material changes when drawing the visible geometry in submission order.
+     */
+    uint32_t countStateChanges(
+        const FrameVector<GeometryObject> &geometryQueue, const FrameVector<uint32_t> &materials,
+        const std::vector<uint32_t> &visible);
+
+    /**
+     * @returns How many times the vao or material changes when drawing the batches in order.
+     */
+    uint32_t countStateChanges(const InstanceBatch *batches, size_t batchCount);
+
+    /**
+     * @brief Batches are ordered by a 64-bit sort key so that draws with the same state end up next to each other.
+     * Each batch's instances are ordered nearest first when a view matrix is given.
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class InstanceBatcher
+    {
+    public:
+        /**
+         * @brief Groups the visible geometry that shares a mesh and a material index. Batches are ordered by material,
+         * then by mesh. Batches and model matrices are appended so that several queues can share one instance buffer.
+         */
+        void batchByMaterial(
+            const FrameVector<GeometryObject> &geometryQueue, const FrameVector<uint32_t> &materials,
+            const std::vector<uint32_t> &visible, const glm::mat4 &viewMatrix,
+            std::vector<InstanceBatch> &batches, std::vector<glm::mat4> &matrices);
+
+        /**
+         * @brief Groups the selected geometry that shares a mesh, nearest first. For depth pre-passes.
+         */
+        void batchByMesh(
+            const FrameVector<GeometryObject> &geometryQueue, const std::vector<uint32_t> &indices,
+            const glm::mat4 &viewMatrix, std::vector<InstanceBatch> &batches, std::vector<glm::mat4> &matrices);
+
+        /**
+         * @brief Groups the selected geometry that shares a mesh. For passes that only need depth.
+         * @param indices The geometry to batch from the queue.
+         * @param bounds The world bounds of each instance, in the same order as the matrices.
+         */
+        void batchByMesh(
+            const FrameVector<GeometryObject> &geometryQueue, const std::vector<uint32_t> &indices,
+            std::vector<InstanceBatch> &batches, std::vector<glm::mat4> &matrices, std::vector<BoundingSphere> &bounds);
+
+    protected:
+        struct SortKey
+        {
+            uint64_t key;
+            uint32_t vao;
+            int32_t indicesCount;
+            uint32_t firstIndex;
+            int32_t baseVertex;
+            uint32_t materialIndex;
+            uint32_t index;
+        };
+
+        /**
+         * @brief A stable LSD radix sort of mKeys by key, one byte at a time.
+         */
+        void sortKeys();
+
+        void emitBatches(
+            const FrameVector<GeometryObject> &geometryQueue, std::vector<InstanceBatch> &batches,
+            std::vector<glm::mat4> &matrices, std::vector<BoundingSphere> *bounds);
+
+        std::vector<SortKey> mKeys;
+        std::vector<SortKey> mScratch;
+    };
+} // graphics
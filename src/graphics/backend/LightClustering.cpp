@@ -0,0 +1,188 @@
+/**
+ * @file LightClustering.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "LightClustering.h"
+
+#include "Logger.h"
+#include "LoggerMacros.h"
+#include "ProfileTimer.h"
+
+namespace graphics
+{
+    uint32_t clusterSlice(const float viewDepth, const float zNear, const float zFar)
+    {
+        if (viewDepth <= zNear)
+            return 0;
+
+        const float slice = glm::log(viewDepth / zNear) / glm::log(zFar / zNear) * static_cast<float>(CLUSTER_COUNT_Z);
+        return glm::min(static_cast<uint32_t>(slice), static_cast<uint32_t>(CLUSTER_COUNT_Z - 1));
+    }
+
+    bool findClusterBounds(
+        const BoundingSphere &viewSphere, const glm::mat4 &projectionMatrix, const float zNear, const float zFar,
+        ClusterBounds &outBounds)
+    {
+        // The camera looks down -z in view space.
+        const float nearestDepth = -viewSphere.centre.z - viewSphere.radius;
+        const float furthestDepth = -viewSphere.centre.z + viewSphere.radius;
+        if (furthestDepth < zNear || nearestDepth > zFar)
+            return false;
+
+        outBounds.min.z = clusterSlice(nearestDepth, zNear, zFar);
+        outBounds.max.z = clusterSlice(glm::min(furthestDepth, zFar), zNear, zFar);
+
+        // Anything crossing the near plane can't be projected, so it covers the whole screen.
+        if (nearestDepth <= zNear)
+        {
+            outBounds.min.x = 0;
+            outBounds.min.y = 0;
+            outBounds.max.x = CLUSTER_COUNT_X - 1;
+            outBounds.max.y = CLUSTER_COUNT_Y - 1;
+            return true;
+        }
+
+        glm::vec2 minNdc(std::numeric_limits<float>::max());
+        glm::vec2 maxNdc(std::numeric_limits<float>::lowest());
+        for (int i = 0; i < 8; ++i)
+        {
+            const glm::vec3 corner = viewSphere.centre + viewSphere.radius * glm::vec3(
+                i & 1 ? 1.f : -1.f, i & 2 ? 1.f : -1.f, i & 4 ? 1.f : -1.f);
+            const glm::vec4 clip = projectionMatrix * glm::vec4(corner, 1.f);
+            const glm::vec2 ndc = glm::vec2(clip) / clip.w;
+            minNdc = glm::min(minNdc, ndc);
+            maxNdc = glm::max(maxNdc, ndc);
+        }
+
+        if (maxNdc.x < -1.f || maxNdc.y < -1.f || minNdc.x > 1.f || minNdc.y > 1.f)
+            return false;
+
+        const glm::vec2 counts(CLUSTER_COUNT_X, CLUSTER_COUNT_Y);
+        const glm::vec2 minTile = glm::clamp(glm::floor((0.5f * minNdc + 0.5f) * counts), glm::vec2(0.f), counts - 1.f);
+        const glm::vec2 maxTile = glm::clamp(glm::floor((0.5f * maxNdc + 0.5f) * counts), glm::vec2(0.f), counts - 1.f);
+        outBounds.min.x = static_cast<uint32_t>(minTile.x);
+        outBounds.min.y = static_cast<uint32_t>(minTile.y);
+        outBounds.max.x = static_cast<uint32_t>(maxTile.x);
+        outBounds.max.y = static_cast<uint32_t>(maxTile.y);
+        return true;
+    }
+
+    BoundingSphere spotlightBounds(const Spotlight &spotlight)
+    {
+        const float angle = spotlight.outerAngle;
+
+        // Wide cones are bounded by the circle at their base. Narrow ones are tighter with the apex on the sphere.
+        if (angle > glm::quarter_pi<float>())
+        {
+            return {
+                spotlight.position + glm::cos(angle) * spotlight.radius * spotlight.direction,
+                glm::sin(angle) * spotlight.radius
+            };
+        }
+
+        const float radius = spotlight.radius / (2.f * glm::cos(angle));
+        return { spotlight.position + radius * spotlight.direction, radius };
+    }
+
+    template<typename TFunction>
+    void LightClusterer::forEachCluster(const ClusterBounds &bounds, TFunction function)
+    {
+        for (uint32_t z = bounds.min.z; z <= bounds.max.z; ++z)
+        {
+            for (uint32_t y = bounds.min.y; y <= bounds.max.y; ++y)
+            {
+                for (uint32_t x = bounds.min.x; x <= bounds.max.x; ++x)
+                    function(x + y * CLUSTER_COUNT_X + z * CLUSTER_COUNT_X * CLUSTER_COUNT_Y);
+            }
+        }
+    }
+
+    void LightClusterer::build(
+        const glm::mat4 &viewMatrix, const glm::mat4 &projectionMatrix, const float zNear, const float zFar,
+        const FrameVector<PointLight> &pointLights, const FrameVector<Spotlight> &spotlights)
+    {
+        PROFILE_FUNC();
+        mRanges.assign(clusterCount, ClusterRange { });
+
+        const auto toViewSpace = [&viewMatrix](const BoundingSphere &sphere) {
+            return BoundingSphere { glm::vec3(viewMatrix * glm::vec4(sphere.centre, 1.f)), sphere.radius };
+        };
+
+        // Lights past the limit can't be gathered by the shader, so they're never binned.
+        const auto countDropped = [](const size_t lightCount) {
+            return static_cast<uint32_t>(lightCount > CLUSTER_MAX_LIGHTS ? lightCount - CLUSTER_MAX_LIGHTS : 0);
+        };
+        mDroppedLightCount = countDropped(pointLights.size()) + countDropped(spotlights.size());
+        if (mDroppedLightCount > 0 && !mHasWarnedAboutDroppedLights)
+        {
+            WARN("% point lights and % spotlights were submitted but only % of each can be shaded. The rest are ignored.",
+                 pointLights.size(), spotlights.size(), CLUSTER_MAX_LIGHTS);
+            mHasWarnedAboutDroppedLights = true;
+        }
+
+        // Count how many lights land in each cluster so that the index list can be laid out in one go.
+        mPointLightBounds.resize(pointLights.size());
+        mIsPointLightVisible.resize(pointLights.size());
+        for (size_t i = 0; i < pointLights.size(); ++i)
+        {
+            const BoundingSphere viewSphere = toViewSpace({ pointLights[i].position, pointLights[i].radius });
+            mIsPointLightVisible[i] = i < CLUSTER_MAX_LIGHTS && findClusterBounds(viewSphere, projectionMatrix, zNear, zFar, mPointLightBounds[i]);
+            if (mIsPointLightVisible[i] != 0)
+                forEachCluster(mPointLightBounds[i], [this](const uint32_t cluster) { ++mRanges[cluster].pointLightCount; });
+        }
+
+        mSpotlightBounds.resize(spotlights.size());
+        mIsSpotlightVisible.resize(spotlights.size());
+        for (size_t i = 0; i < spotlights.size(); ++i)
+        {
+            const BoundingSphere viewSphere = toViewSpace(spotlightBounds(spotlights[i]));
+            mIsSpotlightVisible[i] = i < CLUSTER_MAX_LIGHTS && findClusterBounds(viewSphere, projectionMatrix, zNear, zFar, mSpotlightBounds[i]);
+            if (mIsSpotlightVisible[i] != 0)
+                forEachCluster(mSpotlightBounds[i], [this](const uint32_t cluster) { ++mRanges[cluster].spotlightCount; });
+        }
+
+        uint32_t offset = 0;
+        for (ClusterRange &range : mRanges)
+        {
+            range.offset = offset;
+            offset += range.pointLightCount + range.spotlightCount;
+        }
+        mLightIndices.resize(offset);
+
+        // The counts are rebuilt as each index is written. Point lights are written first so that their count is
+        // final by the time the spotlights are placed after them.
+        for (ClusterRange &range : mRanges)
+        {
+            range.pointLightCount = 0;
+            range.spotlightCount = 0;
+        }
+
+        for (uint32_t i = 0; i < pointLights.size(); ++i)
+        {
+            if (mIsPointLightVisible[i] == 0)
+                continue;
+
+            forEachCluster(mPointLightBounds[i], [this, i](const uint32_t cluster) {
+                ClusterRange &range = mRanges[cluster];
+                mLightIndices[range.offset + range.pointLightCount++] = i;
+            });
+        }
+
+        for (uint32_t i = 0; i < spotlights.size(); ++i)
+        {
+            if (mIsSpotlightVisible[i] == 0)
+                continue;
+
+            forEachCluster(mSpotlightBounds[i], [this, i](const uint32_t cluster) {
+                ClusterRange &range = mRanges[cluster];
+                mLightIndices[range.offset + range.pointLightCount + range.spotlightCount++] = i;
+            });
+        }
+
+        PROFILE_COUNTER("Clustered Light Indices", mLightIndices.size());
+        PROFILE_COUNTER("Clustered Lights Dropped", mDroppedLightCount);
+    }
+} // graphics
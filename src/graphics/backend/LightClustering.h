@@ -0,0 +1,99 @@
+/**
+ * @file LightClustering.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include "BoundingVolumes.h"
+#include "ClusteredLights.h"
+#include "FrameArena.h"
+#include "GraphicsLighting.h"
+#include "Pch.h"
+
+namespace graphics
+{
+    constexpr uint32_t clusterCount = CLUSTER_COUNT_X * CLUSTER_COUNT_Y * CLUSTER_COUNT_Z;
+
+    /**
+     * @brief The inclusive range of clusters that a light touches.
+     */
+    struct ClusterBounds
+    {
+        glm::uvec3 min { 0 };
+        glm::uvec3 max { 0 };
+    };
+
+    /**
+     * @returns The depth slice that a positive view space depth falls in. Slices grow exponentially so that
+     * clusters stay roughly cubic. Must match ClusteredLighting.comp.
+     */
+    uint32_t clusterSlice(float viewDepth, float zNear, float zFar);
+
+    /**
+     * @brief Finds the clusters that a view space sphere overlaps. The screen bounds come from projecting the
+     * sphere's box, so they are conservative.
+     * @returns false if the sphere is outside of the view frustum.
+     */
+    bool findClusterBounds(
+        const BoundingSphere &viewSphere, const glm::mat4 &projectionMatrix, float zNear, float zFar, ClusterBounds &outBounds);
+
+    /**
+     * @returns The smallest world space sphere that encloses the spotlight's cone.
+     */
+    BoundingSphere spotlightBounds(const Spotlight &spotlight);
+
+    /**
+     * @brief Bins the point lights and spotlights into clusters each frame so that the lighting shader only
+     * loops over the lights that can affect each pixel.
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class LightClusterer
+    {
+    public:
+        /**
+         * @brief Bins the lights for this frame. Only the first CLUSTER_MAX_LIGHTS of each type can be shaded, so
+         * the rest are dropped. Dropped lights are counted by the profiler and warned about the first time.
+         */
+        void build(
+            const glm::mat4 &viewMatrix, const glm::mat4 &projectionMatrix, float zNear, float zFar,
+            const FrameVector<PointLight> &pointLights, const FrameVector<Spotlight> &spotlights);
+
+        /**
+         * @returns One range for each cluster, indexed by x + y * CLUSTER_COUNT_X + z * CLUSTER_COUNT_X * CLUSTER_COUNT_Y.
+         */
+        [[nodiscard]] const std::vector<ClusterRange> &getRanges() const { return mRanges; }
+
+        /**
+         * @returns The light indices of every cluster, back to back.
+         */
+        [[nodiscard]] const std::vector<uint32_t> &getLightIndices() const { return mLightIndices; }
+
+        /**
+         * @returns How many lights the last build() dropped for going over CLUSTER_MAX_LIGHTS.
+         */
+        [[nodiscard]] uint32_t getDroppedLightCount() const { return mDroppedLightCount; }
+
+    protected:
+        /**
+         * @brief Calls function with the index of every cluster within bounds.
+         */
+        template<typename TFunction>
+        static void forEachCluster(const ClusterBounds &bounds, TFunction function);
+
+        std::vector<ClusterRange> mRanges;
+        std::vector<uint32_t> mLightIndices;
+
+        // Only valid for the lights that are visible.
+        std::vector<ClusterBounds> mPointLightBounds;
+        std::vector<ClusterBounds> mSpotlightBounds;
+        std::vector<uint8_t> mIsPointLightVisible;
+        std::vector<uint8_t> mIsSpotlightVisible;
+
+        uint32_t mDroppedLightCount { 0 };
+        bool mHasWarnedAboutDroppedLights { false };
+    };
+} // graphics
@@ -16,33 +16,67 @@ namespace graphics
 {
     LightShadingPass::LightShadingPass()
     {
+        PROFILE_FUNC();
         generateIblShaderVariants(file::shaderPath() / "lighting/IBL.comp");
-        for (auto &[ibl, _] : mIblShaderVariants)
-            ibl.block("CameraBlock", 0);
-
         mDirectionalLightShaderVariants = generateLightShaderVariants(file::shaderPath() / "lighting/DirectionalLight.comp");
-        for (auto &[shader, _] : mDirectionalLightShaderVariants)
-        {
-            shader.block("CameraBlock", 0);
-            shader.block("DirectionalLightBlock", 1);
-        }
-
         mPointLightShaderVariants = generateLightShaderVariants(file::shaderPath() / "lighting/PointLight.comp");
-        for (auto &[shader, _] : mPointLightShaderVariants)
-        {
-           shader.block("CameraBlock", 0);
-           shader.block("PointLightBlock", 1);
-        }
-
         mSpotlightShaderVariants = generateLightShaderVariants(file::shaderPath() / "lighting/Spotlight.comp");
-        for (auto &[shader, _] : mSpotlightShaderVariants)
-        {
-           shader.block("CameraBlock", 0);
-           shader.block("SpotlightBlock", 1);
-        }
+        if (isClusteredLightingSupported())
+            mClusteredLightShaderVariants = generateLightShaderVariants(file::shaderPath() / "lighting/ClusteredLighting.comp");
+        else
+            WARN("Bindless textures are not supported. Point lights and spotlights will be shaded one at a time.");
+
+        // The vectors are final now so the shaders won't move while they're being compiled.
+        for (int i = 0; i < mIblShaderVariants.size(); ++i)
+            mShaderCompiler.submit(mIblShaderVariants[i].shader, isLazyVariant(i), [](Shader &shader) {
+                shader.block("CameraBlock", 0);
+            });
+
+        for (int i = 0; i < mDirectionalLightShaderVariants.size(); ++i)
+            mShaderCompiler.submit(mDirectionalLightShaderVariants[i].shader, isLazyVariant(i), [](Shader &shader) {
+                shader.block("CameraBlock", 0);
+                shader.block("DirectionalLightBlock", 1);
+            });
+
+        for (int i = 0; i < mPointLightShaderVariants.size(); ++i)
+            mShaderCompiler.submit(mPointLightShaderVariants[i].shader, isLazyVariant(i), [](Shader &shader) {
+                shader.block("CameraBlock", 0);
+                shader.block("PointLightBlock", 1);
+            });
+
+        for (int i = 0; i < mSpotlightShaderVariants.size(); ++i)
+            mShaderCompiler.submit(mSpotlightShaderVariants[i].shader, isLazyVariant(i), [](Shader &shader) {
+                shader.block("CameraBlock", 0);
+                shader.block("SpotlightBlock", 1);
+            });
+
+        for (int i = 0; i < mClusteredLightShaderVariants.size(); ++i)
+            mShaderCompiler.submit(mClusteredLightShaderVariants[i].shader, isLazyVariant(i), [](Shader &shader) {
+                shader.block("CameraBlock", 0);
+            });
+
+        mShaderCompiler.finish();
+    }
+
+    bool LightShadingPass::updateShaderVariants()
+    {
+        return mShaderCompiler.update();
+    }
+
+    bool LightShadingPass::isClusteredLightingSupported()
+    {
+        static const bool isSupported = GLEW_ARB_bindless_texture;
+        return isSupported;
     }
 
-    void LightShadingPass::execute(Context& context, const Lut &lut, const std::vector<DirectionalLight>& directionalLightQueue)
+    bool LightShadingPass::isLazyVariant(const int variantIndex)
+    {
+        // Variants are generated in shaderVariant order. Every tile can be shaded by the uber variant, so the
+        // others only need to be ready once the tile classification starts using them.
+        return static_cast<shaderVariant>(variantIndex) != shaderVariant::UberShader;
+    }
+
+    void LightShadingPass::execute(Context& context, const Lut &lut, const FrameVector<DirectionalLight>& directionalLightQueue)
     {
         if (directionalLightQueue.empty())
             return;
@@ -57,6 +91,12 @@ namespace graphics
         int indirectOffset = 0;
         for (auto &[shader, callback] : mDirectionalLightShaderVariants)
         {
+            if (!shader.isBuilt())
+            {
+                ++indirectOffset;
+                continue;
+            }
+
             shader.bind();
 
             shader.set("depthBufferTexture", context.depthBuffer.getId(), 0);
@@ -87,7 +127,7 @@ namespace graphics
         popDebugGroup();
     }
 
-    void LightShadingPass::execute(Context& context, const Lut &lut, const std::vector<PointLight>& pointLightQueue)
+    void LightShadingPass::execute(Context& context, const Lut &lut, const FrameVector<PointLight>& pointLightQueue)
     {
         if (pointLightQueue.empty())
             return;
@@ -102,6 +142,12 @@ namespace graphics
         int indirectOffset = 0;
         for (auto &[shader, callback] : mPointLightShaderVariants)
         {
+            if (!shader.isBuilt())
+            {
+                ++indirectOffset;
+                continue;
+            }
+
             shader.bind();
             shader.set("depthBufferTexture", context.depthBuffer.getId(), 0);
             shader.set("directionalAlbedoLut", lut.specularDirectionalAlbedo.getId(), 3);
@@ -132,7 +178,7 @@ namespace graphics
         popDebugGroup();
     }
 
-    void LightShadingPass::execute(Context&context, const Lut&lut, const std::vector<Spotlight>&spotLightQueue)
+    void LightShadingPass::execute(Context&context, const Lut&lut, const FrameVector<Spotlight>&spotLightQueue)
     {
         if (spotLightQueue.empty())
             return;
@@ -147,6 +193,12 @@ namespace graphics
         int indirectOffset = 0;
         for (auto &[shader, callback] : mSpotlightShaderVariants)
         {
+            if (!shader.isBuilt())
+            {
+                ++indirectOffset;
+                continue;
+            }
+
             shader.bind();
             shader.set("depthBufferTexture", context.depthBuffer.getId(), 0);
             shader.set("directionalAlbedoLut", lut.specularDirectionalAlbedo.getId(), 3);
@@ -181,6 +233,121 @@ namespace graphics
         popDebugGroup();
     }
 
+    void LightShadingPass::executeClustered(
+        Context &context, const Lut &lut, const FrameVector<PointLight> &pointLightQueue,
+        const FrameVector<Spotlight> &spotlightQueue)
+    {
+        if (pointLightQueue.empty() && spotlightQueue.empty())
+            return;
+
+        PROFILE_FUNC_NAMED("Clustered Lighting");
+        pushDebugGroup("Clustered Lighting");
+
+        uploadClusteredLights(context, pointLightQueue, spotlightQueue);
+
+        context.camera.bindToSlot(0);
+        context.tileClassificationStorage.bindToSlot(1);
+        mClusterRangeStorage.bindToSlot(CLUSTER_RANGE_BINDING);
+        mClusterLightIndexStorage.bindToSlot(CLUSTER_LIGHT_INDEX_BINDING);
+        mClusteredPointLightStorage.bindToSlot(CLUSTER_POINT_LIGHT_BINDING);
+        mClusteredSpotlightStorage.bindToSlot(CLUSTER_SPOTLIGHT_BINDING);
+
+        int indirectOffset = 0;
+        for (auto &[shader, callback] : mClusteredLightShaderVariants)
+        {
+            if (!shader.isBuilt())
+            {
+                ++indirectOffset;
+                continue;
+            }
+
+            shader.bind();
+            shader.set("depthBufferTexture", context.depthBuffer.getId(), 0);
+            shader.set("directionalAlbedoLut", lut.specularDirectionalAlbedo.getId(), 3);
+            shader.set("directionalAlbedoAverageLut", lut.specularDirectionalAlbedoAverage.getId(), 4);
+            shader.image("storageGBuffer", context.gbuffer.getId(), context.gbuffer.getFormat(), 0, true, GL_READ_ONLY);
+            shader.image("lighting", context.lightBuffer.getId(), context.lightBuffer.getFormat(), 1, false, GL_READ_WRITE);
+            callback(shader, context, lut);
+
+            dispatchComputeIndirect(context.tileClassificationStorage.getId(), indirectOffset * 4 * sizeof(uint32_t));
+            ++indirectOffset;
+        }
+
+        popDebugGroup();
+    }
+
+    void LightShadingPass::uploadClusteredLights(
+        const Context &context, const FrameVector<PointLight> &pointLightQueue,
+        const FrameVector<Spotlight> &spotlightQueue)
+    {
+        PROFILE_FUNC();
+        mLightClusterer.build(
+            context.camera->viewMatrix, context.cameraProjectionMatrix, context.camera->zNear, context.camera->zFar,
+            pointLightQueue, spotlightQueue);
+
+        for (auto it = mShadowMapHandles.begin(); it != mShadowMapHandles.end();)
+        {
+            if (it->second.texture.expired())
+                it = mShadowMapHandles.erase(it);
+            else
+                ++it;
+        }
+
+        mClusteredPointLights.clear();
+        for (const PointLight &pointLight : pointLightQueue)
+        {
+            ClusteredPointLight &light = mClusteredPointLights.emplace_back();
+            light.positionInvSqrRadius = glm::vec4(pointLight.position, 1.f / (pointLight.radius * pointLight.radius));
+            light.intensityZFar = glm::vec4(pointLight.colourIntensity, pointLight.radius);
+            light.bias = pointLight.bias;
+            light.softnessRadius = pointLight.softnessRadius;
+            light.shadowMap = shadowMapHandle(pointLight.shadowMap);
+        }
+
+        mClusteredSpotlights.clear();
+        for (const Spotlight &spotlight : spotlightQueue)
+        {
+            const float angleScale = 1.f / glm::max(0.001f, (spotlight.cosInnerAngle - spotlight.cosOuterAngle));
+
+            ClusteredSpotlight &light = mClusteredSpotlights.emplace_back();
+            light.vpMatrix = spotlight.vpMatrix;
+            light.positionInvSqrRadius = glm::vec4(spotlight.position, 1.f / (spotlight.radius * spotlight.radius));
+            light.directionZFar = glm::vec4(spotlight.direction, spotlight.radius);
+            light.intensityAngleScale = glm::vec4(spotlight.colourIntensity, angleScale);
+            light.bias = spotlight.shadowBias;
+            light.angleOffset = -spotlight.cosOuterAngle * angleScale;
+            light.shadowMap = shadowMapHandle(spotlight.shadowMap);
+        }
+
+        const auto upload = [](ShaderStorageBufferObject &storage, const auto &values) {
+            using TValue = typename std::decay_t<decltype(values)>::value_type;
+            const auto size = static_cast<uint32_t>(sizeof(TValue) * values.size());
+            storage.reserve(glm::max(size, static_cast<uint32_t>(sizeof(TValue))));
+            storage.write(values.data(), size);
+        };
+
+        upload(mClusterRangeStorage, mLightClusterer.getRanges());
+        upload(mClusterLightIndexStorage, mLightClusterer.getLightIndices());
+        upload(mClusteredPointLightStorage, mClusteredPointLights);
+        upload(mClusteredSpotlightStorage, mClusteredSpotlights);
+    }
+
+    template<typename TTexture>
+    uint64_t LightShadingPass::shadowMapHandle(const std::shared_ptr<TTexture> &texture)
+    {
+        BindlessHandle &entry = mShadowMapHandles[texture->getId()];
+
+        // Texture ids are reused once deleted, so the entry may belong to a texture that has since been destroyed.
+        if (entry.texture.lock() != texture)
+        {
+            entry.texture = texture;
+            entry.handle = glGetTextureHandleARB(texture->getId());
+            glMakeTextureHandleResidentARB(entry.handle);
+        }
+
+        return entry.handle;
+    }
+
     void LightShadingPass::execute(Context &context, const Lut &lut, const Skybox &skybox)
     {
         if (!skybox.isValid)
@@ -193,7 +360,10 @@ namespace graphics
         context.tileClassificationStorage.bindToSlot(1);
 
         for (auto &[shader, callback] : mIblShaderVariants)
-            callback(shader, context, lut, skybox);
+        {
+            if (shader.isBuilt())
+                callback(shader, context, lut, skybox);
+        }
 
         popDebugGroup();
     }
@@ -208,7 +378,7 @@ namespace graphics
             { "COMPUTE_TRANSMITTANCE", 1 }
         };
 
-        mIblShaderVariants.push_back( IblShaderVariant { Shader({ path }, uberShaderDefinitions),
+        mIblShaderVariants.push_back( IblShaderVariant { Shader({ path }, uberShaderDefinitions, BuildMode::Deferred),
             [](Shader &shader, const Context &context, const Lut &lut, const Skybox &skybox)
             {
                 shader.image("storageGBuffer", context.gbuffer.getId(), context.gbuffer.getFormat(), 0, true, GL_READ_ONLY);
@@ -239,7 +409,7 @@ namespace graphics
             { "COMPUTE_TRANSMITTANCE", 0 }
         };
 
-        mIblShaderVariants.push_back( IblShaderVariant { Shader({ path }, sheenShaderDefinitions),
+        mIblShaderVariants.push_back( IblShaderVariant { Shader({ path }, sheenShaderDefinitions, BuildMode::Deferred),
             [](Shader &shader, const Context &context, const Lut &lut, const Skybox &skybox)
             {
                 shader.image("storageGBuffer", context.gbuffer.getId(), context.gbuffer.getFormat(), 0, true, GL_READ_ONLY);
@@ -270,7 +440,7 @@ namespace graphics
             { "COMPUTE_TRANSMITTANCE", 1 }
         };
 
-        mIblShaderVariants.push_back(IblShaderVariant { Shader({ path }, transmittanceShaderDefinitions),
+        mIblShaderVariants.push_back(IblShaderVariant { Shader({ path }, transmittanceShaderDefinitions, BuildMode::Deferred),
         [](Shader &shader, const Context &context, const Lut &lut, const Skybox &skybox)
             {
                 shader.image("storageGBuffer", context.gbuffer.getId(), context.gbuffer.getFormat(), 0, true, GL_READ_ONLY);
@@ -298,7 +468,7 @@ namespace graphics
             { "COMPUTE_TRANSMITTANCE", 0 }
         };
 
-        mIblShaderVariants.push_back(IblShaderVariant { Shader({ path }, baseShaderDefinitions),
+        mIblShaderVariants.push_back(IblShaderVariant { Shader({ path }, baseShaderDefinitions, BuildMode::Deferred),
         [](Shader &shader, const Context &context, const Lut &lut, const Skybox &skybox)
             {
                 shader.image("storageGBuffer", context.gbuffer.getId(), context.gbuffer.getFormat(), 0, true, GL_READ_ONLY);
@@ -330,7 +500,7 @@ namespace graphics
             { "COMPUTE_TRANSMITTANCE", 1 }
         };
 
-        results.push_back(LightShaderVariant { Shader( { path }, uberShaderDefinitions),
+        results.push_back(LightShaderVariant { Shader({ path }, uberShaderDefinitions, BuildMode::Deferred),
             [](Shader &shader, Context &context, const Lut &lut)
             {
                 // Note: Bindings here do not match the shader code because there are multiple definitions.
@@ -346,7 +516,7 @@ namespace graphics
             { "COMPUTE_TRANSMITTANCE", 0 }
         };
 
-        results.push_back(LightShaderVariant { Shader( { path }, sheenShaderDefinitions),
+        results.push_back(LightShaderVariant { Shader({ path }, sheenShaderDefinitions, BuildMode::Deferred),
             [](Shader &shader, Context &context, const Lut &lut)
             {
                 // Todo: Bindings here do not match the shader code.
@@ -362,7 +532,7 @@ namespace graphics
             { "COMPUTE_TRANSMITTANCE", 1 }
         };
 
-        results.push_back(LightShaderVariant { Shader( { path }, transmittanceShaderDefinitions),
+        results.push_back(LightShaderVariant { Shader({ path }, transmittanceShaderDefinitions, BuildMode::Deferred),
             [](Shader &shader, Context &context, const Lut &lut)
             {
 
@@ -376,7 +546,7 @@ namespace graphics
             { "COMPUTE_TRANSMITTANCE", 0 }
         };
 
-        results.push_back(LightShaderVariant { Shader( { path }, baseShaderDefinitions),
+        results.push_back(LightShaderVariant { Shader({ path }, baseShaderDefinitions, BuildMode::Deferred),
             [](Shader &shader, Context &context, const Lut &lut)
             {
 
@@ -11,15 +11,19 @@
 #include "Cubemap.h"
 #include "DirectionalLightBlock.h"
 #include "FileLoader.h"
+#include "FrameArena.h"
 #include "GraphicsLighting.h"
 #include "HdrTexture.h"
+#include "LightClustering.h"
 #include "LookUpTables.h"
 #include "Pch.h"
 #include "PointLightBlock.h"
 #include "Shader.h"
+#include "ShaderStorageBufferObject.h"
 #include "SpotlightBlock.h"
 #include "../Primitives.h"
 #include "../Skybox.h"
+#include "../shader/ShaderCompiler.h"
 
 namespace graphics
 {
@@ -43,21 +47,69 @@ namespace graphics
     {
     public:
         LightShadingPass();
-        void execute(Context &context, const Lut &lut, const std::vector<DirectionalLight> &directionalLightQueue);
-        void execute(Context &context, const Lut &lut, const std::vector<PointLight> &pointLightQueue);
-        void execute(Context&context, const Lut&lut, const std::vector<Spotlight>&spotLightQueue);
+        void execute(Context &context, const Lut &lut, const FrameVector<DirectionalLight> &directionalLightQueue);
+        void execute(Context &context, const Lut &lut, const FrameVector<PointLight> &pointLightQueue);
+        void execute(Context&context, const Lut&lut, const FrameVector<Spotlight>&spotLightQueue);
         void execute(Context &context, const Lut &lut, const Skybox &skybox);
+
+        /**
+         * @brief Shades every point light and spotlight in one dispatch per variant. The lights are binned into
+         * clusters first so that each tile only loops over the lights that can reach it. Needs bindless textures
+         * to sample each light's shadow map.
+         */
+        void executeClustered(
+            Context &context, const Lut &lut, const FrameVector<PointLight> &pointLightQueue,
+            const FrameVector<Spotlight> &spotlightQueue);
+
+        [[nodiscard]] static bool isClusteredLightingSupported();
+
+        /**
+         * @brief Finishes any variants that were compiled lazily. Variants are skipped until they're built.
+         * @returns True once every variant is built.
+         */
+        bool updateShaderVariants();
     protected:
         void generateIblShaderVariants(const std::filesystem::path &path);
         std::vector<LightShaderVariant> generateLightShaderVariants(const std::filesystem::path &path);
+        static bool isLazyVariant(int variantIndex);
+
+        void uploadClusteredLights(
+            const Context &context, const FrameVector<PointLight> &pointLightQueue,
+            const FrameVector<Spotlight> &spotlightQueue);
+
+        /**
+         * @returns A resident bindless handle for the texture. Handles are made once and reused while the texture is alive.
+         */
+        template<typename TTexture>
+        uint64_t shadowMapHandle(const std::shared_ptr<TTexture> &texture);
+
+        struct BindlessHandle
+        {
+            std::weak_ptr<const void> texture;
+            uint64_t handle = 0;
+        };
+
+        ShaderCompiler mShaderCompiler;
 
         std::vector<IblShaderVariant> mIblShaderVariants;
         std::vector<LightShaderVariant> mDirectionalLightShaderVariants;
         std::vector<LightShaderVariant> mPointLightShaderVariants;
         std::vector<LightShaderVariant> mSpotlightShaderVariants;
+        std::vector<LightShaderVariant> mClusteredLightShaderVariants;  // Empty when bindless textures aren't supported.
 
         UniformBufferObject<DirectionalLightBlock> mDirectionalLightBlock;
         UniformBufferObject<PointLightBlock> mPointLightBlock;
         UniformBufferObject<SpotlightBlock> mSpotlightBlock;
+
+        LightClusterer mLightClusterer;
+        std::vector<ClusteredPointLight> mClusteredPointLights;
+        std::vector<ClusteredSpotlight> mClusteredSpotlights;
+        ShaderStorageBufferObject mClusterRangeStorage { "Cluster Range Storage" };
+        ShaderStorageBufferObject mClusterLightIndexStorage { "Cluster Light Index Storage" };
+        ShaderStorageBufferObject mClusteredPointLightStorage { "Clustered Point Light Storage" };
+        ShaderStorageBufferObject mClusteredSpotlightStorage { "Clustered Spotlight Storage" };
+
+        // Keyed by texture id. Deleting a texture frees its handles, so entries only need to be dropped once expired.
+        std::unordered_map<uint32_t, BindlessHandle> mShadowMapHandles;
     };
 } // graphics
@@ -13,9 +13,11 @@
 namespace graphics
 {
     void MaterialRenderingPass::execute(
-            const glm::ivec2 &size, Context &context,
-            const std::vector<GeometryObject>&multiGeometryQueue, const std::vector<MaterialData>&multiMaterialQueue,
-            const std::vector<GeometryObject>&singleGeometryQueue, const std::vector<MaterialData>&singleMaterialQueue)
+            const glm::ivec2 &size, Context &context, MaterialTable &materials,
+            const FrameVector<GeometryObject>&multiGeometryQueue, const FrameVector<uint32_t>&multiMaterialQueue,
+            const std::vector<uint32_t> &multiVisible,
+            const FrameVector<GeometryObject>&singleGeometryQueue, const FrameVector<uint32_t>&singleMaterialQueue,
+            const std::vector<uint32_t> &singleVisible)
     {
         PROFILE_FUNC();
         if (multiGeometryQueue.size() != multiMaterialQueue.size() || singleGeometryQueue.size() != singleMaterialQueue.size())
@@ -39,12 +41,52 @@ namespace graphics
 
         // Bind Uniform Buffer Objects. Can this be done at a global level?
         context.camera.bindToSlot(0);
-        mMaterialShaderStorage.bindToSlot(1);
-        mTextureDataShaderStorage.bindToSlot(2);
-        mMaskShaderStorage.bindToSlot(3);
 
-        executeSingleMaterial(context, singleGeometryQueue, singleMaterialQueue);
-        executeMultiMaterial(context, multiGeometryQueue, multiMaterialQueue);
+        if (mUseDepthPrepass)
+        {
+            executeDepthPrepass(context, multiGeometryQueue, multiVisible, singleGeometryQueue, singleVisible);
+
+            // Depth is already final, so only the nearest surface passes.
+            glDepthFunc(GL_LEQUAL);
+            glDepthMask(GL_FALSE);
+        }
+
+        // Both queues share one instance buffer so that it's only uploaded once.
+        const glm::mat4 &viewMatrix = context.camera->viewMatrix;
+        mBatches.clear();
+        mInstanceMatrices.clear();
+        mInstanceBatcher.batchByMaterial(singleGeometryQueue, singleMaterialQueue, singleVisible, viewMatrix, mBatches, mInstanceMatrices);
+        const size_t singleBatchCount = mBatches.size();
+        mInstanceBatcher.batchByMaterial(multiGeometryQueue, multiMaterialQueue, multiVisible, viewMatrix, mBatches, mInstanceMatrices);
+
+        const StreamingRange instanceRange = mStreamingBuffer.write(mInstanceMatrices.data(), sizeof(glm::mat4) * mInstanceMatrices.size());
+
+        materials.bindToSlots();
+        StreamingBuffer::bindToSlot(instanceRange, 4);
+
+        mMultiDraw.build(mBatches);
+        mMultiDraw.upload(mStreamingBuffer);
+
+        const auto batchCount = static_cast<uint32_t>(mBatches.size());
+        uint32_t multiDrawCount = executeSingleMaterial(context, materials, 0, static_cast<uint32_t>(singleBatchCount));
+        multiDrawCount += executeMultiMaterial(context, materials, static_cast<uint32_t>(singleBatchCount), batchCount);
+        mStreamingBuffer.endFrame();
+
+        if (mUseDepthPrepass)
+        {
+            glDepthMask(GL_TRUE);
+            glDepthFunc(GL_LESS);
+        }
+
+        PROFILE_COUNTER("Material Instances", mInstanceMatrices.size());
+        PROFILE_COUNTER("Material Batches", mBatches.size());
+        PROFILE_COUNTER("Material Multi-draws", multiDrawCount);
+        PROFILE_COUNTER("Material State Changes (Submitted)",
+            countStateChanges(singleGeometryQueue, singleMaterialQueue, singleVisible)
+            + countStateChanges(multiGeometryQueue, multiMaterialQueue, multiVisible));
+        PROFILE_COUNTER("Material State Changes (Sorted)",
+            countStateChanges(mBatches.data(), singleBatchCount)
+            + countStateChanges(mBatches.data() + singleBatchCount, mBatches.size() - singleBatchCount));
 
         mFramebuffer.detach(0);
         mFramebuffer.detach(1);
@@ -54,64 +96,85 @@ namespace graphics
         popDebugGroup();
     }
 
-    void MaterialRenderingPass::executeMultiMaterial(
-        const Context& context,
-        const std::vector<GeometryObject>& geometryQueue, const std::vector<MaterialData>& materials)
+    void MaterialRenderingPass::setUseDepthPrepass(const bool useDepthPrepass)
     {
-        mMultiMaterialShader.bind();
-        mMultiMaterialShader.block("CameraBlock", context.camera.getBindPoint());
+        mUseDepthPrepass = useDepthPrepass;
+    }
 
-        for (int i = 0; i < geometryQueue.size(); ++i)
-        {
-            const GeometryObject &geometry = geometryQueue[i];
-            const MaterialData &material = materials[i];
+    void MaterialRenderingPass::executeDepthPrepass(
+        const Context &context, const FrameVector<GeometryObject> &multiGeometryQueue,
+        const std::vector<uint32_t> &multiVisible, const FrameVector<GeometryObject> &singleGeometryQueue,
+        const std::vector<uint32_t> &singleVisible)
+    {
+        PROFILE_FUNC();
+        pushDebugGroup("Depth Pre-pass");
 
-            mMultiMaterialShader.set("u_mvp_matrix", context.cameraViewProjectionMatrix * geometry.matrix);
-            mMultiMaterialShader.set("u_model_matrix", geometry.matrix);
-            mMultiMaterialShader.set("textures", material.textureArrayId, 0);
+        // Materials don't matter here, so both queues are batched together by mesh.
+        const glm::mat4 &viewMatrix = context.camera->viewMatrix;
+        mDepthPrepassBatches.clear();
+        mDepthPrepassMatrices.clear();
+        mInstanceBatcher.batchByMesh(singleGeometryQueue, singleVisible, viewMatrix, mDepthPrepassBatches, mDepthPrepassMatrices);
+        mInstanceBatcher.batchByMesh(multiGeometryQueue, multiVisible, viewMatrix, mDepthPrepassBatches, mDepthPrepassMatrices);
 
-            mMaterialShaderStorage.resize(sizeof(LayerData) * material.layers.size());
-            mMaterialShaderStorage.write(material.layers.data(), sizeof(LayerData) * material.layers.size());
+        const StreamingRange instanceRange = mStreamingBuffer.write(mDepthPrepassMatrices.data(), sizeof(glm::mat4) * mDepthPrepassMatrices.size());
+        StreamingBuffer::bindToSlot(instanceRange, 4);
 
-            mTextureDataShaderStorage.resize(sizeof(TextureData) * material.textureArrayData.size());
-            mTextureDataShaderStorage.write(material.textureArrayData.data(), sizeof(TextureData) * material.textureArrayData.size());
+        mDepthPrepassMultiDraw.build(mDepthPrepassBatches);
+        mDepthPrepassMultiDraw.upload(mStreamingBuffer);
 
-            mMaskShaderStorage.resize(sizeof(MaskData) * material.masks.size());
-            mMaskShaderStorage.write(material.masks.data(), sizeof(MaskData) * material.masks.size());
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
 
-            glBindVertexArray(geometry.vao);
-            glDrawElements(GL_TRIANGLES, geometry.indicesCount, GL_UNSIGNED_INT, nullptr);
-        }
+        mDepthPrepassShader.bind();
+        mDepthPrepassShader.block("CameraBlock", context.camera.getBindPoint());
+        mDepthPrepassShader.set(mDepthPrepassVpMatrix, context.cameraViewProjectionMatrix);
+
+        mDepthPrepassMultiDraw.draw(
+            0, static_cast<uint32_t>(mDepthPrepassBatches.size()),
+            [](uint32_t) { return 0; },
+            [this](const uint32_t first) { mDepthPrepassShader.set(mDepthPrepassDrawOffset, static_cast<int>(first)); });
+
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+
+        PROFILE_COUNTER("Depth Pre-pass Batches", mDepthPrepassBatches.size());
+        popDebugGroup();
     }
 
-    void MaterialRenderingPass::executeSingleMaterial(
-        const Context& context,
-        const std::vector<GeometryObject>& geometryQueue, const std::vector<MaterialData>& materials)
+    uint32_t MaterialRenderingPass::executeMultiMaterial(
+        const Context& context, const MaterialTable& materials, const uint32_t first, const uint32_t last)
     {
-        mSingleMaterialShader.bind();
-        mSingleMaterialShader.block("CameraBlock", context.camera.getBindPoint());
+        mMultiMaterialShader.bind();
+        mMultiMaterialShader.block("CameraBlock", context.camera.getBindPoint());
+        mMultiMaterialShader.set(mMultiVpMatrix, context.cameraViewProjectionMatrix);
+
+        // Material indices come from the draw data, so only a change of texture array splits a multi-draw.
+        return mMultiDraw.draw(
+            first, last,
+            [this, &materials](const uint32_t i) { return materials.textureArrayId(mBatches[i].materialIndex); },
+            [this, &materials](const uint32_t i) {
+                mMultiMaterialShader.set(mMultiDrawOffset, static_cast<int>(i));
+                mMultiMaterialShader.set(mMultiTextures, materials.textureArrayId(mBatches[i].materialIndex), 0);
+            });
+    }
 
-        for (int i = 0; i < geometryQueue.size(); ++i)
+    uint32_t MaterialRenderingPass::executeSingleMaterial(
+        const Context& context, const MaterialTable& materials, const uint32_t first, const uint32_t last)
+    {
+        for (uint32_t i = first; i < last; ++i)
         {
-            const GeometryObject &geometry = geometryQueue[i];
-            const MaterialData &material = materials[i];
-
-            if (material.layers.empty())
+            if (materials.layerCount(mBatches[i].materialIndex) == 0)
                 CRASH("No layers to read from results in undefined behavour.");
-
-            mSingleMaterialShader.set("u_mvp_matrix", context.cameraViewProjectionMatrix * geometry.matrix);
-            mSingleMaterialShader.set("u_model_matrix", geometry.matrix);
-            mSingleMaterialShader.set("textures", material.textureArrayId, 0);
-
-            // Only read in the first layer as that's the only one we can safely use.
-            mMaterialShaderStorage.resize(sizeof(LayerData));
-            mMaterialShaderStorage.write(material.layers.data(), sizeof(LayerData));
-
-            mTextureDataShaderStorage.resize(sizeof(TextureData) * material.textureArrayData.size());
-            mTextureDataShaderStorage.write(material.textureArrayData.data(), sizeof(TextureData) * material.textureArrayData.size());
-
-            glBindVertexArray(geometry.vao);
-            glDrawElements(GL_TRIANGLES, geometry.indicesCount, GL_UNSIGNED_INT, nullptr);
         }
+
+        mSingleMaterialShader.bind();
+        mSingleMaterialShader.block("CameraBlock", context.camera.getBindPoint());
+        mSingleMaterialShader.set(mSingleVpMatrix, context.cameraViewProjectionMatrix);
+
+        return mMultiDraw.draw(
+            first, last,
+            [this, &materials](const uint32_t i) { return materials.textureArrayId(mBatches[i].materialIndex); },
+            [this, &materials](const uint32_t i) {
+                mSingleMaterialShader.set(mSingleDrawOffset, static_cast<int>(i));
+                mSingleMaterialShader.set(mSingleTextures, materials.textureArrayId(mBatches[i].materialIndex), 0);
+            });
     }
 }
@@ -10,31 +10,51 @@
 #include "CameraSettings.h"
 #include "Context.h"
 #include "FileLoader.h"
+#include "FrameArena.h"
 #include "GraphicsDefinitions.h"
-#include "MaterialData.h"
+#include "InstanceBatching.h"
+#include "MaterialTable.h"
+#include "MultiDraw.h"
 #include "Pch.h"
+#include "StreamingBuffer.h"
 
 namespace graphics
 {
     /**
+     * @brief Writes the visible geometry into the gbuffer. Geometry with the same mesh and material is one
+     * indirect command, and runs of commands that share a texture array are drawn with one multi-draw. Draws are sorted by material and mesh, nearest first within each batch.
+     * An optional depth pre-pass lays down depth first so that each pixel is only shaded once.
      * @author Ryan Purse
      * @date 09/03/2024
      */
     class MaterialRenderingPass
     {
     public:
+        /**
+         * @param materials The table that the material queues index into. It must already be uploaded.
+         * @param multiVisible The indices into the multi material queues that survived culling.
+         * @param singleVisible The indices into the single material queues that survived culling.
+         */
         void execute(
-            const glm::ivec2 &size, Context &context,
-            const std::vector<GeometryObject>&multiGeometryQueue, const std::vector<MaterialData>&multiMaterialQueue,
-            const std::vector<GeometryObject>&singleGeometryQueue, const std::vector<MaterialData>&singleMaterialQueue);
+            const glm::ivec2 &size, Context &context, MaterialTable &materials,
+            const FrameVector<GeometryObject>&multiGeometryQueue, const FrameVector<uint32_t>&multiMaterialQueue,
+            const std::vector<uint32_t> &multiVisible,
+            const FrameVector<GeometryObject>&singleGeometryQueue, const FrameVector<uint32_t>&singleMaterialQueue,
+            const std::vector<uint32_t> &singleVisible);
+
+        void setUseDepthPrepass(bool useDepthPrepass);
     protected:
-        void executeMultiMaterial(
-            const Context& context,
-            const std::vector<GeometryObject>& geometryQueue, const std::vector<MaterialData>& materials);
+        void executeDepthPrepass(
+            const Context &context, const FrameVector<GeometryObject> &multiGeometryQueue,
+            const std::vector<uint32_t> &multiVisible, const FrameVector<GeometryObject> &singleGeometryQueue,
+            const std::vector<uint32_t> &singleVisible);
 
-        void executeSingleMaterial(
-            const Context &context,
-            const std::vector<GeometryObject>& geometryQueue, const std::vector<MaterialData>& materials);
+        /**
+         * @brief Draws mBatches from first to last.
+         * @returns How many multi-draws were issued.
+         */
+        uint32_t executeMultiMaterial(const Context& context, const MaterialTable& materials, uint32_t first, uint32_t last);
+        uint32_t executeSingleMaterial(const Context &context, const MaterialTable& materials, uint32_t first, uint32_t last);
 
         FramebufferObject mFramebuffer = FramebufferObject(GL_ONE, GL_ZERO, GL_LESS);
 
@@ -46,7 +66,8 @@ namespace graphics
             {
                 { "FRAGMENT_OUTPUT", 1 },
                 { "COMPUTE_SHEEN", 1 },
-                { "COMPUTE_TRANSMITTANCE", 1 }
+                { "COMPUTE_TRANSMITTANCE", 1 },
+                { "INSTANCED", 1 }
             }
         };
 
@@ -58,12 +79,43 @@ namespace graphics
             {
                 { "FRAGMENT_OUTPUT", 1 },
                 { "COMPUTE_SHEEN", 1 },
-                { "COMPUTE_TRANSMITTANCE", 1 }
+                { "COMPUTE_TRANSMITTANCE", 1 },
+                { "INSTANCED", 1 }
             }
         };
 
-        ShaderStorageBufferObject mMaterialShaderStorage = ShaderStorageBufferObject("Material Shader Storage");
-        ShaderStorageBufferObject mTextureDataShaderStorage = ShaderStorageBufferObject("Texture Data Shader Storage");
-        ShaderStorageBufferObject mMaskShaderStorage = ShaderStorageBufferObject("Mask Shader Storage");
+        // Uses the same vertex shader as the material shaders so that the depth matches exactly.
+        Shader mDepthPrepassShader {
+            {
+                file::shaderPath() / "geometry/standard/Standard.vert",
+                file::shaderPath() / "shadow/Shadow.frag"
+            },
+            {
+                { "INSTANCED", 1 }
+            }
+        };
+
+        // Instance matrices are rewritten every frame. Material data lives in the material table.
+        StreamingBuffer mStreamingBuffer = StreamingBuffer(1024 * 1024, "Material Streaming Buffer");
+
+        // Set once per batch, so they're resolved up front.
+        UniformHandle mMultiVpMatrix = mMultiMaterialShader.getUniform("u_vp_matrix");
+        UniformHandle mMultiDrawOffset = mMultiMaterialShader.getUniform("u_draw_offset");
+        UniformHandle mMultiTextures = mMultiMaterialShader.getUniform("textures");
+        UniformHandle mSingleVpMatrix = mSingleMaterialShader.getUniform("u_vp_matrix");
+        UniformHandle mSingleDrawOffset = mSingleMaterialShader.getUniform("u_draw_offset");
+        UniformHandle mSingleTextures = mSingleMaterialShader.getUniform("textures");
+        UniformHandle mDepthPrepassVpMatrix = mDepthPrepassShader.getUniform("u_vp_matrix");
+        UniformHandle mDepthPrepassDrawOffset = mDepthPrepassShader.getUniform("u_draw_offset");
+
+        InstanceBatcher mInstanceBatcher;
+        std::vector<InstanceBatch> mBatches;
+        std::vector<glm::mat4> mInstanceMatrices;
+        MultiDrawBuilder mMultiDraw;
+
+        bool mUseDepthPrepass { false };
+        std::vector<InstanceBatch> mDepthPrepassBatches;
+        std::vector<glm::mat4> mDepthPrepassMatrices;
+        MultiDrawBuilder mDepthPrepassMultiDraw;
     };
 } // graphics
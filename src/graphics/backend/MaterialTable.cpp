@@ -0,0 +1,211 @@
+/**
+ * @file MaterialTable.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "MaterialTable.h"
+
+#include "Logger.h"
+#include "LoggerMacros.h"
+#include "ProfileTimer.h"
+
+namespace graphics
+{
+    namespace
+    {
+        constexpr uint32_t minimumCapacity = 64;
+
+        template<typename T>
+        void writeRegion(ShaderStorageBufferObject &buffer, const std::vector<T> &values, const uint32_t offset)
+        {
+            if (!values.empty())
+                buffer.write(values.data(), static_cast<uint32_t>(sizeof(T) * values.size()), static_cast<uint32_t>(sizeof(T) * offset));
+        }
+    }
+
+    MaterialTable::MaterialTable()
+    {
+        // So that the buffers always have storage, even before any material exists.
+        repack();
+    }
+
+    uint32_t MaterialTable::create()
+    {
+        uint32_t materialIndex;
+        if (!mFreeIndices.empty())
+        {
+            materialIndex = mFreeIndices.back();
+            mFreeIndices.pop_back();
+        }
+        else
+        {
+            materialIndex = static_cast<uint32_t>(mMaterials.size());
+            mMaterials.emplace_back();
+            mIsRepackRequired |= mMaterials.size() > mEntryCapacity;
+        }
+
+        mMaterials[materialIndex].isLive = true;
+        markDirty(materialIndex);
+        return materialIndex;
+    }
+
+    void MaterialTable::update(const uint32_t materialIndex, const MaterialData &material)
+    {
+        if (materialIndex >= mMaterials.size() || !mMaterials[materialIndex].isLive)
+        {
+            WARN("Material % does not exist. It cannot be updated.", materialIndex);
+            return;
+        }
+
+        Material &entry = mMaterials[materialIndex];
+        entry.data = material;
+
+        // Anything that no longer fits is moved on the next repack.
+        mIsRepackRequired |= !tryAllocate(mLayerPool, entry.layers, static_cast<uint32_t>(material.layers.size()));
+        mIsRepackRequired |= !tryAllocate(mMaskPool, entry.masks, static_cast<uint32_t>(material.masks.size()));
+        mIsRepackRequired |= !tryAllocate(mTexturePool, entry.textures, static_cast<uint32_t>(material.textureArrayData.size()));
+
+        markDirty(materialIndex);
+    }
+
+    void MaterialTable::destroy(const uint32_t materialIndex)
+    {
+        if (materialIndex >= mMaterials.size() || !mMaterials[materialIndex].isLive)
+            return;
+
+        // The regions are kept for whoever reuses this index.
+        Material &entry = mMaterials[materialIndex];
+        entry.data = MaterialData();
+        entry.isLive = false;
+        mFreeIndices.push_back(materialIndex);
+    }
+
+    void MaterialTable::upload()
+    {
+        PROFILE_FUNC();
+        if (mIsRepackRequired)
+            repack();
+
+        uint32_t uploadCount = 0;
+        for (const uint32_t materialIndex : mDirtyIndices)
+        {
+            Material &material = mMaterials[materialIndex];
+            material.isDirty = false;
+            if (!material.isLive)
+                continue;
+
+            const MaterialData &data = material.data;
+            writeRegion(mLayerBuffer, data.layers, material.layers.offset);
+            writeRegion(mMaskBuffer, data.masks, material.masks.offset);
+            writeRegion(mTextureBuffer, data.textureArrayData, material.textures.offset);
+
+            const MaterialEntry entry {
+                material.layers.offset, static_cast<uint32_t>(data.layers.size()),
+                material.masks.offset, static_cast<uint32_t>(data.masks.size()),
+                material.textures.offset, static_cast<uint32_t>(data.textureArrayData.size())
+            };
+            mEntryBuffer.write(&entry, sizeof(MaterialEntry), sizeof(MaterialEntry) * materialIndex);
+            ++uploadCount;
+        }
+        mDirtyIndices.clear();
+
+        PROFILE_COUNTER("Materials Uploaded", uploadCount);
+    }
+
+    void MaterialTable::bindToSlots()
+    {
+        mLayerBuffer.bindToSlot(1);
+        mTextureBuffer.bindToSlot(2);
+        mMaskBuffer.bindToSlot(3);
+        mEntryBuffer.bindToSlot(5);
+    }
+
+    uint32_t MaterialTable::textureArrayId(const uint32_t materialIndex) const
+    {
+        return mMaterials[materialIndex].data.textureArrayId;
+    }
+
+    uint32_t MaterialTable::layerCount(const uint32_t materialIndex) const
+    {
+        return static_cast<uint32_t>(mMaterials[materialIndex].data.layers.size());
+    }
+
+    bool MaterialTable::isMultiMaterial(const uint32_t materialIndex) const
+    {
+        const MaterialData &data = mMaterials[materialIndex].data;
+        return !data.masks.empty() && data.layers.size() > 1;
+    }
+
+    bool MaterialTable::tryAllocate(Pool &pool, Region &region, const uint32_t count)
+    {
+        if (count <= region.capacity)
+            return true;
+
+        // Leave room to grow since materials are usually edited one layer at a time.
+        const uint32_t capacity = glm::max(count, region.capacity * 2);
+        if (pool.end + capacity > pool.capacity)
+            return false;
+
+        region = { pool.end, capacity };
+        pool.end += capacity;
+        return true;
+    }
+
+    void MaterialTable::repack()
+    {
+        PROFILE_FUNC();
+        mLayerPool.end = 0;
+        mMaskPool.end = 0;
+        mTexturePool.end = 0;
+
+        // Lay the live materials out back to back. Regions that are left behind by growing or destroyed materials are dropped.
+        for (uint32_t i = 0; i < mMaterials.size(); ++i)
+        {
+            Material &material = mMaterials[i];
+            if (!material.isLive)
+            {
+                material.layers = material.masks = material.textures = Region();
+                continue;
+            }
+
+            auto place = [](Pool &pool, Region &region, const size_t count) {
+                region = { pool.end, static_cast<uint32_t>(count) };
+                pool.end += region.capacity;
+            };
+            place(mLayerPool, material.layers, material.data.layers.size());
+            place(mMaskPool, material.masks, material.data.masks.size());
+            place(mTexturePool, material.textures, material.data.textureArrayData.size());
+            markDirty(i);
+        }
+
+        // The buffers are resized to twice what's used so that a repack is rare.
+        auto grow = [](Pool &pool) {
+            pool.capacity = glm::max(glm::max(pool.capacity, pool.end * 2), minimumCapacity);
+        };
+        grow(mLayerPool);
+        grow(mMaskPool);
+        grow(mTexturePool);
+        mEntryCapacity = glm::max(glm::max(mEntryCapacity, static_cast<uint32_t>(mMaterials.size()) * 2), minimumCapacity);
+
+        mLayerBuffer.resize(mLayerPool.capacity * sizeof(LayerData));
+        mMaskBuffer.resize(mMaskPool.capacity * sizeof(MaskData));
+        mTextureBuffer.resize(mTexturePool.capacity * sizeof(TextureData));
+        mEntryBuffer.resize(mEntryCapacity * sizeof(MaterialEntry));
+
+        MESSAGE_VERBOSE("Repacked the material table: % materials, % layers, % masks, % textures.",
+            mMaterials.size(), mLayerPool.end, mMaskPool.end, mTexturePool.end);
+        mIsRepackRequired = false;
+    }
+
+    void MaterialTable::markDirty(const uint32_t materialIndex)
+    {
+        Material &material = mMaterials[materialIndex];
+        if (material.isDirty)
+            return;
+
+        material.isDirty = true;
+        mDirtyIndices.push_back(materialIndex);
+    }
+} // graphics
@@ -0,0 +1,111 @@
+/**
+ * @file MaterialTable.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include "MaterialData.h"
+#include "Pch.h"
+#include "ShaderStorageBufferObject.h"
+
+namespace graphics
+{
+    /**
+     * @brief Where a material's data lives in the packed arrays. Must match MaterialTable.glsl.
+     */
+    struct MaterialEntry
+    {
+        uint32_t layerOffset = 0;
+        uint32_t layerCount = 0;
+        uint32_t maskOffset = 0;
+        uint32_t maskCount = 0;
+        uint32_t textureOffset = 0;
+        uint32_t textureCount = 0;
+    };
+
+    /**
+     * @brief Every live material packed into a set of storage buffers. Geometry refers to a material by its index
+     * so that the layers, masks and texture data are only uploaded when the material changes.
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class MaterialTable
+    {
+    public:
+        MaterialTable();
+
+        /**
+         * @returns The index of a new, empty material. Indices are reused once destroyed.
+         */
+        uint32_t create();
+
+        /**
+         * @brief Replaces the material's data. It's written to the gpu on the next upload.
+         */
+        void update(uint32_t materialIndex, const MaterialData &material);
+        void destroy(uint32_t materialIndex);
+
+        /**
+         * @brief Writes every material that has changed since the last upload. Call once per frame before drawing.
+         */
+        void upload();
+
+        /**
+         * @brief Layers at 1, texture data at 2, masks at 3 and the entries at 5.
+         */
+        void bindToSlots();
+
+        [[nodiscard]] uint32_t textureArrayId(uint32_t materialIndex) const;
+        [[nodiscard]] uint32_t layerCount(uint32_t materialIndex) const;
+        [[nodiscard]] bool isMultiMaterial(uint32_t materialIndex) const;
+        [[nodiscard]] uint32_t size() const { return static_cast<uint32_t>(mMaterials.size()); }
+
+    protected:
+        struct Region
+        {
+            uint32_t offset = 0;
+            uint32_t capacity = 0;
+        };
+
+        /**
+         * @brief One of the packed arrays. Regions are handed out from the end and only reclaimed by a repack.
+         */
+        struct Pool
+        {
+            uint32_t end = 0;
+            uint32_t capacity = 0;
+        };
+
+        struct Material
+        {
+            MaterialData data;
+            Region layers;
+            Region masks;
+            Region textures;
+            bool isLive = false;
+            bool isDirty = false;
+        };
+
+        bool tryAllocate(Pool &pool, Region &region, uint32_t count);
+        void repack();
+        void markDirty(uint32_t materialIndex);
+
+        std::vector<Material> mMaterials;
+        std::vector<uint32_t> mFreeIndices;
+        std::vector<uint32_t> mDirtyIndices;
+        bool mIsRepackRequired { false };
+
+        Pool mLayerPool;
+        Pool mMaskPool;
+        Pool mTexturePool;
+        uint32_t mEntryCapacity { 0 };
+
+        ShaderStorageBufferObject mLayerBuffer { "Material Layer Table" };
+        ShaderStorageBufferObject mMaskBuffer { "Material Mask Table" };
+        ShaderStorageBufferObject mTextureBuffer { "Material Texture Table" };
+        ShaderStorageBufferObject mEntryBuffer { "Material Entry Table" };
+    };
+} // graphics
@@ -0,0 +1,41 @@
+/**
+ * @file MultiDraw.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "MultiDraw.h"
+
+namespace graphics
+{
+    void MultiDrawBuilder::build(const std::vector<InstanceBatch> &batches)
+    {
+        mCommands.clear();
+        mDrawData.clear();
+        mVaos.clear();
+        for (const InstanceBatch &batch : batches)
+        {
+            // Instances are found through the draw data, so the base instance isn't needed.
+            mCommands.push_back({
+                static_cast<uint32_t>(batch.indicesCount), batch.instanceCount, batch.firstIndex, batch.baseVertex, 0 });
+            mDrawData.push_back({ batch.firstInstance, batch.materialIndex });
+            mVaos.push_back(batch.vao);
+        }
+    }
+
+    void MultiDrawBuilder::upload(StreamingBuffer &buffer)
+    {
+        const StreamingRange drawDataRange = buffer.write(mDrawData.data(), sizeof(DrawData) * mDrawData.size());
+        StreamingBuffer::bindToSlot(drawDataRange, 10);
+
+        mCommandRange = buffer.write(mCommands.data(), sizeof(DrawElementsIndirectCommand) * mCommands.size());
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, mCommandRange.bufferId);
+    }
+
+    void MultiDrawBuilder::submit(const uint32_t first, const uint32_t count) const
+    {
+        const auto offset = static_cast<uintptr_t>(mCommandRange.offset + first * sizeof(DrawElementsIndirectCommand));
+        glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, reinterpret_cast<const void*>(offset), static_cast<GLsizei>(count), 0);
+    }
+} // graphics
@@ -0,0 +1,98 @@
+/**
+ * @file MultiDraw.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include "InstanceBatching.h"
+#include "Pch.h"
+#include "StreamingBuffer.h"
+
+namespace graphics
+{
+    /**
+     * @brief The layout that glMultiDrawElementsIndirect reads.
+     */
+    struct DrawElementsIndirectCommand
+    {
+        uint32_t count;
+        uint32_t instanceCount;
+        uint32_t firstIndex;
+        int32_t baseVertex;
+        uint32_t baseInstance;
+    };
+
+    /**
+     * @brief What a shader needs to know about each draw. Read through gl_DrawID. Must match Instancing.glsl.
+     */
+    struct DrawData
+    {
+        uint32_t instanceOffset;
+        uint32_t materialIndex;
+    };
+
+    /**
+     * @brief Turns instance batches into indirect commands so that runs of batches that share a vao are drawn
+     * with one glMultiDrawElementsIndirect.
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class MultiDrawBuilder
+    {
+    public:
+        /**
+         * @brief Replaces the commands with one for each batch, in the same order.
+         */
+        void build(const std::vector<InstanceBatch> &batches);
+
+        /**
+         * @brief Writes the commands and draw data into the buffer. The draw data is bound to slot 10 and the commands
+         * to the indirect buffer, so nothing else may be written to the buffer until the commands are drawn.
+         */
+        void upload(StreamingBuffer &buffer);
+
+        /**
+         * @brief Draws the commands from first to last, with one multi-draw for each run that shares a vao and a run key.
+         * @param runKey Called with a command's index. Commands are only drawn together when this returns the same value.
+         * @param beginRun Called with the index of the first command of each run before it is drawn. It must set
+         * u_draw_offset to that index.
+         * @returns How many multi-draws were issued.
+         */
+        template<typename TRunKey, typename TBeginRun>
+        uint32_t draw(uint32_t first, uint32_t last, TRunKey &&runKey, TBeginRun &&beginRun) const;
+
+    protected:
+        void submit(uint32_t first, uint32_t count) const;
+
+        std::vector<DrawElementsIndirectCommand> mCommands;
+        std::vector<DrawData> mDrawData;
+        std::vector<uint32_t> mVaos;
+        StreamingRange mCommandRange;
+    };
+
+    template<typename TRunKey, typename TBeginRun>
+    uint32_t MultiDrawBuilder::draw(const uint32_t first, const uint32_t last, TRunKey &&runKey, TBeginRun &&beginRun) const
+    {
+        uint32_t drawCount = 0;
+        uint32_t runFirst = first;
+        while (runFirst < last)
+        {
+            const auto key = runKey(runFirst);
+            uint32_t runLast = runFirst + 1;
+            while (runLast < last && mVaos[runLast] == mVaos[runFirst] && runKey(runLast) == key)
+                ++runLast;
+
+            beginRun(runFirst);
+            glBindVertexArray(mVaos[runFirst]);
+            submit(runFirst, runLast - runFirst);
+
+            ++drawCount;
+            runFirst = runLast;
+        }
+
+        return drawCount;
+    }
+} // graphics
@@ -8,6 +8,7 @@
 #include "RendererBackend.h"
 
 #include "GraphicsFunctions.h"
+#include "ProfileTimer.h"
 #include "WindowHelpers.h"
 
 namespace graphics
@@ -43,6 +44,8 @@ namespace graphics
 
         mSingleGeometryQueue = std::move(queues.singleMaterialGeometryQueue);
         mSingleMaterialQueue = std::move(queues.singleMaterialQueue);
+
+        mStaticGeneration = queues.staticGeneration;
     }
 
     void RendererBackend::execute()
@@ -50,31 +53,42 @@ namespace graphics
         PROFILE_FUNC();
         pushDebugGroup("Render Pass");
 
-        mShadowMapping.execute(mMultiGeometryQueue, mSingleGeometryQueue, mPointLightQueue);
-        mShadowMapping.execute(mMultiGeometryQueue, mSingleGeometryQueue, mSpotlightQueue);
+        mTileClassification.setSpecialisedVariantsReady(mLightShading.updateShaderVariants());
+        mMaterialTable.upload();
+
+        mShadowMapping.prepareInstances(mMultiGeometryQueue, mSingleGeometryQueue, mStaticGeneration);
+        mShadowMapping.execute(mPointLightQueue);
+        mShadowMapping.execute(mSpotlightQueue);
 
         // Reset the viewport back to the normal size once we've finished rendering all the shadows.
         glViewport(0, 0, window::bufferSize().x, window::bufferSize().y);
 
+        mCulledCount = 0;
         for (const auto &camera : mCameraQueue)
         {
             setupCurrentCamera(camera);
+            cullGeometry();
 
             mMaterialRendering.execute(
-                window::bufferSize(), mContext,
-                mMultiGeometryQueue, mMultiMaterialQueue,
-                mSingleGeometryQueue, mSingleMaterialQueue
+                window::bufferSize(), mContext, mMaterialTable,
+                mMultiGeometryQueue, mMultiMaterialQueue, mMultiVisible,
+                mSingleGeometryQueue, mSingleMaterialQueue, mSingleVisible
             );
 
             mTileClassification.execute(window::bufferSize(), mContext);
-            mShadowMapping.execute(camera, mMultiGeometryQueue, mSingleGeometryQueue, mDirectionalLightQueue);
+            mShadowMapping.execute(camera, mDirectionalLightQueue);
 
             mContext.lightBuffer.resize(window::bufferSize());
             mContext.lightBuffer.clear();
 
             mLightShading.execute(mContext, mPrecalcs, mDirectionalLightQueue);
-            mLightShading.execute(mContext, mPrecalcs, mPointLightQueue);
-            mLightShading.execute(mContext, mPrecalcs, mSpotlightQueue);
+            if (mUseClusteredLighting && LightShadingPass::isClusteredLightingSupported())
+                mLightShading.executeClustered(mContext, mPrecalcs, mPointLightQueue, mSpotlightQueue);
+            else
+            {
+                mLightShading.execute(mContext, mPrecalcs, mPointLightQueue);
+                mLightShading.execute(mContext, mPrecalcs, mSpotlightQueue);
+            }
             mLightShading.execute(mContext, mPrecalcs, mSkybox);
 
             mSkyboxPass.execute(window::bufferSize(), mContext, mSkybox);
@@ -85,6 +99,9 @@ namespace graphics
             mDebugPass.execute(window::bufferSize(), mContext, mDebugQueue, mLineQueue);
         }
 
+        PROFILE_COUNTER("Geometry Submitted", mMultiGeometryQueue.size() + mSingleGeometryQueue.size());
+        PROFILE_COUNTER("Geometry Culled", mCulledCount);
+
         popDebugGroup();
     }
 
@@ -119,12 +136,28 @@ namespace graphics
         mTileClassification.setUseUberVariant(useUber);
     }
 
+    void RendererBackend::setUseClusteredLighting(const bool useClustered)
+    {
+        mUseClusteredLighting = useClustered;
+    }
+
+    void RendererBackend::setUseDepthPrepass(const bool useDepthPrepass)
+    {
+        mMaterialRendering.setUseDepthPrepass(useDepthPrepass);
+    }
+
+    MaterialTable& RendererBackend::getMaterialTable()
+    {
+        return mMaterialTable;
+    }
+
     void RendererBackend::setupCurrentCamera(const CameraSettings& camera)
     {
         const float exposure = 1.f / (1.2f * glm::pow(2.f, camera.eV100));
         const glm::mat4 cameraProjectionMatrix = glm::perspective(camera.fovY, window::aspectRatio(), camera.nearClipDistance, camera.farClipDistance);
         const glm::mat4 vpMatrix = cameraProjectionMatrix * camera.viewMatrix;
         mContext.cameraViewProjectionMatrix = vpMatrix;
+        mContext.cameraProjectionMatrix = cameraProjectionMatrix;
 
         mContext.camera->viewMatrix = camera.viewMatrix;
         mContext.camera->inverseVpMatrix = glm::inverse(vpMatrix);
@@ -135,6 +168,17 @@ namespace graphics
         mContext.camera.updateGlsl();
     }
 
+    void RendererBackend::cullGeometry()
+    {
+        // Shadow casters outside of the camera's frustum can still cast into it, so only the material pass is culled.
+        const Frustum frustum = extractFrustum(mContext.cameraViewProjectionMatrix);
+        mFrustumCuller.cull(frustum, mMultiGeometryQueue, mMultiVisible);
+        mFrustumCuller.cull(frustum, mSingleGeometryQueue, mSingleVisible);
+
+        mCulledCount += static_cast<uint32_t>(mMultiGeometryQueue.size() - mMultiVisible.size());
+        mCulledCount += static_cast<uint32_t>(mSingleGeometryQueue.size() - mSingleVisible.size());
+    }
+
     void RendererBackend::executePostProcessStack(const CameraSettings &camera)
     {
         PROFILE_FUNC();
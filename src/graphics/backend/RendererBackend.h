@@ -9,11 +9,13 @@
 
 #include "Context.h"
 #include "DebugPass.h"
+#include "FrameArena.h"
+#include "FrustumCulling.h"
 #include "GraphicsLighting.h"
 #include "LightShadingPass.h"
 #include "LookUpTables.h"
-#include "MaterialData.h"
 #include "MaterialRenderingPass.h"
+#include "MaterialTable.h"
 #include "Pch.h"
 #include "ShadowMappingPass.h"
 #include "SkyboxPass.h"
@@ -23,18 +25,20 @@ namespace graphics
 {
     struct Queues
     {
-        std::vector<CameraSettings> cameraQueue;
-        std::vector<DirectionalLight> directionalLightQueue;
-        std::vector<PointLight> pointLightQueue;
-        std::vector<Spotlight> spotlightQueue;
-        std::vector<DebugQueueObject> debugQueue;
-        std::vector<LineQueueObject> lineQueue;
-
-        std::vector<GeometryObject> multiMaterialGeometryQueue;
-        std::vector<MaterialData> multiMaterialQueue;
-
-        std::vector<GeometryObject> singleMaterialGeometryQueue;
-        std::vector<MaterialData> singleMaterialQueue;
+        FrameVector<CameraSettings> cameraQueue;
+        FrameVector<DirectionalLight> directionalLightQueue;
+        FrameVector<PointLight> pointLightQueue;
+        FrameVector<Spotlight> spotlightQueue;
+        FrameVector<DebugQueueObject> debugQueue;
+        FrameVector<LineQueueObject> lineQueue;
+
+        FrameVector<GeometryObject> multiMaterialGeometryQueue;
+        FrameVector<uint32_t> multiMaterialQueue;  // Indices into the material table.
+
+        FrameVector<GeometryObject> singleMaterialGeometryQueue;
+        FrameVector<uint32_t> singleMaterialQueue;
+
+        uint64_t staticGeneration;
     };
 
     /**
@@ -56,34 +60,48 @@ namespace graphics
         const TextureBufferObject& whtieFurnacetest();
 
         void setUseUberVariant(bool useUber);
+        void setUseClusteredLighting(bool useClustered);
+        void setUseDepthPrepass(bool useDepthPrepass);
+
+        MaterialTable &getMaterialTable();
 
     protected:
         void setupCurrentCamera(const CameraSettings &camera);
         void executePostProcessStack(const CameraSettings &camera);
+        void cullGeometry();
 
         static constexpr int lutSize = 32;
         Lut mPrecalcs = precalculateLuts(lutSize);
         Skybox mSkybox;
 
         Context mContext;
+        MaterialTable mMaterialTable;
         MaterialRenderingPass mMaterialRendering;
         TileClassificationPass mTileClassification;
         ShadowMappingPass mShadowMapping;
         LightShadingPass mLightShading;
         SkyboxPass mSkyboxPass;
         DebugPass mDebugPass;
+        FrustumCuller mFrustumCuller;
+
+        FrameVector<CameraSettings> mCameraQueue;
+        FrameVector<DirectionalLight> mDirectionalLightQueue;
+        FrameVector<PointLight> mPointLightQueue;
+        FrameVector<Spotlight> mSpotlightQueue;
+        FrameVector<DebugQueueObject> mDebugQueue;
+        FrameVector<LineQueueObject> mLineQueue;
+
+        FrameVector<GeometryObject> mMultiGeometryQueue;
+        FrameVector<uint32_t> mMultiMaterialQueue;
 
-        std::vector<CameraSettings> mCameraQueue;
-        std::vector<DirectionalLight> mDirectionalLightQueue;
-        std::vector<PointLight> mPointLightQueue;
-        std::vector<Spotlight> mSpotlightQueue;
-        std::vector<DebugQueueObject> mDebugQueue;
-        std::vector<LineQueueObject> mLineQueue;
+        FrameVector<GeometryObject> mSingleGeometryQueue;
+        FrameVector<uint32_t> mSingleMaterialQueue;
 
-        std::vector<GeometryObject> mMultiGeometryQueue;
-        std::vector<MaterialData> mMultiMaterialQueue;
+        uint64_t mStaticGeneration { 0 };
 
-        std::vector<GeometryObject> mSingleGeometryQueue;
-        std::vector<MaterialData> mSingleMaterialQueue;
+        std::vector<uint32_t> mMultiVisible;
+        std::vector<uint32_t> mSingleVisible;
+        uint32_t mCulledCount { 0 };
+        bool mUseClusteredLighting { true };
     };
 } // graphics
@@ -7,132 +7,577 @@
 
 #include "ShadowMappingPass.h"
 
+#include <unordered_set>
+
 #include "Cubemap.h"
+#include "Format.h"
 #include "GraphicsFunctions.h"
 #include "WindowHelpers.h"
 
 namespace graphics
 {
-    void ShadowMappingPass::execute(
-        const std::vector<GeometryObject> &multiGeometryQueue,
-        const std::vector<GeometryObject> &singleGeometryQueue,
-        std::vector<PointLight> &pointLightQueue)
+    namespace
     {
-        if (pointLightQueue.empty())
+        constexpr uint64_t fnvOffsetBasis = 14695981039346656037ull;
+        constexpr uint64_t fnvPrime = 1099511628211ull;
+
+        // How many frames a light can go unseen before its cache is freed.
+        constexpr uint64_t cacheLifetime = 60;
+
+        uint64_t hashBytes(uint64_t hash, const void *data, const size_t size)
+        {
+            const auto *bytes = static_cast<const uint8_t*>(data);
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash ^= bytes[i];
+                hash *= fnvPrime;
+            }
+            return hash;
+        }
+
+        template<typename T>
+        uint64_t hashValue(const uint64_t hash, const T &value)
+        {
+            return hashBytes(hash, &value, sizeof(T));
+        }
+
+        bool overlaps(const BoundingSphere &a, const BoundingSphere &b)
+        {
+            return glm::distance(a.centre, b.centre) <= a.radius + b.radius;
+        }
+
+        /**
+         * @brief Profile counters only hold a view of their name so these are never freed. Only called from the
+         * render thread.
+         */
+        std::string_view counterName(const std::string_view lightName, const size_t lightIndex, const std::string_view statistic)
+        {
+            static std::unordered_set<std::string> names;
+            return *names.insert(format::string("% % Shadow %", lightName, lightIndex, statistic)).first;
+        }
+
+        template<typename TTexture>
+        void setCacheCounters(ShadowCache<TTexture> &cache, const std::string_view lightName, const size_t lightIndex, const uint32_t drawCount)
+        {
+#ifdef ENABLE_PROFILING
+            if (cache.counterLightIndex != lightIndex)
+            {
+                cache.counterLightIndex = lightIndex;
+                cache.counterNames = {
+                    counterName(lightName, lightIndex, "Cache Hits"),
+                    counterName(lightName, lightIndex, "Renders"),
+                    counterName(lightName, lightIndex, "Draws"),
+                };
+            }
+
+            PROFILE_COUNTER(cache.counterNames[0], cache.hitCount);
+            PROFILE_COUNTER(cache.counterNames[1], cache.renderCount);
+            PROFILE_COUNTER(cache.counterNames[2], drawCount);
+#endif  // ENABLE_PROFILING
+        }
+
+        /**
+         * @brief Copies every face or layer of a depth texture into another of the same size and format.
+         */
+        void copyDepth(const uint32_t source, const uint32_t destination, const GLenum target, const glm::ivec2 &size, const int depth)
+        {
+            constexpr int x = 0;
+            constexpr int y = 0;
+            constexpr int z = 0;
+            constexpr int mipLevel = 0;
+            glCopyImageSubData(
+                source, target, mipLevel, x, y, z,
+                destination, target, mipLevel, x, y, z,
+                size.x, size.y, depth);
+        }
+    }
+
+    void ShadowMappingPass::prepareInstances(
+        const FrameVector<GeometryObject> &multiGeometryQueue,
+        const FrameVector<GeometryObject> &singleGeometryQueue,
+        const uint64_t staticGeneration)
+    {
+        PROFILE_FUNC();
+        ++mFrameIndex;
+        mBatches.clear();
+        mInstanceMatrices.clear();
+        mInstanceBounds.clear();
+        mStaticCasters.clear();
+        mMovableCasters.clear();
+        mAreStaticCastersHashed = false;
+
+        // Static batches go first so that they can be drawn on their own into the static layers.
+        const auto batch = [this](const FrameVector<GeometryObject> &geometryQueue, const Mobility mobility) {
+            mBatchIndices.clear();
+            for (uint32_t i = 0; i < geometryQueue.size(); ++i)
+            {
+                if (geometryQueue[i].mobility == mobility)
+                    mBatchIndices.push_back(i);
+            }
+            mInstanceBatcher.batchByMesh(geometryQueue, mBatchIndices, mBatches, mInstanceMatrices, mInstanceBounds);
+        };
+
+        batch(multiGeometryQueue, Mobility::Static);
+        batch(singleGeometryQueue, Mobility::Static);
+        mStaticBatchCount = mBatches.size();
+        batch(multiGeometryQueue, Mobility::Movable);
+        batch(singleGeometryQueue, Mobility::Movable);
+
+        const size_t count = mInstanceBounds.size();
+        mX.resize(count);
+        mY.resize(count);
+        mZ.resize(count);
+        mRadius.resize(count);
+        mLightVisible.resize(count);
+        mViewVisible.resize(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const BoundingSphere &sphere = mInstanceBounds[i];
+            mX[i] = sphere.centre.x;
+            mY[i] = sphere.centre.y;
+            mZ[i] = sphere.centre.z;
+            mRadius[i] = sphere.radius;
+        }
+
+        addCasters(multiGeometryQueue);
+        addCasters(singleGeometryQueue);
+
+        if (staticGeneration != mStaticGeneration || mStaticCasters.size() != mStaticCasterCount)
+        {
+            mStaticGeneration = staticGeneration;
+            mStaticCasterCount = mStaticCasters.size();
+            ++mCasterGeneration;
+        }
+
+        evictUnusedCaches(mPointLightCaches);
+        evictUnusedCaches(mSpotlightCaches);
+        evictUnusedCaches(mDirectionalLightCaches);
+
+        PROFILE_COUNTER("Shadow Batches", mBatches.size());
+        PROFILE_COUNTER("Static Shadow Batches", mStaticBatchCount);
+    }
+
+    void ShadowMappingPass::addCasters(const FrameVector<GeometryObject> &geometryQueue)
+    {
+        for (const GeometryObject &geometry : geometryQueue)
+        {
+            if (geometry.mobility == Mobility::Movable)
+            {
+                mMovableCasters.push_back(geometry.worldBounds);
+                continue;
+            }
+
+            mStaticCasters.push_back({ geometry.worldBounds, &geometry, 0 });
+        }
+    }
+
+    void ShadowMappingPass::hashStaticCasters()
+    {
+        if (mAreStaticCastersHashed)
             return;
 
         PROFILE_FUNC();
-        pushDebugGroup("Point Light Shadow Mapping");
-        mFramebuffer.bind();
-        mPointLightShadowShader.bind();
+        for (Caster &caster : mStaticCasters)
+        {
+            const GeometryObject &geometry = *caster.geometry;
+            uint64_t hash = fnvOffsetBasis;
+            hash = hashValue(hash, geometry.vao);
+            hash = hashValue(hash, geometry.indicesCount);
+            hash = hashValue(hash, geometry.firstIndex);
+            hash = hashValue(hash, geometry.baseVertex);
+            hash = hashValue(hash, geometry.matrix);
+            caster.hash = hash;
+        }
+        mAreStaticCastersHashed = true;
+    }
 
-        for (auto &pointLight : pointLightQueue)
+    template<typename TTexture>
+    ShadowUpdate ShadowMappingPass::updateCache(
+        ShadowCache<TTexture> &cache, const bool isStatic, const uint64_t lightHash, const BoundingSphere &influence)
+    {
+        if (!isStatic)
         {
-            PROFILE_SCOPE_BEGIN(pointLightTimer, "Point Light Shadow Pass");
-            pushDebugGroup("Point Light Pass");
-            const glm::ivec2 size = pointLight.shadowMap->getSize();
-            glViewport(0, 0, size.x, size.y);
+            // Movable lights don't keep a static layer so free it if the light used to be static.
+            cache.staticLayer.reset();
+            cache.lightHash = 0;
+            cache.casterGeneration = 0;
+            cache.hasMovableLayer = true;
+            ++cache.renderCount;
+            return { true, false, true, false };
+        }
 
-            mPointLightShadowShader.set("u_light_pos", pointLight.position);
-            mPointLightShadowShader.set("u_z_far", pointLight.radius);
+        // Nothing static has been added, removed or moved and the light is where it was, so neither has its hash.
+        uint64_t staticCasterHash = cache.staticCasterHash;
+        if (cache.casterGeneration != mCasterGeneration || cache.lightHash != lightHash)
+        {
+            hashStaticCasters();
+            staticCasterHash = fnvOffsetBasis;
+            for (const Caster &caster : mStaticCasters)
+            {
+                if (overlaps(caster.bounds, influence))
+                    staticCasterHash = hashValue(staticCasterHash, caster.hash);
+            }
+        }
 
-            for (int viewIndex = 0; viewIndex < 6; ++viewIndex)
+        bool hasMovableCasters = false;
+        for (const BoundingSphere &bounds : mMovableCasters)
+        {
+            if (overlaps(bounds, influence))
             {
-                pushDebugGroup("Rendering Face");
-                Cubemap &shadowMap = *pointLight.shadowMap;
-                mFramebuffer.attachDepthBuffer(shadowMap, viewIndex, 0);
-                mFramebuffer.clearDepthBuffer();
+                hasMovableCasters = true;
+                break;
+            }
+        }
+
+        ShadowUpdate update;
+        update.renderStatic = cache.lightHash != lightHash || cache.staticCasterHash != staticCasterHash;
+        update.renderMovable = hasMovableCasters;
+        // Compositing with no movable casters still has to happen once to remove the ones from the last render.
+        update.composite = update.renderStatic || hasMovableCasters || cache.hasMovableLayer;
+
+        cache.lightHash = lightHash;
+        cache.staticCasterHash = staticCasterHash;
+        cache.casterGeneration = mCasterGeneration;
+        cache.hasMovableLayer = hasMovableCasters;
+
+        update.isCacheHit = !update.composite;
+        update.isCacheHit ? ++cache.hitCount : ++cache.renderCount;
+
+        return update;
+    }
+
+    template<typename TTexture>
+    ShadowCache<TTexture> &ShadowMappingPass::findCache(
+        std::unordered_map<const TTexture*, ShadowCache<TTexture>> &caches, const std::shared_ptr<TTexture> &shadowMap)
+    {
+        ShadowCache<TTexture> &cache = caches[shadowMap.get()];
+
+        // The address may belong to a shadow map that has since been destroyed.
+        if (cache.shadowMap.lock() != shadowMap)
+        {
+            cache = ShadowCache<TTexture>();
+            cache.shadowMap = shadowMap;
+        }
+
+        cache.lastUsedFrame = mFrameIndex;
+        return cache;
+    }
+
+    template<typename TTexture>
+    void ShadowMappingPass::evictUnusedCaches(std::unordered_map<const TTexture*, ShadowCache<TTexture>> &caches) const
+    {
+        for (auto it = caches.begin(); it != caches.end();)
+        {
+            const ShadowCache<TTexture> &cache = it->second;
+            if (cache.shadowMap.expired() || mFrameIndex - cache.lastUsedFrame > cacheLifetime)
+                it = caches.erase(it);
+            else
+                ++it;
+        }
+    }
+
+    ShadowMappingPass::ShadowUniforms ShadowMappingPass::resolveUniforms(Shader &shader, const bool hasLightPosition)
+    {
+        ShadowUniforms uniforms;
+        uniforms.vpMatrix = shader.getUniform("u_vp_matrix");
+        uniforms.drawOffset = shader.getUniform("u_draw_offset");
+        if (hasLightPosition)
+        {
+            uniforms.lightPosition = shader.getUniform("u_light_pos");
+            uniforms.zFar = shader.getUniform("u_z_far");
+        }
+        return uniforms;
+    }
+
+    void ShadowMappingPass::beginViews()
+    {
+        mViews.clear();
+        mViewBatches.clear();
+        mViewMatrices.clear();
+        mLightDraws.clear();
+    }
 
-                for (const auto &geometry : multiGeometryQueue)
+    uint32_t ShadowMappingPass::addView(const uint8_t *visible, const bool includeStatic, const bool includeMovable)
+    {
+        const auto appendBatches = [this, visible](const size_t first, const size_t last) {
+            for (size_t i = first; i < last; ++i)
+            {
+                const InstanceBatch &batch = mBatches[i];
+                InstanceBatch viewBatch {
+                    batch.vao, batch.indicesCount, batch.firstIndex, batch.baseVertex,
+                    static_cast<uint32_t>(mViewMatrices.size()), 0, 0 };
+                for (uint32_t instance = batch.firstInstance; instance < batch.firstInstance + batch.instanceCount; ++instance)
                 {
-                    const glm::mat4 &modelMatrix = geometry.matrix;
-                    const glm::mat4 mvp = pointLight.vpMatrices[viewIndex] * modelMatrix;
-                    mPointLightShadowShader.set("u_model_matrix", modelMatrix);
-                    mPointLightShadowShader.set("u_mvp_matrix", mvp);
+                    if (visible[instance] == 0)
+                        continue;
 
-                    glBindVertexArray(geometry.vao);
-                    glDrawElements(GL_TRIANGLES, geometry.indicesCount, GL_UNSIGNED_INT, nullptr);
+                    mViewMatrices.push_back(mInstanceMatrices[instance]);
+                    ++viewBatch.instanceCount;
                 }
 
-                for (const auto &geometry : singleGeometryQueue)
+                if (viewBatch.instanceCount > 0)
+                    mViewBatches.push_back(viewBatch);
+            }
+        };
+
+        ShadowView view { };
+        view.firstBatch = static_cast<uint32_t>(mViewBatches.size());
+        if (includeStatic)
+            appendBatches(0, mStaticBatchCount);
+        view.movableBatch = static_cast<uint32_t>(mViewBatches.size());
+        if (includeMovable)
+            appendBatches(mStaticBatchCount, mBatches.size());
+        view.lastBatch = static_cast<uint32_t>(mViewBatches.size());
+
+        mViews.push_back(view);
+        return view.lastBatch - view.firstBatch;
+    }
+
+    void ShadowMappingPass::uploadViews(ShaderStorageBufferObject &instanceStorage)
+    {
+        const auto instanceBytes = static_cast<uint32_t>(sizeof(glm::mat4) * mViewMatrices.size());
+        instanceStorage.reserve(instanceBytes);
+        instanceStorage.write(mViewMatrices.data(), instanceBytes);
+        instanceStorage.bindToSlot(4);
+
+        mMultiDraw.build(mViewBatches);
+        mMultiDraw.upload(mDrawStreamingBuffer);
+    }
+
+    void ShadowMappingPass::cullInstances(const Frustum &frustum, const uint8_t *visible)
+    {
+        const size_t count = mInstanceBounds.size();
+        cullSpheres(frustum, mX.data(), mY.data(), mZ.data(), mRadius.data(), count, mViewVisible.data());
+        for (size_t i = 0; i < count; ++i)
+            mViewVisible[i] &= visible[i];
+    }
+
+    void ShadowMappingPass::drawBatches(
+        const Shader &shader, const ShadowUniforms &uniforms, const glm::mat4 &vpMatrix, const uint32_t first, const uint32_t last) const
+    {
+        shader.set(uniforms.vpMatrix, vpMatrix);
+        mMultiDraw.draw(
+            first, last,
+            [](uint32_t) { return 0; },
+            [&shader, &uniforms](const uint32_t i) { shader.set(uniforms.drawOffset, static_cast<int>(i)); });
+    }
+
+    void ShadowMappingPass::execute(FrameVector<PointLight> &pointLightQueue)
+    {
+        if (pointLightQueue.empty())
+            return;
+
+        PROFILE_FUNC();
+        pushDebugGroup("Point Light Shadow Mapping");
+        beginViews();
+
+        uint64_t hitCount = 0;
+        uint64_t renderCount = 0;
+        uint64_t drawCount = 0;
+        for (size_t lightIndex = 0; lightIndex < pointLightQueue.size(); ++lightIndex)
+        {
+            const PointLight &pointLight = pointLightQueue[lightIndex];
+            Cubemap &shadowMap = *pointLight.shadowMap;
+            const glm::ivec2 size = shadowMap.getSize();
+            const bool isStatic = pointLight.mobility == Mobility::Static;
+            const BoundingSphere influence { pointLight.position, pointLight.radius };
+
+            uint64_t lightHash = fnvOffsetBasis;
+            lightHash = hashValue(lightHash, pointLight.position);
+            lightHash = hashValue(lightHash, pointLight.radius);
+            lightHash = hashValue(lightHash, pointLight.vpMatrices);
+            lightHash = hashValue(lightHash, size);
+
+            ShadowCache<Cubemap> &cache = findCache(mPointLightCaches, pointLight.shadowMap);
+            if (isStatic && cache.staticLayer == nullptr)
+                cache.staticLayer = std::make_unique<Cubemap>(size, shadowMap.getFormat());
+            const ShadowUpdate update = updateCache(cache, isStatic, lightHash, influence);
+            update.isCacheHit ? ++hitCount : ++renderCount;
+
+            // Anything outside of the light's radius can't cast a shadow, so that's culled before each face.
+            uint32_t lightDrawCount = 0;
+            mLightDraws.push_back({ update, static_cast<uint32_t>(mViews.size()) });
+            if (!update.isCacheHit)
+            {
+                cullSpheres(influence, mX.data(), mY.data(), mZ.data(), mRadius.data(), mInstanceBounds.size(), mLightVisible.data());
+                for (const glm::mat4 &vpMatrix : pointLight.vpMatrices)
                 {
-                    const glm::mat4 &modelMatrix = geometry.matrix;
-                    const glm::mat4 mvp = pointLight.vpMatrices[viewIndex] * modelMatrix;
-                    mPointLightShadowShader.set("u_model_matrix", modelMatrix);
-                    mPointLightShadowShader.set("u_mvp_matrix", mvp);
+                    cullInstances(extractFrustum(vpMatrix), mLightVisible.data());
+                    lightDrawCount += addView(mViewVisible.data(), update.renderStatic, update.renderMovable);
+                }
+            }
+
+            drawCount += lightDrawCount;
+            setCacheCounters(cache, "Point Light", lightIndex, lightDrawCount);
+        }
 
-                    glBindVertexArray(geometry.vao);
-                    glDrawElements(GL_TRIANGLES, geometry.indicesCount, GL_UNSIGNED_INT, nullptr);
+        mFramebuffer.bind();
+        mPointLightShadowShader.bind();
+        uploadViews(mPointLightInstanceStorage);
+
+        for (size_t lightIndex = 0; lightIndex < pointLightQueue.size(); ++lightIndex)
+        {
+            const LightDraw &lightDraw = mLightDraws[lightIndex];
+            if (lightDraw.update.isCacheHit)
+                continue;
+
+            const PointLight &pointLight = pointLightQueue[lightIndex];
+            PROFILE_SCOPE_BEGIN(pointLightTimer, "Point Light Shadow Pass");
+            pushDebugGroup("Point Light Pass");
+            Cubemap &shadowMap = *pointLight.shadowMap;
+            const glm::ivec2 size = shadowMap.getSize();
+            const ShadowCache<Cubemap> &cache = mPointLightCaches.at(&shadowMap);
+
+            glViewport(0, 0, size.x, size.y);
+            mPointLightShadowShader.set(mPointLightUniforms.lightPosition, pointLight.position);
+            mPointLightShadowShader.set(mPointLightUniforms.zFar, pointLight.radius);
+
+            const auto renderFaces = [&](Cubemap &target, const bool clear, const bool drawStatic, const bool drawMovable) {
+                for (int viewIndex = 0; viewIndex < 6; ++viewIndex)
+                {
+                    pushDebugGroup("Rendering Face");
+                    mFramebuffer.attachDepthBuffer(target, viewIndex, 0);
+                    if (clear)
+                        mFramebuffer.clearDepthBuffer();
+
+                    const ShadowView &view = mViews[lightDraw.firstView + viewIndex];
+                    const uint32_t first = drawStatic ? view.firstBatch : view.movableBatch;
+                    const uint32_t last = drawMovable ? view.lastBatch : view.movableBatch;
+                    drawBatches(mPointLightShadowShader, mPointLightUniforms, pointLight.vpMatrices[viewIndex], first, last);
+
+                    mFramebuffer.detachDepthBuffer();
+                    popDebugGroup();
                 }
+            };
 
-                mFramebuffer.detachDepthBuffer();
-                popDebugGroup();
+            const ShadowUpdate &update = lightDraw.update;
+            if (pointLight.mobility != Mobility::Static)
+                renderFaces(shadowMap, true, true, true);
+            else
+            {
+                if (update.renderStatic)
+                    renderFaces(*cache.staticLayer, true, true, false);
+                if (update.composite)
+                    copyDepth(cache.staticLayer->getId(), shadowMap.getId(), GL_TEXTURE_CUBE_MAP, size, 6);
+                if (update.renderMovable)
+                    renderFaces(shadowMap, false, false, true);
             }
 
             PROFILE_SCOPE_END(pointLightTimer);
             popDebugGroup();
         }
 
+        mDrawStreamingBuffer.endFrame();
+
+        PROFILE_COUNTER("Point Light Shadow Cache Hits", hitCount);
+        PROFILE_COUNTER("Point Light Shadow Renders", renderCount);
+        PROFILE_COUNTER("Point Light Shadow Draws", drawCount);
         popDebugGroup();
     }
 
-    void ShadowMappingPass::execute(
-        const std::vector<GeometryObject> &multiGeometryQueue,
-        const std::vector<GeometryObject> &singleGeometryQueue,
-        const std::vector<Spotlight> &spotlightQueue)
+    void ShadowMappingPass::execute(const FrameVector<Spotlight> &spotlightQueue)
     {
         if (spotlightQueue.empty())
             return;
 
         PROFILE_FUNC();
         pushDebugGroup("Spotlight Shadow Mapping");
+        beginViews();
+
+        uint64_t hitCount = 0;
+        uint64_t renderCount = 0;
+        uint64_t drawCount = 0;
+        for (size_t lightIndex = 0; lightIndex < spotlightQueue.size(); ++lightIndex)
+        {
+            const Spotlight &spotlight = spotlightQueue[lightIndex];
+            TextureBufferObject &shadowMap = *spotlight.shadowMap;
+            const glm::ivec2 size = shadowMap.getSize();
+            const bool isStatic = spotlight.mobility == Mobility::Static;
+
+            uint64_t lightHash = fnvOffsetBasis;
+            lightHash = hashValue(lightHash, spotlight.vpMatrix);
+            lightHash = hashValue(lightHash, spotlight.position);
+            lightHash = hashValue(lightHash, spotlight.radius);
+            lightHash = hashValue(lightHash, size);
+
+            ShadowCache<TextureBufferObject> &cache = findCache(mSpotlightCaches, spotlight.shadowMap);
+            if (isStatic && cache.staticLayer == nullptr)
+            {
+                cache.staticLayer = std::make_unique<TextureBufferObject>(
+                    size, shadowMap.getFormat(), filter::Linear, wrap::ClampToBorder);
+            }
+            const ShadowUpdate update = updateCache(cache, isStatic, lightHash, { spotlight.position, spotlight.radius });
+            update.isCacheHit ? ++hitCount : ++renderCount;
+
+            uint32_t lightDrawCount = 0;
+            mLightDraws.push_back({ update, static_cast<uint32_t>(mViews.size()) });
+            if (!update.isCacheHit)
+            {
+                const Cone cone {
+                    spotlight.position, spotlight.direction,
+                    glm::cos(spotlight.outerAngle), glm::sin(spotlight.outerAngle), spotlight.radius
+                };
+                cullSpheres(cone, mX.data(), mY.data(), mZ.data(), mRadius.data(), mInstanceBounds.size(), mViewVisible.data());
+                lightDrawCount = addView(mViewVisible.data(), update.renderStatic, update.renderMovable);
+            }
+
+            drawCount += lightDrawCount;
+            setCacheCounters(cache, "Spotlight", lightIndex, lightDrawCount);
+        }
 
         mSpotlightShadowShader.bind();
         mFramebuffer.bind();
+        uploadViews(mSpotlightInstanceStorage);
 
-        for (const Spotlight &spotlight : spotlightQueue)
+        for (size_t lightIndex = 0; lightIndex < spotlightQueue.size(); ++lightIndex)
         {
-            const glm::ivec2 size = spotlight.shadowMap->getSize();
-            glViewport(0, 0, size.x, size.y);
+            const LightDraw &lightDraw = mLightDraws[lightIndex];
+            if (lightDraw.update.isCacheHit)
+                continue;
 
-            mFramebuffer.attachDepthBuffer(spotlight.shadowMap.get());
-            mFramebuffer.clearDepthBuffer();
+            const Spotlight &spotlight = spotlightQueue[lightIndex];
+            TextureBufferObject &shadowMap = *spotlight.shadowMap;
+            const glm::ivec2 size = shadowMap.getSize();
+            const ShadowCache<TextureBufferObject> &cache = mSpotlightCaches.at(&shadowMap);
+            const ShadowView &view = mViews[lightDraw.firstView];
 
-            const glm::mat4 &vpMatrix = spotlight.vpMatrix;
-            mSpotlightShadowShader.set("u_light_pos", spotlight.position);
-            mSpotlightShadowShader.set("u_z_far", spotlight.radius);
+            glViewport(0, 0, size.x, size.y);
+            mSpotlightShadowShader.set(mSpotlightUniforms.lightPosition, spotlight.position);
+            mSpotlightShadowShader.set(mSpotlightUniforms.zFar, spotlight.radius);
 
-            for (const auto &rqo : multiGeometryQueue)
-            {
-                const glm::mat4 mvpMatrix = vpMatrix * rqo.matrix;
-                mSpotlightShadowShader.set("u_mvp_matrix", mvpMatrix);
-                mSpotlightShadowShader.set("u_model_matrix", rqo.matrix);
+            const auto render = [&](TextureBufferObject &target, const bool clear, const uint32_t first, const uint32_t last) {
+                mFramebuffer.attachDepthBuffer(&target);
+                if (clear)
+                    mFramebuffer.clearDepthBuffer();
 
-                glBindVertexArray(rqo.vao);
-                glDrawElements(GL_TRIANGLES, rqo.indicesCount, GL_UNSIGNED_INT, nullptr);
-            }
+                drawBatches(mSpotlightShadowShader, mSpotlightUniforms, spotlight.vpMatrix, first, last);
 
-            for (const auto &rqo : singleGeometryQueue)
-            {
-                const glm::mat4 mvpMatrix = vpMatrix * rqo.matrix;
-                mSpotlightShadowShader.set("u_mvp_matrix", mvpMatrix);
-                mSpotlightShadowShader.set("u_model_matrix", rqo.matrix);
+                mFramebuffer.detachDepthBuffer();
+            };
 
-                glBindVertexArray(rqo.vao);
-                glDrawElements(GL_TRIANGLES, rqo.indicesCount, GL_UNSIGNED_INT, nullptr);
+            const ShadowUpdate &update = lightDraw.update;
+            if (spotlight.mobility != Mobility::Static)
+                render(shadowMap, true, view.firstBatch, view.lastBatch);
+            else
+            {
+                if (update.renderStatic)
+                    render(*cache.staticLayer, true, view.firstBatch, view.movableBatch);
+                if (update.composite)
+                    copyDepth(cache.staticLayer->getId(), shadowMap.getId(), GL_TEXTURE_2D, size, 1);
+                if (update.renderMovable)
+                    render(shadowMap, false, view.movableBatch, view.lastBatch);
             }
-
-            mFramebuffer.detachDepthBuffer();
         }
 
+        mDrawStreamingBuffer.endFrame();
+
+        PROFILE_COUNTER("Spotlight Shadow Cache Hits", hitCount);
+        PROFILE_COUNTER("Spotlight Shadow Renders", renderCount);
+        PROFILE_COUNTER("Spotlight Shadow Draws", drawCount);
         popDebugGroup();
     }
 
-    void ShadowMappingPass::execute(
-        const CameraSettings &camera,
-        const std::vector<GeometryObject> &multiGeometryQueue,
-        const std::vector<GeometryObject> &singleGeometryQueue,
-        std::vector<DirectionalLight> &directionalLightQueue)
+    void ShadowMappingPass::execute(const CameraSettings &camera, FrameVector<DirectionalLight> &directionalLightQueue)
     {
         if (directionalLightQueue.empty())
             return;
@@ -141,33 +586,32 @@ namespace graphics
         pushDebugGroup("Directional Light Shadow Mapping");
         const auto resize = [](const glm::vec4 &vec) { return vec / vec.w; };
 
-        mFramebuffer.bind();
-        mDirectionalLightShadowShader.bind();
+        beginViews();
 
-        for (DirectionalLight &directionalLight : directionalLightQueue)
+        uint64_t hitCount = 0;
+        uint64_t renderCount = 0;
+        uint64_t drawCount = 0;
+        for (size_t lightIndex = 0; lightIndex < directionalLightQueue.size(); ++lightIndex)
         {
+            DirectionalLight &directionalLight = directionalLightQueue[lightIndex];
             directionalLight.cascadeDepths.clear();
+            directionalLight.vpMatrices.clear();
             directionalLight.cascadeDepths.reserve(directionalLight.shadowCascadeMultipliers.size());
             for (const auto &multiplier : directionalLight.shadowCascadeMultipliers)
                 directionalLight.cascadeDepths.emplace_back(camera.farClipDistance * multiplier);
 
-            graphics::pushDebugGroup("Directional Light");
-
-            const glm::ivec2 &shadowMapSize = directionalLight.shadowMap->getSize();
-            glViewport(0, 0, shadowMapSize.x, shadowMapSize.y);
+            TextureArrayObject &shadowMap = *directionalLight.shadowMap;
+            const glm::ivec2 &shadowMapSize = shadowMap.getSize();
+            const int layerCount = shadowMap.getLayerCount();
 
             std::vector depths { camera.nearClipDistance };
             for (const float &depth : directionalLight.cascadeDepths)
                 depths.emplace_back(depth);
             depths.emplace_back(camera.farClipDistance);
 
-            for (int j = 0; j < directionalLight.shadowMap->getLayerCount(); ++j)
+            // Every cascade is worked out first so that we know whether the cached layers are still valid.
+            for (int j = 0; j < layerCount; ++j)
             {
-                pushDebugGroup("Cascade Pass");
-
-                mFramebuffer.attachDepthBuffer(*directionalLight.shadowMap, j);
-                mFramebuffer.clearDepthBuffer();
-
                 const float aspectRatio = window::aspectRatio();
                 const glm::mat4 projectionMatrix = glm::perspective(camera.fovY, aspectRatio, depths[j], depths[j + 1]);
 
@@ -220,34 +664,101 @@ namespace graphics
                 );
 
                 directionalLight.vpMatrices.emplace_back(lightProjectionMatrix * lightViewMatrix);
+            }
 
-                for (const auto &rqo : multiGeometryQueue)
-                {
-                    const glm::mat4 &modelMatrix = rqo.matrix;
-                    const glm::mat4 mvp = lightProjectionMatrix * lightViewMatrix * modelMatrix;
-                    mDirectionalLightShadowShader.set("u_mvp_matrix", mvp);
+            const bool isStatic = directionalLight.mobility == Mobility::Static;
 
-                    glBindVertexArray(rqo.vao);
-                    glDrawElements(GL_TRIANGLES, rqo.indicesCount, GL_UNSIGNED_INT, nullptr);
-                }
+            // The cascades follow the camera, so the cache only survives while the camera is still.
+            uint64_t lightHash = fnvOffsetBasis;
+            lightHash = hashBytes(lightHash, directionalLight.vpMatrices.data(), sizeof(glm::mat4) * directionalLight.vpMatrices.size());
+            lightHash = hashValue(lightHash, shadowMapSize);
+            lightHash = hashValue(lightHash, layerCount);
 
-                for (const auto &rqo : singleGeometryQueue)
+            ShadowCache<TextureArrayObject> &cache = findCache(mDirectionalLightCaches, directionalLight.shadowMap);
+            if (isStatic && cache.staticLayer == nullptr)
+            {
+                cache.staticLayer = std::make_unique<TextureArrayObject>(
+                    shadowMapSize, layerCount, shadowMap.getFormat(), filter::Linear, wrap::ClampToBorder);
+            }
+            const ShadowUpdate update = updateCache(cache, isStatic, lightHash, unboundedSphere());
+            update.isCacheHit ? ++hitCount : ++renderCount;
+
+            // Directional lights reach everything so only the cascades cull. Casters between the light and a cascade
+            // still shadow it, so each cascade is extended towards the light.
+            uint32_t lightDrawCount = 0;
+            mLightDraws.push_back({ update, static_cast<uint32_t>(mViews.size()) });
+            if (!update.isCacheHit)
+            {
+                std::fill(mLightVisible.begin(), mLightVisible.end(), 1);
+                for (const glm::mat4 &vpMatrix : directionalLight.vpMatrices)
                 {
-                    const glm::mat4 &modelMatrix = rqo.matrix;
-                    const glm::mat4 mvp = lightProjectionMatrix * lightViewMatrix * modelMatrix;
-                    mDirectionalLightShadowShader.set("u_mvp_matrix", mvp);
+                    cullInstances(extendTowardsEye(extractFrustum(vpMatrix)), mLightVisible.data());
+                    lightDrawCount += addView(mViewVisible.data(), update.renderStatic, update.renderMovable);
+                }
+            }
+
+            drawCount += lightDrawCount;
+            setCacheCounters(cache, "Directional Light", lightIndex, lightDrawCount);
+        }
 
-                    glBindVertexArray(rqo.vao);
-                    glDrawElements(GL_TRIANGLES, rqo.indicesCount, GL_UNSIGNED_INT, nullptr);
+        mFramebuffer.bind();
+        mDirectionalLightShadowShader.bind();
+        uploadViews(mDirectionalLightInstanceStorage);
+
+        for (size_t lightIndex = 0; lightIndex < directionalLightQueue.size(); ++lightIndex)
+        {
+            const LightDraw &lightDraw = mLightDraws[lightIndex];
+            if (lightDraw.update.isCacheHit)
+                continue;
+
+            const DirectionalLight &directionalLight = directionalLightQueue[lightIndex];
+            graphics::pushDebugGroup("Directional Light");
+
+            TextureArrayObject &shadowMap = *directionalLight.shadowMap;
+            const glm::ivec2 &shadowMapSize = shadowMap.getSize();
+            const int layerCount = shadowMap.getLayerCount();
+            const ShadowCache<TextureArrayObject> &cache = mDirectionalLightCaches.at(&shadowMap);
+            glViewport(0, 0, shadowMapSize.x, shadowMapSize.y);
+
+            const auto renderCascades = [&](TextureArrayObject &target, const bool clear, const bool drawStatic, const bool drawMovable) {
+                for (int j = 0; j < layerCount; ++j)
+                {
+                    pushDebugGroup("Cascade Pass");
+                    mFramebuffer.attachDepthBuffer(target, j);
+                    if (clear)
+                        mFramebuffer.clearDepthBuffer();
+
+                    const ShadowView &view = mViews[lightDraw.firstView + j];
+                    const uint32_t first = drawStatic ? view.firstBatch : view.movableBatch;
+                    const uint32_t last = drawMovable ? view.lastBatch : view.movableBatch;
+                    drawBatches(mDirectionalLightShadowShader, mDirectionalLightUniforms, directionalLight.vpMatrices[j], first, last);
+
+                    mFramebuffer.detachDepthBuffer();
+                    popDebugGroup();
                 }
+            };
 
-                mFramebuffer.detachDepthBuffer();
-                popDebugGroup();
+            const ShadowUpdate &update = lightDraw.update;
+            if (directionalLight.mobility != Mobility::Static)
+                renderCascades(shadowMap, true, true, true);
+            else
+            {
+                if (update.renderStatic)
+                    renderCascades(*cache.staticLayer, true, true, false);
+                if (update.composite)
+                    copyDepth(cache.staticLayer->getId(), shadowMap.getId(), GL_TEXTURE_2D_ARRAY, shadowMapSize, layerCount);
+                if (update.renderMovable)
+                    renderCascades(shadowMap, false, false, true);
             }
 
             popDebugGroup();
         }
 
+        mDrawStreamingBuffer.endFrame();
+
+        PROFILE_COUNTER("Directional Light Shadow Cache Hits", hitCount);
+        PROFILE_COUNTER("Directional Light Shadow Renders", renderCount);
+        PROFILE_COUNTER("Directional Light Shadow Draws", drawCount);
         popDebugGroup();
     }
 }
@@ -7,39 +7,178 @@
 
 #pragma once
 
+#include <array>
+
 #include "CameraSettings.h"
 #include "Context.h"
+#include "Cubemap.h"
 #include "FileLoader.h"
+#include "FrameArena.h"
+#include "FrustumCulling.h"
 #include "GraphicsLighting.h"
+#include "InstanceBatching.h"
+#include "MultiDraw.h"
 #include "Pch.h"
+#include "ShaderStorageBufferObject.h"
 
 namespace graphics
 {
 
     /**
+     * @brief Cached depth of the static casters seen by one light. The light's shadow map is only redrawn when
+     * the light, a static caster in its influence or the movable casters in its influence change.
+     */
+    template<typename TTexture>
+    struct ShadowCache
+    {
+        std::weak_ptr<TTexture> shadowMap;
+        std::unique_ptr<TTexture> staticLayer;  // Only made for static lights.
+        uint64_t lightHash = 0;
+        uint64_t staticCasterHash = 0;
+        uint64_t casterGeneration = 0;  // The static casters haven't changed since staticCasterHash while this matches.
+        bool hasMovableLayer = false;  // If the shadow map holds movable casters from the last render.
+        uint64_t lastUsedFrame = 0;
+
+        uint64_t hitCount = 0;
+        uint64_t renderCount = 0;
+
+        // Profile counter names for the light's index in its queue. Only remade when the index changes.
+        size_t counterLightIndex = ~static_cast<size_t>(0);
+        std::array<std::string_view, 3> counterNames;
+    };
+
+    /**
+     * @brief What needs redrawing for a light this frame.
+     */
+    struct ShadowUpdate
+    {
+        bool renderStatic = false;   // Redraw the static layer.
+        bool composite = false;      // Copy the static layer into the shadow map.
+        bool renderMovable = false;  // Draw the movable casters over the top.
+        bool isCacheHit = false;     // The shadow map is left as it is.
+    };
+
+    /**
+     * @brief Renders the depth of every shadow caster from each light. Casters are culled against each light face
+     * or cascade and those sharing a mesh are drawn with one instanced draw call. Static lights keep their static
+     * casters in a separate layer that is only redrawn when something in it changes. Movable casters are
+     * composited over a copy of it.
      * @author Ryan Purse
      * @date 09/03/2024
      */
     class ShadowMappingPass
     {
     public:
-        void execute(
-            const std::vector<GeometryObject> &multiGeometryQueue,
-            const std::vector<GeometryObject> &singleGeometryQueue,
-            std::vector<PointLight> &pointLightQueue);
-
-        void execute(
-            const std::vector<GeometryObject> &multiGeometryQueue,
-            const std::vector<GeometryObject> &singleGeometryQueue,
-            const std::vector<Spotlight> &spotlightQueue);
-
-        void execute(
-            const CameraSettings &camera,
-            const std::vector<GeometryObject> &multiGeometryQueue,
-            const std::vector<GeometryObject> &singleGeometryQueue,
-            std::vector<DirectionalLight> &directionalLightQueue);
+        /**
+         * @brief Batches both queues by mesh and mobility. Must be called once per frame before any of the
+         * execute functions.
+         * @param staticGeneration Changes whenever a static caster is added, removed or moved. Static casters are
+         * only hashed again when it does.
+         */
+        void prepareInstances(
+            const FrameVector<GeometryObject> &multiGeometryQueue,
+            const FrameVector<GeometryObject> &singleGeometryQueue,
+            uint64_t staticGeneration);
+
+        void execute(FrameVector<PointLight> &pointLightQueue);
+
+        void execute(const FrameVector<Spotlight> &spotlightQueue);
+
+        void execute(const CameraSettings &camera, FrameVector<DirectionalLight> &directionalLightQueue);
 
     protected:
+        /**
+         * @brief The uniforms each shadow shader sets per light or per batch.
+         */
+        struct ShadowUniforms
+        {
+            UniformHandle vpMatrix;
+            UniformHandle drawOffset;
+            UniformHandle lightPosition;
+            UniformHandle zFar;
+        };
+
+        /**
+         * @brief Just enough of a caster to tell whether it overlaps a light and whether it has changed.
+         * The hash is only filled in by hashStaticCasters().
+         */
+        struct Caster
+        {
+            BoundingSphere bounds;
+            const GeometryObject *geometry;
+            uint64_t hash;
+        };
+
+        /**
+         * @brief The culled batches of one light face or cascade. Static batches are [firstBatch, movableBatch)
+         * and movable batches are [movableBatch, lastBatch) in mViewBatches.
+         */
+        struct ShadowView
+        {
+            uint32_t firstBatch;
+            uint32_t movableBatch;
+            uint32_t lastBatch;
+        };
+
+        /**
+         * @brief What was decided for a light while culling, so that it can be drawn once the instances are uploaded.
+         */
+        struct LightDraw
+        {
+            ShadowUpdate update;
+            uint32_t firstView;
+        };
+
+        static ShadowUniforms resolveUniforms(Shader &shader, bool hasLightPosition);
+
+        void addCasters(const FrameVector<GeometryObject> &geometryQueue);
+
+        /**
+         * @brief Hashes this frame's static casters if they haven't been already.
+         */
+        void hashStaticCasters();
+
+        /**
+         * @brief Decides what needs to be redrawn and updates the cache's state and statistics to match.
+         * @param isStatic Movable lights don't have a static layer so they are always fully redrawn.
+         */
+        template<typename TTexture>
+        ShadowUpdate updateCache(ShadowCache<TTexture> &cache, bool isStatic, uint64_t lightHash, const BoundingSphere &influence);
+
+        template<typename TTexture>
+        ShadowCache<TTexture> &findCache(
+            std::unordered_map<const TTexture*, ShadowCache<TTexture>> &caches, const std::shared_ptr<TTexture> &shadowMap);
+
+        template<typename TTexture>
+        void evictUnusedCaches(std::unordered_map<const TTexture*, ShadowCache<TTexture>> &caches) const;
+
+        /**
+         * @brief Clears the views of the last pass.
+         */
+        void beginViews();
+
+        /**
+         * @brief Builds the batches of a view from the instances that are visible.
+         * @param visible One value per instance. Instances are drawn when it's non-zero.
+         * @returns The number of draw calls the view will make.
+         */
+        uint32_t addView(const uint8_t *visible, bool includeStatic, bool includeMovable);
+
+        /**
+         * @brief Uploads the model matrices and indirect commands of every view added since beginViews().
+         */
+        void uploadViews(ShaderStorageBufferObject &instanceStorage);
+
+        /**
+         * @brief Ands the visibility of each instance with the frustum into mViewVisible.
+         */
+        void cullInstances(const Frustum &frustum, const uint8_t *visible);
+
+        /**
+         * @brief Draws batches [first, last) of mViewBatches with one multi-draw for each vao.
+         */
+        void drawBatches(const Shader &shader, const ShadowUniforms &uniforms, const glm::mat4 &vpMatrix, uint32_t first, uint32_t last) const;
+
         FramebufferObject mFramebuffer = FramebufferObject(GL_ONE, GL_ZERO, GL_LESS);
 
         Shader mDirectionalLightShadowShader {
@@ -53,6 +192,54 @@ namespace graphics
         Shader mSpotlightShadowShader {
             { file::shaderPath() / "shadow/PointShadow.vert", file::shaderPath() / "shadow/PointShadow.frag" }
         };
+
+        ShadowUniforms mDirectionalLightUniforms = resolveUniforms(mDirectionalLightShadowShader, false);
+        ShadowUniforms mPointLightUniforms = resolveUniforms(mPointLightShadowShader, true);
+        ShadowUniforms mSpotlightUniforms = resolveUniforms(mSpotlightShadowShader, true);
+
+        // One for each light type so that writing the next pass's instances never waits on the last one.
+        ShaderStorageBufferObject mPointLightInstanceStorage = ShaderStorageBufferObject("Point Light Shadow Instance Storage");
+        ShaderStorageBufferObject mSpotlightInstanceStorage = ShaderStorageBufferObject("Spotlight Shadow Instance Storage");
+        ShaderStorageBufferObject mDirectionalLightInstanceStorage = ShaderStorageBufferObject("Directional Light Shadow Instance Storage");
+
+        StreamingBuffer mDrawStreamingBuffer = StreamingBuffer(64 * 1024, "Shadow Draw Streaming Buffer");
+        MultiDrawBuilder mMultiDraw;
+
+        InstanceBatcher mInstanceBatcher;
+        std::vector<InstanceBatch> mBatches;  // Static batches come first.
+        size_t mStaticBatchCount { 0 };
+        std::vector<glm::mat4> mInstanceMatrices;
+        std::vector<BoundingSphere> mInstanceBounds;
+        std::vector<uint32_t> mBatchIndices;
+
+        // The instance bounds as a structure of arrays for the culling kernels.
+        std::vector<float> mX;
+        std::vector<float> mY;
+        std::vector<float> mZ;
+        std::vector<float> mRadius;
+        std::vector<uint8_t> mLightVisible;
+        std::vector<uint8_t> mViewVisible;
+
+        std::vector<ShadowView> mViews;
+        std::vector<InstanceBatch> mViewBatches;
+        std::vector<glm::mat4> mViewMatrices;
+        std::vector<LightDraw> mLightDraws;
+
+        std::vector<Caster> mStaticCasters;
+        std::vector<BoundingSphere> mMovableCasters;
+        bool mAreStaticCastersHashed { false };
+
+        // Bumped when the scene's static generation or the number of static casters changes. The count catches
+        // geometry that stops being submitted without the scene knowing, such as a hidden mesh.
+        uint64_t mCasterGeneration { 1 };
+        uint64_t mStaticGeneration { 0 };
+        size_t mStaticCasterCount { 0 };
+
+        // Keyed by the light's shadow map since that lives as long as the light does. Freed once it's been unused for a while.
+        std::unordered_map<const Cubemap*, ShadowCache<Cubemap>> mPointLightCaches;
+        std::unordered_map<const TextureBufferObject*, ShadowCache<TextureBufferObject>> mSpotlightCaches;
+        std::unordered_map<const TextureArrayObject*, ShadowCache<TextureArrayObject>> mDirectionalLightCaches;
+        uint64_t mFrameIndex { 0 };
     };
 
 } // graphics
@@ -35,7 +35,7 @@ namespace graphics
 
         context.tileClassificationStorage.bindToSlot(1);
 
-        if (mUseUberVariant)
+        if (mUseUberVariant || !mAreSpecialisedVariantsReady)
             mUberShaderTable.bindToSlot(0);
         else
             mShaderTableUbo.bindToSlot(0);
@@ -54,6 +54,11 @@ namespace graphics
         mUseUberVariant = useUber;
     }
 
+    void TileClassificationPass::setSpecialisedVariantsReady(const bool isReady)
+    {
+        mAreSpecialisedVariantsReady = isReady;
+    }
+
     void TileClassificationPass::generateShaderTable()
     {
         mShaderTable.reserve(shaderFlagPermutations);
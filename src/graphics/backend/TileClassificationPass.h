@@ -30,6 +30,11 @@ namespace graphics
 
         void setUseUberVariant(bool useUber);
 
+        /**
+         * @brief Every tile is sent to the uber variant until the specialised lighting variants have been built.
+         */
+        void setSpecialisedVariantsReady(bool isReady);
+
     protected:
         void generateShaderTable();
         static constexpr uint32_t indirectBufferSize = 4 * sizeof(uint32_t) * shaderVariationCount;
@@ -46,6 +51,7 @@ namespace graphics
         std::vector<shaderVariant> mShaderTable;
 
         bool mUseUberVariant = false;
+        bool mAreSpecialisedVariantsReady = false;
         Ubo mShaderTableUbo = Ubo(shaderFlagPermutations * sizeof(uint32_t));
         Ubo mUberShaderTable = Ubo(shaderFlagPermutations * sizeof(uint32_t));
     };
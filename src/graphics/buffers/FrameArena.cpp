@@ -0,0 +1,70 @@
+/**
+ * @file FrameArena.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "FrameArena.h"
+
+namespace graphics
+{
+    FrameArena::FrameArena(const uint64_t blockSize)
+        : mBlockSize(blockSize)
+    {
+    }
+
+    void *FrameArena::allocate(const uint64_t size, const uint64_t alignment)
+    {
+        if (mBlocks.empty())
+            addBlock(glm::max(mBlockSize, size + alignment));
+
+        while (true)
+        {
+            Block &block = mBlocks[mCurrentBlock];
+
+            // The blocks only have the default new alignment, so the address is aligned rather than the offset.
+            const auto base = reinterpret_cast<uintptr_t>(block.data.get());
+            const uint64_t start = ((base + mHead + alignment - 1) & ~(alignment - 1)) - base;
+            if (start + size <= block.size)
+            {
+                mHead = start + size;
+                return block.data.get() + start;
+            }
+
+            mCompletedBytes += mHead;
+            mHead = 0;
+            if (++mCurrentBlock == mBlocks.size())
+                addBlock(glm::max(mBlockSize, size + alignment));
+        }
+    }
+
+    void FrameArena::reset()
+    {
+        // Spilling means the frame didn't fit. Merge so the next one does without going to the heap.
+        if (mBlocks.size() > 1)
+        {
+            const uint64_t total = capacity();
+            mBlocks.clear();
+            addBlock(total);
+        }
+
+        mCurrentBlock = 0;
+        mHead = 0;
+        mCompletedBytes = 0;
+    }
+
+    uint64_t FrameArena::capacity() const
+    {
+        uint64_t total = 0;
+        for (const Block &block : mBlocks)
+            total += block.size;
+        return total;
+    }
+
+    void FrameArena::addBlock(const uint64_t size)
+    {
+        mBlocks.push_back({ std::make_unique<std::byte[]>(size), size });
+        ++mHeapAllocationCount;
+    }
+}
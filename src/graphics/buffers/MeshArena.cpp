@@ -0,0 +1,199 @@
+/**
+ * @file MeshArena.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "MeshArena.h"
+
+#include "Logger.h"
+#include "LoggerMacros.h"
+#include "Mesh.h"
+#include "ProfileTimer.h"
+
+namespace graphics
+{
+    namespace
+    {
+        constexpr uint64_t initialVertexCapacity = 64 * 1024;
+        constexpr uint64_t initialIndexCapacity = 256 * 1024;
+
+        // Packing copies the whole buffer, so it's only worth it once a good chunk of the free space is unusable.
+        constexpr float defragmentThreshold = 0.5f;
+
+        std::vector<MeshArena*> &arenas()
+        {
+            static std::vector<MeshArena*> arenas;
+            return arenas;
+        }
+
+        struct MeshIds
+        {
+            uint32_t count { 0 };
+            std::vector<uint32_t> freeIds;
+        };
+
+        MeshIds &meshIds()
+        {
+            static MeshIds ids;
+            return ids;
+        }
+
+        uint32_t allocateMeshId()
+        {
+            MeshIds &ids = meshIds();
+            if (ids.freeIds.empty())
+                return ids.count++;
+
+            const uint32_t id = ids.freeIds.back();
+            ids.freeIds.pop_back();
+            return id;
+        }
+
+        void nameBuffer(const unsigned int id, const std::string &name)
+        {
+            glObjectLabel(GL_BUFFER, id, static_cast<GLsizei>(name.size()), name.c_str());
+        }
+    }
+
+    MeshArena::MeshArena(const uint32_t vertexStride, const Instructions &layout, std::string debugName)
+        : mDebugName(std::move(debugName))
+    {
+        mVertices.elementSize = vertexStride;
+        mIndices.elementSize = sizeof(uint32_t);
+
+        glCreateVertexArrays(1, &mVao);
+        setVaoLayout(mVao, layout);
+
+        resize(mVertices, initialVertexCapacity);
+        resize(mIndices, initialIndexCapacity);
+        arenas().push_back(this);
+    }
+
+    MeshArena::~MeshArena()
+    {
+        auto &all = arenas();
+        all.erase(std::remove(all.begin(), all.end(), this), all.end());
+
+        glDeleteBuffers(1, &mVertices.id);
+        glDeleteBuffers(1, &mIndices.id);
+        glDeleteVertexArrays(1, &mVao);
+    }
+
+    MeshAllocation MeshArena::allocate(
+        const void *vertices, const uint32_t vertexCount, const uint32_t *indices, const uint32_t indexCount)
+    {
+        return { allocate(mVertices, vertices, vertexCount), allocate(mIndices, indices, indexCount), allocateMeshId() };
+    }
+
+    void MeshArena::free(const MeshAllocation &allocation)
+    {
+        mVertices.allocator.free(allocation.vertices);
+        mIndices.allocator.free(allocation.indices);
+        if (allocation.meshId != RangeAllocator::invalidHandle)
+            meshIds().freeIds.push_back(allocation.meshId);
+    }
+
+    int32_t MeshArena::baseVertex(const MeshAllocation &allocation) const
+    {
+        return static_cast<int32_t>(mVertices.allocator.offset(allocation.vertices));
+    }
+
+    uint32_t MeshArena::firstIndex(const MeshAllocation &allocation) const
+    {
+        return static_cast<uint32_t>(mIndices.allocator.offset(allocation.indices));
+    }
+
+    void MeshArena::defragmentIfNeeded()
+    {
+        if (mVertices.allocator.fragmentation() > defragmentThreshold)
+            defragment(mVertices);
+        if (mIndices.allocator.fragmentation() > defragmentThreshold)
+            defragment(mIndices);
+    }
+
+    void MeshArena::defragmentAll()
+    {
+        for (MeshArena *arena : arenas())
+            arena->defragmentIfNeeded();
+    }
+
+    uint32_t MeshArena::allocate(Buffer &buffer, const void *data, const uint32_t count)
+    {
+        uint32_t handle = buffer.allocator.allocate(count);
+        if (handle == RangeAllocator::invalidHandle)
+        {
+            const uint64_t capacity = glm::max(buffer.allocator.capacity() * 2, buffer.allocator.capacity() + count);
+            resize(buffer, capacity);
+            handle = buffer.allocator.allocate(count);
+        }
+
+        if (count > 0)
+        {
+            glNamedBufferSubData(
+                buffer.id, static_cast<GLintptr>(buffer.allocator.offset(handle) * buffer.elementSize),
+                static_cast<GLsizeiptr>(count) * buffer.elementSize, data);
+        }
+
+        return handle;
+    }
+
+    void MeshArena::resize(Buffer &buffer, const uint64_t capacity)
+    {
+        unsigned int id;
+        glCreateBuffers(1, &id);
+        glNamedBufferStorage(id, static_cast<GLsizeiptr>(capacity * buffer.elementSize), nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+        // Offsets don't change when growing, so the used part is copied over as is.
+        if (buffer.id != 0)
+        {
+            glCopyNamedBufferSubData(buffer.id, id, 0, 0, static_cast<GLsizeiptr>(buffer.allocator.capacity() * buffer.elementSize));
+            glDeleteBuffers(1, &buffer.id);
+            MESSAGE_VERBOSE("Growing % to % elements.", mDebugName, capacity);
+        }
+
+        buffer.id = id;
+        buffer.allocator.grow(capacity);
+        nameBuffer(buffer.id, mDebugName);
+        attachBuffers();
+    }
+
+    void MeshArena::defragment(Buffer &buffer)
+    {
+        PROFILE_FUNC();
+        const std::vector<RangeAllocator::Move> moves = buffer.allocator.defragment();
+
+        // Copies within one buffer can't overlap, so the packed data is written to a new one.
+        unsigned int id;
+        glCreateBuffers(1, &id);
+        glNamedBufferStorage(id, static_cast<GLsizeiptr>(buffer.allocator.capacity() * buffer.elementSize), nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+        // Anything that didn't move is already packed at the start.
+        const uint64_t unmoved = moves.empty() ? buffer.allocator.usedSize() : moves.front().to;
+        if (unmoved > 0)
+            glCopyNamedBufferSubData(buffer.id, id, 0, 0, static_cast<GLsizeiptr>(unmoved * buffer.elementSize));
+
+        for (const auto &[from, to, size] : moves)
+        {
+            glCopyNamedBufferSubData(
+                buffer.id, id,
+                static_cast<GLintptr>(from * buffer.elementSize), static_cast<GLintptr>(to * buffer.elementSize),
+                static_cast<GLsizeiptr>(size * buffer.elementSize));
+        }
+
+        glDeleteBuffers(1, &buffer.id);
+        buffer.id = id;
+        nameBuffer(buffer.id, mDebugName);
+        attachBuffers();
+
+        MESSAGE_VERBOSE("Defragmented %: % allocations moved.", mDebugName, moves.size());
+    }
+
+    void MeshArena::attachBuffers() const
+    {
+        glVertexArrayVertexBuffer(mVao, 0, mVertices.id, 0, static_cast<GLsizei>(mVertices.elementSize));
+        if (mIndices.id != 0)
+            glVertexArrayElementBuffer(mVao, mIndices.id);
+    }
+}
@@ -0,0 +1,160 @@
+/**
+ * @file RangeAllocator.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "RangeAllocator.h"
+
+#include <algorithm>
+
+namespace graphics
+{
+    RangeAllocator::RangeAllocator(const uint64_t capacity)
+    {
+        grow(capacity);
+    }
+
+    uint32_t RangeAllocator::allocate(uint64_t size)
+    {
+        size = std::max(size, static_cast<uint64_t>(1));
+
+        auto range = mFreeRanges.begin();
+        while (range != mFreeRanges.end() && range->second < size)
+            ++range;
+
+        if (range == mFreeRanges.end())
+            return invalidHandle;
+
+        const uint64_t offset = range->first;
+        const uint64_t remaining = range->second - size;
+        mFreeRanges.erase(range);
+        if (remaining > 0)
+            mFreeRanges.emplace(offset + size, remaining);
+
+        uint32_t handle;
+        if (!mFreeHandles.empty())
+        {
+            handle = mFreeHandles.back();
+            mFreeHandles.pop_back();
+        }
+        else
+        {
+            handle = static_cast<uint32_t>(mAllocations.size());
+            mAllocations.emplace_back();
+        }
+
+        mAllocations[handle] = { offset, size, true };
+        mUsedSize += size;
+        return handle;
+    }
+
+    void RangeAllocator::free(const uint32_t handle)
+    {
+        if (handle >= mAllocations.size() || !mAllocations[handle].isLive)
+            return;
+
+        Allocation &allocation = mAllocations[handle];
+        allocation.isLive = false;
+        mUsedSize -= allocation.size;
+        mFreeHandles.push_back(handle);
+
+        uint64_t offset = allocation.offset;
+        uint64_t size = allocation.size;
+
+        // Merge with the free ranges either side so that they can be reused for bigger allocations.
+        const auto next = mFreeRanges.find(offset + size);
+        if (next != mFreeRanges.end())
+        {
+            size += next->second;
+            mFreeRanges.erase(next);
+        }
+
+        const auto after = mFreeRanges.lower_bound(offset);
+        if (after != mFreeRanges.begin())
+        {
+            const auto previous = std::prev(after);
+            if (previous->first + previous->second == offset)
+            {
+                offset = previous->first;
+                size += previous->second;
+                mFreeRanges.erase(previous);
+            }
+        }
+
+        mFreeRanges.emplace(offset, size);
+    }
+
+    void RangeAllocator::grow(const uint64_t capacity)
+    {
+        if (capacity <= mCapacity)
+            return;
+
+        uint64_t offset = mCapacity;
+        uint64_t size = capacity - mCapacity;
+        if (!mFreeRanges.empty())
+        {
+            const auto last = std::prev(mFreeRanges.end());
+            if (last->first + last->second == mCapacity)
+            {
+                offset = last->first;
+                size += last->second;
+                mFreeRanges.erase(last);
+            }
+        }
+
+        mFreeRanges.emplace(offset, size);
+        mCapacity = capacity;
+    }
+
+    std::vector<RangeAllocator::Move> RangeAllocator::defragment()
+    {
+        std::vector<uint32_t> live;
+        live.reserve(mAllocations.size() - mFreeHandles.size());
+        for (uint32_t handle = 0; handle < mAllocations.size(); ++handle)
+        {
+            if (mAllocations[handle].isLive)
+                live.push_back(handle);
+        }
+
+        std::sort(live.begin(), live.end(), [this](const uint32_t lhs, const uint32_t rhs) {
+            return mAllocations[lhs].offset < mAllocations[rhs].offset;
+        });
+
+        std::vector<Move> moves;
+        uint64_t end = 0;
+        for (const uint32_t handle : live)
+        {
+            Allocation &allocation = mAllocations[handle];
+            if (allocation.offset != end)
+            {
+                moves.push_back({ allocation.offset, end, allocation.size });
+                allocation.offset = end;
+            }
+            end += allocation.size;
+        }
+
+        mFreeRanges.clear();
+        if (end < mCapacity)
+            mFreeRanges.emplace(end, mCapacity - end);
+
+        return moves;
+    }
+
+    uint64_t RangeAllocator::largestFreeRange() const
+    {
+        uint64_t largest = 0;
+        for (const auto &[offset, size] : mFreeRanges)
+            largest = std::max(largest, size);
+        return largest;
+    }
+
+    float RangeAllocator::fragmentation() const
+    {
+        const uint64_t freeSize = mCapacity - mUsedSize;
+        if (freeSize == 0)
+            return 0.f;
+        return 1.f - static_cast<float>(largestFreeRange()) / static_cast<float>(freeSize);
+    }
+}
@@ -0,0 +1,37 @@
+/**
+ * @file RingAllocator.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "RingAllocator.h"
+
+namespace graphics
+{
+    RingAllocator::RingAllocator(const uint64_t capacity)
+        : mCapacity(capacity)
+    {
+    }
+
+    void RingAllocator::reset(const uint64_t capacity)
+    {
+        mCapacity = capacity;
+        mHead = 0;
+        mTail = 0;
+        mFrames.clear();
+    }
+
+    uint64_t RingAllocator::endFrame()
+    {
+        const uint64_t id = mNextFrameId++;
+        mFrames.push_back({ id, mHead });
+        return id;
+    }
+
+    void RingAllocator::retireOldestFrame()
+    {
+        mTail = mFrames.front().end;
+        mFrames.pop_front();
+    }
+}
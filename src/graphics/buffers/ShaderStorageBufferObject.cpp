@@ -60,8 +60,8 @@ namespace graphics
 
     void ShaderStorageBufferObject::zeroOut() const
     {
-        const std::vector<uint32_t> zeros(mSize);
-        glNamedBufferSubData(mBufferId, 0, mSize, static_cast<const void*>(zeros.data()));
+        // A null pointer clears to zero without building a buffer of zeros on the CPU.
+        glClearNamedBufferData(mBufferId, GL_R8UI, GL_RED_INTEGER, GL_UNSIGNED_BYTE, nullptr);
     }
 
     void ShaderStorageBufferObject::nameBuffer() const
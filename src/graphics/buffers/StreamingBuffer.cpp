@@ -0,0 +1,155 @@
+/**
+ * @file StreamingBuffer.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "StreamingBuffer.h"
+
+#include "Logger.h"
+#include "LoggerMacros.h"
+
+namespace graphics
+{
+    namespace
+    {
+        uint64_t storageAlignment()
+        {
+            static const uint64_t alignment = [] {
+                int value { 0 };
+                glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &value);
+                return static_cast<uint64_t>(glm::max(value, 4));
+            }();
+            return alignment;
+        }
+
+        void waitForFence(const GLsync fence)
+        {
+            constexpr uint64_t timeoutNanoSeconds = 1000000000;
+            while (true)
+            {
+                const GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeoutNanoSeconds);
+                if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED)
+                    return;
+                if (result == GL_WAIT_FAILED)
+                {
+                    WARN("Failed to wait on a streaming buffer fence.");
+                    return;
+                }
+            }
+        }
+    }
+
+    StreamingBuffer::StreamingBuffer(const uint64_t capacity, const std::string &debugName)
+        : mDebugName(debugName)
+    {
+        create(capacity);
+    }
+
+    StreamingBuffer::~StreamingBuffer()
+    {
+        destroy();
+    }
+
+    StreamingRange StreamingBuffer::allocate(const uint64_t size)
+    {
+        // Zero sized ranges can't be bound, so every allocation is at least one word.
+        const uint64_t allocationSize = glm::max(size, static_cast<uint64_t>(sizeof(uint32_t)));
+        auto waitForFrame = [this](uint64_t) {
+            waitForFence(mFences.front());
+            glDeleteSync(mFences.front());
+            mFences.pop_front();
+        };
+
+        uint64_t offset = mAllocator.allocate(allocationSize, storageAlignment(), waitForFrame);
+        if (offset == RingAllocator::invalidOffset)
+        {
+            grow(allocationSize);
+            offset = mAllocator.allocate(allocationSize, storageAlignment(), waitForFrame);
+        }
+
+        return { mBufferId, offset, allocationSize };
+    }
+
+    void StreamingBuffer::grow(const uint64_t size)
+    {
+        const uint64_t capacity = glm::max(mAllocator.capacity() * 2, size * 2);
+        MESSAGE_VERBOSE("Growing streaming buffer % to % bytes.", mDebugName, capacity);
+
+        // Ranges of this frame may already be bound, so the old buffer is only deleted once the frame ends.
+        // Nothing is written to it again, so its fences aren't needed.
+        for (const GLsync fence : mFences)
+            glDeleteSync(fence);
+        mFences.clear();
+
+        glUnmapNamedBuffer(mBufferId);
+        mRetiredBufferIds.push_back(mBufferId);
+        create(capacity);
+    }
+
+    void StreamingBuffer::deleteRetiredBuffers()
+    {
+        // Deleting a buffer unbinds it from every slot. Commands that were already issued keep it alive on the GPU.
+        if (!mRetiredBufferIds.empty())
+            glDeleteBuffers(static_cast<GLsizei>(mRetiredBufferIds.size()), mRetiredBufferIds.data());
+        mRetiredBufferIds.clear();
+    }
+
+    void StreamingBuffer::endFrame()
+    {
+        // The draws using this frame's ranges have been issued, so the bindings aren't needed any more.
+        deleteRetiredBuffers();
+
+        // Free up what we can now so that allocations rarely have to wait.
+        mAllocator.retireCompletedFrames([this](uint64_t) {
+            const GLenum result = glClientWaitSync(mFences.front(), 0, 0);
+            if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+                return false;
+
+            glDeleteSync(mFences.front());
+            mFences.pop_front();
+            return true;
+        });
+
+        mAllocator.endFrame();
+        mFences.push_back(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+    }
+
+    void StreamingBuffer::bindToSlot(const StreamingRange &range, const unsigned int bindPoint)
+    {
+        glBindBufferRange(
+            GL_SHADER_STORAGE_BUFFER, bindPoint, range.bufferId,
+            static_cast<GLintptr>(range.offset), static_cast<GLsizeiptr>(range.size));
+    }
+
+    void StreamingBuffer::create(const uint64_t capacity)
+    {
+        constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+        glCreateBuffers(1, &mBufferId);
+        glNamedBufferStorage(mBufferId, static_cast<GLsizeiptr>(capacity), nullptr, flags);
+        mMappedData = static_cast<std::byte*>(glMapNamedBufferRange(mBufferId, 0, static_cast<GLsizeiptr>(capacity), flags));
+        mAllocator.reset(capacity);
+
+        if (!mDebugName.empty())
+            glObjectLabel(GL_BUFFER, mBufferId, static_cast<GLsizei>(mDebugName.size()), mDebugName.c_str());
+    }
+
+    void StreamingBuffer::destroy()
+    {
+        deleteRetiredBuffers();
+
+        for (const GLsync fence : mFences)
+            glDeleteSync(fence);
+        mFences.clear();
+
+        if (mBufferId != 0)
+        {
+            glUnmapNamedBuffer(mBufferId);
+            glDeleteBuffers(1, &mBufferId);
+        }
+        mBufferId = 0;
+        mMappedData = nullptr;
+    }
+}
@@ -25,6 +25,25 @@ Texture::~Texture()
 }
 
 void Texture::setData(const glm::ivec2 &size, const unsigned char* bytes)
+{
+    createStorage(size);
+
+    const int lod = 0;
+    const int xOffSet = 0;
+    const int yOffSet = 0;
+
+    glTextureSubImage2D(mId, lod, xOffSet, yOffSet, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, bytes);
+    glGenerateTextureMipmap(mId);
+}
+
+void Texture::setData(const glm::ivec2 &size, graphics::TextureUploader &uploader, const graphics::PixelUpload &upload)
+{
+    createStorage(size);
+    uploader.copyToTexture(upload, mId, size);
+    glGenerateTextureMipmap(mId);
+}
+
+void Texture::createStorage(const glm::ivec2 &size)
 {
     if (mId != 0)
         glDeleteTextures(1, &mId);
@@ -39,11 +58,5 @@ void Texture::setData(const glm::ivec2 &size, const unsigned char* bytes)
     mSize = size;
 
     const unsigned int levels = 1;
-    const int lod = 0;
-    const int xOffSet = 0;
-    const int yOffSet = 0;
-
     glTextureStorage2D(mId, levels, GL_RGBA8, size.x, size.y);
-    glTextureSubImage2D(mId, lod, xOffSet, yOffSet, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, bytes);
-    glGenerateTextureMipmap(mId);
 }
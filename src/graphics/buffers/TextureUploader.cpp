@@ -0,0 +1,123 @@
+/**
+ * @file TextureUploader.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "TextureUploader.h"
+
+#include "ProfileTimer.h"
+
+namespace graphics
+{
+    namespace
+    {
+        // Keeps every row of every upload on a nice boundary for the driver's DMA copy.
+        constexpr uint64_t uploadAlignment = 256;
+    }
+
+    TextureUploader::TextureUploader(const uint64_t capacity)
+        : mCapacity(capacity)
+    {
+        constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+        glCreateBuffers(1, &mBufferId);
+        glNamedBufferStorage(mBufferId, static_cast<GLsizeiptr>(mCapacity), nullptr, flags);
+        mMappedData = static_cast<std::byte*>(glMapNamedBufferRange(mBufferId, 0, static_cast<GLsizeiptr>(mCapacity), flags));
+
+        const std::string debugName = "Texture Uploads";
+        glObjectLabel(GL_BUFFER, mBufferId, static_cast<GLsizei>(debugName.size()), debugName.c_str());
+    }
+
+    TextureUploader::~TextureUploader()
+    {
+        for (const Copy &copy : mCopies)
+            glDeleteSync(copy.fence);
+
+        glUnmapNamedBuffer(mBufferId);
+        glDeleteBuffers(1, &mBufferId);
+    }
+
+    PixelUpload TextureUploader::reserve(const uint64_t size)
+    {
+        if (size == 0 || size > mCapacity)
+            return { };
+
+        const std::lock_guard lock(mMutex);
+        return tryAllocate(size);
+    }
+
+    void TextureUploader::copyToTexture(const PixelUpload &upload, const unsigned int textureId, const glm::ivec2 &size)
+    {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, mBufferId);
+        glTextureSubImage2D(
+            textureId, 0, 0, 0, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE,
+            reinterpret_cast<const void*>(static_cast<uintptr_t>(upload.offset)));
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        mCopies.push_back({ glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), upload.id, std::chrono::steady_clock::now() });
+        mFrameBytes += upload.size;
+    }
+
+    void TextureUploader::update()
+    {
+        while (!mCopies.empty())
+        {
+            // Fences signal in order, so there's no point looking past the first one that hasn't.
+            const Copy &copy = mCopies.front();
+            const GLenum result = glClientWaitSync(copy.fence, 0, 0);
+            if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+                break;
+
+            const auto latency = std::chrono::steady_clock::now() - copy.issueTime;
+            mLatencyMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+            glDeleteSync(copy.fence);
+            {
+                const std::lock_guard lock(mMutex);
+                release(copy.id);
+            }
+            mCopies.pop_front();
+        }
+
+        PROFILE_COUNTER("Texture Upload Bytes", mFrameBytes);
+        PROFILE_COUNTER("Texture Upload Latency (us)", mLatencyMicroseconds);
+        PROFILE_COUNTER("Texture Uploads In Flight", mCopies.size());
+        mFrameBytes = 0;
+    }
+
+    PixelUpload TextureUploader::tryAllocate(const uint64_t size)
+    {
+        const uint64_t physicalHead = mHead % mCapacity;
+        uint64_t padding = ((physicalHead + uploadAlignment - 1) & ~(uploadAlignment - 1)) - physicalHead;
+
+        // Uploads never straddle the end of the buffer. Skip to the start instead, which is always aligned.
+        if (physicalHead + padding + size > mCapacity)
+            padding = mCapacity - physicalHead;
+
+        if (mHead + padding + size - mTail > mCapacity)
+            return { };
+
+        const uint64_t id = mHead + padding;
+        const uint64_t offset = id % mCapacity;
+        mHead = id + size;
+        mRegions.push_back({ id, mHead, false });
+        return { id, offset, size, mMappedData + offset };
+    }
+
+    void TextureUploader::release(const uint64_t id)
+    {
+        for (Region &region : mRegions)
+        {
+            if (region.id == id)
+                region.isDone = true;
+        }
+
+        // Uploads can finish in any order, but the space is only reusable once everything before it is too.
+        while (!mRegions.empty() && mRegions.front().isDone)
+        {
+            mTail = mRegions.front().end;
+            mRegions.pop_front();
+        }
+    }
+}
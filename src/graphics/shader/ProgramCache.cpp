@@ -0,0 +1,173 @@
+/**
+ * @file ProgramCache.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "ProgramCache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "Logger.h"
+#include "LoggerMacros.h"
+
+namespace graphics
+{
+    namespace
+    {
+        constexpr char programCacheMagic[8] { 'P', 'C', 'Y', 'P', 'R', 'O', 'G', '\0' };
+        constexpr uint32_t programCacheVersion = 1;
+
+        struct ProgramCacheHeader
+        {
+            char magic[8];
+            uint32_t version;
+            uint32_t binaryFormat;
+            uint64_t key;
+            uint64_t length;
+        };
+
+        ProgramCacheStatistics statistics;
+
+        uint64_t hashString(const std::string_view string, uint64_t hash)
+        {
+            constexpr uint64_t prime = 1099511628211ull;
+            for (const char character : string)
+                hash = (hash ^ static_cast<unsigned char>(character)) * prime;
+            return hash;
+        }
+
+        bool isProgramCacheSupported()
+        {
+            static const bool isSupported = [] {
+                int formatCount { 0 };
+                glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+                return formatCount > 0;
+            }();
+            return isSupported;
+        }
+
+        const std::string &driverString()
+        {
+            static const std::string driver = [] {
+                const auto get = [](const GLenum name) {
+                    const auto *string = reinterpret_cast<const char*>(glGetString(name));
+                    return std::string(string != nullptr ? string : "");
+                };
+                return get(GL_VENDOR) + "|" + get(GL_RENDERER) + "|" + get(GL_VERSION);
+            }();
+            return driver;
+        }
+
+        std::filesystem::path programCachePath(const uint64_t key)
+        {
+            char name[17];
+            std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+            return std::filesystem::path("shaderCache") / (std::string(name) + ".pcyprog");
+        }
+    }
+
+    uint64_t programCacheKey(const std::vector<PreprocessedShader> &shaders)
+    {
+        uint64_t hash = hashString(driverString(), 14695981039346656037ull);
+        for (const PreprocessedShader &shader : shaders)
+        {
+            hash = (hash ^ shader.type) * 1099511628211ull;
+            hash = hashString(shader.prepend, hash);
+            for (const std::string &source : shader.sources)
+                hash = hashString(source, hash);
+        }
+        return hash;
+    }
+
+    bool loadProgramBinary(const unsigned int programId, const uint64_t key)
+    {
+        if (!isProgramCacheSupported())
+            return false;
+
+        std::ifstream file(programCachePath(key), std::ios::binary);
+        if (!file.is_open())
+            return false;
+
+        ProgramCacheHeader header { };
+        file.read(reinterpret_cast<char*>(&header), sizeof(ProgramCacheHeader));
+        if (!file.good()
+            || std::memcmp(header.magic, programCacheMagic, sizeof(programCacheMagic)) != 0
+            || header.version != programCacheVersion
+            || header.key != key)
+            return false;
+
+        std::vector<char> binary(header.length);
+        file.read(binary.data(), static_cast<std::streamsize>(binary.size()));
+        if (!file.good())
+            return false;
+
+        // Drivers are allowed to reject binaries at any point (e.g., after an update), so this isn't an error.
+        glProgramBinary(programId, header.binaryFormat, binary.data(), static_cast<int>(binary.size()));
+        int result { 0 };
+        glGetProgramiv(programId, GL_LINK_STATUS, &result);
+        if (result == GL_TRUE)
+            return true;
+
+        MESSAGE_VERBOSE("Program binary % was rejected by the driver. Recompiling from source.", programCachePath(key));
+        return false;
+    }
+
+    void saveProgramBinary(const unsigned int programId, const uint64_t key)
+    {
+        if (!isProgramCacheSupported())
+            return;
+
+        int length { 0 };
+        glGetProgramiv(programId, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0)
+            return;
+
+        ProgramCacheHeader header { };
+        std::memcpy(header.magic, programCacheMagic, sizeof(programCacheMagic));
+        header.version = programCacheVersion;
+        header.key = key;
+
+        std::vector<char> binary(length);
+        GLenum binaryFormat { 0 };
+        glGetProgramBinary(programId, length, &length, &binaryFormat, binary.data());
+        header.binaryFormat = binaryFormat;
+        header.length = static_cast<uint64_t>(length);
+
+        const std::filesystem::path path = programCachePath(key);
+        std::error_code error;
+        std::filesystem::create_directories(path.parent_path(), error);
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            WARN("Could not open % to write a program binary.", path);
+            return;
+        }
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(ProgramCacheHeader));
+        file.write(binary.data(), length);
+    }
+
+    void recordProgramBuild(const bool isWarm, const double milliseconds)
+    {
+        if (isWarm)
+        {
+            ++statistics.warmCount;
+            statistics.warmMilliseconds += milliseconds;
+        }
+        else
+        {
+            ++statistics.coldCount;
+            statistics.coldMilliseconds += milliseconds;
+        }
+    }
+
+    const ProgramCacheStatistics &programCacheStatistics()
+    {
+        return statistics;
+    }
+}
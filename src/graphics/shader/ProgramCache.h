@@ -0,0 +1,47 @@
+/**
+ * @file ProgramCache.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include "Pch.h"
+#include "ShaderCompilation.h"
+
+namespace graphics
+{
+    /**
+     * @brief How long it took to build every shader program so far. Warm programs were loaded from the
+     * binary cache, cold programs were compiled from source.
+     */
+    struct ProgramCacheStatistics
+    {
+        uint32_t warmCount { 0 };
+        uint32_t coldCount { 0 };
+        double warmMilliseconds { 0.0 };
+        double coldMilliseconds { 0.0 };
+    };
+
+    /**
+     * @brief Hashes the final sources (which include the definitions) along with the driver's vendor, renderer
+     * and version strings. Any change to either produces a different key so old binaries are never loaded.
+     */
+    uint64_t programCacheKey(const std::vector<PreprocessedShader> &shaders);
+
+    /**
+     * @brief Tries to link the program from a binary on disk.
+     * @returns false if there isn't one or the driver rejected it. The program can still be linked from source.
+     */
+    bool loadProgramBinary(unsigned int programId, uint64_t key);
+
+    /**
+     * @brief Writes the binary of a linked program. The program must be linked with
+     * GL_PROGRAM_BINARY_RETRIEVABLE_HINT set.
+     */
+    void saveProgramBinary(unsigned int programId, uint64_t key);
+
+    void recordProgramBuild(bool isWarm, double milliseconds);
+    const ProgramCacheStatistics &programCacheStatistics();
+}
@@ -32,12 +32,39 @@ namespace graphics
 
     unsigned int compileShader(const std::filesystem::path &path, const std::vector<Definition>& macros)
     {
-        const unsigned int shaderType = getGlslType(path);
+        return compileShaderSource(preprocessShader(path, macros));
+    }
+
+    PreprocessedShader preprocessShader(const std::filesystem::path &path, const std::vector<Definition>& macros)
+    {
         ShaderPreprocessor preprocessor(path);
         preprocessor.setupDefinitions(macros);
         preprocessor.start();
         preprocessor.orderByInclude();
-        return compileShaderSource(shaderType, preprocessor.getSources(), macros);
+        const std::list<ShaderInformation> &data = preprocessor.getSources();
+
+        PreprocessedShader shader;
+        shader.type = getGlslType(path);
+
+        std::stringstream prependShader;
+        prependShader << "#version 460 core\n";
+        for (const std::string &extension : preprocessor.getExtensions())
+            prependShader << extension << "\n";
+        for (const auto & [symbol, constant] : macros)
+            prependShader << "#define " << symbol << " " << constant << "\n";
+        shader.prepend = prependShader.str();
+
+        int shaderIndex = 0;
+        shader.sources.reserve(data.size());
+        for (const auto &information : data)
+        {
+            shader.sources.emplace_back(format::string("#line 1 %\n%", shaderIndex, information.sourceBuffer));
+            ++shaderIndex;
+        }
+
+        shader.fileName = path.filename().string();
+        shader.includedFileNames = format::value(data.begin(), data.end(), [](const ShaderInformation &shaderData) { return shaderData.path.filename().string(); });
+        return shader;
     }
 
     ShaderPreprocessor::ShaderPreprocessor(const std::filesystem::path& path)
@@ -98,6 +125,16 @@ namespace graphics
         mCurrentPath = shaderData.path;
     }
 
+    void ShaderPreprocessor::preprocessExtension(ShaderInformation &shaderData)
+    {
+        shaderData.emitLineCount();
+        if (!shaderData.evaluationStack.top())
+            return;
+
+        if (std::find(mExtensions.begin(), mExtensions.end(), shaderData.mCurrentLine) == mExtensions.end())
+            mExtensions.push_back(shaderData.mCurrentLine);
+    }
+
     void ShaderPreprocessor::walk(const uint32_t depth)
     {
         auto it = std::find_if(mInformation.begin(), mInformation.end(),
@@ -127,6 +164,7 @@ namespace graphics
             { "#endif",   [&] { shaderData.preprocessEndif(); } },
             { "#version", [&] { shaderData.emitLineCount(); } },
             { "#pragma",  [&] { shaderData.emitLineCount(); } },
+            { "#extension", [&] { preprocessExtension(shaderData); } },
             { "#define",  [&] { shaderData.preprocessDefine(tokens, mDefinitions); } },
             { "#line",    [&] { shaderData.emitCurrentLine(); } },
         };
@@ -153,38 +191,37 @@ namespace graphics
         CRASH("Failed to compile shader %\nError while preprocessing file %.\n%", mInvokingPath, mCurrentPath, message);
     }
 
-    unsigned int compileShaderSource(const unsigned int shaderType, const std::list<ShaderInformation> &data, const std::vector<Definition> &macros)
+    unsigned int compileShaderSource(const PreprocessedShader &shader)
     {
-        std::stringstream prependShader;
-        prependShader << "#version 460 core\n";
-        for (const auto & [symbol, constant] : macros)
-            prependShader << "#define " << symbol << " " << constant << "\n";
-        const std::string prependShaderString = prependShader.str();
+        const unsigned int shaderId = submitShaderSource(shader);
+        checkShaderCompile(shaderId, shader);
+        return shaderId;
+    }
 
-        const unsigned shaderId = glCreateShader(shaderType);
-        std::vector<std::string> sourceStrings;
+    unsigned int submitShaderSource(const PreprocessedShader &shader)
+    {
+        const unsigned shaderId = glCreateShader(shader.type);
         std::vector<const char *> dataPtrs;
-        dataPtrs.reserve(data.size() + 1);
-        dataPtrs.push_back(prependShaderString.c_str());
-        int shaderIndex = 0;
-        for (const auto &shader : data)
-        {
-            const std::string shaderSource = format::string("#line 1 %\n%", shaderIndex, shader.sourceBuffer);
-            dataPtrs.push_back(sourceStrings.emplace_back(shaderSource).c_str());
-            ++shaderIndex;
-        }
+        dataPtrs.reserve(shader.sources.size() + 1);
+        dataPtrs.push_back(shader.prepend.c_str());
+        for (const std::string &source : shader.sources)
+            dataPtrs.push_back(source.c_str());
 
 #if 1
-        outputItermediateGlsl(data.back().path.filename().string(), prependShaderString, sourceStrings);
+        outputItermediateGlsl(shader.fileName, shader.prepend, shader.sources);
 #endif
 
         glShaderSource(shaderId, static_cast<int>(dataPtrs.size()), dataPtrs.data(), nullptr);
         glCompileShader(shaderId);
+        return shaderId;
+    }
 
+    void checkShaderCompile(const unsigned int shaderId, const PreprocessedShader &shader)
+    {
         int result { 0 };
         glGetShaderiv(shaderId, GL_COMPILE_STATUS, &result);  // OpenGL fails silently, so we need to check it ourselves.
         if (GL_TRUE == result)
-            return shaderId;
+            return;
 
         const std::unordered_map<unsigned int, std::string> shaderTypes {
             { GL_VERTEX_SHADER, "Vertex" },
@@ -200,9 +237,7 @@ namespace graphics
         glGetShaderInfoLog(shaderId, length, &length, message);
         glDeleteShader(shaderId);
 
-        const std::string shaderNames = format::value(data.begin(), data.end(), [](const ShaderInformation &shaderData) { return shaderData.path.filename().string(); });
-        CRASH("Failed to compile % shader %: \n%", shaderTypes.at(shaderType), shaderNames, message);
-        return 0;
+        CRASH("Failed to compile % shader %: \n%", shaderTypes.at(shader.type), shader.includedFileNames, message);
     }
 
     // So that shader with the same name but different definitions are unique.
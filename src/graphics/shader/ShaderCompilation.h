@@ -16,9 +16,32 @@
 namespace graphics
 {
 
+    /**
+     * @brief The final source strings of one shader stage, as they're handed to OpenGL.
+     */
+    struct PreprocessedShader
+    {
+        unsigned int type { 0 };
+        std::string prepend;               // The version, extensions and definitions.
+        std::vector<std::string> sources;  // One per file, in include order.
+        std::string fileName;              // The file that was compiled.
+        std::string includedFileNames;     // Every file that went into it. Only for error messages.
+    };
+
     unsigned int getGlslType(const std::filesystem::path &path);
     unsigned int compileShader(const std::filesystem::path &path, const std::vector<graphics::Definition>& macros);
-    unsigned int compileShaderSource(unsigned int shaderType, const std::list<ShaderInformation> &data, const std::vector<Definition> &macros);
+    PreprocessedShader preprocessShader(const std::filesystem::path &path, const std::vector<graphics::Definition>& macros);
+    unsigned int compileShaderSource(const PreprocessedShader &shader);
+
+    /**
+     * @brief Hands the source to the driver without waiting for it to compile.
+     */
+    unsigned int submitShaderSource(const PreprocessedShader &shader);
+
+    /**
+     * @brief Waits for the shader to compile and crashes with the error log if it didn't.
+     */
+    void checkShaderCompile(unsigned int shaderId, const PreprocessedShader &shader);
     void outputItermediateGlsl(const std::string &fileName, const std::string &firstSource, const std::vector<std::string> &sources);
 
     class ShaderPreprocessor
@@ -30,9 +53,15 @@ namespace graphics
         void orderByInclude();
         const std::list<ShaderInformation>& getSources() const { return mInformation; }
 
+        /**
+         * @returns Every #extension directive that was found. They must come before any code, so they're moved
+         * to the top of the shader instead of being left in the file that asked for them.
+         */
+        const std::vector<std::string>& getExtensions() const { return mExtensions; }
 
     protected:
         void preprocessInclude(std::string token, ShaderInformation& shaderData, uint32_t depth);
+        void preprocessExtension(ShaderInformation& shaderData);
         void walk(uint32_t depth);
         void crash(const std::string &message) const;
 
@@ -40,5 +69,6 @@ namespace graphics
         std::filesystem::path mCurrentPath;
         std::list<ShaderInformation> mInformation;
         std::unordered_map<std::string, int> mDefinitions;
+        std::vector<std::string> mExtensions;
     };
 }
@@ -0,0 +1,140 @@
+/**
+ * @file ShaderCompiler.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "ShaderCompiler.h"
+
+#include <mutex>
+#include <unordered_set>
+
+#include "ProfileTimer.h"
+#include "Format.h"
+
+namespace graphics
+{
+    namespace
+    {
+        JobScheduler jobScheduler;  // Only touched by the main thread.
+    }
+
+    void setShaderJobScheduler(JobScheduler scheduler)
+    {
+        jobScheduler = std::move(scheduler);
+    }
+
+    std::function<void()> scheduleShaderJob(std::function<void()> job)
+    {
+        if (jobScheduler != nullptr)
+            return jobScheduler(std::move(job));
+
+        job();
+        return nullptr;
+    }
+
+    ShaderCompiler::ShaderCompiler()
+    {
+        static const bool hasSetThreadCount = [] {
+            if (isParallelCompileSupported())
+                glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);  // Let the driver decide how many threads to use.
+            return true;
+        }();
+        static_cast<void>(hasSetThreadCount);
+    }
+
+    void ShaderCompiler::submit(Shader &shader, const bool isLazy, BuiltCallback onBuilt)
+    {
+        if (shader.isBuilt())
+        {
+            if (onBuilt != nullptr)
+                onBuilt(shader);
+            return;
+        }
+
+        shader.startPreprocessing(true);
+        if (isLazy)
+            mLazySubmissions.push_back({ &shader, std::move(onBuilt) });
+        else
+            mSubmissions.push_back({ &shader, std::move(onBuilt) });
+    }
+
+    void ShaderCompiler::finish()
+    {
+        PROFILE_FUNC();
+
+        // Nothing here asks for a status so that the driver can work on all of them at once.
+        for (Submission &submission : mSubmissions)
+            submission.shader->submitBuild();
+        for (Submission &submission : mLazySubmissions)
+            submission.shader->submitBuild();
+
+        for (Submission &submission : mSubmissions)
+            complete(submission);
+        mSubmissions.clear();
+    }
+
+    bool ShaderCompiler::update()
+    {
+        if (mLazySubmissions.empty())
+            return true;
+
+        PROFILE_FUNC();
+        if (isParallelCompileSupported())
+        {
+            const auto it = std::remove_if(mLazySubmissions.begin(), mLazySubmissions.end(), [](Submission &submission) {
+                if (!submission.shader->isBuildComplete())
+                    return false;
+
+                complete(submission);
+                return true;
+            });
+            mLazySubmissions.erase(it, mLazySubmissions.end());
+        }
+        else
+        {
+            complete(mLazySubmissions.back());
+            mLazySubmissions.pop_back();
+        }
+
+        return mLazySubmissions.empty();
+    }
+
+    bool ShaderCompiler::isIdle() const
+    {
+        return mSubmissions.empty() && mLazySubmissions.empty();
+    }
+
+    bool ShaderCompiler::isParallelCompileSupported()
+    {
+        static const bool isSupported = GLEW_KHR_parallel_shader_compile;
+        return isSupported;
+    }
+
+    std::string_view ShaderCompiler::traceName(const std::string &debugName, const std::vector<Definition> &definitions)
+    {
+        // Profile results only hold a view of their name so these are never freed.
+        static std::mutex mutex;
+        static std::unordered_set<std::string> names;
+
+        std::string name = debugName;
+        if (!definitions.empty())
+        {
+            name += " (";
+            for (size_t i = 0; i < definitions.size(); ++i)
+                name += format::string("%%=%", i == 0 ? "" : ", ", definitions[i].symbol, definitions[i].constant);
+            name += ")";
+        }
+
+        const std::unique_lock lock(mutex);
+        return *names.insert(std::move(name)).first;
+    }
+
+    void ShaderCompiler::complete(Submission &submission)
+    {
+        submission.shader->finishBuild();
+        if (submission.onBuilt != nullptr)
+            submission.onBuilt(*submission.shader);
+    }
+}
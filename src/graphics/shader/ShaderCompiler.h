@@ -0,0 +1,97 @@
+/**
+ * @file ShaderCompiler.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include <exception>
+#include <functional>
+
+#include "Pch.h"
+#include "Shader.h"
+#include "ShaderCompilation.h"
+
+namespace graphics
+{
+    /**
+     * @brief Everything a deferred shader needs until its program has linked.
+     */
+    struct PendingBuild
+    {
+        std::vector<std::filesystem::path> paths;
+        std::vector<Definition> definitions;
+        std::string_view traceName;
+        std::function<void()> waitForPreprocessing;  // Empty once preprocessing is known to be done.
+        std::exception_ptr preprocessingError;
+        std::vector<PreprocessedShader> shaders;
+        std::vector<unsigned int> shaderIds;
+        uint64_t cacheKey { 0 };
+        bool isSubmitted { false };
+        bool isFromCache { false };
+        std::chrono::steady_clock::time_point startTime;
+    };
+
+    /**
+     * @brief Runs the job with the scheduler given to setShaderJobScheduler(), or straight away if there isn't one.
+     * @returns A function that blocks until the job is done. Empty if the job has already run.
+     */
+    std::function<void()> scheduleShaderJob(std::function<void()> job);
+
+    /**
+     * @brief Builds many deferred shaders together. Preprocessing runs on worker threads and every program is
+     * handed to the driver before any link status is queried so that the driver can compile them in parallel.
+     * Submitted shaders must not move until they have been built.
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class ShaderCompiler
+    {
+    public:
+        typedef std::function<void(Shader &)> BuiltCallback;
+
+        ShaderCompiler();
+
+        /**
+         * @brief Starts preprocessing the shader on a worker thread.
+         * @param isLazy - Lazy shaders are not waited on by finish(). They're completed by update() once the driver is done.
+         * @param onBuilt - Called on the main thread once the program has linked (e.g., to bind uniform blocks).
+         */
+        void submit(Shader &shader, bool isLazy=false, BuiltCallback onBuilt=nullptr);
+
+        /**
+         * @brief Submits every shader to the driver, then waits for the ones that aren't lazy.
+         */
+        void finish();
+
+        /**
+         * @brief Completes the lazy shaders that have finished compiling. Without GL_KHR_parallel_shader_compile
+         * there's no way to ask, so one shader is completed per call instead.
+         * @returns True once every lazy shader is built.
+         */
+        bool update();
+
+        [[nodiscard]] bool isIdle() const;
+
+        static bool isParallelCompileSupported();
+
+        /**
+         * @returns A name for the profiler that lives for the rest of the program.
+         */
+        static std::string_view traceName(const std::string &debugName, const std::vector<Definition> &definitions);
+
+    protected:
+        struct Submission
+        {
+            Shader *shader;
+            BuiltCallback onBuilt;
+        };
+
+        static void complete(Submission &submission);
+
+        std::vector<Submission> mSubmissions;
+        std::vector<Submission> mLazySubmissions;
+    };
+}
@@ -147,7 +147,7 @@ namespace file
     
     bool hasSceneExtension(const std::string &extension)
     {
-        return extension == ".pcy";
+        return extension == ".pcy" || extension == ".pcyb";
     }
     
     bool hasSceneExtension(const std::filesystem::path &path)
@@ -0,0 +1,97 @@
+/**
+ * @file LogRingBuffer.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "LogRingBuffer.h"
+
+#include <cstring>
+
+namespace debug
+{
+    void LogRecord::setMessage(const std::string_view message)
+    {
+        length = static_cast<uint32_t>(message.size());
+        if (message.size() <= inlineCapacity)
+        {
+            std::memcpy(text, message.data(), message.size());
+            overflow = nullptr;
+        }
+        else
+            overflow = new std::string(message);
+    }
+
+    std::string_view LogRecord::message() const
+    {
+        if (overflow != nullptr)
+            return *overflow;
+        return { text, length };
+    }
+
+    void LogRecord::release()
+    {
+        delete overflow;
+        overflow = nullptr;
+    }
+
+    LogRingBuffer::LogRingBuffer()
+        : mSlots(std::make_unique<Slot[]>(capacity))
+    {
+        for (uint32_t i = 0; i < capacity; ++i)
+            mSlots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    bool LogRingBuffer::tryPush(const LogRecord &record)
+    {
+        uint64_t head = mHead.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Slot &slot = mSlots[head & (capacity - 1)];
+            const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<int64_t>(sequence - head);
+
+            // The slot is free for this lap. Try to claim it before another producer does.
+            if (difference == 0)
+            {
+                if (mHead.compare_exchange_weak(head, head + 1, std::memory_order_relaxed))
+                {
+                    slot.record = record;
+                    slot.sequence.store(head + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            // The consumer hasn't got to this slot from the last lap yet.
+            else if (difference < 0)
+                return false;
+            else
+                head = mHead.load(std::memory_order_relaxed);
+        }
+    }
+
+    bool LogRingBuffer::tryPop(LogRecord &record)
+    {
+        const uint64_t tail = mTail.load(std::memory_order_relaxed);
+        Slot &slot = mSlots[tail & (capacity - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != tail + 1)
+            return false;
+
+        record = slot.record;
+        slot.sequence.store(tail + capacity, std::memory_order_release);
+        mTail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool LogRingBuffer::isEmpty() const
+    {
+        return mTail.load(std::memory_order_acquire) == mHead.load(std::memory_order_acquire);
+    }
+
+    uint64_t LogRingBuffer::size() const
+    {
+        const uint64_t tail = mTail.load(std::memory_order_acquire);
+        const uint64_t head = mHead.load(std::memory_order_acquire);
+        return head > tail ? head - tail : 0;
+    }
+}
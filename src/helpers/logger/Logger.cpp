@@ -12,8 +12,7 @@
 #include <assimp/LogStream.hpp>
 #include <assimp/DefaultLogger.hpp>
 
-#include <sstream>
-#include <fstream>
+#include <iostream>
 
 
 namespace debug
@@ -28,52 +27,164 @@ namespace debug
         // Assimp::DefaultLogger::get()->attachStream(new StreamOutput(Severity_Notification), Assimp::Logger::Info | Assimp::Logger::Debugging);
         // Assimp::DefaultLogger::get()->attachStream(new StreamOutput(Severity_Warning), Assimp::Logger::Warn);
         // Assimp::DefaultLogger::get()->attachStream(new StreamOutput(Severity_Major), Assimp::Logger::Err);
+        
+        mWriterThread = std::thread(&Logger::writerLoop, this);
     }
     
     Logger::~Logger()
     {
+        {
+            const std::lock_guard lock(mWriterMutex);
+            mShouldTerminate = true;
+        }
+        mWriterCondition.notify_one();
+        mWriterThread.join();
+        
         Assimp::DefaultLogger::kill();
     }
     
     void Logger::log(const char file[], int line, Severity severity, std::string_view message)
     {
-        std::stringstream ss;
-        ss << "[" << severityStringMap.at(severity) << "] ";
-        // ss << "(" << file << " at line " << line << ")\n";
-        ss << message << "\n";
+        if (severity < throwLevel)
+        {
+            const OverflowPolicy policy = severity < Severity_Warning
+                ? mOverflowPolicy.load(std::memory_order_relaxed)
+                : OverflowPolicy_Block;
+            push(file, line, severity, message, policy);
+            return;
+        }
         
-        const std::string output = ss.str();
-        logToConsole(output);
-        logToFile(output);
-        logToQueue(message, file, line, severity);
+        // We're about to throw, so make sure that this and everything before it makes it out.
+        push(file, line, severity, message, OverflowPolicy_Block);
+        flush();
+        std::cout << "[" << severityStringMap.at(severity) << "] " << message << "\n";
+        throw LogException();
+    }
+    
+    void Logger::push(const char file[], int line, Severity severity, std::string_view message, OverflowPolicy policy)
+    {
+        LogRecord record;
+        record.file = file;
+        record.line = line;
+        record.severity = severity;
+        record.setMessage(message);
+        
+        while (!mRingBuffer.tryPush(record))
+        {
+            if (policy == OverflowPolicy_Drop)
+            {
+                record.release();
+                mDroppedCount.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            
+            mWriterCondition.notify_one();
+            std::this_thread::yield();
+        }
+        
+        mPushedCount.fetch_add(1, std::memory_order_release);
         
-        if (severity >= throwLevel)
+        // Waking the writer for every message costs more than the rest of the call. It polls anyway, so only
+        // hurry it along when the buffer is starting to fill up.
+        if (mRingBuffer.size() >= wakeThreshold)
+            mWriterCondition.notify_one();
+    }
+    
+    void Logger::flush()
+    {
+        const uint64_t target = mPushedCount.load(std::memory_order_acquire);
+        mWriterCondition.notify_one();
+        
+        std::unique_lock lock(mWriterMutex);
+        mFlushCondition.wait(lock, [this, target] {
+            return mWrittenCount.load(std::memory_order_acquire) >= target;
+        });
+    }
+    
+    void Logger::writerLoop()
+    {
+        LogRecord record { };
+        while (true)
         {
-            std::cout << output;
-            throw LogException();
+            uint64_t writtenCount = 0;
+            while (mRingBuffer.tryPop(record))
+            {
+                write(record);
+                record.release();
+                ++writtenCount;
+            }
+            
+            const uint64_t droppedCount = mDroppedCount.exchange(0, std::memory_order_relaxed);
+            if (droppedCount > 0)
+            {
+                record = { __FILE__, __LINE__, Severity_Warning };
+                record.setMessage(format::string("The logger dropped % messages because it couldn't keep up.", droppedCount));
+                write(record);
+                record.release();
+            }
+            
+            if (mFile.is_open())
+                mFile.flush();
+            
+            std::unique_lock lock(mWriterMutex);
+            if (writtenCount > 0)
+            {
+                mWrittenCount.fetch_add(writtenCount, std::memory_order_release);
+                mFlushCondition.notify_all();
+            }
+            
+            if (mShouldTerminate && mRingBuffer.isEmpty())
+                return;
+            
+            // Producers only notify when the buffer is filling up (and don't take the lock), so poll as well.
+            mWriterCondition.wait_for(lock, std::chrono::milliseconds(10), [this] {
+                return !mRingBuffer.isEmpty() || mShouldTerminate;
+            });
         }
     }
     
+    void Logger::write(const LogRecord &record)
+    {
+        const std::string_view message = record.message();
+        
+        std::string output;
+        output.reserve(message.size() + 16);
+        output += "[";
+        output += severityStringMap.at(record.severity);
+        output += "] ";
+        output += message;
+        output += "\n";
+        
+        logToConsole(output);
+        logToFile(output);
+        logToQueue(message, record.file, record.line, record.severity);
+    }
+    
     void Logger::logToConsole(std::string_view message) const
     {
-        if (sources & OutputSourceFlag_IoStream)
+        if (sources.load(std::memory_order_relaxed) & OutputSourceFlag_IoStream)
             std::cout << message;
     }
     
-    void Logger::logToFile(std::string_view message) const
+    void Logger::logToFile(std::string_view message)
     {
-        if (!(sources & OutputSourceFlag_File))
+        if (!(sources.load(std::memory_order_relaxed) & OutputSourceFlag_File))
             return;
         
-        std::ofstream file(fileName.data(), std::ios_base::app);
-        file << message;
-        file.close();
+        if (!mFile.is_open())
+            mFile.open(fileName.data(), std::ios_base::app);
+        mFile << message;
     }
     
     void Logger::logToQueue(std::string_view message, const char file[], int line, Severity severity)
     {
-        if ((sources & OutputSourceFlag_Queue))
-            messages.emplace_back(Message { line, severity, std::filesystem::path(file), std::string(message) });
+        if (!(sources.load(std::memory_order_relaxed) & OutputSourceFlag_Queue))
+            return;
+        
+        const std::lock_guard lock(mMessagesMutex);
+        if (messages.size() >= historyCapacity)
+            messages.pop_front();
+        messages.emplace_back(Message { line, severity, std::filesystem::path(file), std::string(message) });
     }
 
     void Logger::openglCallBack(
@@ -86,28 +197,10 @@ namespace debug
             return;
 
         const Severity level = glSeverityCastMap.at(severity);
+        const std::string output = format::string(
+            "OpenGL | Source: % | Type: %\n%", glSourceMap.at(source), glTypeMap.at(type), message);
         
-        std::stringstream ss;
-        ss << "[OpenGL | " << severityStringMap.at(level) << "]\n";
-        ss << "  Source: " <<  glSourceMap.at(source) << "\n";
-        ss << "    Type: " << glTypeMap.at(type) << "\n";
-        ss << " Message: " << message << "\n";
-        
-        const std::string output = ss.str();
-        logToConsole(output);
-        logToFile(output);
-        logToQueue(message, "", -1, level);
-        
-        if (level >= throwLevel)
-        {
-            std::cout << output;
-            throw LogException();
-        }
-    }
-    
-    const std::vector<Message> &Logger::getLogs() const
-    {
-        return messages;
+        log("", -1, level, std::string_view(output));
     }
     
     std::string_view Logger::toStringView(Severity severity) const
@@ -117,12 +210,18 @@ namespace debug
     
     void Logger::clearQueue()
     {
+        const std::lock_guard lock(mMessagesMutex);
         messages.clear();
     }
     
     void Logger::setOutputFlag(OutputSourceFlag flag)
     {
-        sources = flag;
+        sources.store(flag, std::memory_order_relaxed);
+    }
+    
+    void Logger::setOverflowPolicy(OverflowPolicy policy)
+    {
+        mOverflowPolicy.store(policy, std::memory_order_relaxed);
     }
     
     
@@ -9,7 +9,6 @@
 #include "Profiler.h"
 
 #include <utility>
-#include <thread>
 
 namespace debug
 {
@@ -33,7 +32,7 @@ namespace debug
         
         mStopped = true;
 
-        const uint32_t threadId = std::hash<std::thread::id>{}(std::this_thread::get_id());
-        profiler->addResult({ mId, mName, start, end, threadId });
+        // The profiler fills in the thread id from the calling thread's buffer.
+        profiler->addResult({ mId, mName, start, end, 0 });
     }
 }
@@ -10,6 +10,39 @@
 
 Profiler *profiler;
 
+namespace
+{
+    /**
+     * @brief Each thread caches its buffer so that only the first result of a thread takes the lock.
+     * The buffer goes back to the pool when the thread exits.
+     */
+    struct ThreadBuffer
+    {
+        std::shared_ptr<debug::ProfileBufferPool> pool;
+        debug::ProfileBuffer *buffer { nullptr };
+
+        ~ThreadBuffer()
+        {
+            release();
+        }
+
+        void release()
+        {
+            if (pool == nullptr)
+                return;
+
+            {
+                const std::unique_lock lock(pool->mutex);
+                pool->freeBuffers.push_back(buffer);
+            }
+            pool.reset();
+            buffer = nullptr;
+        }
+    };
+
+    thread_local ThreadBuffer threadBuffer;
+}
+
 namespace debug
 {
     bool ProfileNode::tryInsert(ProfileResult result)
@@ -27,40 +60,160 @@ namespace debug
         }
         return false;
     }
+
+    ProfileBuffer::ProfileBuffer(const uint32_t threadId)
+        : mThreadId(threadId)
+    {
+    }
+
+    bool ProfileBuffer::push(const ProfileResult &result)
+    {
+        const uint64_t head = mHead.load(std::memory_order_relaxed);
+        if (head - mTail.load(std::memory_order_acquire) >= capacity)
+        {
+            mDroppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        mResults[head & (capacity - 1)] = result;
+        mHead.store(head + 1, std::memory_order_release);
+        return true;
+    }
+}
+
+Profiler::Profiler()
+{
+    // The profiler is created and updated by the main thread.
+    setThreadName("Main Thread");
 }
 
 Profiler::~Profiler()
 {
     if (mIsRecordingSnapshot)
         endSnapshot();
+
+    if (threadBuffer.pool == mBufferPool)
+        threadBuffer.release();
 }
 
 void Profiler::addResult(const debug::ProfileResult &result)
 {
+    debug::ProfileBuffer &buffer = getThreadBuffer();
+    debug::ProfileResult threadResult = result;
+    threadResult.threadId = buffer.threadId();
+    buffer.push(threadResult);
+}
+
+void Profiler::setThreadName(const std::string &name)
+{
+    const uint32_t threadId = getThreadBuffer().threadId();
+    const std::unique_lock lock(mBufferPool->mutex);
+    mBufferPool->threadNames[threadId] = name;
+}
+
+debug::ProfileBuffer &Profiler::getThreadBuffer()
+{
+    if (threadBuffer.pool != mBufferPool)
+    {
+        threadBuffer.release();
+
+        const std::unique_lock lock(mBufferPool->mutex);
+        if (mBufferPool->freeBuffers.empty())
+        {
+            const auto threadId = static_cast<uint32_t>(mBufferPool->buffers.size());
+            mBufferPool->buffers.emplace_back(std::make_unique<debug::ProfileBuffer>(threadId));
+            threadBuffer.buffer = mBufferPool->buffers.back().get();
+        }
+        else
+        {
+            // Reusing the id of a thread that has exited keeps the number of threads in the viewer bounded.
+            threadBuffer.buffer = mBufferPool->freeBuffers.back();
+            mBufferPool->freeBuffers.pop_back();
+            mBufferPool->threadNames.erase(threadBuffer.buffer->threadId());
+        }
+        threadBuffer.pool = mBufferPool;
+    }
+
+    return *threadBuffer.buffer;
+}
+
+std::string Profiler::getThreadName(const uint32_t threadId)
+{
+    const std::unique_lock lock(mBufferPool->mutex);
+    if (const auto it = mBufferPool->threadNames.find(threadId); it != mBufferPool->threadNames.end())
+        return it->second;
+    return "Thread " + std::to_string(threadId);
+}
+
+void Profiler::mergeThreadBuffers()
+{
+    uint64_t droppedCount = 0;
+    {
+        const std::unique_lock lock(mBufferPool->mutex);
+        for (const std::unique_ptr<debug::ProfileBuffer> &buffer : mBufferPool->buffers)
+        {
+            buffer->drain([this](const debug::ProfileResult &result) {
+                if (mIsRecordingSnapshot)
+                    mSnapshotResults.push_back(result);
+                mResults.push_back(result);
+            });
+            droppedCount += buffer->takeDroppedCount();
+        }
+    }
+
+    if (droppedCount > 0)
+        setCounter("Profiler Dropped Results", static_cast<long long>(droppedCount));
+}
+
+void Profiler::setCounter(const std::string_view name, const long long value)
+{
+    const auto now = std::chrono::high_resolution_clock::now();
+    const long long time = std::chrono::time_point_cast<std::chrono::nanoseconds>(now).time_since_epoch().count();
+    const debug::ProfileCounter counter { name, value, time };
+
+    const std::unique_lock lock(mCountersMutex);
     if (mIsRecordingSnapshot)
-        mSnapshotResults.push_back(result);
-    mResults.push_back(result);
+        mSnapshotCounters.push_back(counter);
+
+    const auto it = std::find_if(mCounters.begin(), mCounters.end(), [name](const debug::ProfileCounter &other) {
+        return other.name == name;
+    });
+
+    if (it != mCounters.end())
+        *it = counter;
+    else
+        mCounters.push_back(counter);
 }
 
 void Profiler::createTree()
 {
+    // Scopes only nest within the thread that recorded them, so each thread gets its own tree.
     std::sort(mResults.begin(), mResults.end(), [](const debug::ProfileResult &lhs, const debug::ProfileResult &rhs) {
+        if (lhs.threadId != rhs.threadId)
+            return lhs.threadId < rhs.threadId;
         return lhs.id < rhs.id;
     });
     
     for (const auto &item : mResults)
     {
+        if (mTree.empty() || mTree.back().threadId != item.threadId)
+            mTree.push_back({ item.threadId, getThreadName(item.threadId), { } });
+
+        std::vector<debug::ProfileNode> &nodes = mTree.back().nodes;
         bool isInserted = false;
-        for (auto &node : mTree)
+        for (auto &node : nodes)
             isInserted |= node.tryInsert(item);
         
         if (!isInserted)
-            mTree.push_back({ item.id, item.name, item.startNanoSeconds, item.stopNanoSeconds, {} });
+            nodes.push_back({ item.id, item.name, item.startNanoSeconds, item.stopNanoSeconds, {} });
     }
 }
 
 void Profiler::updateAndClear()
 {
+    mergeThreadBuffers();
+    const std::unique_lock lock(mCountersMutex);
+
 #ifdef ENABLE_PROFILING
     if (!mIsFrozen)
     {
@@ -70,15 +223,17 @@ void Profiler::updateAndClear()
             mTimer -= mUpdateRate;
             mTree.clear();
             createTree();
+            mCounterView = mCounters;
         }
     }
 #else
-    if (!mResults.empty())
+    if (!mResults.empty() || !mCounters.empty())
             LOG_MINOR("Profiling was accessed in a non-profiling build");
 #endif  // ENABLE_PROFILING
     
+    // The id is never reset since scopes on other threads can still be open across frames.
     mResults.clear();
-    mId = 0;
+    mCounters.clear();
 }
 
 bool Profiler::isFrozen() const
@@ -96,13 +251,19 @@ void Profiler::setUpdateRate(float updateRate)
     mUpdateRate = updateRate;
 }
 
-const std::vector<debug::ProfileNode> &Profiler::getTree() const
+const std::vector<debug::ProfileThread> &Profiler::getTree() const
 {
     return mTree;
 }
 
+const std::vector<debug::ProfileCounter> &Profiler::getCounters() const
+{
+    return mCounterView;
+}
+
 void Profiler::beginSnapshot(const std::string& filePath)
 {
+    const std::unique_lock lock(mCountersMutex);
     mSnapshotFilePath = filePath;
     mIsRecordingSnapshot = true;
     mProfileCount = 0;
@@ -110,17 +271,32 @@ void Profiler::beginSnapshot(const std::string& filePath)
 
 void Profiler::endSnapshot()
 {
+    mergeThreadBuffers();
+    const std::unique_lock lock(mCountersMutex);
+
     mOutputSteam.open(mSnapshotFilePath);
     mOutputSteam << "{\"otherData\": {},\"traceEvents\":[";
 
+    std::unordered_map<uint32_t, std::string> threadNames;
+    {
+        const std::unique_lock threadLock(mBufferPool->mutex);
+        threadNames = mBufferPool->threadNames;
+    }
+    for (const auto &[threadId, name] : threadNames)
+        writeThreadName(threadId, name);
+
     for (const auto & snapshot : mSnapshotResults)
         writeProfile(snapshot);
 
+    for (const auto &counter : mSnapshotCounters)
+        writeCounter(counter);
+
     mOutputSteam << "]}";
     mOutputSteam.flush();
     mOutputSteam.close();
 
     mSnapshotResults.clear();
+    mSnapshotCounters.clear();
     mIsRecordingSnapshot = false;
 }
 
@@ -147,7 +323,45 @@ void Profiler::writeProfile(const debug::ProfileResult& result)
     mOutputSteam.flush();
 }
 
+void Profiler::writeCounter(const debug::ProfileCounter &counter)
+{
+    if (mProfileCount++ > 0)
+        mOutputSteam << ",";
+
+    std::string name = std::string(counter.name);
+    std::replace(name.begin(), name.end(), '"', '\'');
+
+    mOutputSteam << "{";
+    mOutputSteam << "\"cat\":\"counter\",";
+    mOutputSteam << "\"name\":\"" << name << "\",";
+    mOutputSteam << "\"ph\":\"C\",";
+    mOutputSteam << "\"pid\":0,";
+    const auto time = static_cast<long long>(counter.timeNanoSeconds * 0.001);
+    mOutputSteam << "\"ts\":" << time << ",";
+    mOutputSteam << "\"args\":{\"value\":" << counter.value << "}";
+    mOutputSteam << "}";
+
+    mOutputSteam.flush();
+}
+
+void Profiler::writeThreadName(const uint32_t threadId, const std::string &name)
+{
+    if (mProfileCount++ > 0)
+        mOutputSteam << ",";
+
+    std::string safeName = name;
+    std::replace(safeName.begin(), safeName.end(), '"', '\'');
+
+    mOutputSteam << "{";
+    mOutputSteam << "\"name\":\"thread_name\",";
+    mOutputSteam << "\"ph\":\"M\",";
+    mOutputSteam << "\"pid\":0,";
+    mOutputSteam << "\"tid\":" << threadId << ",";
+    mOutputSteam << "\"args\":{\"name\":\"" << safeName << "\"}";
+    mOutputSteam << "}";
+}
+
 uint64_t Profiler::getNewId()
 {
-    return ++mId;
+    return mId.fetch_add(1, std::memory_order_relaxed) + 1;
 }
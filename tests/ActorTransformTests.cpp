@@ -0,0 +1,121 @@
+/**
+ * @file ActorTransformTests.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "Scene.h"
+#include "TestHelpers.h"
+
+namespace
+{
+    glm::mat4 buildTransform(const glm::vec3 &position, const glm::quat &rotation, const glm::vec3 &scale)
+    {
+        return glm::translate(glm::mat4(1.f), position) * glm::mat4_cast(rotation) * glm::scale(glm::mat4(1.f), scale);
+    }
+
+    glm::mat4 buildLocalTransform(const engine::Actor &actor)
+    {
+        return buildTransform(actor.position, actor.rotation, actor.scale);
+    }
+
+    /**
+     * @returns The world transform worked out from scratch, without anything that the actors have cached.
+     */
+    glm::mat4 recomputeTransform(const engine::Actor &actor)
+    {
+        const glm::mat4 local = buildLocalTransform(actor);
+        return actor.getParent() != nullptr ? recomputeTransform(*actor.getParent()) * local : local;
+    }
+
+    bool isNear(const glm::mat4 &a, const glm::mat4 &b)
+    {
+        for (int column = 0; column < 4; ++column)
+        {
+            for (int row = 0; row < 4; ++row)
+            {
+                if (std::abs(a[column][row] - b[column][row]) > 0.0001f)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    void checkHierarchy(const std::vector<engine::Actor*> &actors)
+    {
+        for (const engine::Actor *actor : actors)
+            CHECK(isNear(actor->getTransform(), recomputeTransform(*actor)));
+    }
+
+    void testParentedHierarchy()
+    {
+        engine::Scene scene;
+        Ref<engine::Actor> root = scene.spawnActor<engine::Actor>("Root");
+        Ref<engine::Actor> child = scene.spawnActor<engine::Actor>("Child");
+        Ref<engine::Actor> grandchild = scene.spawnActor<engine::Actor>("Grandchild");
+        root->addChildActor(child, false);
+        child->addChildActor(grandchild, false);
+        const std::vector<engine::Actor*> actors { root.get(), child.get(), grandchild.get() };
+
+        root->setPosition(glm::vec3(1.f, 2.f, 3.f));
+        root->setRotation(glm::angleAxis(glm::radians(90.f), glm::vec3(0.f, 1.f, 0.f)));
+        root->setScale(glm::vec3(2.f));
+        child->setPosition(glm::vec3(0.f, 0.f, 5.f));
+        child->setRotation(glm::angleAxis(glm::radians(45.f), glm::vec3(1.f, 0.f, 0.f)));
+        grandchild->setPosition(glm::vec3(1.f, 0.f, 0.f));
+        checkHierarchy(actors);
+
+        // (0, 0, 5) is rotated onto +x, scaled by two and then moved by the root.
+        CHECK(isNear(child->getTransform(), buildTransform(
+            glm::vec3(11.f, 2.f, 3.f), root->rotation * child->rotation, glm::vec3(2.f))));
+
+        // Moving a parent after its children have been cached must reach every descendant.
+        root->setPosition(glm::vec3(-4.f, 0.f, 0.f));
+        checkHierarchy(actors);
+        child->setScale(glm::vec3(0.5f, 1.f, 3.f));
+        checkHierarchy(actors);
+
+        // Setting the same values again must leave the cache as it is.
+        const glm::mat4 before = grandchild->getTransform();
+        root->setPosition(root->position);
+        child->setRotation(child->rotation);
+        CHECK(grandchild->getTransform() == before);
+
+        // The matrix given is kept, while position, rotation and scale are split out of it.
+        const glm::mat4 world = buildTransform(glm::vec3(3.f, -1.f, 2.f), glm::angleAxis(glm::radians(30.f), glm::vec3(0.f, 0.f, 1.f)), glm::vec3(1.f));
+        grandchild->setWorldTransform(world);
+        CHECK(isNear(grandchild->getTransform(), world));
+        checkHierarchy(actors);
+
+        // Changing a single component after setWorldTransform() must still be picked up.
+        grandchild->setPosition(grandchild->position + glm::vec3(0.f, 1.f, 0.f));
+        checkHierarchy(actors);
+    }
+
+    void testKeepWorldRelative()
+    {
+        engine::Scene scene;
+        Ref<engine::Actor> parent = scene.spawnActor<engine::Actor>("Parent");
+        Ref<engine::Actor> child = scene.spawnActor<engine::Actor>("Child");
+        parent->setPosition(glm::vec3(0.f, 10.f, 0.f));
+        parent->setRotation(glm::angleAxis(glm::radians(60.f), glm::vec3(0.f, 1.f, 0.f)));
+        child->setPosition(glm::vec3(5.f, 0.f, 0.f));
+        const glm::mat4 world = child->getTransform();
+
+        parent->addChildActor(child);
+        CHECK(isNear(child->getTransform(), world));
+        CHECK(isNear(child->getTransform(), recomputeTransform(*child)));
+
+        parent->setPosition(glm::vec3(0.f));
+        CHECK(isNear(child->getTransform(), recomputeTransform(*child)));
+    }
+}
+
+int main()
+{
+    test::Environment environment;
+    testParentedHierarchy();
+    testKeepWorldRelative();
+    return test::result();
+}
@@ -0,0 +1,229 @@
+/**
+ * @file FrameArenaTests.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "FrameArena.h"
+#include "GraphicsDefinitions.h"
+#include "GraphicsLighting.h"
+#include "TestHelpers.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    // Only allocations made on the test's thread while counting are recorded, so the logger and profiler don't
+    // get in the way.
+    thread_local bool isCounting = false;
+    uint64_t allocationCount = 0;
+}
+
+void *operator new(const size_t size)
+{
+    if (isCounting)
+        ++allocationCount;
+
+    if (void *pointer = std::malloc(size == 0 ? 1 : size))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept
+{
+    std::free(pointer);
+}
+
+// Replaced as well since some runtimes (and sanitizers) don't forward these to the ones above.
+void *operator new[](const size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete[](void *pointer, size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+namespace
+{
+    using namespace graphics;
+
+    struct Queues
+    {
+        FrameVector<GeometryObject> geometryQueue;
+        FrameVector<uint32_t> materialQueue;
+        FrameVector<PointLight> pointLightQueue;
+        FrameVector<DirectionalLight> directionalLightQueue;
+    };
+
+    /**
+     * @brief Hands queues over the same way as Renderer::render() and Renderer::clear() without needing a GL context.
+     */
+    class FrameLoop
+    {
+    public:
+        FrameLoop()
+        {
+            resetQueues(mFrameArenas[mFrameArenaIndex]);
+        }
+
+        void submit(const uint32_t geometryCount)
+        {
+            for (uint32_t i = 0; i < geometryCount; ++i)
+            {
+                const glm::mat4 matrix = glm::translate(glm::mat4(1.f), glm::vec3(static_cast<float>(i), 0.f, 0.f));
+                mQueues.geometryQueue.emplace_back(1, i % 64, 36, 0, 0, matrix, BoundingSphere { glm::vec3(0.f), 1.f }, Mobility::Movable);
+                mQueues.materialQueue.push_back(i % 100);
+            }
+
+            for (uint32_t i = 0; i < 32; ++i)
+                mQueues.pointLightQueue.push_back(mPointLight);
+            for (uint32_t i = 0; i < 2; ++i)
+                mQueues.directionalLightQueue.push_back(mDirectionalLight);
+        }
+
+        void render()
+        {
+            mBackendQueues = std::move(mQueues);
+        }
+
+        void clear()
+        {
+            mFrameArenaIndex = 1 - mFrameArenaIndex;
+            FrameArena &arena = mFrameArenas[mFrameArenaIndex];
+            arena.reset();
+            resetQueues(arena);
+        }
+
+        [[nodiscard]] uint64_t heapAllocationCount() const
+        {
+            return mFrameArenas[0].heapAllocationCount() + mFrameArenas[1].heapAllocationCount();
+        }
+
+        [[nodiscard]] const Queues &backendQueues() const { return mBackendQueues; }
+
+    protected:
+        void resetQueues(FrameArena &arena)
+        {
+            const auto reset = [&arena](auto &queue) {
+                using Queue = std::decay_t<decltype(queue)>;
+                queue = Queue(typename Queue::allocator_type(arena));
+            };
+
+            reset(mQueues.geometryQueue);
+            reset(mQueues.materialQueue);
+            reset(mQueues.pointLightQueue);
+            reset(mQueues.directionalLightQueue);
+        }
+
+        FrameArena mFrameArenas[2];
+        uint32_t mFrameArenaIndex { 0 };
+        Queues mQueues;
+        Queues mBackendQueues;
+        PointLight mPointLight;
+        DirectionalLight mDirectionalLight;
+    };
+
+    /**
+     * @returns How many times operator new was called while running the frames.
+     */
+    uint64_t countAllocations(FrameLoop &loop, const uint32_t frameCount, const uint32_t geometryCount)
+    {
+        allocationCount = 0;
+        isCounting = true;
+        for (uint32_t frame = 0; frame < frameCount; ++frame)
+        {
+            loop.submit(geometryCount);
+            loop.render();
+            loop.clear();
+        }
+        isCounting = false;
+        return allocationCount;
+    }
+
+    void testAlignment()
+    {
+        FrameArena arena(256);
+        static_cast<void>(arena.allocate(3, 1));
+        const auto address = reinterpret_cast<uintptr_t>(arena.allocate(16, 64));
+        CHECK_EQUAL(address % 64, 0);
+        CHECK(arena.usedBytes() >= 19);
+    }
+
+    void testResetMergesBlocks()
+    {
+        FrameArena arena(100);
+        for (int i = 0; i < 5; ++i)
+            static_cast<void>(arena.allocate(80, 1));
+        CHECK_EQUAL(arena.heapAllocationCount(), 5);
+        CHECK_EQUAL(arena.usedBytes(), 400);
+
+        const uint64_t capacity = arena.capacity();
+        arena.reset();
+        CHECK_EQUAL(arena.usedBytes(), 0);
+        CHECK_EQUAL(arena.capacity(), capacity);
+        CHECK_EQUAL(arena.heapAllocationCount(), 6);
+
+        // The merged block fits the whole of the last frame.
+        for (int i = 0; i < 5; ++i)
+            static_cast<void>(arena.allocate(80, 1));
+        CHECK_EQUAL(arena.heapAllocationCount(), 6);
+    }
+
+    void testSteadyStateFramesDoNotAllocate()
+    {
+        // Big enough to spill over the default block size, so the first frames grow and merge the arenas.
+        constexpr uint32_t geometryCount = 20'000;
+
+        FrameLoop loop;
+        countAllocations(loop, 4, geometryCount);
+        const uint64_t warmHeapAllocations = loop.heapAllocationCount();
+
+        CHECK_EQUAL(countAllocations(loop, 16, geometryCount), 0);
+        CHECK_EQUAL(loop.heapAllocationCount(), warmHeapAllocations);
+        CHECK_EQUAL(loop.backendQueues().geometryQueue.size(), geometryCount);
+
+        // A much bigger frame has to grow the arenas. After that it settles again.
+        CHECK(countAllocations(loop, 4, geometryCount * 8) > 0);
+        CHECK(loop.heapAllocationCount() > warmHeapAllocations);
+        CHECK_EQUAL(countAllocations(loop, 16, geometryCount * 8), 0);
+
+        // Smaller frames fit in what is already there.
+        CHECK_EQUAL(countAllocations(loop, 16, geometryCount / 2), 0);
+    }
+
+    void testDefaultAllocatorUsesTheHeap()
+    {
+        FrameVector<uint32_t> queue { FrameAllocator<uint32_t>() };
+        allocationCount = 0;
+        isCounting = true;
+        queue.push_back(1);
+        isCounting = false;
+        CHECK_EQUAL(allocationCount, 1);
+    }
+}
+
+int main()
+{
+    test::Environment environment;
+
+    testAlignment();
+    testResetMergesBlocks();
+    testSteadyStateFramesDoNotAllocate();
+    testDefaultAllocatorUsesTheHeap();
+
+    return test::result();
+}
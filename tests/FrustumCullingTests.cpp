@@ -0,0 +1,157 @@
+/**
+ * @file FrustumCullingTests.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "FrustumCulling.h"
+#include "TestHelpers.h"
+
+namespace
+{
+    using namespace graphics;
+
+    template<typename TVolume>
+    bool isVisible(const TVolume &volume, const glm::vec3 &centre, const float radius)
+    {
+        uint8_t visible = 2;
+        cullSpheres(volume, &centre.x, &centre.y, &centre.z, &radius, 1, &visible);
+        return visible == 1;
+    }
+
+    void testPerspectiveFrustum()
+    {
+        // A 90 degree fov means that the side planes are at 45 degrees to the view direction (-z).
+        const Frustum frustum = extractFrustum(glm::perspective(glm::radians(90.f), 1.f, 0.1f, 100.f));
+
+        CHECK(isVisible(frustum, glm::vec3(0.f, 0.f, -10.f), 1.f));
+        CHECK(!isVisible(frustum, glm::vec3(0.f, 0.f, 10.f), 1.f));
+
+        // Far plane.
+        CHECK(isVisible(frustum, glm::vec3(0.f, 0.f, -100.5f), 1.f));
+        CHECK(!isVisible(frustum, glm::vec3(0.f, 0.f, -101.5f), 1.f));
+
+        // (-12, 0, -10) is sqrt(2) outside of the left plane.
+        CHECK(isVisible(frustum, glm::vec3(-12.f, 0.f, -10.f), 1.5f));
+        CHECK(!isVisible(frustum, glm::vec3(-12.f, 0.f, -10.f), 1.f));
+        CHECK(isVisible(frustum, glm::vec3(0.f, 12.f, -10.f), 1.5f));
+        CHECK(!isVisible(frustum, glm::vec3(0.f, 12.f, -10.f), 1.f));
+
+        // Between the eye and the near plane.
+        CHECK(!isVisible(frustum, glm::vec3(0.f, 0.f, -0.05f), 0.01f));
+        CHECK(isVisible(extendTowardsEye(frustum), glm::vec3(0.f, 0.f, -0.05f), 0.01f));
+
+        // Geometry without bounds must never be culled.
+        CHECK(isVisible(frustum, glm::vec3(0.f), unboundedSphere().radius));
+    }
+
+    void testViewProjectionFrustum()
+    {
+        const glm::mat4 view = glm::lookAt(glm::vec3(5.f), glm::vec3(0.f), glm::vec3(0.f, 1.f, 0.f));
+        const Frustum frustum = extractFrustum(glm::perspective(glm::radians(60.f), 16.f / 9.f, 0.1f, 50.f) * view);
+
+        CHECK(isVisible(frustum, glm::vec3(0.f), 0.5f));
+        CHECK(!isVisible(frustum, glm::vec3(10.f), 0.5f));
+        CHECK(!isVisible(frustum, glm::vec3(-40.f), 0.5f));
+    }
+
+    void testOrthographicFrustum()
+    {
+        const Frustum frustum = extractFrustum(glm::ortho(-10.f, 10.f, -10.f, 10.f, 0.f, 50.f));
+        const Frustum extended = extendTowardsEye(frustum);
+
+        CHECK(isVisible(frustum, glm::vec3(0.f, 0.f, -25.f), 1.f));
+
+        // Casters behind a cascade still shadow it.
+        CHECK(!isVisible(frustum, glm::vec3(0.f, 0.f, 5.f), 1.f));
+        CHECK(isVisible(extended, glm::vec3(0.f, 0.f, 5.f), 1.f));
+        CHECK(isVisible(extended, glm::vec3(0.f, 0.f, 1000.f), 1.f));
+
+        // Only the near plane is removed.
+        CHECK(!isVisible(extended, glm::vec3(0.f, 0.f, -60.f), 1.f));
+        CHECK(!isVisible(extended, glm::vec3(20.f, 0.f, 5.f), 1.f));
+        CHECK(!isVisible(extended, glm::vec3(0.f, -20.f, 5.f), 1.f));
+    }
+
+    void testManySpheres()
+    {
+        // Each sphere must land in its own slot.
+        const Frustum frustum = extractFrustum(glm::perspective(glm::radians(90.f), 1.f, 0.1f, 100.f));
+        const float x[] { 0.f, 0.f, -12.f, 50.f, 0.f };
+        const float y[] { 0.f, 0.f, 0.f, 0.f, 0.f };
+        const float z[] { -10.f, 10.f, -10.f, -60.f, -99.f };
+        const float radius[] { 1.f, 1.f, 1.5f, 1.f, 0.5f };
+        uint8_t visible[5] { };
+
+        cullSpheres(frustum, x, y, z, radius, 5, visible);
+        CHECK_EQUAL(visible[0], 1);
+        CHECK_EQUAL(visible[1], 0);
+        CHECK_EQUAL(visible[2], 1);
+        CHECK_EQUAL(visible[3], 1);
+        CHECK_EQUAL(visible[4], 1);
+    }
+
+    void testSphere()
+    {
+        const BoundingSphere volume { glm::vec3(0.f), 2.f };
+
+        CHECK(isVisible(volume, glm::vec3(0.f), 0.1f));
+        CHECK(isVisible(volume, glm::vec3(3.f, 0.f, 0.f), 1.f));
+        CHECK(!isVisible(volume, glm::vec3(3.1f, 0.f, 0.f), 1.f));
+        CHECK(!isVisible(volume, glm::vec3(0.f, -2.f, -2.f), 0.5f));
+        CHECK(isVisible(volume, glm::vec3(0.f, -2.f, -2.f), 1.f));
+    }
+
+    void testCone()
+    {
+        Cone cone;
+        cone.apex = glm::vec3(0.f);
+        cone.direction = glm::vec3(0.f, 0.f, -1.f);
+        cone.cosAngle = glm::cos(glm::radians(30.f));
+        cone.sinAngle = glm::sin(glm::radians(30.f));
+        cone.range = 10.f;
+
+        // Apex and axis.
+        CHECK(isVisible(cone, glm::vec3(0.f), 0.1f));
+        CHECK(isVisible(cone, glm::vec3(0.f, 0.f, -5.f), 0.1f));
+
+        // Behind the apex. Only spheres that reach the apex touch the cone.
+        CHECK(!isVisible(cone, glm::vec3(0.f, 0.f, 2.f), 0.5f));
+        CHECK(isVisible(cone, glm::vec3(0.f, 0.f, 2.f), 2.5f));
+        CHECK(!isVisible(cone, glm::vec3(3.f, 0.f, 1.f), 0.5f));
+
+        // Cap.
+        CHECK(isVisible(cone, glm::vec3(0.f, 0.f, -10.5f), 0.6f));
+        CHECK(!isVisible(cone, glm::vec3(0.f, 0.f, -10.5f), 0.4f));
+        CHECK(!isVisible(cone, glm::vec3(0.f, 0.f, -12.f), 1.f));
+
+        // Half a unit outside of the side, measured perpendicular to it.
+        const glm::vec3 side(cone.sinAngle, 0.f, -cone.cosAngle);
+        const glm::vec3 outwards(cone.cosAngle, 0.f, cone.sinAngle);
+        const glm::vec3 centre = 5.f * side + 0.5f * outwards;
+        CHECK(isVisible(cone, centre, 0.6f));
+        CHECK(!isVisible(cone, centre, 0.4f));
+        CHECK(isVisible(cone, glm::vec3(0.f, -centre.x, centre.z), 0.6f));
+        CHECK(!isVisible(cone, glm::vec3(0.f, -centre.x, centre.z), 0.4f));
+
+        // The cone can point anywhere.
+        cone.apex = glm::vec3(10.f, 0.f, 0.f);
+        cone.direction = glm::vec3(1.f, 0.f, 0.f);
+        CHECK(isVisible(cone, glm::vec3(15.f, 0.f, 0.f), 0.1f));
+        CHECK(!isVisible(cone, glm::vec3(5.f, 0.f, 0.f), 0.1f));
+        CHECK(!isVisible(cone, glm::vec3(15.f, 5.f, 0.f), 0.1f));
+    }
+}
+
+int main()
+{
+    test::Environment environment;
+    testPerspectiveFrustum();
+    testViewProjectionFrustum();
+    testOrthographicFrustum();
+    testManySpheres();
+    testSphere();
+    testCone();
+    return test::result();
+}
@@ -0,0 +1,236 @@
+/**
+ * @file LightClusteringTests.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "LightClustering.h"
+#include "TestHelpers.h"
+
+namespace
+{
+    using namespace graphics;
+
+    constexpr float zNear = 0.1f;
+    constexpr float zFar = 100.f;
+
+    // A square view so that both screen axes project the same way.
+    const glm::mat4 projection = glm::perspective(glm::radians(90.f), 1.f, zNear, zFar);
+
+    uint32_t clusterIndex(const uint32_t x, const uint32_t y, const uint32_t z)
+    {
+        return x + y * CLUSTER_COUNT_X + z * CLUSTER_COUNT_X * CLUSTER_COUNT_Y;
+    }
+
+    bool contains(const ClusterBounds &bounds, const uint32_t x, const uint32_t y, const uint32_t z)
+    {
+        return x >= bounds.min.x && x <= bounds.max.x
+            && y >= bounds.min.y && y <= bounds.max.y
+            && z >= bounds.min.z && z <= bounds.max.z;
+    }
+
+    PointLight makePointLight(const glm::vec3 &position, const float radius)
+    {
+        PointLight light;
+        light.position = position;
+        light.radius = radius;
+        return light;
+    }
+
+    void testClusterSlice()
+    {
+        CHECK_EQUAL(clusterSlice(0.f, zNear, zFar), 0);
+        CHECK_EQUAL(clusterSlice(zNear, zNear, zFar), 0);
+        CHECK_EQUAL(clusterSlice(zFar, zNear, zFar), CLUSTER_COUNT_Z - 1);
+        CHECK_EQUAL(clusterSlice(zFar * 10.f, zNear, zFar), CLUSTER_COUNT_Z - 1);
+
+        // Slices are exponential, so the geometric middle of the range is the middle slice.
+        CHECK_EQUAL(clusterSlice(glm::sqrt(zNear * zFar) * 1.01f, zNear, zFar), CLUSTER_COUNT_Z / 2);
+
+        uint32_t lastSlice = 0;
+        for (float depth = zNear; depth < zFar; depth *= 1.1f)
+        {
+            const uint32_t slice = clusterSlice(depth, zNear, zFar);
+            CHECK(slice >= lastSlice);
+            lastSlice = slice;
+        }
+    }
+
+    void testFindClusterBounds()
+    {
+        ClusterBounds bounds;
+
+        // Straight ahead. The box's nearest face projects to +-1/9 in ndc.
+        CHECK(findClusterBounds({ glm::vec3(0.f, 0.f, -10.f), 1.f }, projection, zNear, zFar, bounds));
+        CHECK_EQUAL(bounds.min.x, CLUSTER_COUNT_X / 2 - 1);
+        CHECK_EQUAL(bounds.max.x, CLUSTER_COUNT_X / 2);
+        CHECK(bounds.min.y <= CLUSTER_COUNT_Y / 2 && bounds.max.y >= CLUSTER_COUNT_Y / 2);
+        CHECK_EQUAL(bounds.min.z, clusterSlice(9.f, zNear, zFar));
+        CHECK_EQUAL(bounds.max.z, clusterSlice(11.f, zNear, zFar));
+
+        // Behind the camera, past the far plane and off to the side.
+        CHECK(!findClusterBounds({ glm::vec3(0.f, 0.f, 10.f), 1.f }, projection, zNear, zFar, bounds));
+        CHECK(!findClusterBounds({ glm::vec3(0.f, 0.f, -200.f), 1.f }, projection, zNear, zFar, bounds));
+        CHECK(!findClusterBounds({ glm::vec3(50.f, 0.f, -10.f), 1.f }, projection, zNear, zFar, bounds));
+
+        // Crossing the near plane covers the whole screen.
+        CHECK(findClusterBounds({ glm::vec3(0.f), 1.f }, projection, zNear, zFar, bounds));
+        CHECK_EQUAL(bounds.min.x, 0);
+        CHECK_EQUAL(bounds.min.y, 0);
+        CHECK_EQUAL(bounds.max.x, CLUSTER_COUNT_X - 1);
+        CHECK_EQUAL(bounds.max.y, CLUSTER_COUNT_Y - 1);
+        CHECK_EQUAL(bounds.min.z, 0);
+
+        // Crossing the far plane is clamped to the last slice.
+        CHECK(findClusterBounds({ glm::vec3(0.f, 0.f, -zFar), 5.f }, projection, zNear, zFar, bounds));
+        CHECK_EQUAL(bounds.max.z, CLUSTER_COUNT_Z - 1);
+    }
+
+    void testSpotlightBounds()
+    {
+        const float epsilon = 0.001f;
+        for (const float degrees : { 5.f, 30.f, 45.f, 60.f, 85.f })
+        {
+            Spotlight spotlight;
+            spotlight.position = glm::vec3(1.f, 2.f, 3.f);
+            spotlight.direction = glm::normalize(glm::vec3(1.f, -1.f, 0.f));
+            spotlight.outerAngle = glm::radians(degrees);
+            spotlight.radius = 10.f;
+
+            const BoundingSphere sphere = spotlightBounds(spotlight);
+            const auto isInside = [&](const glm::vec3 &point) {
+                return glm::distance(point, sphere.centre) <= sphere.radius + epsilon;
+            };
+
+            // The apex, the tip of the cone's axis and the rim of the cone must all be inside.
+            const glm::vec3 side = glm::normalize(glm::cross(spotlight.direction, glm::vec3(0.f, 0.f, 1.f)));
+            const float angle = spotlight.outerAngle;
+            CHECK(isInside(spotlight.position));
+            CHECK(isInside(spotlight.position + spotlight.radius * spotlight.direction));
+            CHECK(isInside(spotlight.position + spotlight.radius * (glm::cos(angle) * spotlight.direction + glm::sin(angle) * side)));
+            CHECK(isInside(spotlight.position + spotlight.radius * (glm::cos(angle) * spotlight.direction - glm::sin(angle) * side)));
+
+            // Never looser than a sphere around the apex.
+            CHECK(sphere.radius <= spotlight.radius + epsilon);
+        }
+    }
+
+    void testBuild()
+    {
+        FrameVector<PointLight> pointLights;
+        pointLights.push_back(makePointLight(glm::vec3(0.f, 0.f, -10.f), 1.f));
+        pointLights.push_back(makePointLight(glm::vec3(-5.f, 2.f, -20.f), 4.f));
+        pointLights.push_back(makePointLight(glm::vec3(0.f, 0.f, 10.f), 1.f));  // Behind the camera.
+
+        FrameVector<Spotlight> spotlights;
+        Spotlight spotlight;
+        spotlight.position = glm::vec3(0.f, 5.f, -15.f);
+        spotlight.radius = 8.f;
+        spotlights.push_back(spotlight);
+
+        LightClusterer clusterer;
+        clusterer.build(glm::mat4(1.f), projection, zNear, zFar, pointLights, spotlights);
+        CHECK_EQUAL(clusterer.getDroppedLightCount(), 0);
+
+        const std::vector<ClusterRange> &ranges = clusterer.getRanges();
+        const std::vector<uint32_t> &indices = clusterer.getLightIndices();
+        CHECK_EQUAL(ranges.size(), clusterCount);
+        CHECK(!indices.empty());
+
+        std::vector<ClusterBounds> pointBounds(pointLights.size());
+        std::vector<bool> isPointVisible(pointLights.size());
+        for (size_t i = 0; i < pointLights.size(); ++i)
+            isPointVisible[i] = findClusterBounds({ pointLights[i].position, pointLights[i].radius }, projection, zNear, zFar, pointBounds[i]);
+        CHECK(!isPointVisible[2]);
+
+        ClusterBounds spotBounds;
+        CHECK(findClusterBounds(spotlightBounds(spotlight), projection, zNear, zFar, spotBounds));
+
+        // Every cluster must hold exactly the lights whose bounds cover it, point lights first.
+        uint32_t expectedOffset = 0;
+        for (uint32_t z = 0; z < CLUSTER_COUNT_Z; ++z)
+        {
+            for (uint32_t y = 0; y < CLUSTER_COUNT_Y; ++y)
+            {
+                for (uint32_t x = 0; x < CLUSTER_COUNT_X; ++x)
+                {
+                    const ClusterRange &range = ranges[clusterIndex(x, y, z)];
+                    CHECK_EQUAL(range.offset, expectedOffset);
+
+                    std::vector<uint32_t> expectedPointLights;
+                    for (uint32_t i = 0; i < pointLights.size(); ++i)
+                    {
+                        if (isPointVisible[i] && contains(pointBounds[i], x, y, z))
+                            expectedPointLights.push_back(i);
+                    }
+
+                    const bool hasSpotlight = contains(spotBounds, x, y, z);
+                    CHECK_EQUAL(range.pointLightCount, expectedPointLights.size());
+                    CHECK_EQUAL(range.spotlightCount, hasSpotlight ? 1 : 0);
+                    if (range.pointLightCount != expectedPointLights.size() || range.spotlightCount != (hasSpotlight ? 1u : 0u))
+                        return;
+
+                    for (uint32_t i = 0; i < range.pointLightCount; ++i)
+                        CHECK_EQUAL(indices[range.offset + i], expectedPointLights[i]);
+                    if (hasSpotlight)
+                        CHECK_EQUAL(indices[range.offset + range.pointLightCount], 0);
+
+                    expectedOffset += range.pointLightCount + range.spotlightCount;
+                }
+            }
+        }
+        CHECK_EQUAL(indices.size(), expectedOffset);
+    }
+
+    void testDroppedLights()
+    {
+        // Every light covers the same clusters, so any that were binned past the limit would show up in them.
+        FrameVector<PointLight> pointLights;
+        for (int i = 0; i < CLUSTER_MAX_LIGHTS + 3; ++i)
+            pointLights.push_back(makePointLight(glm::vec3(0.f, 0.f, -10.f), 1.f));
+        FrameVector<Spotlight> spotlights;
+
+        LightClusterer clusterer;
+        clusterer.build(glm::mat4(1.f), projection, zNear, zFar, pointLights, spotlights);
+        CHECK_EQUAL(clusterer.getDroppedLightCount(), 3);
+
+        ClusterBounds bounds;
+        CHECK(findClusterBounds({ glm::vec3(0.f, 0.f, -10.f), 1.f }, projection, zNear, zFar, bounds));
+        const ClusterRange &range = clusterer.getRanges()[clusterIndex(bounds.min.x, bounds.min.y, bounds.min.z)];
+        CHECK_EQUAL(range.pointLightCount, CLUSTER_MAX_LIGHTS);
+        for (const uint32_t index : clusterer.getLightIndices())
+            CHECK(index < CLUSTER_MAX_LIGHTS);
+
+        // The count is per build.
+        pointLights.resize(1);
+        clusterer.build(glm::mat4(1.f), projection, zNear, zFar, pointLights, spotlights);
+        CHECK_EQUAL(clusterer.getDroppedLightCount(), 0);
+
+        // Spotlights have a limit of their own, and a full set of point lights doesn't count against it.
+        Spotlight spotlight;
+        spotlight.position = glm::vec3(0.f, 0.f, -10.f);
+        spotlight.radius = 1.f;
+        for (int i = 0; i < CLUSTER_MAX_LIGHTS + 2; ++i)
+            spotlights.push_back(spotlight);
+        for (int i = 1; i < CLUSTER_MAX_LIGHTS; ++i)
+            pointLights.push_back(makePointLight(glm::vec3(0.f, 0.f, -10.f), 1.f));
+
+        clusterer.build(glm::mat4(1.f), projection, zNear, zFar, pointLights, spotlights);
+        CHECK_EQUAL(clusterer.getDroppedLightCount(), 2);
+        const ClusterRange &fullRange = clusterer.getRanges()[clusterIndex(bounds.min.x, bounds.min.y, bounds.min.z)];
+        CHECK_EQUAL(fullRange.pointLightCount, CLUSTER_MAX_LIGHTS);
+        CHECK_EQUAL(fullRange.spotlightCount, CLUSTER_MAX_LIGHTS);
+    }
+}
+
+int main()
+{
+    test::Environment environment;
+    testClusterSlice();
+    testFindClusterBounds();
+    testSpotlightBounds();
+    testBuild();
+    testDroppedLights();
+    return test::result();
+}
@@ -0,0 +1,247 @@
+/**
+ * @file ProfilerStressTests.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "ProfileTimer.h"
+#include "TestHelpers.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+    constexpr uint32_t longWorkerCount = 4;
+    constexpr uint32_t shortWorkerCount = 4;
+    constexpr uint32_t workerCount = longWorkerCount + shortWorkerCount * 2;  // The short workers are replaced once.
+
+    // Each iteration records three results. A buffer is only ever shared by two workers, one after the other, so
+    // 2 * 3 * 1000 results always fit even if the main thread never got to drain it.
+    constexpr uint32_t iterationCount = 1000;
+
+    std::vector<std::string> scopeNames;
+
+    void recordInnerScope()
+    {
+        PROFILE_FUNC();
+    }
+
+    void recordScopes(const uint32_t workerIndex)
+    {
+        for (uint32_t i = 0; i < iterationCount; ++i)
+        {
+            PROFILE_FUNC_NAMED(scopeNames[workerIndex]);
+            recordInnerScope();
+            recordInnerScope();
+            std::this_thread::yield();
+        }
+    }
+
+    /**
+     * @brief Only returns once the worker has named itself, so the order that buffers are taken in is known.
+     * @param canExit The worker holds on to its buffer until this is ready, if it is valid.
+     */
+    std::thread startWorker(const uint32_t workerIndex, std::shared_future<void> canExit = { })
+    {
+        std::promise<void> registered;
+        std::future<void> isRegistered = registered.get_future();
+        std::thread worker([workerIndex, registered = std::move(registered), canExit = std::move(canExit)]() mutable {
+            PROFILE_THREAD("Stress Worker " + std::to_string(workerIndex));
+            registered.set_value();
+            recordScopes(workerIndex);
+            if (canExit.valid())
+                canExit.wait();
+        });
+
+        isRegistered.wait();
+        return worker;
+    }
+
+    struct Tally
+    {
+        std::vector<uint32_t> outerCounts = std::vector<uint32_t>(workerCount, 0);
+        uint32_t nestedCount { 0 };
+        uint32_t orphanCount { 0 };
+        uint32_t frameCount { 0 };
+    };
+
+    /**
+     * @brief Counts the scopes in the tree made by the last updateAndClear().
+     */
+    void tallyFrame(Tally &tally)
+    {
+        ++tally.frameCount;
+        for (const debug::ProfileCounter &counter : profiler->getCounters())
+            CHECK(counter.name != "Profiler Dropped Results");
+
+        for (const debug::ProfileThread &thread : profiler->getTree())
+        {
+            for (const debug::ProfileNode &node : thread.nodes)
+            {
+                if (node.name == "recordInnerScope")
+                {
+                    // An inner scope is pushed before its outer one, so a drain can land between them.
+                    CHECK(node.children.empty());
+                    ++tally.orphanCount;
+                    continue;
+                }
+
+                const auto it = std::find(scopeNames.begin(), scopeNames.end(), node.name);
+                CHECK(it != scopeNames.end());
+                if (it == scopeNames.end())
+                    continue;
+
+                ++tally.outerCounts[it - scopeNames.begin()];
+                CHECK(node.children.size() <= 2);
+                for (const debug::ProfileNode &child : node.children)
+                {
+                    CHECK_EQUAL(child.name, "recordInnerScope");
+                    CHECK(child.children.empty());
+                    ++tally.nestedCount;
+                }
+            }
+        }
+    }
+
+    /**
+     * @returns Every thread_name event in a snapshot, by thread id.
+     */
+    std::unordered_map<uint32_t, std::string> readThreadNames(const std::string &trace)
+    {
+        const std::string marker = "\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":";
+        const std::string nameMarker = "\"args\":{\"name\":\"";
+
+        std::unordered_map<uint32_t, std::string> threadNames;
+        for (size_t position = trace.find(marker); position != std::string::npos; position = trace.find(marker, position))
+        {
+            position += marker.size();
+            const auto threadId = static_cast<uint32_t>(std::strtoul(trace.c_str() + position, nullptr, 10));
+            const size_t nameStart = trace.find(nameMarker, position) + nameMarker.size();
+            threadNames[threadId] = trace.substr(nameStart, trace.find('"', nameStart) - nameStart);
+        }
+
+        return threadNames;
+    }
+
+    /**
+     * @returns The largest thread id of any scope in a snapshot.
+     */
+    uint32_t readLargestThreadId(const std::string &trace)
+    {
+        const std::string marker = "\"ph\":\"X\",\"pid\":0,\"tid\":";
+
+        uint32_t largest = 0;
+        for (size_t position = trace.find(marker); position != std::string::npos; position = trace.find(marker, position))
+        {
+            position += marker.size();
+            largest = std::max(largest, static_cast<uint32_t>(std::strtoul(trace.c_str() + position, nullptr, 10)));
+        }
+
+        return largest;
+    }
+
+    void testManyThreadsRecording()
+    {
+        for (uint32_t i = 0; i < workerCount; ++i)
+            scopeNames.push_back("Stress Scope " + std::to_string(i));
+
+        const std::filesystem::path snapshotPath = std::filesystem::temp_directory_path() / "ProfilerStressTests.json";
+        profiler->beginSnapshot(snapshotPath.string());
+
+        Tally tally;
+        std::promise<void> replacementsStarted;
+        const std::shared_future<void> hasReplacementsStarted = replacementsStarted.get_future().share();
+        std::vector<std::thread> longWorkers;
+        std::vector<std::thread> shortWorkers;
+
+        // The long workers keep their buffers until the replacements have taken the short workers' ones.
+        for (uint32_t i = 0; i < longWorkerCount; ++i)
+            longWorkers.push_back(startWorker(i, hasReplacementsStarted));
+        for (uint32_t i = 0; i < shortWorkerCount; ++i)
+            shortWorkers.push_back(startWorker(longWorkerCount + i));
+
+        const auto drainUntilJoined = [&tally](std::vector<std::thread> &threads) {
+            std::atomic<bool> isJoined { false };
+            std::thread joiner([&threads, &isJoined] {
+                for (std::thread &thread : threads)
+                    thread.join();
+                isJoined.store(true);
+            });
+
+            while (!isJoined.load())
+            {
+                profiler->updateAndClear();
+                tallyFrame(tally);
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            joiner.join();
+            threads.clear();
+        };
+
+        drainUntilJoined(shortWorkers);
+
+        // The short workers have exited, so their replacements take their buffers and thread ids mid-run.
+        for (uint32_t i = 0; i < shortWorkerCount; ++i)
+            shortWorkers.push_back(startWorker(longWorkerCount + shortWorkerCount + i));
+        replacementsStarted.set_value();
+
+        drainUntilJoined(shortWorkers);
+        drainUntilJoined(longWorkers);
+
+        profiler->updateAndClear();
+        tallyFrame(tally);
+        profiler->endSnapshot();
+
+        for (uint32_t i = 0; i < workerCount; ++i)
+            CHECK_EQUAL(tally.outerCounts[i], iterationCount);
+        CHECK_EQUAL(tally.nestedCount + tally.orphanCount, workerCount * iterationCount * 2);
+        CHECK(tally.nestedCount > 0);
+        CHECK(tally.frameCount > 1);
+
+        std::ifstream stream(snapshotPath);
+        std::stringstream trace;
+        trace << stream.rdbuf();
+        stream.close();
+        std::filesystem::remove(snapshotPath);
+
+        CHECK(trace.str().find("Profiler Dropped Results") == std::string::npos);
+
+        // The main thread and one buffer for each worker that was alive at the same time.
+        CHECK_EQUAL(readLargestThreadId(trace.str()), longWorkerCount + shortWorkerCount);
+
+        const std::unordered_map<uint32_t, std::string> threadNames = readThreadNames(trace.str());
+        CHECK_EQUAL(threadNames.size(), 1 + longWorkerCount + shortWorkerCount);
+        std::vector<std::string> names;
+        for (const auto &[threadId, name] : threadNames)
+            names.push_back(name);
+
+        const auto hasName = [&names](const std::string &name) {
+            return std::find(names.begin(), names.end(), name) != names.end();
+        };
+        CHECK(hasName("Main Thread"));
+        for (uint32_t i = 0; i < longWorkerCount; ++i)
+            CHECK(hasName("Stress Worker " + std::to_string(i)));
+
+        // Reused buffers are renamed by the threads that took them over.
+        for (uint32_t i = 0; i < shortWorkerCount; ++i)
+        {
+            CHECK(!hasName("Stress Worker " + std::to_string(longWorkerCount + i)));
+            CHECK(hasName("Stress Worker " + std::to_string(longWorkerCount + shortWorkerCount + i)));
+        }
+    }
+}
+
+int main()
+{
+    test::Environment environment;
+
+    testManyThreadsRecording();
+
+    return test::result();
+}
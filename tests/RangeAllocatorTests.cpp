@@ -0,0 +1,223 @@
+/**
+ * @file RangeAllocatorTests.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "RangeAllocator.h"
+#include "TestHelpers.h"
+
+#include <algorithm>
+
+namespace
+{
+    using namespace graphics;
+
+    /**
+     * @brief Copies the data the same way as MeshArena::defragment(): the unmoved prefix first, then every move.
+     */
+    std::vector<uint32_t> applyMoves(const std::vector<uint32_t> &data, const std::vector<RangeAllocator::Move> &moves, const uint64_t usedSize)
+    {
+        std::vector<uint32_t> packed(data.size(), 0);
+        const uint64_t unmoved = moves.empty() ? usedSize : moves.front().to;
+        std::copy_n(data.begin(), unmoved, packed.begin());
+        for (const auto &[from, to, size] : moves)
+            std::copy_n(data.begin() + static_cast<std::ptrdiff_t>(from), size, packed.begin() + static_cast<std::ptrdiff_t>(to));
+        return packed;
+    }
+
+    void fill(std::vector<uint32_t> &data, const RangeAllocator &allocator, const uint32_t handle)
+    {
+        std::fill_n(data.begin() + static_cast<std::ptrdiff_t>(allocator.offset(handle)), allocator.size(handle), handle + 1);
+    }
+
+    bool holds(const std::vector<uint32_t> &data, const RangeAllocator &allocator, const uint32_t handle)
+    {
+        const auto first = data.begin() + static_cast<std::ptrdiff_t>(allocator.offset(handle));
+        return std::all_of(first, first + static_cast<std::ptrdiff_t>(allocator.size(handle)), [handle](const uint32_t value) {
+            return value == handle + 1;
+        });
+    }
+
+    void testFirstFit()
+    {
+        RangeAllocator allocator(100);
+        const uint32_t a = allocator.allocate(10);
+        const uint32_t b = allocator.allocate(20);
+        const uint32_t c = allocator.allocate(5);
+        allocator.allocate(30);
+        CHECK_EQUAL(allocator.offset(a), 0);
+        CHECK_EQUAL(allocator.offset(b), 10);
+        CHECK_EQUAL(allocator.offset(c), 30);
+
+        // Free ranges are now [0, 10), [30, 35) and [65, 100).
+        allocator.free(a);
+        allocator.free(c);
+        CHECK_EQUAL(allocator.freeRangeCount(), 3);
+
+        // The first range that fits is used, even though [30, 35) fits exactly.
+        const uint32_t d = allocator.allocate(5);
+        CHECK_EQUAL(allocator.offset(d), 0);
+        const uint32_t e = allocator.allocate(8);
+        CHECK_EQUAL(allocator.offset(e), 65);
+        const uint32_t f = allocator.allocate(5);
+        CHECK_EQUAL(allocator.offset(f), 5);
+
+        CHECK_EQUAL(allocator.allocate(30), RangeAllocator::invalidHandle);
+
+        // Zero sized allocations still take up space so that they have a unique offset.
+        const uint32_t g = allocator.allocate(0);
+        CHECK_EQUAL(allocator.size(g), 1);
+        CHECK_EQUAL(allocator.offset(g), 30);
+    }
+
+    void testFreeMergesNeighbours()
+    {
+        RangeAllocator allocator(30);
+        const uint32_t a = allocator.allocate(10);
+        const uint32_t b = allocator.allocate(10);
+        const uint32_t c = allocator.allocate(10);
+        CHECK_EQUAL(allocator.freeRangeCount(), 0);
+
+        allocator.free(a);
+        allocator.free(c);
+        CHECK_EQUAL(allocator.freeRangeCount(), 2);
+        CHECK_NEAR(allocator.fragmentation(), 0.5f, 0.0001f);
+
+        allocator.free(b);
+        CHECK_EQUAL(allocator.freeRangeCount(), 1);
+        CHECK_EQUAL(allocator.largestFreeRange(), 30);
+        CHECK_EQUAL(allocator.usedSize(), 0);
+        CHECK_NEAR(allocator.fragmentation(), 0.f, 0.0001f);
+
+        // Freeing twice or freeing a handle that was never given out does nothing.
+        allocator.free(b);
+        allocator.free(1000);
+        CHECK_EQUAL(allocator.freeRangeCount(), 1);
+        CHECK_EQUAL(allocator.usedSize(), 0);
+    }
+
+    void testHandlesAreReused()
+    {
+        RangeAllocator allocator(100);
+        allocator.allocate(10);
+        const uint32_t b = allocator.allocate(10);
+        allocator.free(b);
+        CHECK_EQUAL(allocator.allocate(10), b);
+    }
+
+    void testDefragmentKeepsHandles()
+    {
+        RangeAllocator allocator(64);
+        std::vector<uint32_t> handles;
+        for (const uint64_t size : { 4, 6, 3, 8, 5, 7, 2, 9 })
+            handles.push_back(allocator.allocate(size));
+
+        std::vector<uint32_t> data(allocator.capacity(), 0);
+        for (const uint32_t handle : handles)
+            fill(data, allocator, handle);
+
+        // Leaves the first allocation where it is so that there is an unmoved prefix.
+        allocator.free(handles[1]);
+        allocator.free(handles[4]);
+        allocator.free(handles[6]);
+        const std::vector<uint32_t> live { handles[0], handles[2], handles[3], handles[5], handles[7] };
+
+        const uint64_t usedSize = allocator.usedSize();
+        const std::vector<RangeAllocator::Move> moves = allocator.defragment();
+        CHECK_EQUAL(moves.size(), 4);
+        CHECK_EQUAL(allocator.usedSize(), usedSize);
+        CHECK_EQUAL(allocator.freeRangeCount(), 1);
+        CHECK_EQUAL(allocator.largestFreeRange(), allocator.capacity() - usedSize);
+
+        // Live handles are packed in the order they were in and keep their size.
+        uint64_t end = 0;
+        for (const uint32_t handle : live)
+        {
+            CHECK_EQUAL(allocator.offset(handle), end);
+            end += allocator.size(handle);
+        }
+        CHECK_EQUAL(end, usedSize);
+
+        // MeshArena relies on the moves being in order with nothing moved before the first destination.
+        CHECK_EQUAL(moves.front().to, allocator.size(handles[0]));
+        for (size_t i = 0; i < moves.size(); ++i)
+        {
+            CHECK(moves[i].to <= moves[i].from);
+            if (i > 0)
+                CHECK_EQUAL(moves[i].to, moves[i - 1].to + moves[i - 1].size);
+        }
+
+        const std::vector<uint32_t> packed = applyMoves(data, moves, usedSize);
+        for (const uint32_t handle : live)
+            CHECK(holds(packed, allocator, handle));
+
+        // Already packed, so nothing moves.
+        CHECK(allocator.defragment().empty());
+    }
+
+    void testDefragmentFromTheStart()
+    {
+        RangeAllocator allocator(20);
+        const uint32_t a = allocator.allocate(5);
+        const uint32_t b = allocator.allocate(5);
+        std::vector<uint32_t> data(allocator.capacity(), 0);
+        fill(data, allocator, b);
+        allocator.free(a);
+
+        // With nothing left at the start, the first move's destination is zero so no prefix is copied.
+        const std::vector<RangeAllocator::Move> moves = allocator.defragment();
+        CHECK_EQUAL(moves.size(), 1);
+        CHECK_EQUAL(moves.front().to, 0);
+        CHECK_EQUAL(allocator.offset(b), 0);
+        CHECK(holds(applyMoves(data, moves, allocator.usedSize()), allocator, b));
+    }
+
+    void testGrow()
+    {
+        RangeAllocator allocator(20);
+        const uint32_t a = allocator.allocate(10);
+        const uint32_t b = allocator.allocate(5);
+        CHECK_EQUAL(allocator.allocate(10), RangeAllocator::invalidHandle);
+
+        // The free space at the end is merged with the new space.
+        allocator.grow(40);
+        CHECK_EQUAL(allocator.capacity(), 40);
+        CHECK_EQUAL(allocator.freeRangeCount(), 1);
+        CHECK_EQUAL(allocator.largestFreeRange(), 25);
+        CHECK_EQUAL(allocator.offset(a), 0);
+        CHECK_EQUAL(allocator.offset(b), 10);
+
+        const uint32_t c = allocator.allocate(25);
+        CHECK_EQUAL(allocator.offset(c), 15);
+
+        // A full allocator gets a new free range after the last allocation.
+        allocator.grow(50);
+        CHECK_EQUAL(allocator.freeRangeCount(), 1);
+        CHECK_EQUAL(allocator.offset(allocator.allocate(10)), 40);
+
+        // Shrinking isn't supported.
+        allocator.grow(10);
+        CHECK_EQUAL(allocator.capacity(), 50);
+
+        RangeAllocator empty;
+        CHECK_EQUAL(empty.allocate(1), RangeAllocator::invalidHandle);
+        empty.grow(8);
+        CHECK_EQUAL(empty.offset(empty.allocate(8)), 0);
+    }
+}
+
+int main()
+{
+    test::Environment environment;
+
+    testFirstFit();
+    testFreeMergesNeighbours();
+    testHandlesAreReused();
+    testDefragmentKeepsHandles();
+    testDefragmentFromTheStart();
+    testGrow();
+
+    return test::result();
+}
@@ -0,0 +1,136 @@
+/**
+ * @file RingAllocatorTests.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "RingAllocator.h"
+#include "TestHelpers.h"
+
+namespace
+{
+    using namespace graphics;
+
+    auto neverRetire()
+    {
+        return [](uint64_t) { test::fail(__FILE__, __LINE__, "a frame was retired"); };
+    }
+
+    void testAlignment()
+    {
+        RingAllocator allocator(256);
+        CHECK_EQUAL(allocator.allocate(10, 16, neverRetire()), 0);
+        CHECK_EQUAL(allocator.allocate(10, 16, neverRetire()), 16);
+        CHECK_EQUAL(allocator.allocate(4, 4, neverRetire()), 28);
+        CHECK_EQUAL(allocator.usedBytes(), 32);
+    }
+
+    void testWrapAround()
+    {
+        RingAllocator allocator(100);
+        std::vector<uint64_t> retired;
+        auto retire = [&retired](const uint64_t frameId) { retired.push_back(frameId); };
+
+        CHECK_EQUAL(allocator.allocate(60, 1, retire), 0);
+        const uint64_t firstFrame = allocator.endFrame();
+        CHECK_EQUAL(allocator.allocate(30, 1, retire), 60);
+
+        // Only 10 bytes are left before the end, so the allocation skips to the start. That space belongs to the
+        // first frame, which has to be retired first.
+        CHECK_EQUAL(allocator.allocate(20, 1, retire), 0);
+        CHECK_EQUAL(retired.size(), 1);
+        CHECK_EQUAL(retired.front(), firstFrame);
+        CHECK_EQUAL(allocator.framesInFlight(), 0);
+
+        // The skipped bytes stay in use until the current frame is retired.
+        CHECK_EQUAL(allocator.usedBytes(), 60);
+        CHECK_EQUAL(allocator.allocate(20, 1, retire), 20);
+        CHECK_EQUAL(allocator.usedBytes(), 80);
+    }
+
+    void testRetiresOldestFirst()
+    {
+        RingAllocator allocator(90);
+        std::vector<uint64_t> retired;
+        auto retire = [&retired](const uint64_t frameId) { retired.push_back(frameId); };
+
+        std::vector<uint64_t> frames;
+        for (int i = 0; i < 3; ++i)
+        {
+            CHECK_EQUAL(allocator.allocate(30, 1, retire), i * 30);
+            frames.push_back(allocator.endFrame());
+        }
+
+        // Needs the space of two frames.
+        CHECK_EQUAL(allocator.allocate(50, 1, retire), 0);
+        CHECK_EQUAL(retired.size(), 2);
+        CHECK_EQUAL(retired[0], frames[0]);
+        CHECK_EQUAL(retired[1], frames[1]);
+        CHECK_EQUAL(allocator.framesInFlight(), 1);
+        CHECK_EQUAL(allocator.usedBytes(), 80);
+    }
+
+    void testRetireCompletedFrames()
+    {
+        RingAllocator allocator(1024);
+        std::vector<uint64_t> frames;
+        for (int i = 0; i < 3; ++i)
+        {
+            allocator.allocate(100, 1, neverRetire());
+            frames.push_back(allocator.endFrame());
+        }
+
+        // The last frame's fence hasn't signalled yet.
+        std::vector<uint64_t> checked;
+        allocator.retireCompletedFrames([&](const uint64_t frameId) {
+            checked.push_back(frameId);
+            return frameId != frames[2];
+        });
+
+        CHECK_EQUAL(checked, frames);
+        CHECK_EQUAL(allocator.framesInFlight(), 1);
+        CHECK_EQUAL(allocator.usedBytes(), 100);
+
+        // Frames after one that isn't done are never checked.
+        checked.clear();
+        allocator.allocate(100, 1, neverRetire());
+        allocator.endFrame();
+        allocator.retireCompletedFrames([&](const uint64_t frameId) {
+            checked.push_back(frameId);
+            return false;
+        });
+        CHECK_EQUAL(checked.size(), 1);
+        CHECK_EQUAL(allocator.framesInFlight(), 2);
+    }
+
+    void testOverCapacity()
+    {
+        RingAllocator allocator(64);
+        CHECK_EQUAL(allocator.allocate(65, 1, neverRetire()), RingAllocator::invalidOffset);
+        CHECK_EQUAL(allocator.usedBytes(), 0);
+
+        // The current frame can't be retired, so it can never use more than the capacity.
+        CHECK_EQUAL(allocator.allocate(48, 1, neverRetire()), 0);
+        CHECK_EQUAL(allocator.allocate(32, 1, neverRetire()), RingAllocator::invalidOffset);
+        CHECK_EQUAL(allocator.usedBytes(), 48);
+        CHECK_EQUAL(allocator.allocate(16, 1, neverRetire()), 48);
+
+        // Growing resets the allocator, which forgets every frame.
+        allocator.endFrame();
+        allocator.reset(128);
+        CHECK_EQUAL(allocator.framesInFlight(), 0);
+        CHECK_EQUAL(allocator.allocate(128, 1, neverRetire()), 0);
+    }
+}
+
+int main()
+{
+    test::Environment environment;
+    testAlignment();
+    testWrapAround();
+    testRetiresOldestFirst();
+    testRetireCompletedFrames();
+    testOverCapacity();
+    return test::result();
+}
@@ -0,0 +1,66 @@
+/**
+ * @file TestHelpers.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include <cmath>
+#include <iostream>
+
+#include "Logger.h"
+#include "Profiler.h"
+
+// Each test is a plain executable. A failed check prints where it was and makes the executable return non-zero,
+// which is all that ctest needs.
+namespace test
+{
+    inline int failureCount = 0;
+
+    inline void fail(const char *file, const int line, const char *expression)
+    {
+        std::cerr << file << "(" << line << "): check failed: " << expression << "\n";
+        ++failureCount;
+    }
+
+    /**
+     * @returns The value to return from main.
+     */
+    inline int result()
+    {
+        if (failureCount > 0)
+            std::cerr << failureCount << " check(s) failed.\n";
+        return failureCount > 0 ? 1 : 0;
+    }
+
+    /**
+     * @brief Sets up the globals that engine code expects Core to have made, such as the logger and profiler.
+     */
+    class Environment
+    {
+    public:
+        Environment()
+        {
+            debug::logger = &mLogger;
+            mLogger.setOutputFlag(debug::OutputSourceFlag_IoStream);
+            profiler = &mProfiler;
+        }
+
+        ~Environment()
+        {
+            mLogger.flush();
+            profiler = nullptr;
+            debug::logger = nullptr;
+        }
+
+    protected:
+        debug::Logger mLogger;
+        Profiler mProfiler;
+    };
+}
+
+#define CHECK(expression) ((expression) ? (void)0 : test::fail(__FILE__, __LINE__, #expression))
+#define CHECK_EQUAL(a, b) CHECK((a) == (b))
+#define CHECK_NEAR(a, b, epsilon) CHECK(std::abs((a) - (b)) <= (epsilon))